@@ -76,7 +76,14 @@ ApplicationWindow {
         "文件MD5": "qrc:/qt/qml/Honeycomb/windows/FileMD5Window.qml",
         "文件SHA1": "qrc:/qt/qml/Honeycomb/windows/FileSHA1Window.qml",
         "文件SHA256": "qrc:/qt/qml/Honeycomb/windows/FileSHA256Window.qml",
+        "文件SM3": "qrc:/qt/qml/Honeycomb/windows/FileSM3Window.qml",
+        "文件BLAKE3": "qrc:/qt/qml/Honeycomb/windows/FileBLAKE3Window.qml",
+        "文件CRC32": "qrc:/qt/qml/Honeycomb/windows/FileCRC32Window.qml",
+        "文件XXH3": "qrc:/qt/qml/Honeycomb/windows/FileXXH3Window.qml",
         "文件信息查看": "qrc:/qt/qml/Honeycomb/windows/FileInfoWindow.qml",
+        "文件夹校验": "qrc:/qt/qml/Honeycomb/windows/FolderHashWindow.qml",
+        "重复文件查找": "qrc:/qt/qml/Honeycomb/windows/DuplicateFileWindow.qml",
+        "二进制文件比较": "qrc:/qt/qml/Honeycomb/windows/BinaryDiffWindow.qml",
         "SHA1加密": "qrc:/qt/qml/Honeycomb/windows/SHA1Window.qml",
         "SHA256加密": "qrc:/qt/qml/Honeycomb/windows/SHA256Window.qml",
         "密码强度分析": "qrc:/qt/qml/Honeycomb/windows/PasswordStrengthWindow.qml",
@@ -93,6 +100,7 @@ ApplicationWindow {
         "RTSP预览": "qrc:/qt/qml/Honeycomb/windows/RTSPViewerWindow.qml",
         "文件夹映射": "qrc:/qt/qml/Honeycomb/windows/FolderMappingWindow.qml",
         "Fake API": "qrc:/qt/qml/Honeycomb/windows/FakeApiWindow.qml",
+        "HTTP压测": "qrc:/qt/qml/Honeycomb/windows/HttpBenchWindow.qml",
         "寄存器寻址范围": "qrc:/qt/qml/Honeycomb/windows/RegisterRangeWindow.qml",
         "电阻阻值计算": "qrc:/qt/qml/Honeycomb/windows/ResistorCalculatorWindow.qml",
         "串口调试": "qrc:/qt/qml/Honeycomb/windows/SerialPortWindow.qml",
@@ -256,7 +264,14 @@ ApplicationWindow {
             {title: I18n.t("toolFileMd5"), subtitle: I18n.t("toolFileMd5Desc"), key: "文件MD5"},
             {title: I18n.t("toolFileSha1"), subtitle: I18n.t("toolFileSha1Desc"), key: "文件SHA1"},
             {title: I18n.t("toolFileSha256"), subtitle: I18n.t("toolFileSha256Desc"), key: "文件SHA256"},
+            {title: I18n.t("toolFileSm3"), subtitle: I18n.t("toolFileSm3Desc"), key: "文件SM3"},
+            {title: I18n.t("toolFileBlake3"), subtitle: I18n.t("toolFileBlake3Desc"), key: "文件BLAKE3"},
+            {title: I18n.t("toolFileCrc32"), subtitle: I18n.t("toolFileCrc32Desc"), key: "文件CRC32"},
+            {title: I18n.t("toolFileXxh3"), subtitle: I18n.t("toolFileXxh3Desc"), key: "文件XXH3"},
             {title: I18n.t("toolFileInfo"), subtitle: I18n.t("toolFileInfoDesc"), key: "文件信息查看"},
+            {title: I18n.t("toolFolderHash"), subtitle: I18n.t("toolFolderHashDesc"), key: "文件夹校验"},
+            {title: I18n.t("toolDuplicateFile"), subtitle: I18n.t("toolDuplicateFileDesc"), key: "重复文件查找"},
+            {title: I18n.t("toolBinaryDiff"), subtitle: I18n.t("toolBinaryDiffDesc"), key: "二进制文件比较"},
             {title: I18n.t("toolSha1"), subtitle: I18n.t("toolSha1Desc"), key: "SHA1加密"},
             {title: I18n.t("toolSha256"), subtitle: I18n.t("toolSha256Desc"), key: "SHA256加密"},
             {title: I18n.t("toolPwdStrength"), subtitle: I18n.t("toolPwdStrengthDesc"), key: "密码强度分析"},
@@ -281,7 +296,8 @@ ApplicationWindow {
             {title: I18n.t("toolSubnet"), subtitle: I18n.t("toolSubnetDesc"), key: "子网掩码计算器"},
             {title: I18n.t("toolRtsp"), subtitle: I18n.t("toolRtspDesc"), key: "RTSP预览"},
             {title: I18n.t("toolFolderMapping"), subtitle: I18n.t("toolFolderMappingDesc"), key: "文件夹映射"},
-            {title: I18n.t("toolFakeApi"), subtitle: I18n.t("toolFakeApiDesc"), key: "Fake API"}
+            {title: I18n.t("toolFakeApi"), subtitle: I18n.t("toolFakeApiDesc"), key: "Fake API"},
+            {title: I18n.t("toolHttpBench"), subtitle: I18n.t("toolHttpBenchDesc"), key: "HTTP压测"}
         ],
         7: [ // 硬件工具
             {title: I18n.t("toolRegister"), subtitle: I18n.t("toolRegisterDesc"), key: "寄存器寻址范围"},
@@ -44,13 +44,19 @@ function getEnLang() {
         toolQRScanner: "QR Scanner",
         toolQRScannerDesc: "Scan QR code from image",
         toolFileBase64: "File to Base64",
-        toolFileBase64Desc: "Drop a file and convert it to Base64",
+        toolFileBase64Desc: "Convert files to and from Base64, streaming large files",
         toolBase64ImagePreview: "Base64 Image Preview",
         toolBase64ImagePreviewDesc: "Preview image from Base64 text",
         toolImageCompress: "Image Compress",
-        toolImageCompressDesc: "Compress images with more formats and size limits",
+        toolImageCompressDesc: "Compress images with more formats and size limits, or a whole folder in parallel",
         fileBase64DropTip: "Drop to convert to Base64",
-        fileBase64LimitTip: "To avoid freezes, single file size limit:",
+        fileBase64Encode: "File to Base64",
+        fileBase64Decode: "Base64 to file",
+        fileBase64Output: "Output file",
+        fileBase64OutputPlaceholder: "Leave empty to save next to the input file",
+        fileBase64Save: "Save to file",
+        fileBase64Simd: "SIMD: ",
+        fileBase64DecodedPreview: "Decoded data (hex)",
         fileBase64Result: "Base64 Result",
         fileBase64ResultPlaceholder: "Base64 text will appear after conversion",
         imageQualityTiny: "Maximum Compression",
@@ -74,6 +80,16 @@ function getEnLang() {
         imageCompressedSize: "Compressed",
         imageSaved: "Saved",
         imageFormatTip: "Read formats",
+        imageModeSingle: "Single Image",
+        imageModeBatch: "Batch",
+        imageBatchInputPlaceholder: "Folder path or glob such as D:/photos/**/*.jpg, or drop a folder...",
+        imageBatchDropTip: "Release to use this folder",
+        imageBatchOutputFolder: "Output Folder",
+        imageBatchOutputPlaceholder: "Leave empty to write to \"<folder>_compressed\" next to the input folder",
+        imageBatchProcessed: "Processed",
+        imageBatchFailed: "Failed",
+        imageBatchFilesPerSecond: "images/s",
+        imageBatchNone: "Per-file results appear here after compression",
         toolTimestamp: "Timestamp Converter",
         toolTimestampDesc: "Convert timestamp & date",
         toolColor: "Color Converter",
@@ -206,6 +222,7 @@ function getEnLang() {
         fileChecksumDropTip: "Drop to calculate all hashes",
         fileChecksumResult: "Checksum Result",
         fileChecksumPending: "Waiting for calculation",
+        fileChecksumRunning: "Calculating...",
         fileChecksumComparePlaceholder: "Paste expected value to compare",
         fileChecksumCompareTip: "Compare automatically after input",
         fileChecksumMatch: "Match",
@@ -216,14 +233,78 @@ function getEnLang() {
         toolFileSha1Desc: "Drop file to calculate SHA1",
         toolFileSha256: "File SHA256",
         toolFileSha256Desc: "Drop file to calculate SHA256",
+        toolFileSm3: "File SM3",
+        toolFileSm3Desc: "Drop file to calculate SM3",
+        toolFileBlake3: "File BLAKE3",
+        toolFileBlake3Desc: "Drop file to calculate BLAKE3 with multiple threads",
+        toolFileCrc32: "File CRC32",
+        toolFileCrc32Desc: "Drop file to quickly calculate CRC32",
+        toolFileXxh3: "File XXH3",
+        toolFileXxh3Desc: "Drop file to quickly calculate XXH3",
         toolFileInfo: "File Info",
         toolFileInfoDesc: "View file metadata and hashes",
+        toolFolderHash: "Folder Checksums",
+        toolFolderHashDesc: "Generate and verify sha256sum / md5sum manifests",
+        toolDuplicateFile: "Duplicate Finder",
+        toolDuplicateFileDesc: "Find duplicate files by size and hash, and total reclaimable space",
+        toolBinaryDiff: "Binary Compare",
+        toolBinaryDiffDesc: "Compare two large files block by block and list differing byte ranges",
         fileHash: "File Hash",
         fileHashDesc: "Drop a file or enter path to calculate file hash",
         filePath: "File Path",
         filePathPlaceholder: "Enter full file path, or drop a file...",
         fileHashDropTip: "Drop to calculate file hash",
         fileHashResultPlaceholder: "Drop a file or click calculate to show result",
+        fileHashSpeed: "Speed",
+        fileHashEta: "Remaining",
+        fileHashCancel: "Cancel",
+        forceRehash: "Ignore cache and rehash",
+        hashFromCache: "(cached)",
+        folderHash: "Folder Checksums",
+        folderHashDesc: "Generate sha256sum / md5sum compatible manifests, or verify files against one",
+        folderHashFolder: "Folder",
+        folderHashFolderPlaceholder: "Enter a folder path, or drop a folder...",
+        folderHashManifest: "Manifest",
+        folderHashManifestPlaceholder: "Leave empty to write into the folder; drop a .sha256 / .md5 file to verify",
+        folderHashThreads: "Parallel files",
+        folderHashGenerate: "Generate",
+        folderHashVerify: "Verify",
+        folderHashOk: "OK",
+        folderHashMismatch: "Mismatched",
+        folderHashMissing: "Missing",
+        folderHashFailed: "Unreadable",
+        folderHashProblems: "Problem files",
+        folderHashNoProblems: "No problem files",
+        duplicateFile: "Duplicate Finder",
+        duplicateFileDesc: "Groups files by size, then compares the first and last 64 KB; only files that still match are fully hashed",
+        duplicateFileMinimumSize: "Minimum size",
+        duplicateFileScan: "Scan",
+        duplicateFileStageSize: "Grouping by size",
+        duplicateFileStageEdge: "Comparing edges",
+        duplicateFileStageFull: "Full hashing",
+        duplicateFileGroups: "Duplicate groups",
+        duplicateFileDuplicates: "Duplicates",
+        duplicateFileReclaimable: "Reclaimable",
+        duplicateFileNone: "No duplicate files",
+        binaryDiff: "Binary Compare",
+        binaryDiffDesc: "Compares two large files (firmware, disk images) block by block and lists changed, inserted and deleted byte ranges",
+        binaryDiffOld: "Old file",
+        binaryDiffOldPlaceholder: "Enter the old file path, or drop a file...",
+        binaryDiffNew: "New file",
+        binaryDiffNewPlaceholder: "Enter the new file path, or drop a file...",
+        binaryDiffBlockSize: "Block size",
+        binaryDiffAuto: "Auto",
+        binaryDiffThreads: "Parallel segments",
+        binaryDiffCompare: "Compare",
+        binaryDiffStageSignature: "Hashing blocks",
+        binaryDiffStageScan: "Scanning new file",
+        binaryDiffMatched: "Same",
+        binaryDiffChanged: "Changed",
+        binaryDiffInserted: "Inserted",
+        binaryDiffDeleted: "Deleted",
+        binaryDiffRanges: "Differing ranges",
+        binaryDiffNone: "No differing ranges",
+        binaryDiffTruncated: "Only the first %1 are listed; Copy All gets the full list",
         toolSha1: "SHA1 Hash",
         toolSha1Desc: "String to SHA1",
         toolSha256: "SHA256 Hash",
@@ -274,6 +355,8 @@ function getEnLang() {
         toolFolderMappingDesc: "Map folder to HTTP server",
         toolFakeApi: "Fake API",
         toolFakeApiDesc: "Mock API server",
+        toolHttpBench: "HTTP Benchmark",
+        toolHttpBenchDesc: "HTTP throughput and latency load test",
         
         // Hardware tools
         toolRegister: "Register Range",
@@ -464,6 +547,23 @@ function getEnLang() {
         exportConfig: "Export Config",
         importSuccess: "Import Success",
         exportSuccess: "Export Success",
+        importOpenApi: "Import OpenAPI Spec",
+        importingOpenApi: "Importing...",
+        
+        // HTTP Benchmark
+        benchUrl: "Target URL:",
+        benchConnections: "Connections:",
+        benchRate: "Rate (req/s):",
+        benchRateTip: "0 = closed loop, > 0 = open loop at a fixed rate",
+        benchDuration: "Duration (s):",
+        benchKeepAlive: "Keep-Alive",
+        benchStart: "Start",
+        benchStop: "Stop",
+        benchRequests: "Requests",
+        benchErrors: "Errors",
+        benchThroughput: "Throughput",
+        benchReport: "Report",
+        benchNoReport: "Latency distribution will appear here after the run",
         
         // Context Float Window
         contextFloatPin: "Pin",
@@ -1119,17 +1219,30 @@ function getEnLang() {
         decrypt: "Decrypt",
         resultWillAppear: "Result will appear here",
         sm3Desc: "Chinese national hash algorithm, 256-bit output, similar to SHA-256",
-        sm4Desc: "Chinese national symmetric encryption, 128-bit key, supports ECB/CBC mode",
+        sm4Desc: "Chinese national symmetric encryption, 128-bit key, supports ECB/CBC/CTR/GCM mode",
         error: "Error",
         
         // AES Crypto
-        aesCryptoDesc: "Supports AES-128/192/256 encryption, ECB/CBC mode",
+        aesCryptoDesc: "Supports AES-128/192/256 encryption, ECB/CBC/CTR/GCM mode",
+        aesBackend: "Acceleration",
+        sm4Backend: "SM4 acceleration",
+        gcmAad: "AAD",
+        gcmAadPlaceholder: "Optional data that is authenticated but not encrypted...",
+        gcmTag: "Auth Tag",
+        gcmTagPlaceholder: "Filled in after encryption, required for decryption...",
+        fileCryptoTitle: "File Encryption",
+        fileCryptoSelect: "Select File",
+        fileCryptoPlaceholder: "Select a file to encrypt or decrypt...",
+        fileCryptoEncrypt: "Encrypt File",
+        fileCryptoDecrypt: "Decrypt File",
+        fileCryptoCancel: "Cancel",
+        fileCryptoSaveTitle: "Save As",
         aesKeySize: "Key Size",
         aesKeyPlaceholder128: "Enter 32 hex characters key...",
         aesKeyPlaceholder192: "Enter 48 hex characters key...",
         aesKeyPlaceholder256: "Enter 64 hex characters key...",
         aesInputPlaceholder: "Enter plaintext to encrypt or hex ciphertext to decrypt...",
-        aesDesc: "Advanced Encryption Standard, supports 128/192/256-bit keys, ECB/CBC mode, PKCS7 padding",
+        aesDesc: "Advanced Encryption Standard, supports 128/192/256-bit keys, ECB/CBC/CTR/GCM mode, PKCS7 padding for ECB/CBC",
         
         // OpenAI API Test
         apiSettings: "API Settings",
@@ -44,13 +44,19 @@ function getZhLang() {
         toolQRScanner: "识别二维码",
         toolQRScannerDesc: "从图片识别二维码内容",
         toolFileBase64: "文件转Base64",
-        toolFileBase64Desc: "拖入文件转换Base64",
+        toolFileBase64Desc: "文件与Base64互转，大文件流式转换",
         toolBase64ImagePreview: "Base64图片预览",
         toolBase64ImagePreviewDesc: "粘贴Base64预览图片",
         toolImageCompress: "图片压缩",
-        toolImageCompressDesc: "多格式图片压缩与尺寸限制",
+        toolImageCompressDesc: "多格式图片压缩与尺寸限制，可并行批量压缩整个文件夹",
         fileBase64DropTip: "松开后转换Base64",
-        fileBase64LimitTip: "为避免卡顿，单文件大小限制：",
+        fileBase64Encode: "文件转Base64",
+        fileBase64Decode: "Base64转文件",
+        fileBase64Output: "输出文件",
+        fileBase64OutputPlaceholder: "留空时保存在输入文件旁",
+        fileBase64Save: "保存为文件",
+        fileBase64Simd: "SIMD 实现：",
+        fileBase64DecodedPreview: "解码结果（十六进制）",
         fileBase64Result: "Base64结果",
         fileBase64ResultPlaceholder: "转换后显示Base64文本",
         imageQualityTiny: "极限压缩",
@@ -74,6 +80,16 @@ function getZhLang() {
         imageCompressedSize: "压缩后",
         imageSaved: "节省",
         imageFormatTip: "读取格式",
+        imageModeSingle: "单张图片",
+        imageModeBatch: "批量压缩",
+        imageBatchInputPlaceholder: "文件夹路径或通配符，如 D:/photos/**/*.jpg，也可拖入文件夹...",
+        imageBatchDropTip: "松开后填入文件夹路径",
+        imageBatchOutputFolder: "输出文件夹",
+        imageBatchOutputPlaceholder: "留空时输出到输入文件夹旁的“文件夹名_compressed”",
+        imageBatchProcessed: "已处理",
+        imageBatchFailed: "失败",
+        imageBatchFilesPerSecond: "张/秒",
+        imageBatchNone: "压缩后在此逐个列出文件的结果",
         toolTimestamp: "时间戳转换",
         toolTimestampDesc: "时间戳与日期互转",
         toolColor: "颜色值转换",
@@ -206,6 +222,7 @@ function getZhLang() {
         fileChecksumDropTip: "松开后计算所有哈希",
         fileChecksumResult: "校验结果",
         fileChecksumPending: "等待计算",
+        fileChecksumRunning: "计算中...",
         fileChecksumComparePlaceholder: "粘贴用于比对的值",
         fileChecksumCompareTip: "输入后自动比对",
         fileChecksumMatch: "匹配",
@@ -216,14 +233,78 @@ function getZhLang() {
         toolFileSha1Desc: "拖入文件计算SHA1",
         toolFileSha256: "文件SHA256",
         toolFileSha256Desc: "拖入文件计算SHA256",
+        toolFileSm3: "文件SM3",
+        toolFileSm3Desc: "拖入文件计算SM3",
+        toolFileBlake3: "文件BLAKE3",
+        toolFileBlake3Desc: "拖入文件多线程计算BLAKE3",
+        toolFileCrc32: "文件CRC32",
+        toolFileCrc32Desc: "拖入文件快速计算CRC32",
+        toolFileXxh3: "文件XXH3",
+        toolFileXxh3Desc: "拖入文件快速计算XXH3",
         toolFileInfo: "文件信息查看",
         toolFileInfoDesc: "查看文件元信息与摘要",
+        toolFolderHash: "文件夹校验",
+        toolFolderHashDesc: "生成与校验 sha256sum / md5sum 清单",
+        toolDuplicateFile: "重复文件查找",
+        toolDuplicateFileDesc: "按大小与哈希查找重复文件并统计可释放空间",
+        toolBinaryDiff: "二进制文件比较",
+        toolBinaryDiffDesc: "按块比较两个大文件，列出不同的字节范围",
         fileHash: "文件哈希",
         fileHashDesc: "拖入文件或输入路径后计算文件哈希",
         filePath: "文件路径",
         filePathPlaceholder: "请输入文件完整路径，或拖入文件...",
         fileHashDropTip: "松开后计算文件哈希",
         fileHashResultPlaceholder: "拖入文件或点击计算后显示结果",
+        fileHashSpeed: "速度",
+        fileHashEta: "剩余",
+        fileHashCancel: "取消",
+        forceRehash: "忽略缓存重新计算",
+        hashFromCache: "（来自缓存）",
+        folderHash: "文件夹校验",
+        folderHashDesc: "批量生成 sha256sum / md5sum 兼容的校验清单，或按清单逐个校验文件",
+        folderHashFolder: "文件夹",
+        folderHashFolderPlaceholder: "请输入文件夹路径，或拖入文件夹...",
+        folderHashManifest: "校验清单",
+        folderHashManifestPlaceholder: "生成时留空则写入文件夹内；校验时拖入 .sha256 / .md5 文件",
+        folderHashThreads: "并行文件数",
+        folderHashGenerate: "生成清单",
+        folderHashVerify: "校验",
+        folderHashOk: "一致",
+        folderHashMismatch: "不一致",
+        folderHashMissing: "缺失",
+        folderHashFailed: "读取失败",
+        folderHashProblems: "问题文件",
+        folderHashNoProblems: "没有问题文件",
+        duplicateFile: "重复文件查找",
+        duplicateFileDesc: "先按大小分组，再比较首尾 64 KB，只有仍然相同的文件才完整计算哈希",
+        duplicateFileMinimumSize: "最小文件",
+        duplicateFileScan: "查找",
+        duplicateFileStageSize: "按大小分组",
+        duplicateFileStageEdge: "比较首尾",
+        duplicateFileStageFull: "完整比较",
+        duplicateFileGroups: "重复组",
+        duplicateFileDuplicates: "重复文件",
+        duplicateFileReclaimable: "可释放",
+        duplicateFileNone: "没有重复文件",
+        binaryDiff: "二进制文件比较",
+        binaryDiffDesc: "按块比较两个大文件（固件、磁盘镜像等），列出修改、插入与删除的字节范围",
+        binaryDiffOld: "旧文件",
+        binaryDiffOldPlaceholder: "请输入旧文件路径，或拖入文件...",
+        binaryDiffNew: "新文件",
+        binaryDiffNewPlaceholder: "请输入新文件路径，或拖入文件...",
+        binaryDiffBlockSize: "块长",
+        binaryDiffAuto: "自动",
+        binaryDiffThreads: "并行段数",
+        binaryDiffCompare: "比较",
+        binaryDiffStageSignature: "计算块签名",
+        binaryDiffStageScan: "扫描新文件",
+        binaryDiffMatched: "相同",
+        binaryDiffChanged: "修改",
+        binaryDiffInserted: "插入",
+        binaryDiffDeleted: "删除",
+        binaryDiffRanges: "不同的范围",
+        binaryDiffNone: "没有不同的范围",
+        binaryDiffTruncated: "只列出前 %1 项，复制全部可取得完整列表",
         toolSha1: "SHA1加密",
         toolSha1Desc: "字符串转SHA1",
         toolSha256: "SHA256加密",
@@ -274,6 +355,8 @@ function getZhLang() {
         toolFolderMappingDesc: "将文件夹映射为HTTP服务",
         toolFakeApi: "Fake API",
         toolFakeApiDesc: "模拟API接口服务",
+        toolHttpBench: "HTTP压测",
+        toolHttpBenchDesc: "HTTP接口吞吐与延迟压测",
 
         // 硬件工具分类
         toolRegister: "寄存器寻址范围",
@@ -464,6 +547,23 @@ function getZhLang() {
         exportConfig: "导出配置",
         importSuccess: "导入成功",
         exportSuccess: "导出成功",
+        importOpenApi: "导入 OpenAPI 规范",
+        importingOpenApi: "导入中...",
+
+        // HTTP 压测
+        benchUrl: "目标地址:",
+        benchConnections: "连接数:",
+        benchRate: "速率(req/s):",
+        benchRateTip: "0 为闭环模式，大于 0 为开环固定速率",
+        benchDuration: "时长(秒):",
+        benchKeepAlive: "保持连接 (Keep-Alive)",
+        benchStart: "开始压测",
+        benchStop: "停止",
+        benchRequests: "请求数",
+        benchErrors: "错误数",
+        benchThroughput: "吞吐",
+        benchReport: "压测报告",
+        benchNoReport: "压测结束后将在此显示延迟分布",
 
         // 上下文飘窗
         contextFloatPin: "置顶",
@@ -1119,17 +1219,30 @@ function getZhLang() {
         decrypt: "解密",
         resultWillAppear: "结果将显示在这里",
         sm3Desc: "国密哈希算法，输出256位哈希值，类似SHA-256",
-        sm4Desc: "国密对称加密算法，128位密钥，支持ECB/CBC模式",
+        sm4Desc: "国密对称加密算法，128位密钥，支持ECB/CBC/CTR/GCM模式",
         error: "错误",
 
         // AES加解密
-        aesCryptoDesc: "支持AES-128/192/256加密，ECB/CBC模式",
+        aesCryptoDesc: "支持AES-128/192/256加密，ECB/CBC/CTR/GCM模式",
+        aesBackend: "加速实现",
+        sm4Backend: "SM4加速实现",
+        gcmAad: "附加数据",
+        gcmAadPlaceholder: "可选，参与认证但不加密的数据...",
+        gcmTag: "认证标签",
+        gcmTagPlaceholder: "加密后自动生成，解密时需填写...",
+        fileCryptoTitle: "文件加解密",
+        fileCryptoSelect: "选择文件",
+        fileCryptoPlaceholder: "选择要加密或解密的文件...",
+        fileCryptoEncrypt: "加密文件",
+        fileCryptoDecrypt: "解密文件",
+        fileCryptoCancel: "取消",
+        fileCryptoSaveTitle: "保存为",
         aesKeySize: "密钥长度",
         aesKeyPlaceholder128: "请输入32位十六进制密钥...",
         aesKeyPlaceholder192: "请输入48位十六进制密钥...",
         aesKeyPlaceholder256: "请输入64位十六进制密钥...",
         aesInputPlaceholder: "加密时输入明文，解密时输入十六进制密文...",
-        aesDesc: "高级加密标准，支持128/192/256位密钥，ECB/CBC模式，使用PKCS7填充",
+        aesDesc: "高级加密标准，支持128/192/256位密钥，ECB/CBC/CTR/GCM模式，ECB/CBC使用PKCS7填充",
 
         // OpenAI API测试
         apiSettings: "API 设置",
@@ -31,6 +31,7 @@
 #include "src/ResistorCalculator.h"
 #include "src/FolderHttpServer.h"
 #include "src/FakeApiServer.h"
+#include "src/HttpBenchmark.h"
 #include "src/SMCrypto.h"
 #include "src/AESCrypto.h"
 #include "src/OpenAIClient.h"
@@ -40,12 +41,24 @@
 #include "src/ProcessManagerTool.h"
 #include "src/FileHashCalculator.h"
 #include "src/FileUtilityTool.h"
+#include "src/FolderHashTool.h"
+#include "src/DuplicateFileTool.h"
+#include "src/BinaryDiffTool.h"
+#include "src/Base64FileTool.h"
+#include "src/Base64ImageDecoder.h"
+#include "src/BatchImageCompressTool.h"
 #include "src/UpdateChecker.h"
 #include "src/SerialPortTool.h"
 #include "src/WindowElementInspector.h"
+#include "src/HeadlessServer.h"
 
 int main(int argc, char *argv[])
 {
+    // serve / mock 子命令：只启动 QCoreApplication，不初始化 WebEngine 与 QML
+    if (HeadlessServer::isHeadlessCommand(argc, argv)) {
+        return HeadlessServer::run(argc, argv);
+    }
+
     QtWebEngineQuick::initialize();
     QApplication app(argc, argv);
     
@@ -61,6 +74,7 @@ int main(int argc, char *argv[])
     g_barcodeImageProvider = new BarcodeImageProvider();
     g_qrcodeImageProvider = new QRCodeImageProvider();
     g_qrScannerImageProvider = new QRScannerImageProvider();
+    g_base64ImageProvider = new Base64ImageProvider();
 
     // 注册 C++ 类型到 QML
     qmlRegisterType<RandomNumberGenerator>("Honeycomb", 1, 0, "RandomNumberGenerator");
@@ -89,6 +103,7 @@ int main(int argc, char *argv[])
     qmlRegisterType<ResistorCalculator>("Honeycomb", 1, 0, "ResistorCalculator");
     qmlRegisterType<FolderHttpServer>("Honeycomb", 1, 0, "FolderHttpServer");
     qmlRegisterType<FakeApiServer>("Honeycomb", 1, 0, "FakeApiServer");
+    qmlRegisterType<HttpBenchmark>("Honeycomb", 1, 0, "HttpBenchmark");
     qmlRegisterType<SMCrypto>("Honeycomb", 1, 0, "SMCrypto");
     qmlRegisterType<AESCrypto>("Honeycomb", 1, 0, "AESCrypto");
     qmlRegisterType<OpenAIClient>("Honeycomb", 1, 0, "OpenAIClient");
@@ -98,6 +113,12 @@ int main(int argc, char *argv[])
     qmlRegisterType<ProcessManagerTool>("Honeycomb", 1, 0, "ProcessManagerTool");
     qmlRegisterType<FileHashCalculator>("Honeycomb", 1, 0, "FileHashCalculator");
     qmlRegisterType<FileUtilityTool>("Honeycomb", 1, 0, "FileUtilityTool");
+    qmlRegisterType<FolderHashTool>("Honeycomb", 1, 0, "FolderHashTool");
+    qmlRegisterType<DuplicateFileTool>("Honeycomb", 1, 0, "DuplicateFileTool");
+    qmlRegisterType<BinaryDiffTool>("Honeycomb", 1, 0, "BinaryDiffTool");
+    qmlRegisterType<Base64FileTool>("Honeycomb", 1, 0, "Base64FileTool");
+    qmlRegisterType<Base64ImageDecoder>("Honeycomb", 1, 0, "Base64ImageDecoder");
+    qmlRegisterType<BatchImageCompressTool>("Honeycomb", 1, 0, "BatchImageCompressTool");
     qmlRegisterType<UpdateChecker>("Honeycomb", 1, 0, "UpdateChecker");
     qmlRegisterType<SerialPortTool>("Honeycomb", 1, 0, "SerialPortTool");
     qmlRegisterType<WindowElementInspector>("Honeycomb", 1, 0, "WindowElementInspector");
@@ -108,6 +129,7 @@ int main(int argc, char *argv[])
     engine.addImageProvider("barcode", g_barcodeImageProvider);
     engine.addImageProvider("qrcode", g_qrcodeImageProvider);
     engine.addImageProvider("qrscanner", g_qrScannerImageProvider);
+    engine.addImageProvider("base64image", g_base64ImageProvider);
     
     QObject::connect(
         &engine,
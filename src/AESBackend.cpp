@@ -0,0 +1,267 @@
+#include "AESBackend.h"
+#include "CpuFeatures.h"
+
+#include <QtEndian>
+
+namespace {
+
+// AES S盒
+constexpr quint8 SBOX[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+// AES 逆S盒
+constexpr quint8 INV_SBOX[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+// AES Rcon
+constexpr quint8 RCON[11] = {
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+constexpr quint8 xtime(quint8 x)
+{
+    return quint8((x << 1) ^ (((x >> 7) & 1) * 0x1b));
+}
+
+constexpr quint8 multiply(quint8 x, quint8 y)
+{
+    quint8 result = 0;
+    for (; y; y >>= 1) {
+        if (y & 1) {
+            result ^= x;
+        }
+        x = xtime(x);
+    }
+    return result;
+}
+
+constexpr quint32 rotr8(quint32 x)
+{
+    return (x >> 8) | (x << 24);
+}
+
+// T 表：把 SubBytes + ShiftRows + MixColumns 合并为每列 4 次查表。
+// te[0][x] = (2·S[x], S[x], S[x], 3·S[x])，te[1..3] 依次循环右移一个字节；
+// td 同理使用逆 S 盒与 InvMixColumns 系数 (14, 9, 13, 11)。编译期生成。
+struct TTables {
+    quint32 te[4][256];
+    quint32 td[4][256];
+};
+
+constexpr TTables makeTTables()
+{
+    TTables t{};
+    for (int x = 0; x < 256; ++x) {
+        const quint8 s = SBOX[x];
+        const quint8 inv = INV_SBOX[x];
+        quint32 e = (quint32(multiply(s, 2)) << 24) | (quint32(s) << 16)
+                  | (quint32(s) << 8) | quint32(multiply(s, 3));
+        quint32 d = (quint32(multiply(inv, 14)) << 24) | (quint32(multiply(inv, 9)) << 16)
+                  | (quint32(multiply(inv, 13)) << 8) | quint32(multiply(inv, 11));
+        for (int i = 0; i < 4; ++i) {
+            t.te[i][x] = e;
+            t.td[i][x] = d;
+            e = rotr8(e);
+            d = rotr8(d);
+        }
+    }
+    return t;
+}
+
+constexpr TTables T = makeTTables();
+
+inline quint32 subWord(quint32 w)
+{
+    return (quint32(SBOX[w >> 24]) << 24) | (quint32(SBOX[(w >> 16) & 0xff]) << 16)
+         | (quint32(SBOX[(w >> 8) & 0xff]) << 8) | quint32(SBOX[w & 0xff]);
+}
+
+// 对一个轮密钥字做 InvMixColumns：td 表自带逆 S 盒，先过一次 S 盒抵消
+inline quint32 invMixColumnWord(quint32 w)
+{
+    return T.td[0][SBOX[w >> 24]] ^ T.td[1][SBOX[(w >> 16) & 0xff]]
+         ^ T.td[2][SBOX[(w >> 8) & 0xff]] ^ T.td[3][SBOX[w & 0xff]];
+}
+
+void encryptPortable(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+{
+    for (; blocks > 0; --blocks, in += 16, out += 16) {
+        const quint32 *rk = schedule.encWords;
+        quint32 s0 = qFromBigEndian<quint32>(in) ^ rk[0];
+        quint32 s1 = qFromBigEndian<quint32>(in + 4) ^ rk[1];
+        quint32 s2 = qFromBigEndian<quint32>(in + 8) ^ rk[2];
+        quint32 s3 = qFromBigEndian<quint32>(in + 12) ^ rk[3];
+
+        for (int round = 1; round < schedule.rounds; ++round) {
+            rk += 4;
+            const quint32 t0 = T.te[0][s0 >> 24] ^ T.te[1][(s1 >> 16) & 0xff] ^ T.te[2][(s2 >> 8) & 0xff] ^ T.te[3][s3 & 0xff] ^ rk[0];
+            const quint32 t1 = T.te[0][s1 >> 24] ^ T.te[1][(s2 >> 16) & 0xff] ^ T.te[2][(s3 >> 8) & 0xff] ^ T.te[3][s0 & 0xff] ^ rk[1];
+            const quint32 t2 = T.te[0][s2 >> 24] ^ T.te[1][(s3 >> 16) & 0xff] ^ T.te[2][(s0 >> 8) & 0xff] ^ T.te[3][s1 & 0xff] ^ rk[2];
+            const quint32 t3 = T.te[0][s3 >> 24] ^ T.te[1][(s0 >> 16) & 0xff] ^ T.te[2][(s1 >> 8) & 0xff] ^ T.te[3][s2 & 0xff] ^ rk[3];
+            s0 = t0;
+            s1 = t1;
+            s2 = t2;
+            s3 = t3;
+        }
+
+        // 最后一轮没有 MixColumns，直接查 S 盒
+        rk += 4;
+        const quint32 out0 = (quint32(SBOX[s0 >> 24]) << 24) | (quint32(SBOX[(s1 >> 16) & 0xff]) << 16)
+                           | (quint32(SBOX[(s2 >> 8) & 0xff]) << 8) | quint32(SBOX[s3 & 0xff]);
+        const quint32 out1 = (quint32(SBOX[s1 >> 24]) << 24) | (quint32(SBOX[(s2 >> 16) & 0xff]) << 16)
+                           | (quint32(SBOX[(s3 >> 8) & 0xff]) << 8) | quint32(SBOX[s0 & 0xff]);
+        const quint32 out2 = (quint32(SBOX[s2 >> 24]) << 24) | (quint32(SBOX[(s3 >> 16) & 0xff]) << 16)
+                           | (quint32(SBOX[(s0 >> 8) & 0xff]) << 8) | quint32(SBOX[s1 & 0xff]);
+        const quint32 out3 = (quint32(SBOX[s3 >> 24]) << 24) | (quint32(SBOX[(s0 >> 16) & 0xff]) << 16)
+                           | (quint32(SBOX[(s1 >> 8) & 0xff]) << 8) | quint32(SBOX[s2 & 0xff]);
+        qToBigEndian<quint32>(out0 ^ rk[0], out);
+        qToBigEndian<quint32>(out1 ^ rk[1], out + 4);
+        qToBigEndian<quint32>(out2 ^ rk[2], out + 8);
+        qToBigEndian<quint32>(out3 ^ rk[3], out + 12);
+    }
+}
+
+void decryptPortable(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+{
+    for (; blocks > 0; --blocks, in += 16, out += 16) {
+        const quint32 *rk = schedule.decWords;
+        quint32 s0 = qFromBigEndian<quint32>(in) ^ rk[0];
+        quint32 s1 = qFromBigEndian<quint32>(in + 4) ^ rk[1];
+        quint32 s2 = qFromBigEndian<quint32>(in + 8) ^ rk[2];
+        quint32 s3 = qFromBigEndian<quint32>(in + 12) ^ rk[3];
+
+        for (int round = 1; round < schedule.rounds; ++round) {
+            rk += 4;
+            const quint32 t0 = T.td[0][s0 >> 24] ^ T.td[1][(s3 >> 16) & 0xff] ^ T.td[2][(s2 >> 8) & 0xff] ^ T.td[3][s1 & 0xff] ^ rk[0];
+            const quint32 t1 = T.td[0][s1 >> 24] ^ T.td[1][(s0 >> 16) & 0xff] ^ T.td[2][(s3 >> 8) & 0xff] ^ T.td[3][s2 & 0xff] ^ rk[1];
+            const quint32 t2 = T.td[0][s2 >> 24] ^ T.td[1][(s1 >> 16) & 0xff] ^ T.td[2][(s0 >> 8) & 0xff] ^ T.td[3][s3 & 0xff] ^ rk[2];
+            const quint32 t3 = T.td[0][s3 >> 24] ^ T.td[1][(s2 >> 16) & 0xff] ^ T.td[2][(s1 >> 8) & 0xff] ^ T.td[3][s0 & 0xff] ^ rk[3];
+            s0 = t0;
+            s1 = t1;
+            s2 = t2;
+            s3 = t3;
+        }
+
+        rk += 4;
+        const quint32 out0 = (quint32(INV_SBOX[s0 >> 24]) << 24) | (quint32(INV_SBOX[(s3 >> 16) & 0xff]) << 16)
+                           | (quint32(INV_SBOX[(s2 >> 8) & 0xff]) << 8) | quint32(INV_SBOX[s1 & 0xff]);
+        const quint32 out1 = (quint32(INV_SBOX[s1 >> 24]) << 24) | (quint32(INV_SBOX[(s0 >> 16) & 0xff]) << 16)
+                           | (quint32(INV_SBOX[(s3 >> 8) & 0xff]) << 8) | quint32(INV_SBOX[s2 & 0xff]);
+        const quint32 out2 = (quint32(INV_SBOX[s2 >> 24]) << 24) | (quint32(INV_SBOX[(s1 >> 16) & 0xff]) << 16)
+                           | (quint32(INV_SBOX[(s0 >> 8) & 0xff]) << 8) | quint32(INV_SBOX[s3 & 0xff]);
+        const quint32 out3 = (quint32(INV_SBOX[s3 >> 24]) << 24) | (quint32(INV_SBOX[(s2 >> 16) & 0xff]) << 16)
+                           | (quint32(INV_SBOX[(s1 >> 8) & 0xff]) << 8) | quint32(INV_SBOX[s0 & 0xff]);
+        qToBigEndian<quint32>(out0 ^ rk[0], out);
+        qToBigEndian<quint32>(out1 ^ rk[1], out + 4);
+        qToBigEndian<quint32>(out2 ^ rk[2], out + 8);
+        qToBigEndian<quint32>(out3 ^ rk[3], out + 12);
+    }
+}
+
+}
+
+bool AESBackend::expandKey(const quint8 *key, int keyLength, KeySchedule *schedule)
+{
+    if (keyLength != 16 && keyLength != 24 && keyLength != 32) {
+        return false;
+    }
+
+    const int nk = keyLength / 4;
+    const int nr = nk + 6;
+    const int totalWords = 4 * (nr + 1);
+    quint32 *enc = schedule->encWords;
+    quint32 *dec = schedule->decWords;
+    schedule->rounds = nr;
+
+    for (int i = 0; i < nk; ++i) {
+        enc[i] = qFromBigEndian<quint32>(key + i * 4);
+    }
+
+    for (int i = nk; i < totalWords; ++i) {
+        quint32 temp = enc[i - 1];
+        if (i % nk == 0) {
+            // RotWord + SubWord + Rcon
+            temp = subWord((temp << 8) | (temp >> 24)) ^ (quint32(RCON[i / nk]) << 24);
+        } else if (nk > 6 && i % nk == 4) {
+            // SubWord for AES-256
+            temp = subWord(temp);
+        }
+        enc[i] = enc[i - nk] ^ temp;
+    }
+
+    // 等价逆密码：轮密钥逆序，首尾两轮之外再做 InvMixColumns
+    for (int round = 0; round <= nr; ++round) {
+        const quint32 *src = enc + (nr - round) * 4;
+        for (int j = 0; j < 4; ++j) {
+            dec[round * 4 + j] = (round == 0 || round == nr) ? src[j] : invMixColumnWord(src[j]);
+        }
+    }
+
+    for (int i = 0; i < totalWords; ++i) {
+        qToBigEndian<quint32>(enc[i], schedule->encRoundKeys + i * 4);
+        qToBigEndian<quint32>(dec[i], schedule->decRoundKeys + i * 4);
+    }
+    return true;
+}
+
+const AESBackend::Implementation &AESBackend::portable()
+{
+    static const Implementation impl = {"T-table", encryptPortable, decryptPortable};
+    return impl;
+}
+
+QList<const AESBackend::Implementation *> AESBackend::available()
+{
+    QList<const Implementation *> result{&portable()};
+#if defined(Q_PROCESSOR_X86)
+    static const Implementation aesNi = {"AES-NI", AESBackendHw::encryptAesNi, AESBackendHw::decryptAesNi};
+    if (CpuFeatures::hasAesNi() && CpuFeatures::hasSse41()) {
+        result << &aesNi;
+    }
+#endif
+#if defined(Q_PROCESSOR_ARM_64)
+    static const Implementation armCe = {"ARMv8-CE", AESBackendHw::encryptArmCe, AESBackendHw::decryptArmCe};
+    if (CpuFeatures::hasArmAes()) {
+        result << &armCe;
+    }
+#endif
+    return result;
+}
+
+const AESBackend::Implementation &AESBackend::active()
+{
+    static const Implementation *impl = available().constLast();
+    return *impl;
+}
@@ -0,0 +1,66 @@
+#ifndef AESBACKEND_H
+#define AESBACKEND_H
+
+#include <QList>
+#include <QtGlobal>
+
+#include <cstddef>
+
+// AES 分组运算后端：可移植的 32 位 T 表实现，以及运行时按 CPU 特性选择的
+// AES-NI（x86）/ ARMv8 加密扩展实现。所有模式（ECB/CBC/...）都通过这里加解密分组。
+class AESBackend
+{
+public:
+    struct KeySchedule {
+        // 轮密钥的字节序列，硬件指令直接加载
+        alignas(16) quint8 encRoundKeys[240];
+        // 等价逆密码的解密轮密钥：逆序，中间各轮做 InvMixColumns
+        alignas(16) quint8 decRoundKeys[240];
+        // 同一组轮密钥的大端 32 位字形式，供 T 表实现使用
+        quint32 encWords[60];
+        quint32 decWords[60];
+        int rounds = 0;
+    };
+
+    // 处理 blocks 个连续 16 字节分组，in 与 out 可以指向同一缓冲区
+    using BlockFunction = void (*)(const KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks);
+
+    struct Implementation {
+        const char *name;
+        BlockFunction encrypt;
+        BlockFunction decrypt;
+    };
+
+    // keyLength 为 16 / 24 / 32 字节
+    static bool expandKey(const quint8 *key, int keyLength, KeySchedule *schedule);
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active();
+    static const Implementation &portable();
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available();
+
+    static void encryptBlocks(const KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+    {
+        active().encrypt(schedule, in, out, blocks);
+    }
+
+    static void decryptBlocks(const KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+    {
+        active().decrypt(schedule, in, out, blocks);
+    }
+};
+
+// 硬件实现位于 AESBackend_x86.cpp / AESBackend_arm.cpp，这两个文件使用单独的编译选项
+namespace AESBackendHw {
+#if defined(Q_PROCESSOR_X86)
+void encryptAesNi(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks);
+void decryptAesNi(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks);
+#endif
+#if defined(Q_PROCESSOR_ARM_64)
+void encryptArmCe(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks);
+void decryptArmCe(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks);
+#endif
+}
+
+#endif // AESBACKEND_H
@@ -0,0 +1,106 @@
+#include "AESBackend.h"
+
+// ARMv8 加密扩展实现。GCC/Clang 下本文件以 -march=armv8-a+crypto 单独编译，
+// 只有 CpuFeatures 检测到 AES 指令时才会被调用。
+#if defined(Q_PROCESSOR_ARM_64)
+
+#include <arm_neon.h>
+
+namespace {
+
+constexpr size_t kParallelBlocks = 4;
+
+struct RoundKeys {
+    uint8x16_t k[15];
+};
+
+inline RoundKeys loadRoundKeys(const quint8 *bytes, int rounds)
+{
+    RoundKeys keys;
+    for (int i = 0; i <= rounds; ++i) {
+        keys.k[i] = vld1q_u8(bytes + i * 16);
+    }
+    return keys;
+}
+
+// vaeseq_u8 = AddRoundKey + SubBytes + ShiftRows，vaesmcq_u8 = MixColumns
+inline uint8x16_t encryptOne(uint8x16_t b, const RoundKeys &keys, int rounds)
+{
+    for (int r = 0; r < rounds - 1; ++r) {
+        b = vaesmcq_u8(vaeseq_u8(b, keys.k[r]));
+    }
+    b = vaeseq_u8(b, keys.k[rounds - 1]);
+    return veorq_u8(b, keys.k[rounds]);
+}
+
+// vaesdq_u8 = AddRoundKey + InvSubBytes + InvShiftRows，配合等价逆密码轮密钥
+inline uint8x16_t decryptOne(uint8x16_t b, const RoundKeys &keys, int rounds)
+{
+    for (int r = 0; r < rounds - 1; ++r) {
+        b = vaesimcq_u8(vaesdq_u8(b, keys.k[r]));
+    }
+    b = vaesdq_u8(b, keys.k[rounds - 1]);
+    return veorq_u8(b, keys.k[rounds]);
+}
+
+}
+
+namespace AESBackendHw {
+
+void encryptArmCe(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+{
+    const int rounds = schedule.rounds;
+    const RoundKeys keys = loadRoundKeys(schedule.encRoundKeys, rounds);
+
+    for (; blocks >= kParallelBlocks; blocks -= kParallelBlocks, in += 64, out += 64) {
+        uint8x16_t b0 = vld1q_u8(in);
+        uint8x16_t b1 = vld1q_u8(in + 16);
+        uint8x16_t b2 = vld1q_u8(in + 32);
+        uint8x16_t b3 = vld1q_u8(in + 48);
+        for (int r = 0; r < rounds - 1; ++r) {
+            b0 = vaesmcq_u8(vaeseq_u8(b0, keys.k[r]));
+            b1 = vaesmcq_u8(vaeseq_u8(b1, keys.k[r]));
+            b2 = vaesmcq_u8(vaeseq_u8(b2, keys.k[r]));
+            b3 = vaesmcq_u8(vaeseq_u8(b3, keys.k[r]));
+        }
+        vst1q_u8(out, veorq_u8(vaeseq_u8(b0, keys.k[rounds - 1]), keys.k[rounds]));
+        vst1q_u8(out + 16, veorq_u8(vaeseq_u8(b1, keys.k[rounds - 1]), keys.k[rounds]));
+        vst1q_u8(out + 32, veorq_u8(vaeseq_u8(b2, keys.k[rounds - 1]), keys.k[rounds]));
+        vst1q_u8(out + 48, veorq_u8(vaeseq_u8(b3, keys.k[rounds - 1]), keys.k[rounds]));
+    }
+
+    for (; blocks > 0; --blocks, in += 16, out += 16) {
+        vst1q_u8(out, encryptOne(vld1q_u8(in), keys, rounds));
+    }
+}
+
+void decryptArmCe(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+{
+    const int rounds = schedule.rounds;
+    const RoundKeys keys = loadRoundKeys(schedule.decRoundKeys, rounds);
+
+    for (; blocks >= kParallelBlocks; blocks -= kParallelBlocks, in += 64, out += 64) {
+        uint8x16_t b0 = vld1q_u8(in);
+        uint8x16_t b1 = vld1q_u8(in + 16);
+        uint8x16_t b2 = vld1q_u8(in + 32);
+        uint8x16_t b3 = vld1q_u8(in + 48);
+        for (int r = 0; r < rounds - 1; ++r) {
+            b0 = vaesimcq_u8(vaesdq_u8(b0, keys.k[r]));
+            b1 = vaesimcq_u8(vaesdq_u8(b1, keys.k[r]));
+            b2 = vaesimcq_u8(vaesdq_u8(b2, keys.k[r]));
+            b3 = vaesimcq_u8(vaesdq_u8(b3, keys.k[r]));
+        }
+        vst1q_u8(out, veorq_u8(vaesdq_u8(b0, keys.k[rounds - 1]), keys.k[rounds]));
+        vst1q_u8(out + 16, veorq_u8(vaesdq_u8(b1, keys.k[rounds - 1]), keys.k[rounds]));
+        vst1q_u8(out + 32, veorq_u8(vaesdq_u8(b2, keys.k[rounds - 1]), keys.k[rounds]));
+        vst1q_u8(out + 48, veorq_u8(vaesdq_u8(b3, keys.k[rounds - 1]), keys.k[rounds]));
+    }
+
+    for (; blocks > 0; --blocks, in += 16, out += 16) {
+        vst1q_u8(out, decryptOne(vld1q_u8(in), keys, rounds));
+    }
+}
+
+}
+
+#endif
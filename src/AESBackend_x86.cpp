@@ -0,0 +1,107 @@
+#include "AESBackend.h"
+
+// AES-NI 实现。GCC/Clang 下本文件以 -maes -msse4.1 单独编译，
+// 只有 CpuFeatures 检测到 AES-NI 时才会被调用。
+#if defined(Q_PROCESSOR_X86)
+
+#include <wmmintrin.h>
+#include <smmintrin.h>
+
+namespace {
+
+// 一次处理 4 个分组，隐藏 aesenc/aesdec 的指令延迟
+constexpr size_t kParallelBlocks = 4;
+
+struct RoundKeys {
+    __m128i k[15];
+};
+
+inline RoundKeys loadRoundKeys(const quint8 *bytes, int rounds)
+{
+    RoundKeys keys;
+    for (int i = 0; i <= rounds; ++i) {
+        keys.k[i] = _mm_load_si128(reinterpret_cast<const __m128i *>(bytes + i * 16));
+    }
+    return keys;
+}
+
+inline __m128i load(const quint8 *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+inline void store(quint8 *p, __m128i v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+
+}
+
+namespace AESBackendHw {
+
+void encryptAesNi(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+{
+    const int rounds = schedule.rounds;
+    const RoundKeys keys = loadRoundKeys(schedule.encRoundKeys, rounds);
+
+    for (; blocks >= kParallelBlocks; blocks -= kParallelBlocks, in += 64, out += 64) {
+        __m128i b0 = _mm_xor_si128(load(in), keys.k[0]);
+        __m128i b1 = _mm_xor_si128(load(in + 16), keys.k[0]);
+        __m128i b2 = _mm_xor_si128(load(in + 32), keys.k[0]);
+        __m128i b3 = _mm_xor_si128(load(in + 48), keys.k[0]);
+        for (int r = 1; r < rounds; ++r) {
+            b0 = _mm_aesenc_si128(b0, keys.k[r]);
+            b1 = _mm_aesenc_si128(b1, keys.k[r]);
+            b2 = _mm_aesenc_si128(b2, keys.k[r]);
+            b3 = _mm_aesenc_si128(b3, keys.k[r]);
+        }
+        store(out, _mm_aesenclast_si128(b0, keys.k[rounds]));
+        store(out + 16, _mm_aesenclast_si128(b1, keys.k[rounds]));
+        store(out + 32, _mm_aesenclast_si128(b2, keys.k[rounds]));
+        store(out + 48, _mm_aesenclast_si128(b3, keys.k[rounds]));
+    }
+
+    for (; blocks > 0; --blocks, in += 16, out += 16) {
+        __m128i b = _mm_xor_si128(load(in), keys.k[0]);
+        for (int r = 1; r < rounds; ++r) {
+            b = _mm_aesenc_si128(b, keys.k[r]);
+        }
+        store(out, _mm_aesenclast_si128(b, keys.k[rounds]));
+    }
+}
+
+void decryptAesNi(const AESBackend::KeySchedule &schedule, const quint8 *in, quint8 *out, size_t blocks)
+{
+    // decRoundKeys 已是等价逆密码轮密钥（中间轮做过 InvMixColumns），可直接用于 aesdec
+    const int rounds = schedule.rounds;
+    const RoundKeys keys = loadRoundKeys(schedule.decRoundKeys, rounds);
+
+    for (; blocks >= kParallelBlocks; blocks -= kParallelBlocks, in += 64, out += 64) {
+        __m128i b0 = _mm_xor_si128(load(in), keys.k[0]);
+        __m128i b1 = _mm_xor_si128(load(in + 16), keys.k[0]);
+        __m128i b2 = _mm_xor_si128(load(in + 32), keys.k[0]);
+        __m128i b3 = _mm_xor_si128(load(in + 48), keys.k[0]);
+        for (int r = 1; r < rounds; ++r) {
+            b0 = _mm_aesdec_si128(b0, keys.k[r]);
+            b1 = _mm_aesdec_si128(b1, keys.k[r]);
+            b2 = _mm_aesdec_si128(b2, keys.k[r]);
+            b3 = _mm_aesdec_si128(b3, keys.k[r]);
+        }
+        store(out, _mm_aesdeclast_si128(b0, keys.k[rounds]));
+        store(out + 16, _mm_aesdeclast_si128(b1, keys.k[rounds]));
+        store(out + 32, _mm_aesdeclast_si128(b2, keys.k[rounds]));
+        store(out + 48, _mm_aesdeclast_si128(b3, keys.k[rounds]));
+    }
+
+    for (; blocks > 0; --blocks, in += 16, out += 16) {
+        __m128i b = _mm_xor_si128(load(in), keys.k[0]);
+        for (int r = 1; r < rounds; ++r) {
+            b = _mm_aesdec_si128(b, keys.k[r]);
+        }
+        store(out, _mm_aesdeclast_si128(b, keys.k[rounds]));
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,26 @@
+#include "AESContext.h"
+
+#include <cstring>
+
+bool AESContext::setKey(const quint8 *key, int keyLength)
+{
+    if (keyLength == m_keyLength && std::memcmp(key, m_key, size_t(keyLength)) == 0) {
+        return true;
+    }
+    if (!AESBackend::expandKey(key, keyLength, &m_schedule)) {
+        return false;
+    }
+    std::memcpy(m_key, key, size_t(keyLength));
+    m_keyLength = keyLength;
+    return true;
+}
+
+void AESContext::encryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const
+{
+    AESBackend::encryptBlocks(m_schedule, in, out, blocks);
+}
+
+void AESContext::decryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const
+{
+    AESBackend::decryptBlocks(m_schedule, in, out, blocks);
+}
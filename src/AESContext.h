@@ -0,0 +1,25 @@
+#ifndef AESCONTEXT_H
+#define AESCONTEXT_H
+
+#include "AESBackend.h"
+#include "BlockCipherContext.h"
+
+// AES 加解密上下文：保存扩展后的轮密钥，密钥不变时重复调用 setKey 不会再次扩展。
+// 可以按值复制，供后台任务持有独立的一份。
+class AESContext : public BlockCipherContext
+{
+public:
+    // keyLength 为 16 / 24 / 32 字节，其他长度返回 false
+    bool setKey(const quint8 *key, int keyLength);
+    bool hasKey() const { return m_keyLength != 0; }
+
+    void encryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const override;
+    void decryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const override;
+
+private:
+    AESBackend::KeySchedule m_schedule;
+    quint8 m_key[32] = {};
+    int m_keyLength = 0;
+};
+
+#endif // AESCONTEXT_H
@@ -1,59 +1,29 @@
 #include "AESCrypto.h"
+#include "GcmMode.h"
 #include <QRandomGenerator>
 
-// AES S盒
-const quint8 AESCrypto::SBOX[256] = {
-    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
-    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
-    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
-    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
-    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
-    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
-    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
-    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
-    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
-    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
-    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
-};
-
-// AES 逆S盒
-const quint8 AESCrypto::INV_SBOX[256] = {
-    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
-    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
-    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
-    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
-    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
-    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
-    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
-    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
-    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
-    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
-    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
-    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
-    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
-    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
-    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
-    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
-};
-
-// AES Rcon
-const quint8 AESCrypto::RCON[11] = {
-    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
-};
+#include <memory>
 
 AESCrypto::AESCrypto(QObject *parent)
     : QObject(parent)
     , m_keySize("128")
     , m_mode("ECB")
     , m_uppercase(false)
-    , m_nr(10)
-    , m_nk(4)
+    , m_fileWatcher(new QFutureWatcher<FileCipher::Result>(this))
+    , m_fileProgress(0.0)
 {
+    connect(m_fileWatcher, &QFutureWatcher<FileCipher::Result>::progressValueChanged, this, [this](int value) {
+        m_fileProgress = double(value) / FileCipher::kProgressRange;
+        emit fileProgressChanged();
+    });
+    connect(m_fileWatcher, &QFutureWatcher<FileCipher::Result>::finished, this, &AESCrypto::onFileFinished);
+}
+
+AESCrypto::~AESCrypto()
+{
+    // 窗口关闭时停止后台任务，未完成的输出文件会被丢弃
+    m_fileWatcher->cancel();
+    m_fileWatcher->waitForFinished();
 }
 
 QString AESCrypto::inputText() const { return m_inputText; }
@@ -86,10 +56,6 @@ QString AESCrypto::keySize() const { return m_keySize; }
 void AESCrypto::setKeySize(const QString &size) {
     if (m_keySize != size) {
         m_keySize = size;
-        // 更新轮数和密钥字数
-        if (size == "128") { m_nr = 10; m_nk = 4; }
-        else if (size == "192") { m_nr = 12; m_nk = 6; }
-        else if (size == "256") { m_nr = 14; m_nk = 8; }
         emit keySizeChanged();
     }
 }
@@ -102,6 +68,8 @@ void AESCrypto::setMode(const QString &mode) {
     }
 }
 
+QString AESCrypto::backendName() const { return QString::fromLatin1(AESBackend::active().name); }
+
 bool AESCrypto::uppercase() const { return m_uppercase; }
 void AESCrypto::setUppercase(bool upper) {
     if (m_uppercase != upper) {
@@ -110,16 +78,36 @@ void AESCrypto::setUppercase(bool upper) {
     }
 }
 
+QString AESCrypto::aad() const { return m_aad; }
+void AESCrypto::setAad(const QString &aad) {
+    if (m_aad != aad) {
+        m_aad = aad;
+        emit aadChanged();
+    }
+}
+
+QString AESCrypto::tag() const { return m_tag; }
+void AESCrypto::setTag(const QString &tag) {
+    if (m_tag != tag) {
+        m_tag = tag;
+        emit tagChanged();
+    }
+}
+
 void AESCrypto::clear()
 {
     m_inputText.clear();
     m_key.clear();
     m_iv.clear();
     m_result.clear();
+    m_aad.clear();
+    m_tag.clear();
     emit inputTextChanged();
     emit keyChanged();
     emit ivChanged();
     emit resultChanged();
+    emit aadChanged();
+    emit tagChanged();
 }
 
 QString AESCrypto::generateKey()
@@ -137,8 +125,10 @@ QString AESCrypto::generateKey()
 
 QString AESCrypto::generateIV()
 {
+    // GCM 推荐 12 字节 IV，可直接作为计数器前缀
+    const int ivLen = m_mode == "GCM" ? 12 : 16;
     QByteArray iv;
-    for (int i = 0; i < 16; ++i) {
+    for (int i = 0; i < ivLen; ++i) {
         iv.append(static_cast<char>(QRandomGenerator::global()->bounded(256)));
     }
     return iv.toHex();
@@ -146,381 +136,249 @@ QString AESCrypto::generateIV()
 
 // ==================== AES 核心实现 ====================
 
-quint8 AESCrypto::xtime(quint8 x)
-{
-    return ((x << 1) ^ (((x >> 7) & 1) * 0x1b));
-}
-
-quint8 AESCrypto::multiply(quint8 x, quint8 y)
-{
-    return (((y & 1) * x) ^
-            ((y >> 1 & 1) * xtime(x)) ^
-            ((y >> 2 & 1) * xtime(xtime(x))) ^
-            ((y >> 3 & 1) * xtime(xtime(xtime(x)))) ^
-            ((y >> 4 & 1) * xtime(xtime(xtime(xtime(x))))));
-}
+namespace {
 
-void AESCrypto::subBytes(quint8 *state)
+quint8 *bytes(QByteArray &data)
 {
-    for (int i = 0; i < 16; ++i) {
-        state[i] = SBOX[state[i]];
-    }
+    return reinterpret_cast<quint8 *>(data.data());
 }
 
-void AESCrypto::invSubBytes(quint8 *state)
+const quint8 *bytes(const QByteArray &data)
 {
-    for (int i = 0; i < 16; ++i) {
-        state[i] = INV_SBOX[state[i]];
-    }
+    return reinterpret_cast<const quint8 *>(data.constData());
 }
 
-void AESCrypto::shiftRows(quint8 *state)
-{
-    quint8 temp;
-
-    // Row 1: shift left by 1
-    temp = state[1];
-    state[1] = state[5];
-    state[5] = state[9];
-    state[9] = state[13];
-    state[13] = temp;
-
-    // Row 2: shift left by 2
-    temp = state[2];
-    state[2] = state[10];
-    state[10] = temp;
-    temp = state[6];
-    state[6] = state[14];
-    state[14] = temp;
-
-    // Row 3: shift left by 3
-    temp = state[15];
-    state[15] = state[11];
-    state[11] = state[7];
-    state[7] = state[3];
-    state[3] = temp;
 }
 
-void AESCrypto::invShiftRows(quint8 *state)
+bool AESCrypto::prepareKey()
 {
-    quint8 temp;
-
-    // Row 1: shift right by 1
-    temp = state[13];
-    state[13] = state[9];
-    state[9] = state[5];
-    state[5] = state[1];
-    state[1] = temp;
-
-    // Row 2: shift right by 2
-    temp = state[2];
-    state[2] = state[10];
-    state[10] = temp;
-    temp = state[6];
-    state[6] = state[14];
-    state[14] = temp;
-
-    // Row 3: shift right by 3
-    temp = state[3];
-    state[3] = state[7];
-    state[7] = state[11];
-    state[11] = state[15];
-    state[15] = temp;
-}
+    const QByteArray keyBytes = QByteArray::fromHex(m_key.toLatin1());
+    int expectedKeyLen = m_keySize == "128" ? 16 : (m_keySize == "192" ? 24 : 32);
 
-void AESCrypto::mixColumns(quint8 *state)
-{
-    quint8 temp[4];
-
-    for (int c = 0; c < 4; ++c) {
-        int col = c * 4;
-        temp[0] = state[col];
-        temp[1] = state[col + 1];
-        temp[2] = state[col + 2];
-        temp[3] = state[col + 3];
-
-        // MixColumns 系数: 2, 3, 1, 1
-        state[col]     = xtime(temp[0]) ^ multiply(temp[1], 0x03) ^ temp[2] ^ temp[3];
-        state[col + 1] = temp[0] ^ xtime(temp[1]) ^ multiply(temp[2], 0x03) ^ temp[3];
-        state[col + 2] = temp[0] ^ temp[1] ^ xtime(temp[2]) ^ multiply(temp[3], 0x03);
-        state[col + 3] = multiply(temp[0], 0x03) ^ temp[1] ^ temp[2] ^ xtime(temp[3]);
+    if (keyBytes.size() != expectedKeyLen) {
+        emit errorOccurred(tr("密钥长度必须为%1字节（%2个十六进制字符）").arg(expectedKeyLen).arg(expectedKeyLen * 2));
+        return false;
     }
+    // 密钥未变时沿用已扩展的轮密钥
+    m_context.setKey(bytes(keyBytes), keyBytes.size());
+    return true;
 }
 
-void AESCrypto::invMixColumns(quint8 *state)
+bool AESCrypto::parseIv(QByteArray *ivBytes)
 {
-    quint8 temp[4];
-
-    for (int c = 0; c < 4; ++c) {
-        int col = c * 4;
-        temp[0] = state[col];
-        temp[1] = state[col + 1];
-        temp[2] = state[col + 2];
-        temp[3] = state[col + 3];
-
-        state[col]     = multiply(temp[0], 0x0e) ^ multiply(temp[1], 0x0b) ^ multiply(temp[2], 0x0d) ^ multiply(temp[3], 0x09);
-        state[col + 1] = multiply(temp[0], 0x09) ^ multiply(temp[1], 0x0e) ^ multiply(temp[2], 0x0b) ^ multiply(temp[3], 0x0d);
-        state[col + 2] = multiply(temp[0], 0x0d) ^ multiply(temp[1], 0x09) ^ multiply(temp[2], 0x0e) ^ multiply(temp[3], 0x0b);
-        state[col + 3] = multiply(temp[0], 0x0b) ^ multiply(temp[1], 0x0d) ^ multiply(temp[2], 0x09) ^ multiply(temp[3], 0x0e);
+    if (m_mode == "GCM") {
+        *ivBytes = QByteArray::fromHex(m_iv.toLatin1());
+        if (ivBytes->isEmpty()) {
+            emit errorOccurred(tr("GCM模式需要IV（推荐12字节，24个十六进制字符）"));
+            return false;
+        }
+    } else if (m_mode == "CBC" || m_mode == "CTR") {
+        *ivBytes = QByteArray::fromHex(m_iv.toLatin1());
+        if (ivBytes->size() != 16) {
+            emit errorOccurred(tr("IV长度必须为16字节（32个十六进制字符）"));
+            return false;
+        }
     }
+    return true;
 }
 
-void AESCrypto::addRoundKey(quint8 *state, const quint8 *roundKey)
+void AESCrypto::encrypt()
 {
-    for (int i = 0; i < 16; ++i) {
-        state[i] ^= roundKey[i];
+    if (m_inputText.isEmpty()) {
+        emit errorOccurred(tr("请输入要加密的内容"));
+        return;
     }
-}
-
-void AESCrypto::keyExpansion(const QByteArray &key)
-{
-    int i, j;
-    quint8 temp[4];
-    int keyBytes = m_nk * 4;
 
-    // 复制原始密钥
-    for (i = 0; i < keyBytes; ++i) {
-        m_roundKeys[i] = static_cast<quint8>(key[i]);
+    if (!prepareKey()) {
+        return;
     }
 
-    // 扩展密钥
-    for (i = m_nk; i < 4 * (m_nr + 1); ++i) {
-        for (j = 0; j < 4; ++j) {
-            temp[j] = m_roundKeys[(i - 1) * 4 + j];
-        }
-
-        if (i % m_nk == 0) {
-            // RotWord
-            quint8 k = temp[0];
-            temp[0] = temp[1];
-            temp[1] = temp[2];
-            temp[2] = temp[3];
-            temp[3] = k;
-
-            // SubWord
-            for (j = 0; j < 4; ++j) {
-                temp[j] = SBOX[temp[j]];
-            }
-
-            // XOR with Rcon
-            temp[0] ^= RCON[i / m_nk];
-        } else if (m_nk > 6 && i % m_nk == 4) {
-            // SubWord for AES-256
-            for (j = 0; j < 4; ++j) {
-                temp[j] = SBOX[temp[j]];
-            }
-        }
-
-        for (j = 0; j < 4; ++j) {
-            m_roundKeys[i * 4 + j] = m_roundKeys[(i - m_nk) * 4 + j] ^ temp[j];
-        }
+    QByteArray ivBytes;
+    if (!parseIv(&ivBytes)) {
+        return;
     }
-}
 
-void AESCrypto::encryptBlock(quint8 *block)
-{
-    addRoundKey(block, m_roundKeys);
+    // 在同一个缓冲区内原地加密，ECB / CBC 先预留填充的空间
+    QByteArray data = m_inputText.toUtf8();
+    const qsizetype length = data.size();
 
-    for (int round = 1; round < m_nr; ++round) {
-        subBytes(block);
-        shiftRows(block);
-        mixColumns(block);
-        addRoundKey(block, m_roundKeys + round * 16);
+    if (m_mode == "CBC") {
+        data.resize(BlockCipherContext::paddedLength(length));
+        m_context.encryptCBC(bytes(ivBytes), bytes(data), length, bytes(data));
+    } else if (m_mode == "CTR") {
+        m_context.cryptCTR(bytes(ivBytes), bytes(data), length, bytes(data));
+    } else if (m_mode == "GCM") {
+        const QByteArray aadBytes = QByteArray::fromHex(m_aad.toLatin1());
+        QByteArray tagBytes(GcmMode::kTagLength, Qt::Uninitialized);
+        m_context.encryptGCM(bytes(ivBytes), ivBytes.size(), bytes(aadBytes), aadBytes.size(),
+                             bytes(data), length, bytes(data), bytes(tagBytes));
+        m_tag = m_uppercase ? QString(tagBytes.toHex()).toUpper() : QString(tagBytes.toHex());
+        emit tagChanged();
+    } else {
+        data.resize(BlockCipherContext::paddedLength(length));
+        m_context.encryptECB(bytes(data), length, bytes(data));
     }
 
-    subBytes(block);
-    shiftRows(block);
-    addRoundKey(block, m_roundKeys + m_nr * 16);
+    m_result = data.toHex();
+    if (m_uppercase) {
+        m_result = m_result.toUpper();
+    }
+    emit resultChanged();
 }
 
-void AESCrypto::decryptBlock(quint8 *block)
+void AESCrypto::decrypt()
 {
-    addRoundKey(block, m_roundKeys + m_nr * 16);
-
-    for (int round = m_nr - 1; round > 0; --round) {
-        invShiftRows(block);
-        invSubBytes(block);
-        addRoundKey(block, m_roundKeys + round * 16);
-        invMixColumns(block);
+    if (m_inputText.isEmpty()) {
+        emit errorOccurred(tr("请输入要解密的内容"));
+        return;
     }
 
-    invShiftRows(block);
-    invSubBytes(block);
-    addRoundKey(block, m_roundKeys);
-}
-
-QByteArray AESCrypto::pkcs7Pad(const QByteArray &data, int blockSize)
-{
-    int padLen = blockSize - (data.size() % blockSize);
-    QByteArray padded = data;
-    for (int i = 0; i < padLen; ++i) {
-        padded.append(static_cast<char>(padLen));
+    if (!prepareKey()) {
+        return;
     }
-    return padded;
-}
 
-QByteArray AESCrypto::pkcs7Unpad(const QByteArray &data)
-{
-    if (data.isEmpty()) return data;
-    int padLen = static_cast<quint8>(data.at(data.size() - 1));
-    if (padLen > 16 || padLen > data.size()) return data;
-    return data.left(data.size() - padLen);
-}
+    QByteArray data = QByteArray::fromHex(m_inputText.toLatin1());
+    // CTR / GCM 不填充，密文长度与明文相同
+    if (m_mode != "CTR" && m_mode != "GCM" && data.size() % 16 != 0) {
+        emit errorOccurred(tr("密文长度必须是32的倍数（16字节块）"));
+        return;
+    }
 
-QByteArray AESCrypto::encryptECB(const QByteArray &plaintext, const QByteArray &key)
-{
-    keyExpansion(key);
+    QByteArray ivBytes;
+    if (!parseIv(&ivBytes)) {
+        return;
+    }
 
-    QByteArray padded = pkcs7Pad(plaintext, 16);
-    QByteArray result;
+    // CBC 解密要读取前一密文块，写到单独的缓冲区；其余模式原地解密
+    qsizetype length = data.size();
 
-    for (int i = 0; i < padded.size(); i += 16) {
-        quint8 block[16];
-        for (int j = 0; j < 16; ++j) {
-            block[j] = static_cast<quint8>(padded[i + j]);
+    if (m_mode == "CBC") {
+        QByteArray plain(data.size(), Qt::Uninitialized);
+        length = m_context.decryptCBC(bytes(ivBytes), bytes(data), data.size(), bytes(plain));
+        data.swap(plain);
+    } else if (m_mode == "CTR") {
+        m_context.cryptCTR(bytes(ivBytes), bytes(data), length, bytes(data));
+    } else if (m_mode == "GCM") {
+        const QByteArray tagBytes = QByteArray::fromHex(m_tag.toLatin1());
+        if (tagBytes.size() < GcmMode::kMinTagLength || tagBytes.size() > GcmMode::kTagLength) {
+            emit errorOccurred(tr("认证标签长度必须为12~16字节（24~32个十六进制字符）"));
+            return;
+        }
+        const QByteArray aadBytes = QByteArray::fromHex(m_aad.toLatin1());
+        if (!m_context.decryptGCM(bytes(ivBytes), ivBytes.size(), bytes(aadBytes), aadBytes.size(),
+                                  bytes(data), length, bytes(tagBytes), tagBytes.size(), bytes(data))) {
+            emit errorOccurred(tr("认证失败：标签不匹配，密文、附加数据或密钥有误"));
+            return;
         }
-        encryptBlock(block);
-        result.append(reinterpret_cast<const char*>(block), 16);
+    } else {
+        length = m_context.decryptECB(bytes(data), length, bytes(data));
     }
 
-    return result;
+    if (length < 0) {
+        emit errorOccurred(tr("填充无效：密钥、IV或模式有误"));
+        return;
+    }
+    m_result = QString::fromUtf8(data.constData(), length);
+    emit resultChanged();
 }
 
-QByteArray AESCrypto::decryptECB(const QByteArray &ciphertext, const QByteArray &key)
-{
-    keyExpansion(key);
-
-    QByteArray result;
+// ==================== 文件加解密 ====================
 
-    for (int i = 0; i < ciphertext.size(); i += 16) {
-        quint8 block[16];
-        for (int j = 0; j < 16; ++j) {
-            block[j] = static_cast<quint8>(ciphertext[i + j]);
-        }
-        decryptBlock(block);
-        result.append(reinterpret_cast<const char*>(block), 16);
-    }
+bool AESCrypto::fileRunning() const { return m_fileWatcher->isRunning(); }
+double AESCrypto::fileProgress() const { return m_fileProgress; }
 
-    return pkcs7Unpad(result);
+bool AESCrypto::encryptFile(const QString &inputPath, const QString &outputPath)
+{
+    return startFile(true, inputPath, outputPath);
 }
 
-QByteArray AESCrypto::encryptCBC(const QByteArray &plaintext, const QByteArray &key, const QByteArray &iv)
+bool AESCrypto::decryptFile(const QString &inputPath, const QString &outputPath)
 {
-    keyExpansion(key);
-
-    QByteArray padded = pkcs7Pad(plaintext, 16);
-    QByteArray result;
-    QByteArray prevBlock = iv;
-
-    for (int i = 0; i < padded.size(); i += 16) {
-        quint8 block[16];
-        for (int j = 0; j < 16; ++j) {
-            block[j] = static_cast<quint8>(padded[i + j]) ^ static_cast<quint8>(prevBlock[j]);
-        }
-        encryptBlock(block);
-        result.append(reinterpret_cast<const char*>(block), 16);
-        prevBlock = result.right(16);
-    }
-
-    return result;
+    return startFile(false, inputPath, outputPath);
 }
 
-QByteArray AESCrypto::decryptCBC(const QByteArray &ciphertext, const QByteArray &key, const QByteArray &iv)
+void AESCrypto::cancelFile()
 {
-    keyExpansion(key);
-
-    QByteArray result;
-    QByteArray prevBlock = iv;
-
-    for (int i = 0; i < ciphertext.size(); i += 16) {
-        quint8 block[16];
-        QByteArray currentBlock = ciphertext.mid(i, 16);
-
-        for (int j = 0; j < 16; ++j) {
-            block[j] = static_cast<quint8>(currentBlock[j]);
-        }
-        decryptBlock(block);
-
-        for (int j = 0; j < 16; ++j) {
-            block[j] ^= static_cast<quint8>(prevBlock[j]);
-        }
-
-        result.append(reinterpret_cast<const char*>(block), 16);
-        prevBlock = currentBlock;
-    }
-
-    return pkcs7Unpad(result);
+    m_fileWatcher->cancel();
 }
 
-void AESCrypto::encrypt()
+bool AESCrypto::startFile(bool encrypt, const QString &inputPath, const QString &outputPath)
 {
-    if (m_inputText.isEmpty()) {
-        emit errorOccurred(tr("请输入要加密的内容"));
-        return;
+    if (fileRunning()) {
+        emit errorOccurred(tr("文件正在处理中，请稍候"));
+        return false;
     }
-
-    QByteArray keyBytes = QByteArray::fromHex(m_key.toLatin1());
-    int expectedKeyLen = m_keySize == "128" ? 16 : (m_keySize == "192" ? 24 : 32);
-
-    if (keyBytes.size() != expectedKeyLen) {
-        emit errorOccurred(tr("密钥长度必须为%1字节（%2个十六进制字符）").arg(expectedKeyLen).arg(expectedKeyLen * 2));
-        return;
+    if (inputPath.isEmpty() || outputPath.isEmpty()) {
+        emit errorOccurred(tr("请选择输入文件和输出文件"));
+        return false;
     }
 
-    QByteArray result;
+    QByteArray ivBytes;
+    if (!prepareKey() || !parseIv(&ivBytes)) {
+        return false;
+    }
 
+    FileCipher::Options options;
+    options.encrypt = encrypt;
+    options.iv = ivBytes;
     if (m_mode == "CBC") {
-        QByteArray ivBytes = QByteArray::fromHex(m_iv.toLatin1());
-        if (ivBytes.size() != 16) {
-            emit errorOccurred(tr("IV长度必须为16字节（32个十六进制字符）"));
-            return;
+        options.mode = FileCipher::Mode::CBC;
+    } else if (m_mode == "CTR") {
+        options.mode = FileCipher::Mode::CTR;
+    } else if (m_mode == "GCM") {
+        options.mode = FileCipher::Mode::GCM;
+        options.aad = QByteArray::fromHex(m_aad.toLatin1());
+        if (!encrypt) {
+            options.tag = QByteArray::fromHex(m_tag.toLatin1());
+            if (options.tag.size() < GcmMode::kMinTagLength || options.tag.size() > GcmMode::kTagLength) {
+                emit errorOccurred(tr("认证标签长度必须为12~16字节（24~32个十六进制字符）"));
+                return false;
+            }
         }
-        result = encryptCBC(m_inputText.toUtf8(), keyBytes, ivBytes);
     } else {
-        result = encryptECB(m_inputText.toUtf8(), keyBytes);
+        options.mode = FileCipher::Mode::ECB;
     }
 
-    m_result = result.toHex();
-    if (m_uppercase) {
-        m_result = m_result.toUpper();
-    }
-    emit resultChanged();
+    // 工作线程持有上下文的一份副本，界面上修改密钥不影响正在进行的任务
+    auto context = std::make_shared<AESContext>(m_context);
+    options.encryptBlocks = [context](const quint8 *in, quint8 *out, size_t blocks) {
+        context->encryptBlocks(in, out, blocks);
+    };
+    options.decryptBlocks = [context](const quint8 *in, quint8 *out, size_t blocks) {
+        context->decryptBlocks(in, out, blocks);
+    };
+    options.inputPath = FileCipher::localPath(inputPath);
+    options.outputPath = FileCipher::localPath(outputPath);
+
+    m_fileProgress = 0.0;
+    emit fileProgressChanged();
+    m_fileWatcher->setFuture(FileCipher::start(options));
+    emit fileRunningChanged();
+    return true;
 }
 
-void AESCrypto::decrypt()
+void AESCrypto::onFileFinished()
 {
-    if (m_inputText.isEmpty()) {
-        emit errorOccurred(tr("请输入要解密的内容"));
-        return;
+    // 取消后不会产生结果
+    FileCipher::Result result;
+    result.canceled = true;
+    if (!m_fileWatcher->isCanceled() && m_fileWatcher->future().resultCount() > 0) {
+        result = m_fileWatcher->result();
     }
 
-    QByteArray keyBytes = QByteArray::fromHex(m_key.toLatin1());
-    int expectedKeyLen = m_keySize == "128" ? 16 : (m_keySize == "192" ? 24 : 32);
-
-    if (keyBytes.size() != expectedKeyLen) {
-        emit errorOccurred(tr("密钥长度必须为%1字节（%2个十六进制字符）").arg(expectedKeyLen).arg(expectedKeyLen * 2));
-        return;
-    }
-
-    QByteArray cipherBytes = QByteArray::fromHex(m_inputText.toLatin1());
-    if (cipherBytes.size() % 16 != 0) {
-        emit errorOccurred(tr("密文长度必须是32的倍数（16字节块）"));
-        return;
-    }
-
-    QByteArray result;
-
-    if (m_mode == "CBC") {
-        QByteArray ivBytes = QByteArray::fromHex(m_iv.toLatin1());
-        if (ivBytes.size() != 16) {
-            emit errorOccurred(tr("IV长度必须为16字节（32个十六进制字符）"));
-            return;
+    if (result.success) {
+        if (!result.tag.isEmpty()) {
+            m_tag = m_uppercase ? QString(result.tag.toHex()).toUpper() : QString(result.tag.toHex());
+            emit tagChanged();
         }
-        result = decryptCBC(cipherBytes, keyBytes, ivBytes);
+        m_fileProgress = 1.0;
+        emit fileProgressChanged();
+        emit fileFinished(true, tr("处理完成，已写入 %1 字节").arg(result.bytesWritten));
+    } else if (result.canceled) {
+        emit fileFinished(false, tr("已取消"));
     } else {
-        result = decryptECB(cipherBytes, keyBytes);
+        emit errorOccurred(result.errorMessage);
+        emit fileFinished(false, result.errorMessage);
     }
-
-    m_result = QString::fromUtf8(result);
-    emit resultChanged();
+    emit fileRunningChanged();
 }
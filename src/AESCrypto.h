@@ -4,6 +4,10 @@
 #include <QObject>
 #include <QString>
 #include <QByteArray>
+#include <QFutureWatcher>
+
+#include "AESContext.h"
+#include "FileCipher.h"
 
 class AESCrypto : public QObject
 {
@@ -15,9 +19,15 @@ class AESCrypto : public QObject
     Q_PROPERTY(QString keySize READ keySize WRITE setKeySize NOTIFY keySizeChanged)
     Q_PROPERTY(QString mode READ mode WRITE setMode NOTIFY modeChanged)
     Q_PROPERTY(bool uppercase READ uppercase WRITE setUppercase NOTIFY uppercaseChanged)
+    Q_PROPERTY(QString aad READ aad WRITE setAad NOTIFY aadChanged)
+    Q_PROPERTY(QString tag READ tag WRITE setTag NOTIFY tagChanged)
+    Q_PROPERTY(QString backendName READ backendName CONSTANT)
+    Q_PROPERTY(bool fileRunning READ fileRunning NOTIFY fileRunningChanged)
+    Q_PROPERTY(double fileProgress READ fileProgress NOTIFY fileProgressChanged)
 
 public:
     explicit AESCrypto(QObject *parent = nullptr);
+    ~AESCrypto();
 
     QString inputText() const;
     void setInputText(const QString &text);
@@ -39,10 +49,30 @@ public:
     bool uppercase() const;
     void setUppercase(bool upper);
 
+    // GCM 模式的附加认证数据与认证标签，均为十六进制；加密时输出标签，解密时校验标签
+    QString aad() const;
+    void setAad(const QString &aad);
+
+    QString tag() const;
+    void setTag(const QString &tag);
+
+    // 当前使用的分组运算实现："AES-NI" / "ARMv8-CE" / "T-table"
+    QString backendName() const;
+
     // AES 加解密
     Q_INVOKABLE void encrypt();
     Q_INVOKABLE void decrypt();
 
+    // 文件加解密：使用当前的密钥、模式、IV（及 GCM 的附加数据/标签），在后台线程分块处理，
+    // 完成后发出 fileFinished；GCM 加密得到的标签写入 tag
+    Q_INVOKABLE bool encryptFile(const QString &inputPath, const QString &outputPath);
+    Q_INVOKABLE bool decryptFile(const QString &inputPath, const QString &outputPath);
+    Q_INVOKABLE void cancelFile();
+
+    bool fileRunning() const;
+    // 0.0 ~ 1.0
+    double fileProgress() const;
+
     // 生成随机密钥
     Q_INVOKABLE QString generateKey();
     Q_INVOKABLE QString generateIV();
@@ -58,55 +88,36 @@ signals:
     void keySizeChanged();
     void modeChanged();
     void uppercaseChanged();
+    void aadChanged();
+    void tagChanged();
     void errorOccurred(const QString &error);
+    void fileRunningChanged();
+    void fileProgressChanged();
+    void fileFinished(bool success, const QString &message);
 
 private:
-    // AES 核心函数
-    void keyExpansion(const QByteArray &key);
-    void encryptBlock(quint8 *block);
-    void decryptBlock(quint8 *block);
-
-    // AES 变换
-    void subBytes(quint8 *state);
-    void invSubBytes(quint8 *state);
-    void shiftRows(quint8 *state);
-    void invShiftRows(quint8 *state);
-    void mixColumns(quint8 *state);
-    void invMixColumns(quint8 *state);
-    void addRoundKey(quint8 *state, const quint8 *roundKey);
-
-    quint8 xtime(quint8 x);
-    quint8 multiply(quint8 x, quint8 y);
-
-    // PKCS7 填充
-    QByteArray pkcs7Pad(const QByteArray &data, int blockSize);
-    QByteArray pkcs7Unpad(const QByteArray &data);
-
-    // ECB 模式
-    QByteArray encryptECB(const QByteArray &plaintext, const QByteArray &key);
-    QByteArray decryptECB(const QByteArray &ciphertext, const QByteArray &key);
-
-    // CBC 模式
-    QByteArray encryptCBC(const QByteArray &plaintext, const QByteArray &key, const QByteArray &iv);
-    QByteArray decryptCBC(const QByteArray &ciphertext, const QByteArray &key, const QByteArray &iv);
+    // 校验密钥并交给上下文扩展，以及解析当前模式所需的 IV，失败时发出 errorOccurred
+    bool prepareKey();
+    bool parseIv(QByteArray *ivBytes);
+
+    bool startFile(bool encrypt, const QString &inputPath, const QString &outputPath);
+    void onFileFinished();
 
     QString m_inputText;
     QString m_key;
     QString m_iv;
     QString m_result;
     QString m_keySize;  // "128", "192", "256"
-    QString m_mode;     // "ECB", "CBC"
+    QString m_mode;     // "ECB", "CBC", "CTR", "GCM"
     bool m_uppercase;
+    QString m_aad;
+    QString m_tag;
 
-    // AES 轮密钥 (字节形式，最多 14 轮 + 1，每轮 16 字节)
-    quint8 m_roundKeys[240];
-    int m_nr;                 // 轮数
-    int m_nk;                 // 密钥字数
+    // 分组运算由 AESBackend 按 CPU 特性选择实现
+    AESContext m_context;
 
-    // AES S盒和逆S盒
-    static const quint8 SBOX[256];
-    static const quint8 INV_SBOX[256];
-    static const quint8 RCON[11];
+    QFutureWatcher<FileCipher::Result> *m_fileWatcher;
+    double m_fileProgress;
 };
 
 #endif // AESCRYPTO_H
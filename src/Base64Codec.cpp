@@ -0,0 +1,357 @@
+#include "Base64Codec.h"
+#include "CpuFeatures.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QPromise>
+#include <QSaveFile>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <optional>
+
+namespace {
+
+constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr quint8 kInvalid = 0xff;
+
+struct DecodeTable {
+    quint8 value[256];
+};
+
+constexpr DecodeTable makeDecodeTable()
+{
+    DecodeTable table{};
+    for (int c = 0; c < 256; ++c) {
+        table.value[c] = kInvalid;
+    }
+    for (int i = 0; i < 64; ++i) {
+        table.value[quint8(kAlphabet[i])] = quint8(i);
+    }
+    return table;
+}
+
+constexpr DecodeTable kDecodeTable = makeDecodeTable();
+
+bool isSpace(quint8 c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+// 末尾不足 3 字节的部分，补 '=' 到 4 个字符
+void encodeTail(char *out, const quint8 *in, size_t length)
+{
+    const quint32 value = quint32(in[0]) << 16 | (length > 1 ? quint32(in[1]) << 8 : 0);
+    out[0] = kAlphabet[value >> 18];
+    out[1] = kAlphabet[(value >> 12) & 0x3f];
+    out[2] = length > 1 ? kAlphabet[(value >> 6) & 0x3f] : '=';
+    out[3] = '=';
+}
+
+// 跨块保存不足 4 个字符的剩余部分；整组的字符交给 SIMD 实现，遇到空白、'=' 或非法字符时逐个处理
+class Decoder
+{
+public:
+    explicit Decoder(const Base64Codec::Implementation &implementation)
+        : m_implementation(implementation)
+    {
+    }
+
+    // out 至少要有 length / 4 * 3 + 3 字节；返回写出的字节数，出错返回 -1
+    qsizetype feed(quint8 *out, const char *in, qsizetype length)
+    {
+        qsizetype written = 0;
+        qsizetype i = 0;
+        while (i < length) {
+            if (m_groupLength == 0 && m_padding == 0) {
+                const size_t consumed = m_implementation.decode(out + written, in + i, size_t(length - i) & ~size_t(3));
+                i += qsizetype(consumed);
+                written += qsizetype(consumed / 4 * 3);
+                if (i >= length) {
+                    break;
+                }
+            }
+
+            const quint8 c = quint8(in[i]);
+            const quint8 value = kDecodeTable.value[c];
+            if (value != kInvalid) {
+                if (m_padding > 0) {
+                    return fail(QStringLiteral("偏移 %1 处：填充符 '=' 之后仍有数据").arg(m_position + i));
+                }
+                m_group[m_groupLength++] = char(c);
+                if (m_groupLength == 4) {
+                    Base64CodecHw::decodePortable(out + written, m_group, 4);
+                    written += 3;
+                    m_groupLength = 0;
+                }
+            } else if (c == '=') {
+                if (m_groupLength < 2 || m_groupLength + m_padding >= 4) {
+                    return fail(QStringLiteral("偏移 %1 处：填充符 '=' 的位置不正确").arg(m_position + i));
+                }
+                ++m_padding;
+            } else if (!isSpace(c)) {
+                return fail(QStringLiteral("偏移 %1 处的字符不是Base64字符").arg(m_position + i));
+            }
+            ++i;
+        }
+        m_position += length;
+        return written;
+    }
+
+    // 输入结束时解出剩余的 2~3 个字符；返回写出的字节数，出错返回 -1
+    qsizetype finish(quint8 *out)
+    {
+        if (m_groupLength == 1) {
+            return fail(QStringLiteral("Base64数据长度不正确"));
+        }
+        if (m_groupLength == 0) {
+            return 0;
+        }
+        const quint32 a = kDecodeTable.value[quint8(m_group[0])];
+        const quint32 b = kDecodeTable.value[quint8(m_group[1])];
+        out[0] = quint8(a << 2 | b >> 4);
+        if (m_groupLength == 2) {
+            return 1;
+        }
+        const quint32 c = kDecodeTable.value[quint8(m_group[2])];
+        out[1] = quint8(b << 4 | c >> 2);
+        return 2;
+    }
+
+    QString errorMessage() const
+    {
+        return m_errorMessage;
+    }
+
+private:
+    qsizetype fail(const QString &message)
+    {
+        m_errorMessage = message;
+        return -1;
+    }
+
+    const Base64Codec::Implementation &m_implementation;
+    char m_group[4] = {};
+    int m_groupLength = 0;
+    int m_padding = 0;
+    qint64 m_position = 0;
+    QString m_errorMessage;
+};
+
+// 读满 length 字节，只有到达文件末尾时才会更少
+qint64 readFull(QFile &file, char *buffer, qint64 length)
+{
+    qint64 total = 0;
+    while (total < length) {
+        const qint64 n = file.read(buffer + total, length - total);
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    return total;
+}
+
+}
+
+void Base64CodecHw::encodePortable(char *out, const quint8 *in, size_t length)
+{
+    for (size_t i = 0; i + 3 <= length; i += 3) {
+        const quint32 value = quint32(in[i]) << 16 | quint32(in[i + 1]) << 8 | in[i + 2];
+        out[0] = kAlphabet[value >> 18];
+        out[1] = kAlphabet[(value >> 12) & 0x3f];
+        out[2] = kAlphabet[(value >> 6) & 0x3f];
+        out[3] = kAlphabet[value & 0x3f];
+        out += 4;
+    }
+}
+
+size_t Base64CodecHw::decodePortable(quint8 *out, const char *in, size_t length)
+{
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        const quint32 a = kDecodeTable.value[quint8(in[i])];
+        const quint32 b = kDecodeTable.value[quint8(in[i + 1])];
+        const quint32 c = kDecodeTable.value[quint8(in[i + 2])];
+        const quint32 d = kDecodeTable.value[quint8(in[i + 3])];
+        // 合法字符的值都小于 64，kInvalid 的高两位为 1
+        if (((a | b | c | d) & 0xc0) != 0) {
+            break;
+        }
+        const quint32 value = a << 18 | b << 12 | c << 6 | d;
+        out[0] = quint8(value >> 16);
+        out[1] = quint8(value >> 8);
+        out[2] = quint8(value);
+        out += 3;
+    }
+    return i;
+}
+
+const Base64Codec::Implementation &Base64Codec::portable()
+{
+    static const Implementation impl = {"Scalar", Base64CodecHw::encodePortable, Base64CodecHw::decodePortable};
+    return impl;
+}
+
+QList<const Base64Codec::Implementation *> Base64Codec::available()
+{
+    QList<const Implementation *> result{&portable()};
+#if defined(Q_PROCESSOR_X86)
+    static const Implementation ssse3 = {"SSSE3", Base64CodecHw::encodeSsse3, Base64CodecHw::decodeSsse3};
+    static const Implementation avx2 = {"AVX2", Base64CodecHw::encodeAvx2, Base64CodecHw::decodeAvx2};
+    if (CpuFeatures::hasSsse3()) {
+        result << &ssse3;
+    }
+    if (CpuFeatures::hasAvx2()) {
+        result << &avx2;
+    }
+#endif
+    return result;
+}
+
+const Base64Codec::Implementation &Base64Codec::active()
+{
+    static const Implementation *impl = available().constLast();
+    return *impl;
+}
+
+QByteArray Base64Codec::encode(const QByteArray &data, const Implementation &implementation)
+{
+    const qsizetype full = data.size() / 3 * 3;
+    QByteArray text((data.size() + 2) / 3 * 4, Qt::Uninitialized);
+    const quint8 *in = reinterpret_cast<const quint8 *>(data.constData());
+    implementation.encode(text.data(), in, size_t(full));
+    if (full < data.size()) {
+        encodeTail(text.data() + full / 3 * 4, in + full, size_t(data.size() - full));
+    }
+    return text;
+}
+
+QByteArray Base64Codec::decode(const QByteArray &text, bool *ok, const Implementation &implementation)
+{
+    Decoder decoder(implementation);
+    QByteArray data(text.size() / 4 * 3 + 3, Qt::Uninitialized);
+    quint8 *out = reinterpret_cast<quint8 *>(data.data());
+    const qsizetype written = decoder.feed(out, text.constData(), text.size());
+    const qsizetype tail = written < 0 ? -1 : decoder.finish(out + written);
+    if (ok) {
+        *ok = tail >= 0;
+    }
+    if (tail < 0) {
+        return QByteArray();
+    }
+    data.truncate(written + tail);
+    return data;
+}
+
+Base64Codec::Result Base64Codec::convertFile(const Options &options, const ProgressFunction &progress)
+{
+    Result result;
+    const bool previewOnly = options.outputPath.isEmpty();
+    qsizetype chunkSize = options.encode ? options.chunkSize / 3 * 3 : options.chunkSize;
+    if (chunkSize < 4) {
+        result.errorMessage = QStringLiteral("分块大小过小");
+        return result;
+    }
+    if (previewOnly) {
+        // 只需读到能填满预览的长度；解码时输入可能含空白，不够时会继续读下一块
+        const qsizetype needed = options.encode ? (options.previewLength / 4 + 1) * 3 : (options.previewLength / 3 + 1) * 4;
+        chunkSize = qMin(chunkSize, needed);
+    } else if (QFileInfo(options.inputPath).absoluteFilePath() == QFileInfo(options.outputPath).absoluteFilePath()) {
+        result.errorMessage = QStringLiteral("输出文件不能与输入文件相同");
+        return result;
+    }
+
+    QFile input(options.inputPath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        result.errorMessage = QStringLiteral("无法打开文件: %1").arg(options.inputPath);
+        return result;
+    }
+
+    // 写入临时文件，全部成功后才替换目标文件
+    std::optional<QSaveFile> output;
+    if (!previewOnly) {
+        output.emplace(options.outputPath);
+        if (!output->open(QIODevice::WriteOnly)) {
+            result.errorMessage = QStringLiteral("无法创建文件: %1").arg(options.outputPath);
+            return result;
+        }
+    }
+
+    const Implementation &implementation = active();
+    Decoder decoder(implementation);
+    QByteArray inBuffer(chunkSize, Qt::Uninitialized);
+    QByteArray outBuffer(options.encode ? chunkSize / 3 * 4 + 4 : chunkSize / 4 * 3 + 6, Qt::Uninitialized);
+    char *in = inBuffer.data();
+    char *out = outBuffer.data();
+    const qint64 total = input.size();
+
+    for (;;) {
+        const qint64 n = readFull(input, in, chunkSize);
+        if (n < 0) {
+            result.errorMessage = QStringLiteral("读取文件失败: %1").arg(options.inputPath);
+            return result;
+        }
+        const bool last = input.atEnd();
+
+        qsizetype length = 0;
+        if (options.encode) {
+            const qint64 full = n / 3 * 3;
+            implementation.encode(out, reinterpret_cast<const quint8 *>(in), size_t(full));
+            length = qsizetype(full / 3 * 4);
+            if (full < n) {
+                encodeTail(out + length, reinterpret_cast<const quint8 *>(in) + full, size_t(n - full));
+                length += 4;
+            }
+        } else {
+            quint8 *bytes = reinterpret_cast<quint8 *>(out);
+            length = decoder.feed(bytes, in, qsizetype(n));
+            const qsizetype tail = length < 0 || !last ? 0 : decoder.finish(bytes + length);
+            if (length < 0 || tail < 0) {
+                result.errorMessage = decoder.errorMessage();
+                return result;
+            }
+            length += tail;
+        }
+
+        if (result.preview.size() < options.previewLength) {
+            result.preview.append(out, qMin(length, options.previewLength - result.preview.size()));
+        }
+        if (output && output->write(out, length) != length) {
+            result.errorMessage = QStringLiteral("写入文件失败: %1").arg(options.outputPath);
+            return result;
+        }
+        result.bytesRead += n;
+        result.bytesWritten += length;
+
+        if (progress && !progress(result.bytesRead, total)) {
+            result.canceled = true;
+            return result;
+        }
+        if (last || (previewOnly && result.preview.size() >= options.previewLength)) {
+            result.previewComplete = last && result.bytesWritten <= options.previewLength;
+            break;
+        }
+    }
+
+    if (output && !output->commit()) {
+        result.errorMessage = QStringLiteral("写入文件失败: %1").arg(options.outputPath);
+        return result;
+    }
+
+    result.success = true;
+    return result;
+}
+
+QFuture<Base64Codec::Result> Base64Codec::start(const Options &options)
+{
+    return QtConcurrent::run([options](QPromise<Result> &promise) {
+        promise.setProgressRange(0, kProgressRange);
+        promise.addResult(convertFile(options, [&promise](qint64 processed, qint64 total) {
+            promise.setProgressValue(total > 0 ? int(processed * kProgressRange / total) : kProgressRange);
+            return !promise.isCanceled();
+        }));
+    });
+}
@@ -0,0 +1,93 @@
+#ifndef BASE64CODEC_H
+#define BASE64CODEC_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+#include <cstddef>
+#include <functional>
+
+// Base64（RFC 4648 标准字母表，带 '=' 填充）编解码。
+// 整块数据由运行时按 CPU 选择的 SSSE3 / AVX2 实现处理：编码用 pshufb 重排 3 字节为 4 个 6 位索引，
+// 再用一次 pshufb 查偏移表得到字符；解码用高低半字节两张表同时校验字符与查偏移。
+// 文件到文件的转换按固定大小的块流式进行，内存占用与文件大小无关；解码时忽略空白字符（换行的 MIME / PEM 文本）。
+class Base64Codec
+{
+public:
+    // 编码 length 字节（须为 3 的倍数），写出 length / 3 * 4 个字符
+    using EncodeFunction = void (*)(char *out, const quint8 *in, size_t length);
+    // 解码 length 个字符（须为 4 的倍数），在第一个含字母表以外字符（包括空白与 '='）的 4 字符组之前停下；
+    // 返回已解码的字符数，写出其 3/4 的字节
+    using DecodeFunction = size_t (*)(quint8 *out, const char *in, size_t length);
+
+    struct Implementation {
+        const char *name;
+        EncodeFunction encode;
+        DecodeFunction decode;
+    };
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active();
+    static const Implementation &portable();
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available();
+
+    static QByteArray encode(const QByteArray &data, const Implementation &implementation = active());
+    // 忽略空白字符，允许省略末尾的 '='；出错时返回空数组并把 ok 置为 false
+    static QByteArray decode(const QByteArray &text, bool *ok = nullptr,
+                             const Implementation &implementation = active());
+
+    struct Options {
+        bool encode = true;
+        QString inputPath;
+        // 为空时只转换开头 previewLength 字节的输出用于预览，不写文件
+        QString outputPath;
+        // 结果开头保留的字节数
+        qsizetype previewLength = kDefaultPreviewLength;
+        // 每次读入的字节数，编码时向下取整为 3 的倍数
+        qsizetype chunkSize = kDefaultChunkSize;
+    };
+
+    struct Result {
+        bool success = false;
+        bool canceled = false;
+        QString errorMessage;
+        qint64 bytesRead = 0;
+        qint64 bytesWritten = 0;
+        // 输出的开头部分；previewComplete 为 true 时就是完整的输出
+        QByteArray preview;
+        bool previewComplete = false;
+    };
+
+    // 每处理完一块调用一次；返回 false 表示取消
+    using ProgressFunction = std::function<bool(qint64 processed, qint64 total)>;
+
+    // 失败或取消时不会留下不完整的输出文件
+    static Result convertFile(const Options &options, const ProgressFunction &progress = ProgressFunction());
+
+    // 在全局线程池中运行；进度范围 0~kProgressRange，可通过 QFuture::cancel() 取消
+    static QFuture<Result> start(const Options &options);
+
+    static constexpr qsizetype kDefaultChunkSize = 3 * 1024 * 1024;
+    static constexpr qsizetype kDefaultPreviewLength = 64 * 1024;
+    static constexpr int kProgressRange = 1000;
+};
+
+namespace Base64CodecHw {
+// 逐 3 字节 / 4 字符处理，SIMD 实现用它处理不足一个向量的剩余部分
+void encodePortable(char *out, const quint8 *in, size_t length);
+size_t decodePortable(quint8 *out, const char *in, size_t length);
+
+// SIMD 实现位于 Base64Codec_x86.cpp / Base64Codec_avx2.cpp，这两个文件使用单独的编译选项
+#if defined(Q_PROCESSOR_X86)
+void encodeSsse3(char *out, const quint8 *in, size_t length);
+size_t decodeSsse3(quint8 *out, const char *in, size_t length);
+void encodeAvx2(char *out, const quint8 *in, size_t length);
+size_t decodeAvx2(quint8 *out, const char *in, size_t length);
+#endif
+}
+
+#endif // BASE64CODEC_H
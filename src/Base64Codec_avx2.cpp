@@ -0,0 +1,99 @@
+#include "Base64Codec.h"
+
+// AVX2 实现。GCC/Clang 下本文件以 -mavx2 单独编译，只有 CpuFeatures 检测到 AVX2 时才会被调用。
+// 与 Base64Codec_x86.cpp 的算法相同，两个 128 位通道各处理 12 字节 / 16 个字符。
+#if defined(Q_PROCESSOR_X86)
+
+#include <immintrin.h>
+
+namespace {
+
+inline __m256i encodeIndices(__m256i in)
+{
+    in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                  1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+                                          _mm256_set1_epi32(0x04000040));
+    const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+                                          _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(ac, bd);
+}
+
+inline __m256i encodeCharacters(__m256i indices)
+{
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+    const __m256i shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                           'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(shift, range), indices);
+}
+
+inline bool decodeIndices(__m256i &str)
+{
+    const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+                                           0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2f = _mm256_set1_epi8(0x2f);
+
+    const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask2f);
+    const __m256i loNibbles = _mm256_and_si256(str, mask2f);
+    if (!_mm256_testz_si256(_mm256_shuffle_epi8(lutLo, loNibbles), _mm256_shuffle_epi8(lutHi, hiNibbles))) {
+        return false;
+    }
+    const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(str, mask2f), hiNibbles));
+    str = _mm256_add_epi8(str, roll);
+    return true;
+}
+
+// 两个通道各得到 12 字节，再把它们并到低 24 字节
+inline __m256i decodePack(__m256i indices)
+{
+    const __m256i pairs = _mm256_maddubs_epi16(indices, _mm256_set1_epi32(0x01400140));
+    __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    words = _mm256_shuffle_epi8(words, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    return _mm256_permutevar8x32_epi32(words, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+}
+
+void Base64CodecHw::encodeAvx2(char *out, const quint8 *in, size_t length)
+{
+    size_t i = 0;
+    // 两个通道分别读 in + i 与 in + i + 12 开始的 16 字节，因此至少还剩 28 字节时才走向量路径
+    for (; i + 28 <= length; i += 24) {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12));
+        const __m256i data = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), encodeCharacters(encodeIndices(data)));
+        out += 32;
+    }
+    encodePortable(out, in + i, length - i);
+}
+
+size_t Base64CodecHw::decodeAvx2(quint8 *out, const char *in, size_t length)
+{
+    size_t i = 0;
+    // 每次写 32 字节只有前 24 字节有效，剩余不少于 48 个字符时输出缓冲区才一定放得下
+    for (; i + 48 <= length; i += 32) {
+        __m256i str = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        if (!decodeIndices(str)) {
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), decodePack(str));
+        out += 24;
+    }
+    return i + decodePortable(out, in + i, length - i);
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "Base64Codec.h"
+
+// SSSE3 实现。GCC/Clang 下本文件以 -mssse3 单独编译，只有 CpuFeatures 检测到 SSSE3 时才会被调用。
+// 编码每次 12 字节 -> 16 个字符，解码每次 16 个字符 -> 12 字节，不足一个向量的部分交给逐字节实现。
+#if defined(Q_PROCESSOR_X86)
+
+#include <tmmintrin.h>
+
+namespace {
+
+// 每 3 字节复制成 4 字节 [b1 b0 b2 b1]，再用乘法把 4 个 6 位字段分别移到各字节的低位
+inline __m128i encodeIndices(__m128i in)
+{
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i ac = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const __m128i bd = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(ac, bd);
+}
+
+// 索引 0~63 按所在区间（A-Z、a-z、0-9、'+'、'/'）压缩成 0~13，查表得到要加上的偏移
+inline __m128i encodeCharacters(__m128i indices)
+{
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, range), indices);
+}
+
+// 字符的高低半字节各查一张位掩码表，两者按位与不为 0 的字符不在字母表中
+inline bool decodeIndices(__m128i &str)
+{
+    const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask2f = _mm_set1_epi8(0x2f);
+
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask2f);
+    const __m128i loNibbles = _mm_and_si128(str, mask2f);
+    const __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lutLo, loNibbles), _mm_shuffle_epi8(lutHi, hiNibbles));
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalid, _mm_setzero_si128())) != 0) {
+        return false;
+    }
+    // 高半字节决定偏移，'/' 与 '+' 的高半字节相同，减一后落到单独的表项
+    const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(str, mask2f), hiNibbles));
+    str = _mm_add_epi8(str, roll);
+    return true;
+}
+
+// 每 4 个 6 位索引合并成 3 字节，放在低 12 字节
+inline __m128i decodePack(__m128i indices)
+{
+    const __m128i pairs = _mm_maddubs_epi16(indices, _mm_set1_epi32(0x01400140));
+    const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+}
+
+void Base64CodecHw::encodeSsse3(char *out, const quint8 *in, size_t length)
+{
+    size_t i = 0;
+    // 每次读 16 字节只用前 12 字节，因此至少还剩 16 字节时才走向量路径
+    for (; i + 16 <= length; i += 12) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), encodeCharacters(encodeIndices(data)));
+        out += 16;
+    }
+    encodePortable(out, in + i, length - i);
+}
+
+size_t Base64CodecHw::decodeSsse3(quint8 *out, const char *in, size_t length)
+{
+    size_t i = 0;
+    // 每次写 16 字节只有前 12 字节有效，剩余不少于 24 个字符时输出缓冲区才一定放得下
+    for (; i + 24 <= length; i += 16) {
+        __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        if (!decodeIndices(str)) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), decodePack(str));
+        out += 12;
+    }
+    return i + decodePortable(out, in + i, length - i);
+}
+
+#endif
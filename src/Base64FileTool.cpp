@@ -0,0 +1,212 @@
+#include "Base64FileTool.h"
+
+#include <QFileInfo>
+
+Base64FileTool::Base64FileTool(QObject *parent)
+    : QObject(parent)
+    , m_decoding(false)
+    , m_progress(0)
+    , m_writingFile(false)
+    , m_watcher(new QFutureWatcher<Base64Codec::Result>(this))
+{
+    connect(m_watcher, &QFutureWatcher<Base64Codec::Result>::progressValueChanged, this, [this](int value) {
+        m_progress = qBound(0, value, Base64Codec::kProgressRange);
+        emit progressChanged();
+    });
+    connect(m_watcher, &QFutureWatcher<Base64Codec::Result>::finished, this, &Base64FileTool::onFinished);
+}
+
+Base64FileTool::~Base64FileTool()
+{
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+}
+
+QString Base64FileTool::inputPath() const
+{
+    return m_inputPath;
+}
+
+void Base64FileTool::setInputPath(const QString &inputPath)
+{
+    if (m_inputPath != inputPath) {
+        m_inputPath = inputPath;
+        emit inputPathChanged();
+    }
+}
+
+QString Base64FileTool::outputPath() const
+{
+    return m_outputPath;
+}
+
+void Base64FileTool::setOutputPath(const QString &outputPath)
+{
+    if (m_outputPath != outputPath) {
+        m_outputPath = outputPath;
+        emit outputPathChanged();
+    }
+}
+
+bool Base64FileTool::decoding() const
+{
+    return m_decoding;
+}
+
+void Base64FileTool::setDecoding(bool decoding)
+{
+    if (m_decoding != decoding) {
+        m_decoding = decoding;
+        emit decodingChanged();
+    }
+}
+
+bool Base64FileTool::running() const
+{
+    return m_watcher->isRunning();
+}
+
+int Base64FileTool::progress() const
+{
+    return m_progress;
+}
+
+QString Base64FileTool::preview() const
+{
+    if (m_decoding) {
+        return QString::fromLatin1(m_result.preview.toHex(' '));
+    }
+    return QString::fromLatin1(m_result.preview);
+}
+
+bool Base64FileTool::previewComplete() const
+{
+    return m_result.previewComplete;
+}
+
+qint64 Base64FileTool::bytesRead() const
+{
+    return m_result.bytesRead;
+}
+
+qint64 Base64FileTool::bytesWritten() const
+{
+    return m_result.bytesWritten;
+}
+
+QString Base64FileTool::implementationName() const
+{
+    return QString::fromLatin1(Base64Codec::active().name);
+}
+
+QString Base64FileTool::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+void Base64FileTool::loadPreview()
+{
+    start(QString());
+}
+
+void Base64FileTool::convert()
+{
+    const QString outputPath = m_outputPath.trimmed().isEmpty() ? defaultOutputPath() : m_outputPath.trimmed();
+    start(outputPath);
+}
+
+void Base64FileTool::cancel()
+{
+    m_watcher->cancel();
+}
+
+void Base64FileTool::clear()
+{
+    m_watcher->cancel();
+    m_progress = 0;
+    m_result = Base64Codec::Result();
+    emit progressChanged();
+    emit resultChanged();
+    setStatusMessage(QString());
+}
+
+QString Base64FileTool::defaultOutputPath() const
+{
+    const QString inputPath = m_inputPath.trimmed();
+    if (inputPath.isEmpty()) {
+        return QString();
+    }
+    if (!m_decoding) {
+        return inputPath + QStringLiteral(".b64");
+    }
+    const QString suffix = QFileInfo(inputPath).suffix().toLower();
+    if (suffix == QStringLiteral("b64") || suffix == QStringLiteral("base64") || suffix == QStringLiteral("txt")) {
+        return inputPath.left(inputPath.size() - suffix.size() - 1);
+    }
+    return inputPath + QStringLiteral(".bin");
+}
+
+void Base64FileTool::start(const QString &outputPath)
+{
+    const QString inputPath = m_inputPath.trimmed();
+    if (inputPath.isEmpty() || !QFileInfo(inputPath).isFile()) {
+        setStatusMessage(QStringLiteral("文件不存在"));
+        emit finished(false, m_statusMessage);
+        return;
+    }
+
+    Base64Codec::Options options;
+    options.encode = !m_decoding;
+    options.inputPath = inputPath;
+    options.outputPath = outputPath;
+    options.previewLength = m_decoding ? kDecodePreviewLength : kEncodePreviewLength;
+
+    m_watcher->cancel();
+    m_writingFile = !outputPath.isEmpty();
+    m_progress = 0;
+    m_result = Base64Codec::Result();
+    emit progressChanged();
+    emit resultChanged();
+    setStatusMessage(m_writingFile ? QStringLiteral("正在转换...") : QString());
+    m_watcher->setFuture(Base64Codec::start(options));
+    emit runningChanged();
+}
+
+void Base64FileTool::onFinished()
+{
+    // 取消后不会产生结果
+    Base64Codec::Result result;
+    result.canceled = true;
+    if (!m_watcher->isCanceled() && m_watcher->future().resultCount() > 0) {
+        result = m_watcher->result();
+    }
+
+    QString message;
+    if (result.success) {
+        m_progress = Base64Codec::kProgressRange;
+        if (m_writingFile) {
+            message = QStringLiteral("转换完成，已写入 %1 字节").arg(result.bytesWritten);
+        } else if (!result.previewComplete) {
+            message = QStringLiteral("只显示开头部分，完整结果请保存为文件");
+        }
+    } else if (result.canceled) {
+        message = QStringLiteral("已取消");
+    } else {
+        message = result.errorMessage;
+    }
+
+    m_result = result;
+    emit progressChanged();
+    emit resultChanged();
+    setStatusMessage(message);
+    emit finished(result.success, message);
+    emit runningChanged();
+}
+
+void Base64FileTool::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef BASE64FILETOOL_H
+#define BASE64FILETOOL_H
+
+#include "Base64Codec.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+
+// 文件与 Base64 文本互转：输入文件按块流式转换写入输出文件，大小不受限制，界面只显示结果的开头部分。
+// 转换在线程池中进行，界面线程只接收进度与结果。
+class Base64FileTool : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString inputPath READ inputPath WRITE setInputPath NOTIFY inputPathChanged)
+    // 为空时 convert() 使用 defaultOutputPath()
+    Q_PROPERTY(QString outputPath READ outputPath WRITE setOutputPath NOTIFY outputPathChanged)
+    // false 为文件转 Base64，true 为 Base64 文本转回文件
+    Q_PROPERTY(bool decoding READ decoding WRITE setDecoding NOTIFY decodingChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    // 千分比
+    Q_PROPERTY(int progress READ progress NOTIFY progressChanged)
+    // 编码时为 Base64 文本的开头，解码时为解出数据开头的十六进制
+    Q_PROPERTY(QString preview READ preview NOTIFY resultChanged)
+    // 预览就是完整的结果，可以直接复制
+    Q_PROPERTY(bool previewComplete READ previewComplete NOTIFY resultChanged)
+    Q_PROPERTY(qint64 bytesRead READ bytesRead NOTIFY resultChanged)
+    Q_PROPERTY(qint64 bytesWritten READ bytesWritten NOTIFY resultChanged)
+    // 当前使用的 SIMD 实现，例如 "AVX2"
+    Q_PROPERTY(QString implementationName READ implementationName CONSTANT)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    // 编码预览的字符数；解码预览的字节数（显示为十六进制，约为三倍长度）
+    static constexpr qsizetype kEncodePreviewLength = 64 * 1024;
+    static constexpr qsizetype kDecodePreviewLength = 4 * 1024;
+
+    explicit Base64FileTool(QObject *parent = nullptr);
+    ~Base64FileTool() override;
+
+    QString inputPath() const;
+    void setInputPath(const QString &inputPath);
+
+    QString outputPath() const;
+    void setOutputPath(const QString &outputPath);
+
+    bool decoding() const;
+    void setDecoding(bool decoding);
+
+    bool running() const;
+    int progress() const;
+    QString preview() const;
+    bool previewComplete() const;
+    qint64 bytesRead() const;
+    qint64 bytesWritten() const;
+    QString implementationName() const;
+    QString statusMessage() const;
+
+    // 只转换开头部分用于预览，不写文件
+    Q_INVOKABLE void loadPreview();
+    // 转换整个文件写入 outputPath
+    Q_INVOKABLE void convert();
+    Q_INVOKABLE void cancel();
+    Q_INVOKABLE void clear();
+    // 编码时在输入文件名后加 .b64；解码时去掉 .b64 / .base64 / .txt 后缀，没有这些后缀时加 .bin
+    Q_INVOKABLE QString defaultOutputPath() const;
+
+signals:
+    void inputPathChanged();
+    void outputPathChanged();
+    void decodingChanged();
+    void runningChanged();
+    void progressChanged();
+    void resultChanged();
+    void statusMessageChanged();
+    void finished(bool success, const QString &message);
+
+private:
+    void start(const QString &outputPath);
+    void onFinished();
+    void setStatusMessage(const QString &message);
+
+    QString m_inputPath;
+    QString m_outputPath;
+    bool m_decoding;
+    int m_progress;
+    // 当前任务是否写文件，决定完成时的提示
+    bool m_writingFile;
+    Base64Codec::Result m_result;
+    QString m_statusMessage;
+    QFutureWatcher<Base64Codec::Result> *m_watcher;
+};
+
+#endif // BASE64FILETOOL_H
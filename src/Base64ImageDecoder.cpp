@@ -0,0 +1,282 @@
+#include "Base64ImageDecoder.h"
+#include "Base64Codec.h"
+#include "ImageCompressor.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QtConcurrent/QtConcurrentRun>
+
+Base64ImageProvider *g_base64ImageProvider = nullptr;
+
+namespace {
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+double elapsedMilliseconds(const QElapsedTimer &timer)
+{
+    return double(timer.nsecsElapsed()) / 1e6;
+}
+
+}
+
+// ==================== Base64ImageProvider ====================
+
+Base64ImageProvider::Base64ImageProvider()
+    : QQuickImageProvider(QQuickImageProvider::Image)
+{
+}
+
+QImage Base64ImageProvider::requestImage(const QString &id, QSize *size, const QSize &requestedSize)
+{
+    QImage image;
+    {
+        QMutexLocker locker(&m_mutex);
+        image = m_images.value(id);
+    }
+
+    if (image.isNull()) {
+        image = QImage(1, 1, QImage::Format_ARGB32);
+        image.fill(Qt::transparent);
+    }
+
+    if (size)
+        *size = image.size();
+
+    if (requestedSize.isValid() && requestedSize != image.size())
+        return image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    return image;
+}
+
+void Base64ImageProvider::setImage(const QString &id, const QImage &image)
+{
+    QMutexLocker locker(&m_mutex);
+    m_images.insert(id, image);
+}
+
+void Base64ImageProvider::removeImage(const QString &id)
+{
+    QMutexLocker locker(&m_mutex);
+    m_images.remove(id);
+}
+
+// ==================== Base64ImageDecoder ====================
+
+Base64ImageDecoder::Base64ImageDecoder(QObject *parent)
+    : QObject(parent)
+    , m_maxDimension(kDefaultMaxDimension)
+    , m_imageSerial(0)
+    , m_watcher(new QFutureWatcher<Result>(this))
+{
+    connect(m_watcher, &QFutureWatcher<Result>::finished, this, &Base64ImageDecoder::onFinished);
+}
+
+Base64ImageDecoder::~Base64ImageDecoder()
+{
+    m_watcher->waitForFinished();
+    releaseImage();
+}
+
+bool Base64ImageDecoder::running() const
+{
+    return m_watcher->isRunning();
+}
+
+int Base64ImageDecoder::maxDimension() const
+{
+    return m_maxDimension;
+}
+
+void Base64ImageDecoder::setMaxDimension(int maxDimension)
+{
+    maxDimension = qMax(0, maxDimension);
+    if (m_maxDimension != maxDimension) {
+        m_maxDimension = maxDimension;
+        emit maxDimensionChanged();
+    }
+}
+
+QString Base64ImageDecoder::imageSource() const
+{
+    return m_imageId.isEmpty() ? QString() : QStringLiteral("image://base64image/%1").arg(m_imageId);
+}
+
+bool Base64ImageDecoder::hasImage() const
+{
+    return !m_imageId.isEmpty();
+}
+
+int Base64ImageDecoder::imageWidth() const
+{
+    return m_result.originalSize.width();
+}
+
+int Base64ImageDecoder::imageHeight() const
+{
+    return m_result.originalSize.height();
+}
+
+int Base64ImageDecoder::decodedWidth() const
+{
+    return m_result.image.width();
+}
+
+int Base64ImageDecoder::decodedHeight() const
+{
+    return m_result.image.height();
+}
+
+QString Base64ImageDecoder::format() const
+{
+    return m_result.format;
+}
+
+qint64 Base64ImageDecoder::byteCount() const
+{
+    return m_result.byteCount;
+}
+
+double Base64ImageDecoder::base64Milliseconds() const
+{
+    return m_result.base64Milliseconds;
+}
+
+double Base64ImageDecoder::imageMilliseconds() const
+{
+    return m_result.imageMilliseconds;
+}
+
+QString Base64ImageDecoder::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+void Base64ImageDecoder::decode(const QString &text)
+{
+    if (text.trimmed().isEmpty()) {
+        clear();
+        setStatusMessage(QStringLiteral("请输入 Base64 或 Data URL"));
+        emit finished(false, m_statusMessage);
+        return;
+    }
+
+    // QString 隐式共享，转换为 Latin-1 与之后的全部解码都在工作线程中进行
+    const int maxDimension = m_maxDimension;
+    setStatusMessage(QStringLiteral("正在解码..."));
+    m_watcher->setFuture(QtConcurrent::run([text, maxDimension]() {
+        QElapsedTimer timer;
+        timer.start();
+        const QByteArray latin1 = text.toLatin1();
+        const double conversion = elapsedMilliseconds(timer);
+        Result result = decodeImage(latin1, maxDimension);
+        result.base64Milliseconds += conversion;
+        return result;
+    }));
+    emit runningChanged();
+}
+
+void Base64ImageDecoder::clear()
+{
+    releaseImage();
+    m_result = Result();
+    emit resultChanged();
+    setStatusMessage(QString());
+}
+
+Base64ImageDecoder::Result Base64ImageDecoder::decodeImage(const QByteArray &text, int maxDimension)
+{
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    qsizetype begin = 0;
+    while (begin < text.size() && isSpace(text.at(begin))) {
+        ++begin;
+    }
+    // data:[<mime>][;参数];base64,<数据>
+    if (text.mid(begin, 5).toLower() == "data:") {
+        const qsizetype comma = text.indexOf(',', begin);
+        if (comma < 0) {
+            result.errorMessage = QStringLiteral("Data URL 缺少逗号");
+            return result;
+        }
+        if (!text.mid(begin, comma - begin).toLower().contains(";base64")) {
+            result.errorMessage = QStringLiteral("只支持 base64 编码的 Data URL");
+            return result;
+        }
+        begin = comma + 1;
+    }
+
+    // 跳过前缀时不复制输入
+    bool ok = false;
+    QByteArray data = Base64Codec::decode(QByteArray::fromRawData(text.constData() + begin, text.size() - begin), &ok);
+    result.base64Milliseconds = elapsedMilliseconds(timer);
+    if (!ok || data.isEmpty()) {
+        result.errorMessage = QStringLiteral("Base64 数据无效");
+        return result;
+    }
+    result.byteCount = data.size();
+
+    timer.restart();
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    // 按旋转后的方向缩放解码，originalSize 也是旋转后的尺寸
+    result.image = ImageCompressor::read(reader, maxDimension, maxDimension, &result.originalSize);
+    if (result.image.isNull()) {
+        result.errorMessage = QStringLiteral("图片解码失败: %1").arg(reader.errorString());
+        return result;
+    }
+    result.format = QString::fromLatin1(reader.format());
+    result.imageMilliseconds = elapsedMilliseconds(timer);
+    result.success = true;
+    return result;
+}
+
+void Base64ImageDecoder::onFinished()
+{
+    if (m_watcher->future().resultCount() == 0) {
+        emit runningChanged();
+        return;
+    }
+    const Result result = m_watcher->result();
+    QString message = result.errorMessage;
+
+    releaseImage();
+    m_result = result;
+    if (result.success) {
+        m_imageId = QStringLiteral("%1_%2").arg(quintptr(this), 0, 16).arg(++m_imageSerial);
+        if (g_base64ImageProvider) {
+            g_base64ImageProvider->setImage(m_imageId, result.image);
+        }
+        message = QStringLiteral("解码完成，共 %1 ms").arg(result.base64Milliseconds + result.imageMilliseconds, 0, 'f', 1);
+    }
+
+    emit resultChanged();
+    setStatusMessage(message);
+    emit finished(result.success, message);
+    emit runningChanged();
+}
+
+void Base64ImageDecoder::releaseImage()
+{
+    if (!m_imageId.isEmpty()) {
+        if (g_base64ImageProvider) {
+            g_base64ImageProvider->removeImage(m_imageId);
+        }
+        m_imageId.clear();
+    }
+}
+
+void Base64ImageDecoder::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef BASE64IMAGEDECODER_H
+#define BASE64IMAGEDECODER_H
+
+#include <QByteArray>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQuickImageProvider>
+#include <QSize>
+#include <QString>
+
+// Base64 / Data URL 图片预览：Base64 解码与图片解码都在线程池中进行，界面线程只接收结果。
+// 图片按 maxDimension 交给 QImageReader 按比例缩小解码（JPEG 等格式解码时直接降采样），
+// 结果放进 Base64ImageProvider，QML 通过 image://base64image/ 地址显示。
+class Base64ImageDecoder : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    // 预览的最长边，0 表示按原始尺寸解码
+    Q_PROPERTY(int maxDimension READ maxDimension WRITE setMaxDimension NOTIFY maxDimensionChanged)
+    Q_PROPERTY(QString imageSource READ imageSource NOTIFY resultChanged)
+    Q_PROPERTY(bool hasImage READ hasImage NOTIFY resultChanged)
+    // 图片的原始尺寸与实际解码出的尺寸
+    Q_PROPERTY(int imageWidth READ imageWidth NOTIFY resultChanged)
+    Q_PROPERTY(int imageHeight READ imageHeight NOTIFY resultChanged)
+    Q_PROPERTY(int decodedWidth READ decodedWidth NOTIFY resultChanged)
+    Q_PROPERTY(int decodedHeight READ decodedHeight NOTIFY resultChanged)
+    // QImageReader 识别出的格式，例如 "png"
+    Q_PROPERTY(QString format READ format NOTIFY resultChanged)
+    // Base64 解出的字节数
+    Q_PROPERTY(qint64 byteCount READ byteCount NOTIFY resultChanged)
+    // Base64 解码与图片解码的耗时（毫秒）
+    Q_PROPERTY(double base64Milliseconds READ base64Milliseconds NOTIFY resultChanged)
+    Q_PROPERTY(double imageMilliseconds READ imageMilliseconds NOTIFY resultChanged)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    static constexpr int kDefaultMaxDimension = 2048;
+
+    struct Result {
+        bool success = false;
+        QString errorMessage;
+        QImage image;
+        QSize originalSize;
+        QString format;
+        qint64 byteCount = 0;
+        double base64Milliseconds = 0;
+        double imageMilliseconds = 0;
+    };
+
+    explicit Base64ImageDecoder(QObject *parent = nullptr);
+    ~Base64ImageDecoder() override;
+
+    bool running() const;
+    int maxDimension() const;
+    void setMaxDimension(int maxDimension);
+    QString imageSource() const;
+    bool hasImage() const;
+    int imageWidth() const;
+    int imageHeight() const;
+    int decodedWidth() const;
+    int decodedHeight() const;
+    QString format() const;
+    qint64 byteCount() const;
+    double base64Milliseconds() const;
+    double imageMilliseconds() const;
+    QString statusMessage() const;
+
+    // 纯 Base64 或 data:image/...;base64,... 均可，空白字符会被忽略
+    Q_INVOKABLE void decode(const QString &text);
+    Q_INVOKABLE void clear();
+
+    // 在调用线程中完成全部解码，供 decode() 的工作线程使用
+    static Result decodeImage(const QByteArray &text, int maxDimension);
+
+signals:
+    void runningChanged();
+    void maxDimensionChanged();
+    void resultChanged();
+    void statusMessageChanged();
+    void finished(bool success, const QString &message);
+
+private:
+    void onFinished();
+    void releaseImage();
+    void setStatusMessage(const QString &message);
+
+    int m_maxDimension;
+    Result m_result;
+    QString m_imageId;
+    int m_imageSerial;
+    QString m_statusMessage;
+    QFutureWatcher<Result> *m_watcher;
+};
+
+// 供 QML 显示解码结果；requestImage 在 QML 的图片加载线程中调用，因此需要加锁
+class Base64ImageProvider : public QQuickImageProvider
+{
+public:
+    Base64ImageProvider();
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override;
+    void setImage(const QString &id, const QImage &image);
+    void removeImage(const QString &id);
+
+private:
+    QMutex m_mutex;
+    QHash<QString, QImage> m_images;
+};
+
+extern Base64ImageProvider *g_base64ImageProvider;
+
+#endif // BASE64IMAGEDECODER_H
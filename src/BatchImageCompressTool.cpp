@@ -0,0 +1,425 @@
+#include "BatchImageCompressTool.h"
+
+#include <QDir>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVariantMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+// 每个工作线程同时只持有一张解码后的图片，线程数受内存与 CPU 核数共同限制
+constexpr int kMaxThreadCount = 16;
+
+double savedPercent(qint64 inputBytes, qint64 outputBytes)
+{
+    return inputBytes > 0 ? (1.0 - double(outputBytes) / double(inputBytes)) * 100.0 : 0.0;
+}
+
+// path 是否为 folder 本身或位于其中
+bool isSameOrInside(const QString &path, const QString &folder)
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_MACOS)
+    const Qt::CaseSensitivity sensitivity = Qt::CaseInsensitive;
+#else
+    const Qt::CaseSensitivity sensitivity = Qt::CaseSensitive;
+#endif
+    const QString prefix = folder.endsWith('/') ? folder : folder + '/';
+    return path.compare(folder, sensitivity) == 0 || path.startsWith(prefix, sensitivity);
+}
+
+}
+
+BatchImageCompressTool::BatchImageCompressTool(QObject *parent)
+    : QObject(parent)
+    , m_format("jpeg")
+    , m_quality(70)
+    , m_maxWidth(0)
+    , m_maxHeight(0)
+    , m_threadCount(qBound(1, QThread::idealThreadCount(), kMaxThreadCount))
+    , m_failedFiles(0)
+    , m_inputBytes(0)
+    , m_outputBytes(0)
+    , m_processedBytes(0)
+    , m_elapsedNanoseconds(0)
+    , m_run(0)
+    , m_watcher(new QFutureWatcher<ImageCompressor::BatchItem>(this))
+{
+    connect(m_watcher, &QFutureWatcher<ImageCompressor::BatchItem>::resultsReadyAt,
+            this, &BatchImageCompressTool::onResultsReadyAt);
+    connect(m_watcher, &QFutureWatcher<ImageCompressor::BatchItem>::progressRangeChanged,
+            this, &BatchImageCompressTool::progressChanged);
+    connect(m_watcher, &QFutureWatcher<ImageCompressor::BatchItem>::finished,
+            this, &BatchImageCompressTool::onFinished);
+}
+
+BatchImageCompressTool::~BatchImageCompressTool()
+{
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+}
+
+QString BatchImageCompressTool::inputPath() const
+{
+    return m_inputPath;
+}
+
+void BatchImageCompressTool::setInputPath(const QString &inputPath)
+{
+    if (m_inputPath != inputPath) {
+        m_inputPath = inputPath;
+        emit inputPathChanged();
+    }
+}
+
+QString BatchImageCompressTool::outputFolder() const
+{
+    return m_outputFolder;
+}
+
+void BatchImageCompressTool::setOutputFolder(const QString &outputFolder)
+{
+    if (m_outputFolder != outputFolder) {
+        m_outputFolder = outputFolder;
+        emit outputFolderChanged();
+    }
+}
+
+QString BatchImageCompressTool::format() const
+{
+    return m_format;
+}
+
+void BatchImageCompressTool::setFormat(const QString &format)
+{
+    QString value = format.trimmed().toLower();
+    if (value == QStringLiteral("jpg")) {
+        value = QStringLiteral("jpeg");
+    }
+    if (!value.isEmpty() && m_format != value) {
+        m_format = value;
+        emit optionsChanged();
+    }
+}
+
+int BatchImageCompressTool::quality() const
+{
+    return m_quality;
+}
+
+void BatchImageCompressTool::setQuality(int quality)
+{
+    quality = qBound(1, quality, 100);
+    if (m_quality != quality) {
+        m_quality = quality;
+        emit optionsChanged();
+    }
+}
+
+int BatchImageCompressTool::maxWidth() const
+{
+    return m_maxWidth;
+}
+
+void BatchImageCompressTool::setMaxWidth(int maxWidth)
+{
+    maxWidth = qMax(0, maxWidth);
+    if (m_maxWidth != maxWidth) {
+        m_maxWidth = maxWidth;
+        emit optionsChanged();
+    }
+}
+
+int BatchImageCompressTool::maxHeight() const
+{
+    return m_maxHeight;
+}
+
+void BatchImageCompressTool::setMaxHeight(int maxHeight)
+{
+    maxHeight = qMax(0, maxHeight);
+    if (m_maxHeight != maxHeight) {
+        m_maxHeight = maxHeight;
+        emit optionsChanged();
+    }
+}
+
+int BatchImageCompressTool::threadCount() const
+{
+    return m_threadCount;
+}
+
+void BatchImageCompressTool::setThreadCount(int threadCount)
+{
+    threadCount = qBound(1, threadCount, kMaxThreadCount);
+    if (m_threadCount != threadCount) {
+        m_threadCount = threadCount;
+        emit threadCountChanged();
+    }
+}
+
+bool BatchImageCompressTool::running() const
+{
+    return m_watcher->isRunning();
+}
+
+int BatchImageCompressTool::totalFiles() const
+{
+    return m_watcher->progressMaximum();
+}
+
+int BatchImageCompressTool::processedFiles() const
+{
+    return int(m_items.size());
+}
+
+int BatchImageCompressTool::failedFiles() const
+{
+    return m_failedFiles;
+}
+
+qint64 BatchImageCompressTool::inputBytes() const
+{
+    return m_inputBytes;
+}
+
+qint64 BatchImageCompressTool::outputBytes() const
+{
+    return m_outputBytes;
+}
+
+double BatchImageCompressTool::elapsedSeconds() const
+{
+    const qint64 nanoseconds = m_watcher->isRunning() ? m_timer.nsecsElapsed() : m_elapsedNanoseconds;
+    return double(nanoseconds) / 1e9;
+}
+
+double BatchImageCompressTool::filesPerSecond() const
+{
+    const double seconds = elapsedSeconds();
+    return seconds > 0 ? m_items.size() / seconds : 0.0;
+}
+
+double BatchImageCompressTool::bytesPerSecond() const
+{
+    const double seconds = elapsedSeconds();
+    return seconds > 0 ? m_processedBytes / seconds : 0.0;
+}
+
+QVariantList BatchImageCompressTool::items() const
+{
+    QVariantList items;
+    items.reserve(m_items.size());
+    for (const ImageCompressor::BatchItem &item : m_items) {
+        const ImageCompressor::Result &result = item.result;
+        QVariantMap map;
+        map.insert("path", item.path);
+        map.insert("outputPath", item.outputPath);
+        map.insert("success", result.success);
+        map.insert("error", result.errorMessage);
+        map.insert("inputBytes", result.inputBytes);
+        map.insert("outputBytes", result.outputBytes);
+        map.insert("width", result.originalSize.width());
+        map.insert("height", result.originalSize.height());
+        map.insert("outputWidth", result.outputSize.width());
+        map.insert("outputHeight", result.outputSize.height());
+        map.insert("milliseconds", item.milliseconds);
+        items.append(map);
+    }
+    return items;
+}
+
+QStringList BatchImageCompressTool::problems() const
+{
+    QStringList problems;
+    for (const ImageCompressor::BatchItem &item : m_items) {
+        if (!item.result.success) {
+            problems.append(QStringLiteral("[失败] %1: %2").arg(item.path, item.result.errorMessage));
+        }
+    }
+    return problems;
+}
+
+QString BatchImageCompressTool::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+void BatchImageCompressTool::start()
+{
+    QString root;
+    QString pattern;
+    if (!ImageCompressor::parseInput(m_inputPath, &root, &pattern)) {
+        setStatusMessage("文件夹不存在");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+    const QString inputRoot = QDir(root).absolutePath();
+    const QString outputFolder = m_outputFolder.trimmed().isEmpty() ? defaultOutputFolder() : m_outputFolder.trimmed();
+    const QString outputRoot = QDir(QDir::fromNativeSeparators(outputFolder)).absolutePath();
+    // 输出在输入目录内时，再次运行会把上次的结果当作输入
+    if (isSameOrInside(outputRoot, inputRoot)) {
+        setStatusMessage("输出文件夹不能是输入文件夹或其中的子文件夹");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+
+    ImageCompressor::Options options;
+    options.format = m_format.toLatin1();
+    options.quality = m_quality;
+    options.maxWidth = m_maxWidth;
+    options.maxHeight = m_maxHeight;
+    const int threads = m_threadCount;
+
+    // 上一次任务被取消后可能还在写最后几个文件，等它结束，避免与新任务写同一个文件
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+    resetResults();
+    const int run = ++m_run;
+    m_timer.start();
+    setStatusMessage("正在压缩...");
+
+    m_watcher->setFuture(QtConcurrent::run([this, run, inputRoot, pattern, outputRoot, options, threads](
+                                               QPromise<ImageCompressor::BatchItem> &promise) {
+        const QStringList paths = ImageCompressor::collectImages(inputRoot, pattern);
+        promise.setProgressRange(0, int(paths.size()));
+        if (promise.isCanceled()) {
+            return;
+        }
+        // 取消后 QPromise 不再接收结果，但正在处理的文件仍会写到磁盘，这些结果另行送回界面线程
+        QMutex mutex;
+        QList<ImageCompressor::BatchItem> late;
+        ImageCompressor::compressAll(
+            inputRoot, paths, outputRoot, options, threads,
+            [&promise, &mutex, &late](const ImageCompressor::BatchItem &item, int processed, int) {
+                if (!promise.addResult(item)) {
+                    QMutexLocker locker(&mutex);
+                    late.append(item);
+                }
+                promise.setProgressValue(processed);
+                return !promise.isCanceled();
+            });
+        // 排在 finished 之前到达界面线程，结束时的统计已包含这些文件
+        if (!late.isEmpty()) {
+            QMetaObject::invokeMethod(this, [this, run, late]() {
+                if (run == m_run) {
+                    appendItems(late);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }));
+    emit runningChanged();
+}
+
+void BatchImageCompressTool::cancel()
+{
+    m_watcher->cancel();
+}
+
+QString BatchImageCompressTool::defaultOutputFolder() const
+{
+    QString root;
+    QString pattern;
+    if (!ImageCompressor::parseInput(m_inputPath, &root, &pattern)) {
+        return QString();
+    }
+    const QString folder = QDir(root).absolutePath();
+    if (QDir(folder).isRoot()) {
+        return QDir::toNativeSeparators(QDir(folder).filePath(QStringLiteral("compressed")));
+    }
+    return QDir::toNativeSeparators(folder + QStringLiteral("_compressed"));
+}
+
+QString BatchImageCompressTool::report() const
+{
+    QString text;
+    for (const ImageCompressor::BatchItem &item : m_items) {
+        const ImageCompressor::Result &result = item.result;
+        if (result.success) {
+            text += QStringLiteral("%1\t%2 -> %3 字节\t%4%\n")
+                        .arg(item.path)
+                        .arg(result.inputBytes)
+                        .arg(result.outputBytes)
+                        .arg(savedPercent(result.inputBytes, result.outputBytes), 0, 'f', 1);
+        }
+    }
+    const QStringList failures = problems();
+    if (!failures.isEmpty()) {
+        text += '\n' + failures.join('\n') + '\n';
+    }
+    return text;
+}
+
+void BatchImageCompressTool::onResultsReadyAt(int begin, int end)
+{
+    QList<ImageCompressor::BatchItem> items;
+    items.reserve(end - begin);
+    for (int i = begin; i < end; ++i) {
+        items.append(m_watcher->resultAt(i));
+    }
+    appendItems(items);
+}
+
+void BatchImageCompressTool::appendItems(const QList<ImageCompressor::BatchItem> &items)
+{
+    for (const ImageCompressor::BatchItem &item : items) {
+        m_processedBytes += item.result.inputBytes;
+        if (item.result.success) {
+            m_inputBytes += item.result.inputBytes;
+            m_outputBytes += item.result.outputBytes;
+        } else {
+            ++m_failedFiles;
+        }
+        m_items.append(item);
+    }
+    emit itemsChanged();
+    emit progressChanged();
+}
+
+void BatchImageCompressTool::onFinished()
+{
+    m_elapsedNanoseconds = m_timer.nsecsElapsed();
+    const int total = totalFiles();
+    const bool canceled = m_watcher->isCanceled();
+
+    QString message;
+    if (canceled) {
+        message = QStringLiteral("已取消，已处理 %1 / %2 个文件").arg(m_items.size()).arg(total);
+    } else if (total == 0) {
+        message = QStringLiteral("没有找到可压缩的图片");
+    } else {
+        message = QStringLiteral("已压缩 %1 个文件，体积减少 %2%")
+                      .arg(m_items.size() - m_failedFiles)
+                      .arg(savedPercent(m_inputBytes, m_outputBytes), 0, 'f', 1);
+        if (m_failedFiles > 0) {
+            message += QStringLiteral("，%1 个文件失败").arg(m_failedFiles);
+        }
+    }
+
+    emit progressChanged();
+    setStatusMessage(message);
+    emit finished(!canceled && total > 0 && m_failedFiles == 0, message);
+    emit runningChanged();
+}
+
+void BatchImageCompressTool::resetResults()
+{
+    m_items.clear();
+    m_failedFiles = 0;
+    m_inputBytes = 0;
+    m_outputBytes = 0;
+    m_processedBytes = 0;
+    m_elapsedNanoseconds = 0;
+    emit itemsChanged();
+    emit progressChanged();
+}
+
+void BatchImageCompressTool::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
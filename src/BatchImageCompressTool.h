@@ -0,0 +1,133 @@
+#ifndef BATCHIMAGECOMPRESSTOOL_H
+#define BATCHIMAGECOMPRESSTOOL_H
+
+#include "ImageCompressor.h"
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+// 批量图片压缩：输入为文件夹或带通配符的路径，多个文件在线程池中并行解码、缩小与编码，
+// 输出保留原来的目录结构。每个文件完成后结果立即显示，并统计节省的空间、速度与失败的文件。
+class BatchImageCompressTool : public QObject
+{
+    Q_OBJECT
+    // 文件夹，或 D:/photos/**/*.jpg 这样的通配符路径
+    Q_PROPERTY(QString inputPath READ inputPath WRITE setInputPath NOTIFY inputPathChanged)
+    // 为空时使用 defaultOutputFolder()
+    Q_PROPERTY(QString outputFolder READ outputFolder WRITE setOutputFolder NOTIFY outputFolderChanged)
+    // 输出格式，例如 "jpeg"
+    Q_PROPERTY(QString format READ format WRITE setFormat NOTIFY optionsChanged)
+    Q_PROPERTY(int quality READ quality WRITE setQuality NOTIFY optionsChanged)
+    // 任一为 0 表示保持原尺寸
+    Q_PROPERTY(int maxWidth READ maxWidth WRITE setMaxWidth NOTIFY optionsChanged)
+    Q_PROPERTY(int maxHeight READ maxHeight WRITE setMaxHeight NOTIFY optionsChanged)
+    // 同时处理的文件数
+    Q_PROPERTY(int threadCount READ threadCount WRITE setThreadCount NOTIFY threadCountChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(int totalFiles READ totalFiles NOTIFY progressChanged)
+    Q_PROPERTY(int processedFiles READ processedFiles NOTIFY progressChanged)
+    Q_PROPERTY(int failedFiles READ failedFiles NOTIFY progressChanged)
+    // 压缩成功的文件压缩前后的总字节数
+    Q_PROPERTY(qint64 inputBytes READ inputBytes NOTIFY progressChanged)
+    Q_PROPERTY(qint64 outputBytes READ outputBytes NOTIFY progressChanged)
+    // 从开始到现在（或到结束）的耗时与按输入计算的速度
+    Q_PROPERTY(double elapsedSeconds READ elapsedSeconds NOTIFY progressChanged)
+    Q_PROPERTY(double filesPerSecond READ filesPerSecond NOTIFY progressChanged)
+    Q_PROPERTY(double bytesPerSecond READ bytesPerSecond NOTIFY progressChanged)
+    // 每项为 { path, outputPath, success, error, inputBytes, outputBytes, width, height, outputWidth, outputHeight, milliseconds }
+    Q_PROPERTY(QVariantList items READ items NOTIFY itemsChanged)
+    Q_PROPERTY(QStringList problems READ problems NOTIFY itemsChanged)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    explicit BatchImageCompressTool(QObject *parent = nullptr);
+    ~BatchImageCompressTool() override;
+
+    QString inputPath() const;
+    void setInputPath(const QString &inputPath);
+
+    QString outputFolder() const;
+    void setOutputFolder(const QString &outputFolder);
+
+    QString format() const;
+    void setFormat(const QString &format);
+
+    int quality() const;
+    void setQuality(int quality);
+
+    int maxWidth() const;
+    void setMaxWidth(int maxWidth);
+
+    int maxHeight() const;
+    void setMaxHeight(int maxHeight);
+
+    int threadCount() const;
+    void setThreadCount(int threadCount);
+
+    bool running() const;
+    int totalFiles() const;
+    int processedFiles() const;
+    int failedFiles() const;
+    qint64 inputBytes() const;
+    qint64 outputBytes() const;
+    double elapsedSeconds() const;
+    double filesPerSecond() const;
+    double bytesPerSecond() const;
+    QVariantList items() const;
+    QStringList problems() const;
+    QString statusMessage() const;
+
+    Q_INVOKABLE void start();
+    Q_INVOKABLE void cancel();
+    // 输入目录旁边的“目录名_compressed”
+    Q_INVOKABLE QString defaultOutputFolder() const;
+    // 结果的纯文本形式，每行一个文件：相对路径、压缩前后大小与节省比例，失败的文件列出原因
+    Q_INVOKABLE QString report() const;
+
+signals:
+    void inputPathChanged();
+    void outputFolderChanged();
+    void optionsChanged();
+    void threadCountChanged();
+    void runningChanged();
+    void progressChanged();
+    void itemsChanged();
+    void statusMessageChanged();
+    void finished(bool success, const QString &message);
+
+private:
+    void onResultsReadyAt(int begin, int end);
+    void appendItems(const QList<ImageCompressor::BatchItem> &items);
+    void onFinished();
+    void resetResults();
+    void setStatusMessage(const QString &message);
+
+    QString m_inputPath;
+    QString m_outputFolder;
+    QString m_format;
+    int m_quality;
+    int m_maxWidth;
+    int m_maxHeight;
+    int m_threadCount;
+    QString m_statusMessage;
+
+    QList<ImageCompressor::BatchItem> m_items;
+    int m_failedFiles;
+    qint64 m_inputBytes;
+    qint64 m_outputBytes;
+    // 已处理文件（含失败的）的总字节数，用于计算速度
+    qint64 m_processedBytes;
+    QElapsedTimer m_timer;
+    // 任务结束后固定下来的耗时
+    qint64 m_elapsedNanoseconds;
+    // 每次 start() 加一，丢弃上一次任务取消后才送到的结果
+    int m_run;
+    QFutureWatcher<ImageCompressor::BatchItem> *m_watcher;
+};
+
+#endif // BATCHIMAGECOMPRESSTOOL_H
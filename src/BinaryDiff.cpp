@@ -0,0 +1,550 @@
+#include "BinaryDiff.h"
+#include "XXH3.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QPair>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtEndian>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+// 每次从文件读取的字节数
+constexpr qint64 kReadLength = 1024 * 1024;
+// 每段至少这么大才值得交给单独的线程
+constexpr qint64 kMinSegmentLength = 8 * 1024 * 1024;
+// 收窄空隙时每次比较的字节数
+constexpr qint64 kCompareLength = 512;
+
+// 多项式滚动哈希 h = Σ (x[i] + 1) · M^(n-1-i) mod 2^64，每个字节 +1 让全零窗口不为 0
+constexpr quint64 kMultiplier = 0x100000001b3ULL;
+// 查表前把滚动哈希打散，多项式哈希的低位只取决于字节的低位
+constexpr quint64 kMix = 0x9e3779b97f4a7c15ULL;
+// 过滤位图比桶多 2^kFilterExtraBits 倍，大多数未命中的窗口只查位图，不碰更大的桶表
+constexpr int kFilterExtraBits = 4;
+
+class RollingHash
+{
+public:
+    explicit RollingHash(int length)
+        : m_length(length)
+        , m_outFactor(1)
+    {
+        for (int i = 1; i < length; ++i) {
+            m_outFactor *= kMultiplier;
+        }
+    }
+
+    // 每次并入 4 个字节，依赖链上每 4 个字节只有一次乘法
+    quint64 hash(const quint8 *data) const
+    {
+        constexpr quint64 m2 = kMultiplier * kMultiplier;
+        constexpr quint64 m3 = m2 * kMultiplier;
+        constexpr quint64 m4 = m3 * kMultiplier;
+        quint64 h = 0;
+        int i = 0;
+        for (; i + 4 <= m_length; i += 4) {
+            h = h * m4 + (quint64(data[i]) + 1) * m3 + (quint64(data[i + 1]) + 1) * m2
+                + (quint64(data[i + 2]) + 1) * kMultiplier + data[i + 3] + 1;
+        }
+        for (; i < m_length; ++i) {
+            h = h * kMultiplier + data[i] + 1;
+        }
+        return h;
+    }
+
+    quint64 roll(quint64 h, quint8 out, quint8 in) const
+    {
+        return (h - (quint64(out) + 1) * m_outFactor) * kMultiplier + in + 1;
+    }
+
+private:
+    int m_length;
+    quint64 m_outFactor;
+};
+
+struct StrongHash {
+    quint64 high = 0;
+    quint64 low = 0;
+
+    bool operator==(const StrongHash &other) const { return high == other.high && low == other.low; }
+};
+
+StrongHash strongHash(const quint8 *data, qsizetype length)
+{
+    XXH3 hash(XXH3::Bits128);
+    hash.addData(reinterpret_cast<const char *>(data), length);
+    const QByteArray digest = hash.result();
+    StrongHash result;
+    result.high = qFromBigEndian<quint64>(digest.constData());
+    result.low = qFromBigEndian<quint64>(digest.constData() + 8);
+    return result;
+}
+
+// 旧文件各块的签名，以及按滚动哈希查块号的桶表
+struct Signatures {
+    int blockSize = 0;
+    qint64 blocks = 0;
+    QList<quint64> weak;
+    QList<StrongHash> strong;
+
+    int bucketBits = 0;
+    // bucketStart[b] 到 bucketStart[b + 1] 是第 b 个桶中的块号，桶内按块号升序
+    QList<quint32> bucketStart;
+    QList<quint32> entries;
+    QList<quint64> filter;
+
+    quint64 mixed(quint64 weakHash) const { return weakHash * kMix; }
+
+    bool mayContain(quint64 weakHash) const
+    {
+        const quint64 f = mixed(weakHash) >> (64 - bucketBits - kFilterExtraBits);
+        return filter.constData()[f >> 6] >> (f & 63) & 1;
+    }
+
+    void buildTable()
+    {
+        bucketBits = 4;
+        while ((qint64(1) << bucketBits) < blocks * 2) {
+            ++bucketBits;
+        }
+        const int filterBits = bucketBits + kFilterExtraBits;
+        filter = QList<quint64>(qsizetype(1) << (filterBits - 6), 0);
+        bucketStart = QList<quint32>((qsizetype(1) << bucketBits) + 1, 0);
+        for (qint64 i = 0; i < blocks; ++i) {
+            const quint64 f = mixed(weak.at(i)) >> (64 - filterBits);
+            filter[f >> 6] |= quint64(1) << (f & 63);
+            ++bucketStart[(f >> kFilterExtraBits) + 1];
+        }
+        std::partial_sum(bucketStart.begin(), bucketStart.end(), bucketStart.begin());
+
+        QList<quint32> fill(bucketStart.begin(), bucketStart.end() - 1);
+        entries = QList<quint32>(blocks);
+        for (qint64 i = 0; i < blocks; ++i) {
+            const quint64 bucket = mixed(weak.at(i)) >> (64 - bucketBits);
+            entries[fill[bucket]++] = quint32(i);
+        }
+    }
+
+    // 查找内容与 window 相同的块；有多块相同时优先 preferred，让连续的匹配在旧文件中也尽量连续
+    qint64 find(quint64 weakHash, const quint8 *window, qint64 preferred) const
+    {
+        if (!mayContain(weakHash)) {
+            return -1;
+        }
+
+        bool hashed = false;
+        StrongHash hash;
+        const auto matches = [&](qint64 block) {
+            if (weak.at(block) != weakHash) {
+                return false;
+            }
+            if (!hashed) {
+                hash = strongHash(window, blockSize);
+                hashed = true;
+            }
+            return strong.at(block) == hash;
+        };
+        if (preferred >= 0 && preferred < blocks && matches(preferred)) {
+            return preferred;
+        }
+        const quint64 bucket = mixed(weakHash) >> (64 - bucketBits);
+        for (quint32 i = bucketStart.at(bucket); i < bucketStart.at(bucket + 1); ++i) {
+            if (matches(entries.at(i))) {
+                return entries.at(i);
+            }
+        }
+        return -1;
+    }
+};
+
+struct Match {
+    qint64 newOffset;
+    qint64 block;
+};
+
+// 一个线程负责的文件段；出错时 errorMessage 非空
+struct Segment {
+    qint64 begin = 0;
+    qint64 end = 0;
+    QList<Match> matches;
+    QString errorMessage;
+};
+
+// 把 [0, length) 按 unit 的整数倍切成适合 threadCount 个线程的若干段
+QList<Segment> splitSegments(qint64 length, qint64 unit, int threadCount)
+{
+    qint64 segmentLength = length;
+    if (threadCount > 1) {
+        // 段数多于线程数，读得快的线程可以多领几段
+        segmentLength = qMax(kMinSegmentLength, length / (qint64(threadCount) * 4));
+        segmentLength = (segmentLength + unit - 1) / unit * unit;
+    }
+    QList<Segment> segments;
+    for (qint64 begin = 0; begin < length; begin += segmentLength) {
+        Segment segment;
+        segment.begin = begin;
+        segment.end = qMin(length, begin + segmentLength);
+        segments.append(segment);
+    }
+    return segments;
+}
+
+// 逐个或在独立线程池中处理各段；blockingMap 的调用线程也参与处理，池中只需再开 threadCount - 1 个线程
+template <typename Function>
+void forEachSegment(QList<Segment> &segments, int threadCount, Function function)
+{
+    if (threadCount <= 1 || segments.size() <= 1) {
+        for (Segment &segment : segments) {
+            function(segment);
+        }
+        return;
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount - 1);
+    QtConcurrent::blockingMap(&pool, segments, function);
+}
+
+bool readFully(QFile &file, qint64 offset, char *data, qint64 length)
+{
+    return file.seek(offset) && file.read(data, length) == length;
+}
+
+QString readError(QFile &file)
+{
+    return file.error() != QFileDevice::NoError ? file.errorString() : QStringLiteral("文件读取不完整");
+}
+
+// 从 oldOffset / newOffset 起向后（backward 时从两者向前）比较，返回相同的字节数，最多 limit
+qint64 commonLength(QFile &oldFile, qint64 oldOffset, QFile &newFile, qint64 newOffset, qint64 limit, bool backward,
+                    bool *ok)
+{
+    char oldData[kCompareLength];
+    char newData[kCompareLength];
+    qint64 same = 0;
+    while (same < limit) {
+        const qint64 length = qMin(kCompareLength, limit - same);
+        const qint64 oldAt = backward ? oldOffset - same - length : oldOffset + same;
+        const qint64 newAt = backward ? newOffset - same - length : newOffset + same;
+        if (!readFully(oldFile, oldAt, oldData, length) || !readFully(newFile, newAt, newData, length)) {
+            *ok = false;
+            return same;
+        }
+        for (qint64 i = 0; i < length; ++i) {
+            const qint64 at = backward ? length - 1 - i : i;
+            if (oldData[at] != newData[at]) {
+                return same + i;
+            }
+        }
+        same += length;
+    }
+    return same;
+}
+
+}
+
+int BinaryDiff::defaultBlockSize(qint64 oldSize)
+{
+    qint64 blockSize = kMinBlockSize;
+    while (blockSize < kMaxBlockSize && oldSize / blockSize > kMaxBlocks) {
+        blockSize *= 2;
+    }
+    return int(blockSize);
+}
+
+BinaryDiff::Result BinaryDiff::compare(const QString &oldPath, const QString &newPath, int threadCount, int blockSize,
+                                       const ProgressFunction &progress)
+{
+    Result result;
+    QFile oldFile(oldPath);
+    QFile newFile(newPath);
+    if (!oldFile.open(QIODevice::ReadOnly)) {
+        result.errorMessage = QStringLiteral("旧文件无法读取: %1").arg(oldFile.errorString());
+        return result;
+    }
+    if (!newFile.open(QIODevice::ReadOnly)) {
+        result.errorMessage = QStringLiteral("新文件无法读取: %1").arg(newFile.errorString());
+        return result;
+    }
+    result.oldSize = oldFile.size();
+    result.newSize = newFile.size();
+    result.blockSize = blockSize > 0 ? qBound(64, blockSize, int(kMaxBlockSize)) : defaultBlockSize(result.oldSize);
+    const int length = result.blockSize;
+
+    std::atomic<bool> stop(false);
+    std::atomic<qint64> processed(0);
+    const auto report = [&](Stage stage, qint64 bytes, qint64 total) {
+        if (progress && !progress(stage, processed += bytes, total)) {
+            stop.store(true);
+        }
+    };
+    const auto firstError = [](const QList<Segment> &segments) {
+        for (const Segment &segment : segments) {
+            if (!segment.errorMessage.isEmpty()) {
+                return segment.errorMessage;
+            }
+        }
+        return QString();
+    };
+
+    // 1. 旧文件分块签名，不足一块的尾部不参与，留给第 3 步逐字节比较
+    Signatures signatures;
+    signatures.blockSize = length;
+    signatures.blocks = result.oldSize / length;
+    signatures.weak = QList<quint64>(signatures.blocks);
+    signatures.strong = QList<StrongHash>(signatures.blocks);
+    const qint64 signedLength = signatures.blocks * length;
+    const RollingHash rolling(length);
+
+    QList<Segment> blockSegments = splitSegments(signedLength, length, threadCount);
+    report(Stage::Signature, 0, signedLength);
+    forEachSegment(blockSegments, threadCount, [&](Segment &segment) {
+        QFile file(oldPath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            segment.errorMessage = QStringLiteral("旧文件无法读取: %1").arg(file.errorString());
+            return;
+        }
+        const qint64 readLength = qMax<qint64>(kReadLength / length, 1) * length;
+        QByteArray buffer(readLength, Qt::Uninitialized);
+        for (qint64 offset = segment.begin; offset < segment.end && !stop.load(std::memory_order_relaxed);
+             offset += readLength) {
+            const qint64 chunk = qMin(readLength, segment.end - offset);
+            if (!readFully(file, offset, buffer.data(), chunk)) {
+                segment.errorMessage = QStringLiteral("旧文件读取失败: %1").arg(readError(file));
+                return;
+            }
+            const quint8 *data = reinterpret_cast<const quint8 *>(buffer.constData());
+            for (qint64 i = 0; i < chunk; i += length) {
+                const qint64 block = (offset + i) / length;
+                signatures.weak[block] = rolling.hash(data + i);
+                signatures.strong[block] = strongHash(data + i, length);
+            }
+            report(Stage::Signature, chunk, signedLength);
+        }
+    });
+    if (stop.load()) {
+        result.canceled = true;
+        return result;
+    }
+    result.errorMessage = firstError(blockSegments);
+    if (!result.errorMessage.isEmpty()) {
+        return result;
+    }
+    signatures.buildTable();
+
+    // 2. 新文件各段分别滑动窗口；段的边界是块长的整数倍，两个文件相同的部分在各段内都能对齐
+    const qint64 windowCount = signatures.blocks > 0 ? qMax<qint64>(result.newSize - length + 1, 0) : 0;
+    QList<Segment> windowSegments = splitSegments(windowCount, length, threadCount);
+    processed.store(0);
+    report(Stage::Scan, 0, windowCount);
+    forEachSegment(windowSegments, threadCount, [&](Segment &segment) {
+        QFile file(newPath);
+        if (!file.open(QIODevice::ReadOnly) || !file.seek(segment.begin)) {
+            segment.errorMessage = QStringLiteral("新文件无法读取: %1").arg(file.errorString());
+            return;
+        }
+        // 段内最后一个窗口起点为 end - 1，需要读到 end - 1 + length
+        const qint64 readEnd = segment.end - 1 + length;
+        QByteArray buffer(kReadLength + length, Qt::Uninitialized);
+        quint8 *data = reinterpret_cast<quint8 *>(buffer.data());
+        qint64 bufferOffset = segment.begin;
+        qint64 bufferLength = 0;
+        qint64 reported = segment.begin;
+
+        qint64 pos = segment.begin;
+        qint64 preferred = -1;
+        bool fresh = true;
+        quint64 hash = 0;
+        while (pos < segment.end) {
+            // 保证缓冲区含有当前窗口以及滚动时移入的下一个字节
+            const qint64 need = qMin(pos + length + 1, readEnd);
+            if (need > bufferOffset + bufferLength) {
+                const qint64 keep = bufferOffset + bufferLength - pos;
+                std::memmove(data, data + (pos - bufferOffset), size_t(qMax<qint64>(keep, 0)));
+                bufferOffset = pos;
+                bufferLength = qMax<qint64>(keep, 0);
+                const qint64 chunk = qMin(qint64(buffer.size()) - bufferLength, readEnd - (bufferOffset + bufferLength));
+                if (!file.seek(bufferOffset + bufferLength)
+                    || file.read(reinterpret_cast<char *>(data) + bufferLength, chunk) != chunk) {
+                    segment.errorMessage = QStringLiteral("新文件读取失败: %1").arg(readError(file));
+                    return;
+                }
+                bufferLength += chunk;
+                report(Stage::Scan, pos - reported, windowCount);
+                reported = pos;
+                if (stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+
+            const quint8 *window = data + (pos - bufferOffset);
+            if (fresh) {
+                hash = rolling.hash(window);
+                fresh = false;
+            }
+            // 绝大多数窗口在位图这一步就被排除，在已读入的数据内连续滚动，不必逐字节检查是否需要补读
+            const quint8 *last = data + (qMin(segment.end, bufferOffset + bufferLength - length) - 1 - bufferOffset);
+            while (window < last && !signatures.mayContain(hash)) {
+                hash = rolling.roll(hash, window[0], window[length]);
+                ++window;
+            }
+            pos = bufferOffset + (window - data);
+
+            const qint64 block = signatures.find(hash, window, preferred);
+            if (block >= 0) {
+                segment.matches.append({pos, block});
+                preferred = block + 1;
+                pos += length;
+                fresh = true;
+                continue;
+            }
+            if (pos + 1 >= segment.end) {
+                break;
+            }
+            hash = rolling.roll(hash, window[0], window[length]);
+            ++pos;
+        }
+        report(Stage::Scan, segment.end - reported, windowCount);
+    });
+    if (stop.load()) {
+        result.canceled = true;
+        return result;
+    }
+    result.errorMessage = firstError(windowSegments);
+    if (!result.errorMessage.isEmpty()) {
+        return result;
+    }
+
+    // 各段的匹配按新文件偏移首尾相接；跨段重叠时保留靠前的一个，
+    // 再把新旧两边都连续的匹配合并为一段，首尾各加一个空的哨兵
+    QList<Range> runs;
+    runs.append({Kind::Match, 0, 0, 0, 0});
+    qint64 matchedEnd = 0;
+    for (const Segment &segment : std::as_const(windowSegments)) {
+        for (const Match &match : segment.matches) {
+            if (match.newOffset < matchedEnd) {
+                continue;
+            }
+            const qint64 oldOffset = match.block * length;
+            Range &last = runs.last();
+            if (last.newOffset + last.newLength == match.newOffset && last.oldOffset + last.oldLength == oldOffset) {
+                last.oldLength += length;
+                last.newLength += length;
+            } else {
+                runs.append({Kind::Match, oldOffset, length, match.newOffset, length});
+            }
+            matchedEnd = match.newOffset + length;
+        }
+    }
+    runs.append({Kind::Match, result.oldSize, 0, result.newSize, 0});
+
+    // 3. 匹配之间的空隙先向两端逐字节收窄（不足一块的差异因此能精确到字节），剩余部分归类
+    for (qsizetype i = 1; i < runs.size(); ++i) {
+        Range &previous = runs[i - 1];
+        Range &next = runs[i];
+        const qint64 oldEnd = previous.oldOffset + previous.oldLength;
+        const qint64 newEnd = previous.newOffset + previous.newLength;
+        const qint64 newGap = next.newOffset - newEnd;
+        // 旧文件中前后两段的顺序颠倒时，空隙在旧文件里没有对应的范围
+        const bool ordered = next.oldOffset >= oldEnd;
+        const qint64 oldGap = ordered ? next.oldOffset - oldEnd : 0;
+
+        bool ok = true;
+        const qint64 forward = commonLength(oldFile, oldEnd, newFile, newEnd,
+                                            std::min<qint64>({newGap, length, ordered ? oldGap : result.oldSize - oldEnd}),
+                                            false, &ok);
+        previous.oldLength += forward;
+        previous.newLength += forward;
+        const qint64 backward = commonLength(oldFile, next.oldOffset, newFile, next.newOffset,
+                                             std::min<qint64>({newGap - forward, length,
+                                                               ordered ? oldGap - forward : next.oldOffset}),
+                                             true, &ok);
+        next.oldOffset -= backward;
+        next.oldLength += backward;
+        next.newOffset -= backward;
+        next.newLength += backward;
+        if (!ok) {
+            result.errorMessage = QStringLiteral("文件读取失败: %1")
+                                      .arg(oldFile.error() != QFileDevice::NoError ? readError(oldFile)
+                                                                                   : readError(newFile));
+            return result;
+        }
+    }
+
+    // 旧文件中被某段匹配引用过的范围，按起点排序并合并。空隙在旧文件中的对应范围若已被别处引用，
+    // 说明那段数据只是挪了位置，不算修改或删除
+    QList<QPair<qint64, qint64>> covered;
+    for (const Range &run : std::as_const(runs)) {
+        if (run.oldLength > 0) {
+            covered.append({run.oldOffset, run.oldOffset + run.oldLength});
+        }
+    }
+    std::sort(covered.begin(), covered.end());
+    QList<QPair<qint64, qint64>> merged;
+    for (const QPair<qint64, qint64> &interval : std::as_const(covered)) {
+        if (!merged.isEmpty() && interval.first <= merged.last().second) {
+            merged.last().second = qMax(merged.last().second, interval.second);
+        } else {
+            merged.append(interval);
+        }
+    }
+    const auto isCovered = [&merged](qint64 begin, qint64 end) {
+        const auto it = std::upper_bound(merged.begin(), merged.end(), begin,
+                                         [](qint64 value, const QPair<qint64, qint64> &interval) {
+                                             return value < interval.second;
+                                         });
+        return it != merged.end() && it->first < end;
+    };
+
+    for (qsizetype i = 0; i < runs.size(); ++i) {
+        const Range &run = runs.at(i);
+        if (run.newLength > 0) {
+            if (!result.ranges.isEmpty() && result.ranges.last().kind == Kind::Match
+                && result.ranges.last().oldOffset + result.ranges.last().oldLength == run.oldOffset
+                && result.ranges.last().newOffset + result.ranges.last().newLength == run.newOffset) {
+                result.ranges.last().oldLength += run.oldLength;
+                result.ranges.last().newLength += run.newLength;
+            } else {
+                result.ranges.append(run);
+            }
+            result.matchedBytes += run.newLength;
+        }
+        if (i + 1 == runs.size()) {
+            break;
+        }
+
+        const Range &next = runs.at(i + 1);
+        const qint64 oldEnd = run.oldOffset + run.oldLength;
+        const qint64 newEnd = run.newOffset + run.newLength;
+        const qint64 newGap = next.newOffset - newEnd;
+        const qint64 oldGap = next.oldOffset > oldEnd && !isCovered(oldEnd, next.oldOffset) ? next.oldOffset - oldEnd : 0;
+        Range gap;
+        gap.oldOffset = oldEnd;
+        gap.oldLength = oldGap;
+        gap.newOffset = newEnd;
+        gap.newLength = newGap;
+        if (newGap > 0 && oldGap > 0) {
+            gap.kind = Kind::Changed;
+            result.changedBytes += newGap;
+        } else if (newGap > 0) {
+            gap.kind = Kind::Inserted;
+            result.insertedBytes += newGap;
+        } else if (oldGap > 0) {
+            gap.kind = Kind::Deleted;
+            result.deletedBytes += oldGap;
+        } else {
+            continue;
+        }
+        result.ranges.append(gap);
+    }
+
+    result.success = true;
+    return result;
+}
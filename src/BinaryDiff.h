@@ -0,0 +1,71 @@
+#ifndef BINARYDIFF_H
+#define BINARYDIFF_H
+
+#include <QList>
+#include <QString>
+
+#include <functional>
+
+// 两个大文件的块级比较，做法与 rsync 相同：
+//   1. 把旧文件切成固定大小的块，记录每块的滚动哈希与 XXH3-128；
+//   2. 在新文件上逐字节滑动同样长度的窗口，滚动哈希命中后再用 XXH3-128 确认，确认后跳过整块；
+//   3. 相邻匹配之间的空隙向两端逐字节比较收窄，剩下的部分按新旧长度分为修改、插入与删除。
+// 两步都把文件分段交给独立线程池并行读取，耗时与文件大小成线性关系；
+// 内存只与旧文件的块数有关（每块约 50 字节），块数超过 kMaxBlocks 时自动增大块长。
+class BinaryDiff
+{
+public:
+    static constexpr int kMinBlockSize = 4096;
+    static constexpr int kMaxBlockSize = 16 * 1024 * 1024;
+    static constexpr qint64 kMaxBlocks = 1 << 20;
+
+    enum class Kind {
+        // 新旧文件中内容相同；旧文件偏移不连续时表示这段数据被移动过
+        Match,
+        // 新旧文件都有数据但内容不同，两边长度可以不同
+        Changed,
+        // 只在新文件中出现，oldOffset 为插入位置
+        Inserted,
+        // 只在旧文件中出现，newOffset 为删除位置
+        Deleted,
+    };
+
+    struct Range {
+        Kind kind = Kind::Match;
+        qint64 oldOffset = 0;
+        qint64 oldLength = 0;
+        qint64 newOffset = 0;
+        qint64 newLength = 0;
+    };
+
+    struct Result {
+        bool success = false;
+        bool canceled = false;
+        QString errorMessage;
+        int blockSize = 0;
+        qint64 oldSize = 0;
+        qint64 newSize = 0;
+        // 按新文件偏移排列，Deleted 排在其删除位置处
+        QList<Range> ranges;
+        // 以新文件计的相同、修改、插入字节数，以及旧文件中被删除的字节数
+        qint64 matchedBytes = 0;
+        qint64 changedBytes = 0;
+        qint64 insertedBytes = 0;
+        qint64 deletedBytes = 0;
+    };
+
+    enum class Stage { Signature, Scan };
+
+    // 每读完一段调用一次，processed / total 为本步骤的字节数，可能来自不同的工作线程；返回 false 时取消
+    using ProgressFunction = std::function<bool(Stage stage, qint64 processed, qint64 total)>;
+
+    // 旧文件大小对应的默认块长：不小于 kMinBlockSize 的 2 的幂，且块数不超过 kMaxBlocks
+    static int defaultBlockSize(qint64 oldSize);
+
+    // blockSize 为 0 时使用 defaultBlockSize，否则限制在 64 到 kMaxBlockSize 之间；
+    // threadCount 就是同时读取的文件段数，机械硬盘上应设为 1
+    static Result compare(const QString &oldPath, const QString &newPath, int threadCount, int blockSize = 0,
+                          const ProgressFunction &progress = ProgressFunction());
+};
+
+#endif // BINARYDIFF_H
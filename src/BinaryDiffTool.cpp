@@ -0,0 +1,305 @@
+#include "BinaryDiffTool.h"
+
+#include <QFileInfo>
+#include <QThread>
+#include <QVariantMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+// 同时读取的文件段数上限
+constexpr int kMaxThreadCount = 8;
+// 每一步的进度按千分比计
+constexpr int kProgressScale = 1000;
+
+QString kindName(BinaryDiff::Kind kind)
+{
+    switch (kind) {
+    case BinaryDiff::Kind::Changed:
+        return QStringLiteral("changed");
+    case BinaryDiff::Kind::Inserted:
+        return QStringLiteral("inserted");
+    case BinaryDiff::Kind::Deleted:
+        return QStringLiteral("deleted");
+    default:
+        return QStringLiteral("match");
+    }
+}
+
+QString hexOffset(qint64 offset)
+{
+    return QStringLiteral("0x%1").arg(offset, 8, 16, QLatin1Char('0'));
+}
+
+}
+
+BinaryDiffTool::BinaryDiffTool(QObject *parent)
+    : QObject(parent)
+    , m_blockSize(0)
+    , m_threadCount(qBound(1, QThread::idealThreadCount(), 4))
+    , m_progress(0)
+    , m_stage(std::make_shared<std::atomic<int>>(0))
+    , m_watcher(new QFutureWatcher<BinaryDiff::Result>(this))
+{
+    connect(m_watcher, &QFutureWatcher<BinaryDiff::Result>::progressValueChanged,
+            this, &BinaryDiffTool::onProgressValueChanged);
+    connect(m_watcher, &QFutureWatcher<BinaryDiff::Result>::finished, this, &BinaryDiffTool::onFinished);
+}
+
+BinaryDiffTool::~BinaryDiffTool()
+{
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+}
+
+QString BinaryDiffTool::oldPath() const
+{
+    return m_oldPath;
+}
+
+void BinaryDiffTool::setOldPath(const QString &oldPath)
+{
+    if (m_oldPath != oldPath) {
+        m_oldPath = oldPath;
+        emit oldPathChanged();
+    }
+}
+
+QString BinaryDiffTool::newPath() const
+{
+    return m_newPath;
+}
+
+void BinaryDiffTool::setNewPath(const QString &newPath)
+{
+    if (m_newPath != newPath) {
+        m_newPath = newPath;
+        emit newPathChanged();
+    }
+}
+
+int BinaryDiffTool::blockSize() const
+{
+    return m_blockSize;
+}
+
+void BinaryDiffTool::setBlockSize(int blockSize)
+{
+    blockSize = qBound(0, blockSize, BinaryDiff::kMaxBlockSize);
+    if (m_blockSize != blockSize) {
+        m_blockSize = blockSize;
+        emit blockSizeChanged();
+    }
+}
+
+int BinaryDiffTool::threadCount() const
+{
+    return m_threadCount;
+}
+
+void BinaryDiffTool::setThreadCount(int threadCount)
+{
+    threadCount = qBound(1, threadCount, kMaxThreadCount);
+    if (m_threadCount != threadCount) {
+        m_threadCount = threadCount;
+        emit threadCountChanged();
+    }
+}
+
+bool BinaryDiffTool::running() const
+{
+    return m_watcher->isRunning();
+}
+
+int BinaryDiffTool::stage() const
+{
+    return m_stage->load();
+}
+
+int BinaryDiffTool::progress() const
+{
+    return m_progress;
+}
+
+QVariantList BinaryDiffTool::ranges() const
+{
+    QVariantList ranges;
+    const qsizetype count = qMin<qsizetype>(m_differences.size(), kMaxListedRanges);
+    ranges.reserve(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        const BinaryDiff::Range &range = m_differences.at(i);
+        QVariantMap item;
+        item.insert("kind", kindName(range.kind));
+        item.insert("oldOffset", range.oldOffset);
+        item.insert("oldLength", range.oldLength);
+        item.insert("newOffset", range.newOffset);
+        item.insert("newLength", range.newLength);
+        ranges.append(item);
+    }
+    return ranges;
+}
+
+int BinaryDiffTool::differenceCount() const
+{
+    return int(m_differences.size());
+}
+
+int BinaryDiffTool::usedBlockSize() const
+{
+    return m_result.blockSize;
+}
+
+qint64 BinaryDiffTool::matchedBytes() const
+{
+    return m_result.matchedBytes;
+}
+
+qint64 BinaryDiffTool::changedBytes() const
+{
+    return m_result.changedBytes;
+}
+
+qint64 BinaryDiffTool::insertedBytes() const
+{
+    return m_result.insertedBytes;
+}
+
+qint64 BinaryDiffTool::deletedBytes() const
+{
+    return m_result.deletedBytes;
+}
+
+QString BinaryDiffTool::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+void BinaryDiffTool::compare()
+{
+    if (m_oldPath.trimmed().isEmpty() || !QFileInfo(m_oldPath).isFile()) {
+        setStatusMessage("旧文件不存在");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+    if (m_newPath.trimmed().isEmpty() || !QFileInfo(m_newPath).isFile()) {
+        setStatusMessage("新文件不存在");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+
+    const QString oldPath = m_oldPath;
+    const QString newPath = m_newPath;
+    const int blockSize = m_blockSize;
+    const int threads = m_threadCount;
+
+    // 上一次任务被取消后可能仍在收尾，换一个新的步骤计数，不与它共用
+    m_watcher->cancel();
+    m_stage = std::make_shared<std::atomic<int>>(0);
+    const std::shared_ptr<std::atomic<int>> stage = m_stage;
+    m_progress = 0;
+    m_result = BinaryDiff::Result();
+    m_differences.clear();
+    emit resultChanged();
+    emit progressChanged();
+    setStatusMessage("正在比较...");
+
+    m_watcher->setFuture(QtConcurrent::run([oldPath, newPath, blockSize, threads, stage](QPromise<BinaryDiff::Result> &promise) {
+        // QPromise 的进度只能增大，第 i 步占 [i * kProgressScale, (i + 1) * kProgressScale]
+        promise.setProgressRange(0, kProgressScale);
+        const BinaryDiff::Result result = BinaryDiff::compare(
+            oldPath, newPath, threads, blockSize,
+            [&](BinaryDiff::Stage current, qint64 processed, qint64 total) {
+                const int offset = int(current) * kProgressScale;
+                if (int(current) != stage->load()) {
+                    stage->store(int(current));
+                    promise.setProgressRange(offset, offset + kProgressScale);
+                }
+                if (total > 0) {
+                    promise.setProgressValue(offset + int(processed * kProgressScale / total));
+                }
+                return !promise.isCanceled();
+            });
+        if (result.canceled || promise.isCanceled()) {
+            return;
+        }
+        promise.addResult(result);
+    }));
+    emit runningChanged();
+}
+
+void BinaryDiffTool::cancel()
+{
+    m_watcher->cancel();
+}
+
+QString BinaryDiffTool::report() const
+{
+    QString text;
+    for (const BinaryDiff::Range &range : m_differences) {
+        QString kind;
+        switch (range.kind) {
+        case BinaryDiff::Kind::Changed:
+            kind = QStringLiteral("修改");
+            break;
+        case BinaryDiff::Kind::Inserted:
+            kind = QStringLiteral("插入");
+            break;
+        default:
+            kind = QStringLiteral("删除");
+            break;
+        }
+        text += QStringLiteral("%1  旧 %2 +%3  新 %4 +%5\n")
+                    .arg(kind, hexOffset(range.oldOffset))
+                    .arg(range.oldLength)
+                    .arg(hexOffset(range.newOffset))
+                    .arg(range.newLength);
+    }
+    return text;
+}
+
+void BinaryDiffTool::onProgressValueChanged(int value)
+{
+    m_progress = qBound(0, value - m_watcher->progressMinimum(), kProgressScale);
+    emit progressChanged();
+}
+
+void BinaryDiffTool::onFinished()
+{
+    BinaryDiff::Result result;
+    result.errorMessage = QStringLiteral("已取消");
+    if (!m_watcher->isCanceled() && m_watcher->future().resultCount() > 0) {
+        result = m_watcher->result();
+    }
+
+    m_result = result;
+    m_differences.clear();
+    for (const BinaryDiff::Range &range : std::as_const(result.ranges)) {
+        if (range.kind != BinaryDiff::Kind::Match) {
+            m_differences.append(range);
+        }
+    }
+
+    QString message = result.errorMessage;
+    if (result.success) {
+        if (!m_differences.isEmpty()) {
+            message = QStringLiteral("找到 %1 处不同，块长 %2 字节").arg(m_differences.size()).arg(result.blockSize);
+        } else if (result.ranges.size() <= 1) {
+            message = QStringLiteral("两个文件内容相同");
+        } else {
+            message = QStringLiteral("没有修改或新增的数据，只是数据块的位置不同");
+        }
+    }
+    emit resultChanged();
+    emit progressChanged();
+    setStatusMessage(message);
+    emit finished(result.success, message);
+    emit runningChanged();
+}
+
+void BinaryDiffTool::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
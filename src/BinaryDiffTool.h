@@ -0,0 +1,107 @@
+#ifndef BINARYDIFFTOOL_H
+#define BINARYDIFFTOOL_H
+
+#include "BinaryDiff.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QVariantList>
+
+#include <atomic>
+#include <memory>
+
+// 二进制文件比较：按块比较两个大文件（固件、磁盘镜像等），列出相同、修改、插入与删除的字节范围。
+// 比较在线程池中进行，界面线程只接收进度与结果。
+class BinaryDiffTool : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString oldPath READ oldPath WRITE setOldPath NOTIFY oldPathChanged)
+    Q_PROPERTY(QString newPath READ newPath WRITE setNewPath NOTIFY newPathChanged)
+    // 0 表示按旧文件大小自动选择
+    Q_PROPERTY(int blockSize READ blockSize WRITE setBlockSize NOTIFY blockSizeChanged)
+    // 同时读取的文件段数，文件在机械硬盘上时设为 1 可避免磁头来回寻道
+    Q_PROPERTY(int threadCount READ threadCount WRITE setThreadCount NOTIFY threadCountChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    // 0 计算旧文件的块签名，1 扫描新文件
+    Q_PROPERTY(int stage READ stage NOTIFY progressChanged)
+    // 当前步骤的千分比
+    Q_PROPERTY(int progress READ progress NOTIFY progressChanged)
+    // 不同的范围（修改、插入、删除），每项为 { kind, oldOffset, oldLength, newOffset, newLength }，最多 kMaxListedRanges 项
+    Q_PROPERTY(QVariantList ranges READ ranges NOTIFY resultChanged)
+    Q_PROPERTY(int differenceCount READ differenceCount NOTIFY resultChanged)
+    Q_PROPERTY(int usedBlockSize READ usedBlockSize NOTIFY resultChanged)
+    Q_PROPERTY(qint64 matchedBytes READ matchedBytes NOTIFY resultChanged)
+    Q_PROPERTY(qint64 changedBytes READ changedBytes NOTIFY resultChanged)
+    Q_PROPERTY(qint64 insertedBytes READ insertedBytes NOTIFY resultChanged)
+    Q_PROPERTY(qint64 deletedBytes READ deletedBytes NOTIFY resultChanged)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    // 界面列表只显示前这么多项，完整结果用 report() 取得
+    static constexpr int kMaxListedRanges = 1000;
+
+    explicit BinaryDiffTool(QObject *parent = nullptr);
+    ~BinaryDiffTool() override;
+
+    QString oldPath() const;
+    void setOldPath(const QString &oldPath);
+
+    QString newPath() const;
+    void setNewPath(const QString &newPath);
+
+    int blockSize() const;
+    void setBlockSize(int blockSize);
+
+    int threadCount() const;
+    void setThreadCount(int threadCount);
+
+    bool running() const;
+    int stage() const;
+    int progress() const;
+    QVariantList ranges() const;
+    int differenceCount() const;
+    int usedBlockSize() const;
+    qint64 matchedBytes() const;
+    qint64 changedBytes() const;
+    qint64 insertedBytes() const;
+    qint64 deletedBytes() const;
+    QString statusMessage() const;
+
+    Q_INVOKABLE void compare();
+    Q_INVOKABLE void cancel();
+    // 全部不同范围的纯文本形式，每行一项，偏移为十六进制
+    Q_INVOKABLE QString report() const;
+
+signals:
+    void oldPathChanged();
+    void newPathChanged();
+    void blockSizeChanged();
+    void threadCountChanged();
+    void runningChanged();
+    void progressChanged();
+    void resultChanged();
+    void statusMessageChanged();
+    void finished(bool success, const QString &message);
+
+private:
+    void onProgressValueChanged(int value);
+    void onFinished();
+    void setStatusMessage(const QString &message);
+
+    QString m_oldPath;
+    QString m_newPath;
+    int m_blockSize;
+    int m_threadCount;
+    QString m_statusMessage;
+    int m_progress;
+    BinaryDiff::Result m_result;
+    // 只含不同的范围
+    QList<BinaryDiff::Range> m_differences;
+
+    // 工作线程写入当前步骤，上一次任务可能尚未结束，因此每次任务单独创建
+    std::shared_ptr<std::atomic<int>> m_stage;
+    QFutureWatcher<BinaryDiff::Result> *m_watcher;
+};
+
+#endif // BINARYDIFFTOOL_H
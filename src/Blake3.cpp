@@ -0,0 +1,405 @@
+#include "Blake3.h"
+#include "CpuFeatures.h"
+
+#include <QtAlgorithms>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtEndian>
+
+#include <cstring>
+#include <vector>
+
+const quint32 Blake3Hw::kIv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// 第 r 轮使用的消息字顺序，即把固定排列连续作用 r 次
+const quint8 Blake3Hw::kMessageSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+namespace {
+
+// 线程池中每片至少这么长，最多拆成 kMaxLeaves 片
+constexpr qsizetype kMinLeafLength = 64 * 1024;
+constexpr int kMaxLeaves = 64;
+
+inline quint32 rotateRight(quint32 x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+inline void mix(quint32 *v, int a, int b, int c, int d, quint32 x, quint32 y)
+{
+    v[a] = v[a] + v[b] + x;
+    v[d] = rotateRight(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotateRight(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + y;
+    v[d] = rotateRight(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = rotateRight(v[b] ^ v[c], 7);
+}
+
+// 压缩一个分组，cv 原地更新为新的链值（即完整输出的前 8 个字）
+void compress(quint32 *cv, const quint8 *block, int blockLength, quint64 counter, quint8 flags)
+{
+    quint32 m[16];
+    for (int i = 0; i < 16; ++i) {
+        m[i] = qFromLittleEndian<quint32>(block + i * 4);
+    }
+
+    quint32 v[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        Blake3Hw::kIv[0], Blake3Hw::kIv[1], Blake3Hw::kIv[2], Blake3Hw::kIv[3],
+        quint32(counter), quint32(counter >> 32), quint32(blockLength), flags,
+    };
+    for (const quint8 *s : Blake3Hw::kMessageSchedule) {
+        mix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        mix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        mix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        mix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        mix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        mix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        mix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        cv[i] = v[i] ^ v[i + 8];
+    }
+}
+
+void storeWords(const quint32 *words, quint8 *out)
+{
+    for (int i = 0; i < 8; ++i) {
+        qToLittleEndian(words[i], out + i * 4);
+    }
+}
+
+void hashLanesPortable(const quint8 *const *inputs, size_t blocks, const quint32 *key, quint64 counter,
+                       bool incrementCounter, quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out)
+{
+    Q_UNUSED(incrementCounter);
+    quint32 cv[8];
+    std::memcpy(cv, key, sizeof(cv));
+    for (size_t b = 0; b < blocks; ++b) {
+        const quint8 blockFlags = flags | (b == 0 ? flagsStart : 0) | (b + 1 == blocks ? flagsEnd : 0);
+        compress(cv, inputs[0] + b * Blake3::kBlockLength, Blake3::kBlockLength, counter, blockFlags);
+    }
+    storeWords(cv, out);
+}
+
+// 两个子节点链值拼成一个分组的父节点
+void parentChainingValue(const quint8 *left, const quint8 *right, quint8 *out)
+{
+    quint8 block[Blake3::kBlockLength];
+    std::memcpy(block, left, Blake3::kDigestLength);
+    std::memcpy(block + Blake3::kDigestLength, right, Blake3::kDigestLength);
+    quint32 cv[8];
+    std::memcpy(cv, Blake3Hw::kIv, sizeof(cv));
+    compress(cv, block, Blake3::kBlockLength, 0, Blake3::Parent);
+    storeWords(cv, out);
+}
+
+}
+
+void Blake3::ChunkState::reset(const quint32 *key, quint64 chunkCounter)
+{
+    std::memcpy(cv, key, sizeof(cv));
+    counter = chunkCounter;
+    std::memset(buffer, 0, sizeof(buffer));
+    bufferLength = 0;
+    blocksCompressed = 0;
+}
+
+qsizetype Blake3::ChunkState::length() const
+{
+    return qsizetype(blocksCompressed) * kBlockLength + bufferLength;
+}
+
+void Blake3::ChunkState::update(const quint8 *data, qsizetype length)
+{
+    while (length > 0) {
+        // 分块的最后一个分组要带 ChunkEnd，因此缓冲区满了也要等到有后续输入时才压缩
+        if (bufferLength == kBlockLength) {
+            compress(cv, buffer, kBlockLength, counter, blocksCompressed == 0 ? ChunkStart : 0);
+            ++blocksCompressed;
+            std::memset(buffer, 0, sizeof(buffer));
+            bufferLength = 0;
+        }
+        const qsizetype take = qMin<qsizetype>(kBlockLength - bufferLength, length);
+        std::memcpy(buffer + bufferLength, data, size_t(take));
+        bufferLength += int(take);
+        data += take;
+        length -= take;
+    }
+}
+
+const Blake3::Implementation &Blake3::portable()
+{
+    static const Implementation impl = {"Scalar", 1, hashLanesPortable};
+    return impl;
+}
+
+QList<const Blake3::Implementation *> Blake3::available()
+{
+    QList<const Implementation *> result{&portable()};
+#if defined(Q_PROCESSOR_X86)
+    // 16 / 8 位循环移位用 PSHUFB
+    static const Implementation ssse3 = {"SSSE3 x4", 4, Blake3Hw::hashLanesSsse3};
+    static const Implementation avx2 = {"AVX2 x8", 8, Blake3Hw::hashLanesAvx2};
+    if (CpuFeatures::hasSsse3()) {
+        result << &ssse3;
+        if (CpuFeatures::hasAvx2()) {
+            result << &avx2;
+        }
+    }
+#endif
+    return result;
+}
+
+const Blake3::Implementation &Blake3::active()
+{
+    static const Implementation *impl = available().constLast();
+    return *impl;
+}
+
+Blake3::Blake3(const Implementation &implementation)
+    : m_implementation(&implementation)
+    , m_parallel(true)
+{
+    reset();
+}
+
+void Blake3::reset()
+{
+    m_chunk.reset(Blake3Hw::kIv, 0);
+    m_stackSize = 0;
+}
+
+bool Blake3::isParallel() const
+{
+    return m_parallel;
+}
+
+void Blake3::setParallel(bool parallel)
+{
+    m_parallel = parallel;
+}
+
+void Blake3::hashMany(const quint8 *const *inputs, size_t count, size_t blocks, quint64 counter,
+                      bool incrementCounter, quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out) const
+{
+    const size_t lanes = size_t(m_implementation->lanes);
+    size_t i = 0;
+    for (; i + lanes <= count; i += lanes) {
+        m_implementation->hashLanes(inputs + i, blocks, Blake3Hw::kIv, counter + (incrementCounter ? i : 0),
+                                    incrementCounter, flags, flagsStart, flagsEnd, out + i * kDigestLength);
+    }
+    for (; i < count; ++i) {
+        hashLanesPortable(inputs + i, blocks, Blake3Hw::kIv, counter + (incrementCounter ? i : 0),
+                          incrementCounter, flags, flagsStart, flagsEnd, out + i * kDigestLength);
+    }
+}
+
+void Blake3::subtreeChainingValue(const quint8 *data, qsizetype length, quint64 chunkCounter, quint8 *cv) const
+{
+    // 先把所有分块并排压缩成链值，再逐层两两合并，每一层都走 SIMD 多通道
+    size_t count = size_t(length / kChunkLength);
+    std::vector<const quint8 *> inputs(count);
+    std::vector<quint8> current(count * kDigestLength);
+    std::vector<quint8> next(count / 2 * kDigestLength);
+    for (size_t i = 0; i < count; ++i) {
+        inputs[i] = data + i * kChunkLength;
+    }
+    hashMany(inputs.data(), count, kChunkLength / kBlockLength, chunkCounter, true, 0, ChunkStart, ChunkEnd,
+             current.data());
+
+    while (count > 1) {
+        count /= 2;
+        for (size_t i = 0; i < count; ++i) {
+            inputs[i] = current.data() + i * 2 * kDigestLength;
+        }
+        hashMany(inputs.data(), count, 1, 0, false, Parent, 0, 0, next.data());
+        current.swap(next);
+    }
+    std::memcpy(cv, current.data(), kDigestLength);
+}
+
+void Blake3::subtreeChildren(const quint8 *data, qsizetype length, quint64 chunkCounter, quint8 *cvs) const
+{
+    int leaves = 2;
+    if (m_parallel && length >= kParallelThreshold) {
+        while (leaves < kMaxLeaves && length / (leaves * 2) >= kMinLeafLength) {
+            leaves *= 2;
+        }
+    }
+    const qsizetype leafLength = length / leaves;
+    const quint64 leafChunks = quint64(leafLength / kChunkLength);
+
+    std::vector<quint8> current(size_t(leaves) * kDigestLength);
+    if (leaves > 2) {
+        QList<int> indices(leaves);
+        for (int i = 0; i < leaves; ++i) {
+            indices[i] = i;
+        }
+        // blockingMap 会让调用线程也参与处理，在线程池内部调用也不会死锁
+        QtConcurrent::blockingMap(indices, [&](const int &i) {
+            subtreeChainingValue(data + i * leafLength, leafLength, chunkCounter + quint64(i) * leafChunks,
+                                 current.data() + i * kDigestLength);
+        });
+    } else {
+        subtreeChainingValue(data, leafLength, chunkCounter, current.data());
+        subtreeChainingValue(data + leafLength, leafLength, chunkCounter + leafChunks,
+                             current.data() + kDigestLength);
+    }
+
+    // 合并到只剩左右两个子节点：整棵子树可能就是根，根节点要等 result() 时带上 Root 标志压缩
+    std::vector<const quint8 *> inputs(size_t(leaves) / 2);
+    std::vector<quint8> next(size_t(leaves) / 2 * kDigestLength);
+    for (size_t count = size_t(leaves) / 2; count >= 2; count /= 2) {
+        for (size_t i = 0; i < count; ++i) {
+            inputs[i] = current.data() + i * 2 * kDigestLength;
+        }
+        hashMany(inputs.data(), count, 1, 0, false, Parent, 0, 0, next.data());
+        current.swap(next);
+    }
+    std::memcpy(cvs, current.data(), 2 * kDigestLength);
+}
+
+void Blake3::mergeStack(quint64 totalChunks)
+{
+    // 已处理 n 个分块时，右边缘上的完整子树个数就是 n 的二进制中 1 的个数
+    const int remaining = qPopulationCount(totalChunks);
+    while (m_stackSize > remaining) {
+        --m_stackSize;
+        parentChainingValue(m_stack[m_stackSize - 1], m_stack[m_stackSize], m_stack[m_stackSize - 1]);
+    }
+}
+
+void Blake3::pushChainingValue(const quint8 *cv, quint64 chunkCounter)
+{
+    mergeStack(chunkCounter);
+    std::memcpy(m_stack[m_stackSize], cv, kDigestLength);
+    ++m_stackSize;
+}
+
+void Blake3::addData(const char *data, qsizetype length)
+{
+    const quint8 *input = reinterpret_cast<const quint8 *>(data);
+
+    // 先补满上一次留下的不完整分块；之后还有输入，说明它不是根，可以结束它
+    if (m_chunk.length() > 0) {
+        const qsizetype take = qMin(kChunkLength - m_chunk.length(), length);
+        m_chunk.update(input, take);
+        input += take;
+        length -= take;
+        if (length == 0) {
+            return;
+        }
+        quint32 cv[8];
+        std::memcpy(cv, m_chunk.cv, sizeof(cv));
+        compress(cv, m_chunk.buffer, m_chunk.bufferLength, m_chunk.counter,
+                 (m_chunk.blocksCompressed == 0 ? ChunkStart : 0) | ChunkEnd);
+        quint8 bytes[kDigestLength];
+        storeWords(cv, bytes);
+        pushChainingValue(bytes, m_chunk.counter);
+        m_chunk.reset(Blake3Hw::kIv, m_chunk.counter + 1);
+    }
+
+    // 剩余输入多于一个分块时，每次取能整除已处理分块数的最大 2^k 个分块作为一棵完整子树；
+    // 调用方每次都传入同样的 2^k 长度时（如 FileDigest 的 4 MiB 读缓冲区），每次就是整段输入
+    while (length > kChunkLength) {
+        qsizetype subtreeLength = qsizetype(1) << (63 - qCountLeadingZeroBits(quint64(length)));
+        const quint64 processed = m_chunk.counter * kChunkLength;
+        while ((quint64(subtreeLength) - 1) & processed) {
+            subtreeLength /= 2;
+        }
+        const quint64 subtreeChunks = quint64(subtreeLength / kChunkLength);
+
+        if (subtreeLength == kChunkLength) {
+            quint8 cv[kDigestLength];
+            hashMany(&input, 1, kChunkLength / kBlockLength, m_chunk.counter, true, 0, ChunkStart, ChunkEnd, cv);
+            pushChainingValue(cv, m_chunk.counter);
+        } else {
+            // 只压入左右两个子节点，栈惰性合并，保证不会提前把根节点当作普通父节点压缩
+            quint8 cvs[2 * kDigestLength];
+            subtreeChildren(input, subtreeLength, m_chunk.counter, cvs);
+            pushChainingValue(cvs, m_chunk.counter);
+            pushChainingValue(cvs + kDigestLength, m_chunk.counter + subtreeChunks / 2);
+        }
+        m_chunk.counter += subtreeChunks;
+        input += subtreeLength;
+        length -= subtreeLength;
+    }
+
+    if (length > 0) {
+        m_chunk.update(input, length);
+        // 后面还有这块数据，栈里的节点都不会是根，可以提前合并
+        mergeStack(m_chunk.counter);
+    }
+}
+
+void Blake3::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+void Blake3::result(quint8 *digest) const
+{
+    // 根节点的输入：链值、分组、分组长度、标志
+    quint32 cv[8];
+    quint8 block[kBlockLength];
+    int blockLength;
+    quint8 flags;
+
+    int remaining = m_stackSize;
+    if (remaining == 0 || m_chunk.length() > 0) {
+        std::memcpy(cv, m_chunk.cv, sizeof(cv));
+        std::memcpy(block, m_chunk.buffer, kBlockLength);
+        blockLength = m_chunk.bufferLength;
+        flags = (m_chunk.blocksCompressed == 0 ? ChunkStart : 0) | ChunkEnd;
+    } else {
+        // 输入恰好结束在分块边界时栈里至少有两个链值
+        std::memcpy(cv, Blake3Hw::kIv, sizeof(cv));
+        std::memcpy(block, m_stack[remaining - 2], kDigestLength);
+        std::memcpy(block + kDigestLength, m_stack[remaining - 1], kDigestLength);
+        blockLength = kBlockLength;
+        flags = Parent;
+        remaining -= 2;
+    }
+
+    // 自右向左把栈里剩下的链值逐个并入
+    while (remaining > 0) {
+        const quint64 counter = flags & Parent ? 0 : m_chunk.counter;
+        compress(cv, block, blockLength, counter, flags);
+        std::memcpy(block, m_stack[remaining - 1], kDigestLength);
+        storeWords(cv, block + kDigestLength);
+        std::memcpy(cv, Blake3Hw::kIv, sizeof(cv));
+        blockLength = kBlockLength;
+        flags = Parent;
+        --remaining;
+    }
+
+    compress(cv, block, blockLength, 0, flags | Root);
+    storeWords(cv, digest);
+}
+
+QByteArray Blake3::result() const
+{
+    QByteArray digest(kDigestLength, Qt::Uninitialized);
+    result(reinterpret_cast<quint8 *>(digest.data()));
+    return digest;
+}
+
+QByteArray Blake3::hash(const QByteArray &data)
+{
+    Blake3 blake3;
+    blake3.addData(data);
+    return blake3.result();
+}
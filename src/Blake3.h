@@ -0,0 +1,110 @@
+#ifndef BLAKE3_H
+#define BLAKE3_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtGlobal>
+
+#include <cstddef>
+
+// BLAKE3 哈希（32 字节输出），接口与 SM3 / QCryptographicHash 相同，可多次 addData 分段输入。
+// 消息按 1 KiB 分块组成 Merkle 树：一次输入的数据够大时，整棵子树的分块同时放进 SIMD 寄存器的
+// 各个通道压缩（SSSE3 每次 4 块，AVX2 每次 8 块），更大的子树再拆成若干片交给全局线程池并行计算。
+class Blake3
+{
+public:
+    static constexpr int kDigestLength = 32;
+    static constexpr int kBlockLength = 64;
+    static constexpr int kChunkLength = 1024;
+    // 子树至少这么大才拆给多个线程，更小时线程调度的开销大于收益
+    static constexpr qsizetype kParallelThreshold = 256 * 1024;
+
+    enum Flag : quint8 {
+        ChunkStart = 1,
+        ChunkEnd = 2,
+        Parent = 4,
+        Root = 8,
+    };
+
+    // 同时压缩 lanes 个输入，每个输入依次经过 blocks 个 64 字节分组，输出各自的 32 字节链值。
+    // 第 i 个输入的计数器为 counter + i（incrementCounter 为 false 时都为 counter）；
+    // 第一个分组额外带 flagsStart，最后一个分组额外带 flagsEnd
+    using HashLanesFunction = void (*)(const quint8 *const *inputs, size_t blocks, const quint32 *key,
+                                       quint64 counter, bool incrementCounter, quint8 flags,
+                                       quint8 flagsStart, quint8 flagsEnd, quint8 *out);
+
+    struct Implementation {
+        const char *name;
+        int lanes;
+        HashLanesFunction hashLanes;
+    };
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active();
+    static const Implementation &portable();
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available();
+
+    explicit Blake3(const Implementation &implementation = active());
+
+    void reset();
+    void addData(const char *data, qsizetype length);
+    void addData(const QByteArray &data);
+
+    // 输出 32 字节摘要；不改变内部状态，可以继续 addData
+    void result(quint8 *digest) const;
+    QByteArray result() const;
+
+    // 是否把大的子树拆给全局线程池，默认开启；在线程池任务中调用也不会死锁
+    bool isParallel() const;
+    void setParallel(bool parallel);
+
+    static QByteArray hash(const QByteArray &data);
+
+private:
+    // 1 KiB 分块内的增量状态
+    struct ChunkState {
+        quint32 cv[8];
+        quint64 counter;
+        quint8 buffer[kBlockLength];
+        int bufferLength;
+        int blocksCompressed;
+
+        void reset(const quint32 *key, quint64 chunkCounter);
+        qsizetype length() const;
+        void update(const quint8 *data, qsizetype length);
+    };
+
+    // 任意数量输入的 hashLanes，不足一组的尾部用可移植实现
+    void hashMany(const quint8 *const *inputs, size_t count, size_t blocks, quint64 counter, bool incrementCounter,
+                  quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out) const;
+    // length 为分块长度的 2^k 倍，输出整棵子树的链值
+    void subtreeChainingValue(const quint8 *data, qsizetype length, quint64 chunkCounter, quint8 *cv) const;
+    // length 为分块长度的 2^k 倍（k >= 1），输出左右两棵半子树的链值，共 64 字节
+    void subtreeChildren(const quint8 *data, qsizetype length, quint64 chunkCounter, quint8 *cvs) const;
+    void mergeStack(quint64 totalChunks);
+    void pushChainingValue(const quint8 *cv, quint64 chunkCounter);
+
+    const Implementation *m_implementation;
+    bool m_parallel;
+    ChunkState m_chunk;
+    // 树右边缘尚未合并的链值，深度不超过 54（2^64 字节 / 1 KiB 分块）
+    quint8 m_stack[54][kDigestLength];
+    int m_stackSize;
+};
+
+// 初始向量与每轮的消息字排列，可移植实现与 SIMD 实现共用
+namespace Blake3Hw {
+extern const quint32 kIv[8];
+extern const quint8 kMessageSchedule[7][16];
+
+// SIMD 实现位于 Blake3_x86.cpp / Blake3_avx2.cpp，这两个文件使用单独的编译选项
+#if defined(Q_PROCESSOR_X86)
+void hashLanesSsse3(const quint8 *const *inputs, size_t blocks, const quint32 *key, quint64 counter,
+                    bool incrementCounter, quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out);
+void hashLanesAvx2(const quint8 *const *inputs, size_t blocks, const quint32 *key, quint64 counter,
+                   bool incrementCounter, quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out);
+#endif
+}
+
+#endif // BLAKE3_H
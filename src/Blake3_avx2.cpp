@@ -0,0 +1,143 @@
+#include "Blake3.h"
+
+// AVX2 实现。GCC/Clang 下本文件以 -mavx2 单独编译，只有 CpuFeatures 检测到 SSSE3 与 AVX2 时才会被调用。
+// 与 Blake3_x86.cpp 的算法相同，寄存器加宽到 256 位，每次同时压缩 8 个输入。
+#if defined(Q_PROCESSOR_X86)
+
+#include <immintrin.h>
+
+namespace {
+
+constexpr int kLanes = 8;
+
+inline __m256i add(__m256i a, __m256i b)
+{
+    return _mm256_add_epi32(a, b);
+}
+
+inline __m256i rotateRight16(__m256i x)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+inline __m256i rotateRight8(__m256i x)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12));
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+template <int N>
+inline __m256i rotateRight(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+inline void mix(__m256i *v, int a, int b, int c, int d, __m256i x, __m256i y)
+{
+    v[a] = add(add(v[a], v[b]), x);
+    v[d] = rotateRight16(_mm256_xor_si256(v[d], v[a]));
+    v[c] = add(v[c], v[d]);
+    v[b] = rotateRight<12>(_mm256_xor_si256(v[b], v[c]));
+    v[a] = add(add(v[a], v[b]), y);
+    v[d] = rotateRight8(_mm256_xor_si256(v[d], v[a]));
+    v[c] = add(v[c], v[d]);
+    v[b] = rotateRight<7>(_mm256_xor_si256(v[b], v[c]));
+}
+
+// 8x8 的 32 位字转置：输入第 k 行是第 k 个通道的 8 个字，输出第 j 行是各通道的第 j 个字，反之亦然
+inline void transpose(__m256i *r)
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+inline void loadMessage(const quint8 *const *inputs, size_t offset, __m256i *m)
+{
+    for (int half = 0; half < 2; ++half) {
+        for (int k = 0; k < kLanes; ++k) {
+            m[half * 8 + k] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(inputs[k] + offset + half * 32));
+        }
+        transpose(m + half * 8);
+    }
+}
+
+}
+
+void Blake3Hw::hashLanesAvx2(const quint8 *const *inputs, size_t blocks, const quint32 *key, quint64 counter,
+                             bool incrementCounter, quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out)
+{
+    __m256i h[8];
+    for (int i = 0; i < 8; ++i) {
+        h[i] = _mm256_set1_epi32(int(key[i]));
+    }
+
+    alignas(32) quint32 counterLow[kLanes];
+    alignas(32) quint32 counterHigh[kLanes];
+    for (int k = 0; k < kLanes; ++k) {
+        const quint64 value = counter + (incrementCounter ? quint64(k) : 0);
+        counterLow[k] = quint32(value);
+        counterHigh[k] = quint32(value >> 32);
+    }
+    const __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i *>(counterLow));
+    const __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i *>(counterHigh));
+
+    for (size_t b = 0; b < blocks; ++b) {
+        __m256i m[16];
+        loadMessage(inputs, b * Blake3::kBlockLength, m);
+
+        const quint8 blockFlags = flags | (b == 0 ? flagsStart : 0) | (b + 1 == blocks ? flagsEnd : 0);
+        __m256i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            _mm256_set1_epi32(int(kIv[0])), _mm256_set1_epi32(int(kIv[1])),
+            _mm256_set1_epi32(int(kIv[2])), _mm256_set1_epi32(int(kIv[3])),
+            low, high, _mm256_set1_epi32(Blake3::kBlockLength), _mm256_set1_epi32(blockFlags),
+        };
+        for (const quint8 *s : kMessageSchedule) {
+            mix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            mix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            mix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            mix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            mix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            mix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            mix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i) {
+            h[i] = _mm256_xor_si256(v[i], v[i + 8]);
+        }
+    }
+
+    transpose(h);
+    for (int k = 0; k < kLanes; ++k) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + k * Blake3::kDigestLength), h[k]);
+    }
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "Blake3.h"
+
+// SSSE3 实现。GCC/Clang 下本文件以 -mssse3 单独编译，只有 CpuFeatures 检测到 SSSE3 时才会被调用。
+// 4 个输入的同一个状态字放在一个寄存器的 4 个 32 位通道里，压缩函数逐字照搬可移植实现；
+// 16 / 8 位循环移位用 PSHUFB 一条指令完成。
+#if defined(Q_PROCESSOR_X86)
+
+#include <tmmintrin.h>
+
+namespace {
+
+constexpr int kLanes = 4;
+
+inline __m128i add(__m128i a, __m128i b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+inline __m128i rotateRight16(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+}
+
+inline __m128i rotateRight8(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12));
+}
+
+template <int N>
+inline __m128i rotateRight(__m128i x)
+{
+    return _mm_or_si128(_mm_srli_epi32(x, N), _mm_slli_epi32(x, 32 - N));
+}
+
+inline void mix(__m128i *v, int a, int b, int c, int d, __m128i x, __m128i y)
+{
+    v[a] = add(add(v[a], v[b]), x);
+    v[d] = rotateRight16(_mm_xor_si128(v[d], v[a]));
+    v[c] = add(v[c], v[d]);
+    v[b] = rotateRight<12>(_mm_xor_si128(v[b], v[c]));
+    v[a] = add(add(v[a], v[b]), y);
+    v[d] = rotateRight8(_mm_xor_si128(v[d], v[a]));
+    v[c] = add(v[c], v[d]);
+    v[b] = rotateRight<7>(_mm_xor_si128(v[b], v[c]));
+}
+
+// 4x4 的 32 位字转置，行与通道互换
+inline void transpose(__m128i *r)
+{
+    const __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+    const __m128i t1 = _mm_unpackhi_epi32(r[0], r[1]);
+    const __m128i t2 = _mm_unpacklo_epi32(r[2], r[3]);
+    const __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+    r[0] = _mm_unpacklo_epi64(t0, t2);
+    r[1] = _mm_unpackhi_epi64(t0, t2);
+    r[2] = _mm_unpacklo_epi64(t1, t3);
+    r[3] = _mm_unpackhi_epi64(t1, t3);
+}
+
+inline void loadMessage(const quint8 *const *inputs, size_t offset, __m128i *m)
+{
+    for (int quarter = 0; quarter < 4; ++quarter) {
+        for (int k = 0; k < kLanes; ++k) {
+            m[quarter * 4 + k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(inputs[k] + offset + quarter * 16));
+        }
+        transpose(m + quarter * 4);
+    }
+}
+
+}
+
+void Blake3Hw::hashLanesSsse3(const quint8 *const *inputs, size_t blocks, const quint32 *key, quint64 counter,
+                              bool incrementCounter, quint8 flags, quint8 flagsStart, quint8 flagsEnd, quint8 *out)
+{
+    __m128i h[8];
+    for (int i = 0; i < 8; ++i) {
+        h[i] = _mm_set1_epi32(int(key[i]));
+    }
+
+    alignas(16) quint32 counterLow[kLanes];
+    alignas(16) quint32 counterHigh[kLanes];
+    for (int k = 0; k < kLanes; ++k) {
+        const quint64 value = counter + (incrementCounter ? quint64(k) : 0);
+        counterLow[k] = quint32(value);
+        counterHigh[k] = quint32(value >> 32);
+    }
+    const __m128i low = _mm_load_si128(reinterpret_cast<const __m128i *>(counterLow));
+    const __m128i high = _mm_load_si128(reinterpret_cast<const __m128i *>(counterHigh));
+
+    for (size_t b = 0; b < blocks; ++b) {
+        __m128i m[16];
+        loadMessage(inputs, b * Blake3::kBlockLength, m);
+
+        const quint8 blockFlags = flags | (b == 0 ? flagsStart : 0) | (b + 1 == blocks ? flagsEnd : 0);
+        __m128i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            _mm_set1_epi32(int(kIv[0])), _mm_set1_epi32(int(kIv[1])),
+            _mm_set1_epi32(int(kIv[2])), _mm_set1_epi32(int(kIv[3])),
+            low, high, _mm_set1_epi32(Blake3::kBlockLength), _mm_set1_epi32(blockFlags),
+        };
+        for (const quint8 *s : kMessageSchedule) {
+            mix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            mix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            mix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            mix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            mix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            mix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            mix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i) {
+            h[i] = _mm_xor_si128(v[i], v[i + 8]);
+        }
+    }
+
+    // h[0..3] 转置后是各通道的前 4 个字，h[4..7] 是后 4 个字
+    transpose(h);
+    transpose(h + 4);
+    for (int k = 0; k < kLanes; ++k) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + k * Blake3::kDigestLength), h[k]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + k * Blake3::kDigestLength + 16), h[k + 4]);
+    }
+}
+
+#endif
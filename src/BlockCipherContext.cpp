@@ -0,0 +1,125 @@
+#include "BlockCipherContext.h"
+#include "GcmMode.h"
+
+#include <cstring>
+
+ParallelBlockCipher::BlockFunction BlockCipherContext::encryptFunction() const
+{
+    // 只捕获一个指针，std::function 不会为此分配内存
+    return [this](const quint8 *in, quint8 *out, size_t blocks) {
+        encryptBlocks(in, out, blocks);
+    };
+}
+
+ParallelBlockCipher::BlockFunction BlockCipherContext::decryptFunction() const
+{
+    return [this](const quint8 *in, quint8 *out, size_t blocks) {
+        decryptBlocks(in, out, blocks);
+    };
+}
+
+qsizetype BlockCipherContext::paddedLength(qsizetype length)
+{
+    return length + kBlockSize - length % kBlockSize;
+}
+
+qsizetype BlockCipherContext::pkcs7Pad(quint8 *data, qsizetype length)
+{
+    const int padLength = int(kBlockSize - length % kBlockSize);
+    std::memset(data + length, padLength, size_t(padLength));
+    return length + padLength;
+}
+
+qsizetype BlockCipherContext::pkcs7Unpad(const quint8 *data, qsizetype length)
+{
+    if (length <= 0) {
+        return -1;
+    }
+    const int padLength = data[length - 1];
+    if (padLength == 0 || padLength > kBlockSize || padLength > length) {
+        return -1;
+    }
+    for (qsizetype i = length - padLength; i < length; ++i) {
+        if (data[i] != padLength) {
+            return -1;
+        }
+    }
+    return length - padLength;
+}
+
+qsizetype BlockCipherContext::encryptECB(const quint8 *in, qsizetype length, quint8 *out) const
+{
+    if (out != in) {
+        std::memcpy(out, in, size_t(length));
+    }
+    const qsizetype padded = pkcs7Pad(out, length);
+    ParallelBlockCipher::ecb(encryptFunction(), out, out, padded);
+    return padded;
+}
+
+qsizetype BlockCipherContext::encryptCBC(const quint8 *iv, const quint8 *in, qsizetype length, quint8 *out) const
+{
+    if (out != in) {
+        std::memcpy(out, in, size_t(length));
+    }
+    const qsizetype padded = pkcs7Pad(out, length);
+
+    // CBC 加密逐块串行，直接在输出缓冲区上与前一密文块异或
+    const quint8 *prev = iv;
+    for (qsizetype i = 0; i < padded; i += kBlockSize) {
+        quint8 *block = out + i;
+        for (int j = 0; j < kBlockSize; ++j) {
+            block[j] ^= prev[j];
+        }
+        encryptBlocks(block, block, 1);
+        prev = block;
+    }
+    return padded;
+}
+
+qsizetype BlockCipherContext::decryptECB(const quint8 *in, qsizetype length, quint8 *out) const
+{
+    if (length <= 0 || length % kBlockSize != 0) {
+        return -1;
+    }
+    ParallelBlockCipher::ecb(decryptFunction(), in, out, length);
+    return pkcs7Unpad(out, length);
+}
+
+qsizetype BlockCipherContext::decryptCBC(const quint8 *iv, const quint8 *in, qsizetype length, quint8 *out) const
+{
+    if (length <= 0 || length % kBlockSize != 0) {
+        return -1;
+    }
+    ParallelBlockCipher::cbcDecrypt(decryptFunction(), iv, in, out, length);
+    return pkcs7Unpad(out, length);
+}
+
+void BlockCipherContext::cryptCTR(const quint8 *iv, const quint8 *in, qsizetype length, quint8 *out) const
+{
+    ParallelBlockCipher::ctr(encryptFunction(), iv, in, out, length);
+}
+
+void BlockCipherContext::encryptGCM(const quint8 *iv, qsizetype ivLength, const quint8 *aad, qsizetype aadLength,
+                                    const quint8 *in, qsizetype length, quint8 *out, quint8 *tag) const
+{
+    GcmMode::Stream stream(encryptFunction(), iv, ivLength, aad, aadLength);
+    stream.crypt(in, out, length);
+    stream.authenticate(out, length);
+    stream.finish(tag);
+}
+
+bool BlockCipherContext::decryptGCM(const quint8 *iv, qsizetype ivLength, const quint8 *aad, qsizetype aadLength,
+                                    const quint8 *in, qsizetype length, const quint8 *tag, qsizetype tagLength,
+                                    quint8 *out) const
+{
+    GcmMode::Stream stream(encryptFunction(), iv, ivLength, aad, aadLength);
+
+    // 先认证后解密
+    stream.authenticate(in, length);
+    if (!stream.verify(tag, tagLength)) {
+        return false;
+    }
+    stream.crypt(in, out, length);
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef BLOCKCIPHERCONTEXT_H
+#define BLOCKCIPHERCONTEXT_H
+
+#include "ParallelBlockCipher.h"
+
+#include <QtGlobal>
+
+#include <cstddef>
+
+// 128 位分组密码各工作模式的公共实现，AESContext 与 SM4Context 只需提供分组加解密。
+// 不依赖 QObject：输入输出都是调用方提供的缓冲区，扩展后的轮密钥保存在上下文中反复使用，
+// 处理过程中不做堆分配。同一个上下文可以被多个线程同时用来加解密（设置密钥除外）。
+class BlockCipherContext
+{
+public:
+    static constexpr qsizetype kBlockSize = 16;
+
+    virtual ~BlockCipherContext() = default;
+
+    // 处理 blocks 个连续分组，in 与 out 可以相同
+    virtual void encryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const = 0;
+    virtual void decryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const = 0;
+
+    // 供 ParallelBlockCipher / GcmMode / FileCipher 使用，引用本上下文，不复制轮密钥
+    ParallelBlockCipher::BlockFunction encryptFunction() const;
+    ParallelBlockCipher::BlockFunction decryptFunction() const;
+
+    // PKCS7 填充后的长度，总比输入多 1~16 字节
+    static qsizetype paddedLength(qsizetype length);
+    // 在 data[length] 之后写入填充，返回填充后的长度；缓冲区须有 paddedLength(length) 字节
+    static qsizetype pkcs7Pad(quint8 *data, qsizetype length);
+    // 校验填充，返回去掉填充后的长度；填充无效时返回 -1
+    static qsizetype pkcs7Unpad(const quint8 *data, qsizetype length);
+
+    // ECB / CBC 加密：out 须有 paddedLength(length) 字节，可以与 in 相同；返回密文长度
+    qsizetype encryptECB(const quint8 *in, qsizetype length, quint8 *out) const;
+    qsizetype encryptCBC(const quint8 *iv, const quint8 *in, qsizetype length, quint8 *out) const;
+    // ECB / CBC 解密：返回去掉填充后的明文长度；length 不是 16 的正整数倍或填充无效时返回 -1。
+    // CBC 解密时 out 不能与 in 相同
+    qsizetype decryptECB(const quint8 *in, qsizetype length, quint8 *out) const;
+    qsizetype decryptCBC(const quint8 *iv, const quint8 *in, qsizetype length, quint8 *out) const;
+
+    // CTR：加解密相同，不填充，out 可以与 in 相同
+    void cryptCTR(const quint8 *iv, const quint8 *in, qsizetype length, quint8 *out) const;
+
+    // GCM：tag 输出 16 字节；解密先认证，标签不匹配时返回 false 且不写 out
+    void encryptGCM(const quint8 *iv, qsizetype ivLength, const quint8 *aad, qsizetype aadLength,
+                    const quint8 *in, qsizetype length, quint8 *out, quint8 *tag) const;
+    bool decryptGCM(const quint8 *iv, qsizetype ivLength, const quint8 *aad, qsizetype aadLength,
+                    const quint8 *in, qsizetype length, const quint8 *tag, qsizetype tagLength,
+                    quint8 *out) const;
+};
+
+#endif // BLOCKCIPHERCONTEXT_H
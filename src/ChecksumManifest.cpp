@@ -0,0 +1,275 @@
+#include "ChecksumManifest.h"
+#include "FileDigest.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+bool isHexDigest(const QByteArray &value)
+{
+    if (value.isEmpty() || value.size() % 2 != 0) {
+        return false;
+    }
+    for (char c : value) {
+        const bool hex = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        if (!hex) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// GNU coreutils 对含 '\\' 或换行的文件名在行首加 '\\'，并把它们写成 "\\\\" 与 "\\n"
+QByteArray unescapePath(const QByteArray &path)
+{
+    QByteArray result;
+    result.reserve(path.size());
+    for (qsizetype i = 0; i < path.size(); ++i) {
+        if (path[i] == '\\' && i + 1 < path.size()) {
+            ++i;
+            result.append(path[i] == 'n' ? '\n' : path[i]);
+        } else {
+            result.append(path[i]);
+        }
+    }
+    return result;
+}
+
+}
+
+QList<ChecksumManifest::Entry> ChecksumManifest::parse(const QByteArray &text, int *malformedLines,
+                                                       QString *bsdAlgorithm)
+{
+    QList<Entry> entries;
+    int malformed = 0;
+
+    const QList<QByteArray> lines = text.split('\n');
+    for (QByteArray line : lines) {
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        if (line.trimmed().isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        bool escaped = false;
+        if (line.startsWith('\\')) {
+            escaped = true;
+            line.remove(0, 1);
+        }
+
+        Entry entry;
+        QByteArray path;
+        // GNU 格式：digest 后跟一个空格，再跟模式字符（' ' 文本 / '*' 二进制）。
+        // 先按它识别，文件名本身含 " (" 与 ") = " 时也不会被当成 BSD 格式
+        const qsizetype space = line.indexOf(' ');
+        const qsizetype bsdSplit = line.lastIndexOf(") = ");
+        const qsizetype open = line.indexOf(" (");
+        if (space > 0 && space + 2 < line.size() && (line[space + 1] == ' ' || line[space + 1] == '*')
+            && isHexDigest(line.left(space))) {
+            entry.digest = line.left(space);
+            path = line.mid(space + 2);
+        } else if (bsdSplit > 0 && open > 0 && open < bsdSplit) {
+            // BSD 格式：ALGO (path) = digest
+            if (bsdAlgorithm && bsdAlgorithm->isEmpty()) {
+                *bsdAlgorithm = QString::fromLatin1(line.left(open)).toUpper().remove('-');
+            }
+            path = line.mid(open + 2, bsdSplit - open - 2);
+            entry.digest = line.mid(bsdSplit + 4).trimmed();
+        } else {
+            // 省略了模式字符的 GNU 格式
+            if (space <= 0 || space + 1 >= line.size()) {
+                ++malformed;
+                continue;
+            }
+            entry.digest = line.left(space);
+            path = line.mid(space + 1);
+        }
+
+        if (!isHexDigest(entry.digest) || path.isEmpty()) {
+            ++malformed;
+            continue;
+        }
+        entry.digest = entry.digest.toLower();
+        entry.path = QString::fromUtf8(escaped ? unescapePath(path) : path);
+        entries.append(entry);
+    }
+
+    if (malformedLines) {
+        *malformedLines = malformed;
+    }
+    return entries;
+}
+
+QByteArray ChecksumManifest::format(const QList<Entry> &entries)
+{
+    QByteArray text;
+    for (const Entry &entry : entries) {
+        QByteArray path = entry.path.toUtf8();
+        const bool escape = path.contains('\\') || path.contains('\n');
+        if (escape) {
+            path.replace("\\", "\\\\");
+            path.replace("\n", "\\n");
+            text.append('\\');
+        }
+        text.append(entry.digest);
+        text.append("  ");
+        text.append(path);
+        text.append('\n');
+    }
+    return text;
+}
+
+QString ChecksumManifest::algorithmForFile(const QString &path)
+{
+    QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix.endsWith(QStringLiteral("sum"))) {
+        suffix.chop(3);
+    }
+    if (suffix == QStringLiteral("md5") || suffix == QStringLiteral("sha1") || suffix == QStringLiteral("sha256")
+        || suffix == QStringLiteral("sha384") || suffix == QStringLiteral("sha512") || suffix == QStringLiteral("sm3")) {
+        return suffix.toUpper();
+    }
+    // b3sum 的默认扩展名
+    if (suffix == QStringLiteral("b3") || suffix == QStringLiteral("blake3")) {
+        return QStringLiteral("BLAKE3");
+    }
+    return QString();
+}
+
+QString ChecksumManifest::algorithmForDigestLength(int hexLength)
+{
+    switch (hexLength) {
+    case 32:
+        return QStringLiteral("MD5");
+    case 40:
+        return QStringLiteral("SHA1");
+    case 64:
+        return QStringLiteral("SHA256");
+    case 96:
+        return QStringLiteral("SHA384");
+    case 128:
+        return QStringLiteral("SHA512");
+    default:
+        return QString();
+    }
+}
+
+QString ChecksumManifest::suffixForAlgorithm(const QString &algorithm)
+{
+    return algorithm.trimmed().toLower();
+}
+
+QStringList ChecksumManifest::collectFiles(const QString &root, const QString &excludedFile)
+{
+    const QDir rootDir(root);
+    const QString excluded = excludedFile.isEmpty() ? QString() : QFileInfo(excludedFile).absoluteFilePath();
+
+    QList<QPair<QString, QString>> files;
+    QDirIterator it(root, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        const QFileInfo info = it.fileInfo();
+        if (!excluded.isEmpty() && info.absoluteFilePath() == excluded) {
+            continue;
+        }
+        const QString relative = rootDir.relativeFilePath(path);
+        const qsizetype slash = relative.lastIndexOf('/');
+        files.append({slash < 0 ? QString() : relative.left(slash), relative.mid(slash + 1)});
+    }
+    std::sort(files.begin(), files.end());
+
+    QStringList result;
+    result.reserve(files.size());
+    for (const auto &file : std::as_const(files)) {
+        result.append(file.first.isEmpty() ? file.second : file.first + '/' + file.second);
+    }
+    return result;
+}
+
+QList<ChecksumManifest::Check> ChecksumManifest::hashFiles(const QString &root, const QList<Entry> &entries,
+                                                          const QString &algorithm, int threadCount,
+                                                          const CheckFunction &checked,
+                                                          const CancelFunction &isCanceled)
+{
+    QList<Check> checks(entries.size());
+    const QDir rootDir(root);
+
+    // 清单中的顺序未必是目录顺序，按 collectFiles 的规则排好再派发，结果仍写回原位置
+    QList<qsizetype> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    const auto sortKey = [&entries](qsizetype index) {
+        const QString &path = entries.at(index).path;
+        const qsizetype slash = path.lastIndexOf('/');
+        return qMakePair(slash < 0 ? QString() : path.left(slash), path.mid(slash + 1));
+    };
+    std::stable_sort(order.begin(), order.end(), [&sortKey](qsizetype a, qsizetype b) {
+        return sortKey(a) < sortKey(b);
+    });
+
+    std::atomic<bool> canceled(false);
+    // 调用者的取消在读取每一块时都检查，大文件不必读完才停下
+    const auto stopped = [&canceled, &isCanceled]() {
+        if (canceled.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        if (isCanceled && isCanceled()) {
+            canceled.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    };
+    const auto hashEntry = [&](const qsizetype &index) {
+        if (stopped()) {
+            return;
+        }
+
+        const Entry &entry = entries.at(index);
+        Check &check = checks[index];
+        const QString path = rootDir.filePath(entry.path);
+        if (!QFileInfo::exists(path)) {
+            check.status = Status::Missing;
+            check.errorMessage = QStringLiteral("文件不存在");
+        } else {
+            const FileDigest::FileResult result = FileDigest::hashFile(path, {algorithm}, [&stopped](qint64, qint64) {
+                return !stopped();
+            });
+            if (result.canceled) {
+                return;
+            }
+            if (!result.success) {
+                check.status = Status::Failed;
+                check.errorMessage = result.errorMessage;
+            } else {
+                check.digest = result.digests.value(0).toHex();
+                check.status = entry.digest.isEmpty() || entry.digest == check.digest ? Status::Ok : Status::Mismatch;
+            }
+        }
+
+        if (checked && !checked(entry, check)) {
+            canceled.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    if (threadCount <= 1) {
+        for (qsizetype index : std::as_const(order)) {
+            hashEntry(index);
+        }
+    } else {
+        // blockingMap 的调用线程也参与处理，池中只需再开 threadCount - 1 个线程；
+        // 独立的线程池不占用全局线程池，单个文件的预读任务仍在全局线程池中进行
+        QThreadPool pool;
+        pool.setMaxThreadCount(threadCount - 1);
+        QtConcurrent::blockingMap(&pool, order, hashEntry);
+    }
+    return checks;
+}
@@ -0,0 +1,61 @@
+#ifndef CHECKSUMMANIFEST_H
+#define CHECKSUMMANIFEST_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+// sha256sum / md5sum 等命令使用的校验清单。
+// 读取支持 GNU 格式（"摘要  路径"、二进制模式 "摘要 *路径"、带反斜杠转义的行）
+// 与 BSD 格式（"SHA256 (路径) = 摘要"）；写出固定为 GNU 文本模式，可直接交给 sha256sum -c 校验。
+class ChecksumManifest
+{
+public:
+    struct Entry {
+        // 相对清单所在目录的路径，分隔符为 '/'
+        QString path;
+        // 小写十六进制摘要
+        QByteArray digest;
+    };
+
+    enum class Status { Ok, Mismatch, Missing, Failed, Canceled };
+
+    struct Check {
+        Status status = Status::Canceled;
+        // 计算出的小写十六进制摘要
+        QByteArray digest;
+        QString errorMessage;
+    };
+
+    // 每处理完一个文件调用一次，可能来自不同的工作线程；返回 false 时不再派发剩余文件
+    using CheckFunction = std::function<bool(const Entry &entry, const Check &check)>;
+    // 调用者是否已取消；在读取文件的过程中也会检查，返回 true 时当前文件立即停止
+    using CancelFunction = std::function<bool()>;
+
+    // 解析清单文本；空行与 # 注释忽略，无法识别的行计入 malformedLines
+    static QList<Entry> parse(const QByteArray &text, int *malformedLines = nullptr, QString *bsdAlgorithm = nullptr);
+    static QByteArray format(const QList<Entry> &entries);
+
+    // 按扩展名（.md5、.sha1、.sha256、.sha384、.sha512、.sm3，可带 sum 后缀）推断算法，无法推断时返回空
+    static QString algorithmForFile(const QString &path);
+    // 按十六进制摘要长度推断算法；64 位按 SHA256 处理
+    static QString algorithmForDigestLength(int hexLength);
+    // 生成清单时使用的扩展名，如 "sha256"
+    static QString suffixForAlgorithm(const QString &algorithm);
+
+    // 递归列出 root 下的普通文件（不进入目录符号链接），返回相对路径。
+    // 先按目录、再按文件名排序，同一目录的文件连续读取，机械硬盘上磁头来回移动更少
+    static QStringList collectFiles(const QString &root, const QString &excludedFile = QString());
+
+    // 用最多 threadCount 个线程并行计算 root 下各条目的摘要，结果与 entries 顺序一致。
+    // 条目带摘要时与之比较（校验），不带摘要时只计算（生成清单）。
+    // threadCount 就是同时读取的文件数，机械硬盘上应设为 1
+    static QList<Check> hashFiles(const QString &root, const QList<Entry> &entries, const QString &algorithm,
+                                  int threadCount, const CheckFunction &checked = CheckFunction(),
+                                  const CancelFunction &isCanceled = CancelFunction());
+};
+
+#endif // CHECKSUMMANIFEST_H
@@ -0,0 +1,146 @@
+#include "CpuFeatures.h"
+
+#include <QStringList>
+#include <QtGlobal>
+
+#if defined(Q_PROCESSOR_X86)
+#  if defined(Q_CC_MSVC)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
+#if defined(Q_PROCESSOR_ARM_64)
+#  if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#    include <sys/auxv.h>
+#    include <asm/hwcap.h>
+#  elif defined(Q_OS_WIN)
+#    include <windows.h>
+#  endif
+#endif
+
+namespace {
+
+struct Features {
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool avx2 = false;
+    bool aesni = false;
+    bool pclmul = false;
+    bool shani = false;
+    bool armAes = false;
+    bool armPmull = false;
+    bool armCrc32 = false;
+    bool armSha2 = false;
+};
+
+#if defined(Q_PROCESSOR_X86)
+void cpuid(int leaf, int subleaf, unsigned int regs[4])
+{
+#  if defined(Q_CC_MSVC)
+    int info[4];
+    __cpuidex(info, leaf, subleaf);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<unsigned int>(info[i]);
+    }
+#  else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+}
+
+// AVX 寄存器需要操作系统在上下文切换时保存（XCR0 的 bit 1、2）
+bool osSavesYmm()
+{
+#  if defined(Q_CC_MSVC)
+    return (_xgetbv(0) & 0x6) == 0x6;
+#  else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (eax & 0x6) == 0x6;
+#  endif
+}
+#endif
+
+Features detect()
+{
+    Features f;
+
+#if defined(Q_PROCESSOR_X86)
+    unsigned int regs[4] = {0, 0, 0, 0};
+    cpuid(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const unsigned int ecx1 = regs[2];
+    f.ssse3 = ecx1 & (1u << 9);
+    f.sse41 = ecx1 & (1u << 19);
+    f.sse42 = ecx1 & (1u << 20);
+    f.aesni = ecx1 & (1u << 25);
+    f.pclmul = ecx1 & (1u << 1);
+    const bool osxsave = ecx1 & (1u << 27);
+    const bool avx = ecx1 & (1u << 28);
+
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, regs);
+        f.avx2 = avx && osxsave && (regs[1] & (1u << 5)) && osSavesYmm();
+        f.shani = regs[1] & (1u << 29);
+    }
+#elif defined(Q_PROCESSOR_ARM_64)
+#  if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    f.armAes = hwcap & HWCAP_AES;
+    f.armPmull = hwcap & HWCAP_PMULL;
+    f.armCrc32 = hwcap & HWCAP_CRC32;
+    f.armSha2 = hwcap & HWCAP_SHA2;
+#  elif defined(Q_OS_MACOS) || defined(Q_OS_IOS)
+    // Apple Silicon 均支持 ARMv8 加密扩展与 CRC32
+    f.armAes = f.armPmull = f.armCrc32 = f.armSha2 = true;
+#  elif defined(Q_OS_WIN)
+    f.armAes = f.armPmull = f.armSha2 = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE);
+    f.armCrc32 = IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE);
+#  endif
+#endif
+
+    return f;
+}
+
+const Features &features()
+{
+    static const Features f = detect();
+    return f;
+}
+
+}
+
+bool CpuFeatures::hasSsse3() { return features().ssse3; }
+bool CpuFeatures::hasSse41() { return features().sse41; }
+bool CpuFeatures::hasSse42() { return features().sse42; }
+bool CpuFeatures::hasAvx2() { return features().avx2; }
+bool CpuFeatures::hasAesNi() { return features().aesni; }
+bool CpuFeatures::hasPclmul() { return features().pclmul; }
+bool CpuFeatures::hasShaNi() { return features().shani; }
+bool CpuFeatures::hasArmAes() { return features().armAes; }
+bool CpuFeatures::hasArmPmull() { return features().armPmull; }
+bool CpuFeatures::hasArmCrc32() { return features().armCrc32; }
+bool CpuFeatures::hasArmSha2() { return features().armSha2; }
+
+QString CpuFeatures::summary()
+{
+    const Features &f = features();
+    QStringList names;
+    if (f.ssse3) names << "SSSE3";
+    if (f.sse41) names << "SSE4.1";
+    if (f.sse42) names << "SSE4.2";
+    if (f.avx2) names << "AVX2";
+    if (f.aesni) names << "AES-NI";
+    if (f.pclmul) names << "PCLMUL";
+    if (f.shani) names << "SHA-NI";
+    if (f.armAes) names << "ARMv8-AES";
+    if (f.armPmull) names << "PMULL";
+    if (f.armCrc32) names << "CRC32";
+    if (f.armSha2) names << "ARMv8-SHA2";
+    return names.isEmpty() ? QString("通用") : names.join(' ');
+}
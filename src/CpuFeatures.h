@@ -0,0 +1,29 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+#include <QString>
+
+// 运行时 CPU 指令集检测（首次调用时检测一次并缓存），供各加速实现选择代码路径
+class CpuFeatures
+{
+public:
+    // x86 / x86-64
+    static bool hasSsse3();
+    static bool hasSse41();
+    static bool hasSse42();
+    static bool hasAvx2();
+    static bool hasAesNi();
+    static bool hasPclmul();
+    static bool hasShaNi();
+
+    // ARMv8
+    static bool hasArmAes();
+    static bool hasArmPmull();
+    static bool hasArmCrc32();
+    static bool hasArmSha2();
+
+    // 例如 "SSE4.2 AVX2 AES-NI PCLMUL"，用于界面展示
+    static QString summary();
+};
+
+#endif // CPUFEATURES_H
@@ -0,0 +1,148 @@
+#include "Crc32.h"
+#include "CpuFeatures.h"
+
+#include <QtEndian>
+
+namespace {
+
+constexpr quint32 kIeeePolynomial = 0xedb88320u;
+constexpr quint32 kCastagnoliPolynomial = 0x82f63b78u;
+
+constexpr Crc32Hw::Tables makeTables(quint32 polynomial)
+{
+    Crc32Hw::Tables tables{};
+    for (quint32 b = 0; b < 256; ++b) {
+        quint32 crc = b;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+        }
+        tables.t[0][b] = crc;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (int b = 0; b < 256; ++b) {
+            const quint32 previous = tables.t[k - 1][b];
+            tables.t[k][b] = (previous >> 8) ^ tables.t[0][previous & 0xff];
+        }
+    }
+    return tables;
+}
+
+quint32 updateIeeePortable(quint32 crc, const quint8 *data, size_t length)
+{
+    return Crc32Hw::updatePortable(Crc32Hw::kIeeeTables, crc, data, length);
+}
+
+quint32 updateCastagnoliPortable(quint32 crc, const quint8 *data, size_t length)
+{
+    return Crc32Hw::updatePortable(Crc32Hw::kCastagnoliTables, crc, data, length);
+}
+
+}
+
+const Crc32Hw::Tables Crc32Hw::kIeeeTables = makeTables(kIeeePolynomial);
+const Crc32Hw::Tables Crc32Hw::kCastagnoliTables = makeTables(kCastagnoliPolynomial);
+
+quint32 Crc32Hw::updatePortable(const Tables &tables, quint32 crc, const quint8 *data, size_t length)
+{
+    const auto &t = tables.t;
+    // 每次 8 字节：前 4 字节与寄存器异或后和后 4 字节分别查 8 张表
+    while (length >= 8) {
+        const quint32 low = qFromLittleEndian<quint32>(data) ^ crc;
+        const quint32 high = qFromLittleEndian<quint32>(data + 4);
+        crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^ t[5][(low >> 16) & 0xff] ^ t[4][low >> 24]
+            ^ t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^ t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+        ++data;
+        --length;
+    }
+    return crc;
+}
+
+const Crc32::Implementation &Crc32::portable(Variant variant)
+{
+    static const Implementation ieee = {"Slicing-by-8", updateIeeePortable};
+    static const Implementation castagnoli = {"Slicing-by-8", updateCastagnoliPortable};
+    return variant == Castagnoli ? castagnoli : ieee;
+}
+
+QList<const Crc32::Implementation *> Crc32::available(Variant variant)
+{
+    QList<const Implementation *> result{&portable(variant)};
+#if defined(Q_PROCESSOR_X86)
+    // PCLMUL 折叠最后一步取 32 位结果用到 SSE4.1 的 PEXTRD
+    static const Implementation pclmul = {"PCLMUL", Crc32Hw::updateIeeePclmul};
+    static const Implementation sse42 = {"SSE4.2", Crc32Hw::updateCastagnoliSse42};
+    if (variant == Ieee && CpuFeatures::hasPclmul() && CpuFeatures::hasSse41()) {
+        result << &pclmul;
+    }
+    if (variant == Castagnoli && CpuFeatures::hasSse42()) {
+        result << &sse42;
+    }
+#endif
+#if defined(Q_PROCESSOR_ARM_64)
+    static const Implementation armIeee = {"ARMv8-CRC", Crc32Hw::updateIeeeArm};
+    static const Implementation armCastagnoli = {"ARMv8-CRC", Crc32Hw::updateCastagnoliArm};
+    if (CpuFeatures::hasArmCrc32()) {
+        result << (variant == Castagnoli ? &armCastagnoli : &armIeee);
+    }
+#endif
+    return result;
+}
+
+const Crc32::Implementation &Crc32::active(Variant variant)
+{
+    static const Implementation *ieee = available(Ieee).constLast();
+    static const Implementation *castagnoli = available(Castagnoli).constLast();
+    return *(variant == Castagnoli ? castagnoli : ieee);
+}
+
+Crc32::Crc32(Variant variant)
+    : Crc32(active(variant))
+{
+}
+
+Crc32::Crc32(const Implementation &implementation)
+    : m_implementation(&implementation)
+{
+    reset();
+}
+
+void Crc32::reset()
+{
+    m_crc = 0xffffffffu;
+}
+
+void Crc32::addData(const char *data, qsizetype length)
+{
+    if (length > 0) {
+        m_crc = m_implementation->update(m_crc, reinterpret_cast<const quint8 *>(data), size_t(length));
+    }
+}
+
+void Crc32::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+quint32 Crc32::value() const
+{
+    return ~m_crc;
+}
+
+QByteArray Crc32::result() const
+{
+    QByteArray digest(4, Qt::Uninitialized);
+    qToBigEndian(value(), digest.data());
+    return digest;
+}
+
+quint32 Crc32::checksum(Variant variant, const QByteArray &data)
+{
+    Crc32 crc(variant);
+    crc.addData(data);
+    return crc.value();
+}
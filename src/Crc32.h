@@ -0,0 +1,76 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtGlobal>
+
+#include <cstddef>
+
+// 非加密的 CRC-32 校验，用于快速发现文件损坏，接口与 SM3 / Blake3 相同，可多次 addData 分段输入。
+// Ieee 与 zlib / zip / PNG 的 crc32 相同；Castagnoli 即 CRC-32C（iSCSI、ext4、Btrfs 使用）。
+// 运行时按 CPU 选择实现：x86 上 CRC-32 用 PCLMUL 折叠、CRC-32C 用 SSE4.2 crc32 指令，ARMv8 上两者都用 CRC 扩展指令。
+class Crc32
+{
+public:
+    enum Variant {
+        Ieee,
+        Castagnoli,
+    };
+
+    // 处理 length 字节。crc 为未取反的寄存器值（初值 0xffffffff），返回新的寄存器值
+    using UpdateFunction = quint32 (*)(quint32 crc, const quint8 *data, size_t length);
+
+    struct Implementation {
+        const char *name;
+        UpdateFunction update;
+    };
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active(Variant variant);
+    static const Implementation &portable(Variant variant);
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available(Variant variant);
+
+    explicit Crc32(Variant variant = Ieee);
+    // 实现本身决定计算哪一种 CRC，用于逐个校验 available() 中的实现
+    explicit Crc32(const Implementation &implementation);
+
+    void reset();
+    void addData(const char *data, qsizetype length);
+    void addData(const QByteArray &data);
+
+    quint32 value() const;
+    // 4 字节大端序，toHex() 后与 cksum / 7-Zip 等工具显示的一致
+    QByteArray result() const;
+
+    static quint32 checksum(Variant variant, const QByteArray &data);
+
+private:
+    const Implementation *m_implementation;
+    quint32 m_crc;
+};
+
+namespace Crc32Hw {
+// 按 8 字节切片查表：t[k][b] 为字节 b 之后再跟 k 个零字节的 CRC 寄存器值
+struct Tables {
+    quint32 t[8][256];
+};
+extern const Tables kIeeeTables;
+extern const Tables kCastagnoliTables;
+
+// 硬件实现位于 Crc32_x86.cpp / Crc32_arm.cpp，这两个文件使用单独的编译选项
+#if defined(Q_PROCESSOR_X86)
+quint32 updateIeeePclmul(quint32 crc, const quint8 *data, size_t length);
+quint32 updateCastagnoliSse42(quint32 crc, const quint8 *data, size_t length);
+#endif
+#if defined(Q_PROCESSOR_ARM_64)
+quint32 updateIeeeArm(quint32 crc, const quint8 *data, size_t length);
+quint32 updateCastagnoliArm(quint32 crc, const quint8 *data, size_t length);
+#endif
+
+// 查表法，硬件实现用它处理不足一个折叠块的首尾字节
+quint32 updatePortable(const Tables &tables, quint32 crc, const quint8 *data, size_t length);
+}
+
+#endif // CRC32_H
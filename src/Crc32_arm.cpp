@@ -0,0 +1,45 @@
+#include "Crc32.h"
+
+// ARMv8 CRC 扩展实现。GCC/Clang 下本文件以 -march=armv8-a+crc 单独编译，
+// 只有 CpuFeatures 检测到 CRC32 指令时才会被调用。两种多项式各有一组指令。
+#if defined(Q_PROCESSOR_ARM_64)
+
+#include <arm_acle.h>
+
+#include <cstring>
+
+quint32 Crc32Hw::updateIeeeArm(quint32 crc, const quint8 *data, size_t length)
+{
+    while (length >= 8) {
+        quint64 word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = __crc32d(crc, word);
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = __crc32b(crc, *data);
+        ++data;
+        --length;
+    }
+    return crc;
+}
+
+quint32 Crc32Hw::updateCastagnoliArm(quint32 crc, const quint8 *data, size_t length)
+{
+    while (length >= 8) {
+        quint64 word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+        data += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = __crc32cb(crc, *data);
+        ++data;
+        --length;
+    }
+    return crc;
+}
+
+#endif
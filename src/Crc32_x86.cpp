@@ -0,0 +1,122 @@
+#include "Crc32.h"
+
+// x86 实现。GCC/Clang 下本文件以 -msse4.2 -mpclmul 单独编译，只有 CpuFeatures 检测到对应指令时才会被调用。
+#if defined(Q_PROCESSOR_X86)
+
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+
+#include <cstring>
+
+namespace {
+
+// 折叠常数（x^n mod P 的位反转形式），与 Intel《Fast CRC Computation Using PCLMULQDQ》及 zlib 相同
+alignas(16) const quint64 kFold4[2] = {0x0154442bd4, 0x01c6e41596};   // 跨 64 字节
+alignas(16) const quint64 kFold1[2] = {0x01751997d0, 0x00ccaa009e};   // 跨 16 字节
+alignas(16) const quint64 kFold64[2] = {0x0163cd6124, 0x0000000000};  // 128 位折叠到 64 位
+alignas(16) const quint64 kBarrett[2] = {0x01db710641, 0x01f7011641}; // P(x) 与 Barrett 约减的 μ
+
+inline __m128i load(const quint8 *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+inline __m128i fold(__m128i x, __m128i k, __m128i next)
+{
+    const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+    const __m128i high = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(low, high), next);
+}
+
+// length 至少 64 且为 16 的倍数
+quint32 foldBlocks(quint32 crc, const quint8 *data, size_t length)
+{
+    __m128i x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(int(crc)));
+    __m128i x2 = load(data + 16);
+    __m128i x3 = load(data + 32);
+    __m128i x4 = load(data + 48);
+    data += 64;
+    length -= 64;
+
+    // 4 路并行，每次折叠 64 字节，隐藏 PCLMULQDQ 的延迟
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i *>(kFold4));
+    while (length >= 64) {
+        x1 = fold(x1, k, load(data));
+        x2 = fold(x2, k, load(data + 16));
+        x3 = fold(x3, k, load(data + 32));
+        x4 = fold(x4, k, load(data + 48));
+        data += 64;
+        length -= 64;
+    }
+
+    k = _mm_load_si128(reinterpret_cast<const __m128i *>(kFold1));
+    x1 = fold(x1, k, x2);
+    x1 = fold(x1, k, x3);
+    x1 = fold(x1, k, x4);
+    while (length >= 16) {
+        x1 = fold(x1, k, load(data));
+        data += 16;
+        length -= 16;
+    }
+
+    // 128 位折叠到 64 位
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    __m128i t = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), t);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(kFold64));
+    t = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x00), t);
+
+    // Barrett 约减到 32 位
+    k = _mm_load_si128(reinterpret_cast<const __m128i *>(kBarrett));
+    t = _mm_and_si128(x1, mask32);
+    t = _mm_clmulepi64_si128(t, k, 0x10);
+    t = _mm_and_si128(t, mask32);
+    t = _mm_clmulepi64_si128(t, k, 0x00);
+    x1 = _mm_xor_si128(x1, t);
+    return quint32(_mm_extract_epi32(x1, 1));
+}
+
+}
+
+quint32 Crc32Hw::updateIeeePclmul(quint32 crc, const quint8 *data, size_t length)
+{
+    if (length >= 64) {
+        const size_t folded = length & ~size_t(15);
+        crc = foldBlocks(crc, data, folded);
+        data += folded;
+        length -= folded;
+    }
+    return updatePortable(kIeeeTables, crc, data, length);
+}
+
+quint32 Crc32Hw::updateCastagnoliSse42(quint32 crc, const quint8 *data, size_t length)
+{
+#if defined(Q_PROCESSOR_X86_64)
+    quint64 crc64 = crc;
+    while (length >= 8) {
+        quint64 word;
+        std::memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    crc = quint32(crc64);
+#endif
+    while (length >= 4) {
+        quint32 word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+        data += 4;
+        length -= 4;
+    }
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *data);
+        ++data;
+        --length;
+    }
+    return crc;
+}
+
+#endif
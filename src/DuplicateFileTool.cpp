@@ -0,0 +1,292 @@
+#include "DuplicateFileTool.h"
+#include "FileDigest.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QThread>
+#include <QVariantMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+// 同时读取的文件数上限，再多对 SSD 也不会更快，只会增加内存占用
+constexpr int kMaxThreadCount = 8;
+
+}
+
+DuplicateFileTool::DuplicateFileTool(QObject *parent)
+    : QObject(parent)
+    , m_algorithm("BLAKE3")
+    , m_minimumSize(1)
+    , m_threadCount(qBound(1, QThread::idealThreadCount(), 4))
+    , m_processedFiles(0)
+    , m_stage(std::make_shared<std::atomic<int>>(0))
+    , m_watcher(new QFutureWatcher<RunResult>(this))
+{
+    connect(m_watcher, &QFutureWatcher<RunResult>::progressValueChanged,
+            this, &DuplicateFileTool::onProgressValueChanged);
+    connect(m_watcher, &QFutureWatcher<RunResult>::progressRangeChanged, this, [this]() {
+        // 每一步开始时进度范围整体后移，已处理数从 0 重新计
+        m_processedFiles = qMax(0, m_watcher->progressValue() - m_watcher->progressMinimum());
+        emit progressChanged();
+    });
+    connect(m_watcher, &QFutureWatcher<RunResult>::finished, this, &DuplicateFileTool::onFinished);
+}
+
+DuplicateFileTool::~DuplicateFileTool()
+{
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+}
+
+QString DuplicateFileTool::folderPath() const
+{
+    return m_folderPath;
+}
+
+void DuplicateFileTool::setFolderPath(const QString &folderPath)
+{
+    if (m_folderPath != folderPath) {
+        m_folderPath = folderPath;
+        emit folderPathChanged();
+    }
+}
+
+QString DuplicateFileTool::algorithm() const
+{
+    return m_algorithm;
+}
+
+void DuplicateFileTool::setAlgorithm(const QString &algorithm)
+{
+    if (m_algorithm != algorithm) {
+        m_algorithm = algorithm;
+        emit algorithmChanged();
+    }
+}
+
+qint64 DuplicateFileTool::minimumSize() const
+{
+    return m_minimumSize;
+}
+
+void DuplicateFileTool::setMinimumSize(qint64 minimumSize)
+{
+    minimumSize = qMax<qint64>(0, minimumSize);
+    if (m_minimumSize != minimumSize) {
+        m_minimumSize = minimumSize;
+        emit minimumSizeChanged();
+    }
+}
+
+int DuplicateFileTool::threadCount() const
+{
+    return m_threadCount;
+}
+
+void DuplicateFileTool::setThreadCount(int threadCount)
+{
+    threadCount = qBound(1, threadCount, kMaxThreadCount);
+    if (m_threadCount != threadCount) {
+        m_threadCount = threadCount;
+        emit threadCountChanged();
+    }
+}
+
+bool DuplicateFileTool::running() const
+{
+    return m_watcher->isRunning();
+}
+
+int DuplicateFileTool::stage() const
+{
+    return m_stage->load();
+}
+
+int DuplicateFileTool::totalFiles() const
+{
+    return m_watcher->progressMaximum() - m_watcher->progressMinimum();
+}
+
+int DuplicateFileTool::processedFiles() const
+{
+    return m_processedFiles;
+}
+
+QVariantList DuplicateFileTool::groups() const
+{
+    QVariantList groups;
+    groups.reserve(m_groups.size());
+    for (const DuplicateFinder::Group &group : m_groups) {
+        QVariantMap item;
+        item.insert("size", group.size);
+        item.insert("digest", QString::fromLatin1(group.digest));
+        item.insert("paths", group.paths);
+        item.insert("reclaimable", group.reclaimableBytes());
+        groups.append(item);
+    }
+    return groups;
+}
+
+int DuplicateFileTool::groupCount() const
+{
+    return int(m_groups.size());
+}
+
+int DuplicateFileTool::duplicateCount() const
+{
+    int count = 0;
+    for (const DuplicateFinder::Group &group : m_groups) {
+        count += int(group.paths.size()) - 1;
+    }
+    return count;
+}
+
+qint64 DuplicateFileTool::reclaimableBytes() const
+{
+    qint64 bytes = 0;
+    for (const DuplicateFinder::Group &group : m_groups) {
+        bytes += group.reclaimableBytes();
+    }
+    return bytes;
+}
+
+QStringList DuplicateFileTool::problems() const
+{
+    return m_problems;
+}
+
+QString DuplicateFileTool::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+void DuplicateFileTool::scan()
+{
+    if (m_folderPath.trimmed().isEmpty() || !QFileInfo(m_folderPath).isDir()) {
+        setStatusMessage("文件夹不存在");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+    const QString algorithm = m_algorithm.trimmed().toUpper();
+    if (!FileDigest::create(algorithm)) {
+        setStatusMessage(QStringLiteral("不支持的哈希算法: %1").arg(m_algorithm));
+        emit finished(false, m_statusMessage);
+        return;
+    }
+
+    const QString folder = QDir(m_folderPath).absolutePath();
+    const qint64 minimumSize = m_minimumSize;
+    const int threads = m_threadCount;
+
+    // 上一次任务被取消后可能仍在收尾，换一个新的步骤计数，不与它共用
+    m_watcher->cancel();
+    m_stage = std::make_shared<std::atomic<int>>(0);
+    const std::shared_ptr<std::atomic<int>> stage = m_stage;
+    m_processedFiles = 0;
+    m_groups.clear();
+    m_problems.clear();
+    emit groupsChanged();
+    emit problemsChanged();
+    emit progressChanged();
+    setStatusMessage("正在扫描...");
+
+    m_watcher->setFuture(QtConcurrent::run([folder, minimumSize, algorithm, threads, stage](QPromise<RunResult> &promise) {
+        RunResult result;
+        result.folder = folder;
+        const QList<DuplicateFinder::File> files = DuplicateFinder::collectFiles(folder, minimumSize);
+        if (promise.isCanceled()) {
+            return;
+        }
+
+        // QPromise 的进度只能增大，每一步的范围接在上一步之后
+        int offset = 0;
+        int stageTotal = 0;
+        bool canceled = false;
+        result.groups = DuplicateFinder::find(
+            folder, files, algorithm, threads,
+            [&](DuplicateFinder::Stage current, int processed, int total) {
+                if (processed == 0) {
+                    offset += stageTotal;
+                    stageTotal = total;
+                    stage->store(int(current));
+                    promise.setProgressRange(offset, offset + total);
+                } else {
+                    promise.setProgressValue(offset + processed);
+                }
+                return !promise.isCanceled();
+            },
+            &result.problems, &canceled);
+        if (canceled || promise.isCanceled()) {
+            return;
+        }
+
+        result.success = result.problems.isEmpty();
+        result.message = result.groups.isEmpty()
+                             ? QStringLiteral("已比较 %1 个文件，没有重复文件").arg(files.size())
+                             : QStringLiteral("已比较 %1 个文件，找到 %2 组重复文件")
+                                   .arg(files.size())
+                                   .arg(result.groups.size());
+        if (!result.problems.isEmpty()) {
+            result.message += QStringLiteral("，%1 个文件无法读取").arg(result.problems.size());
+        }
+        promise.addResult(result);
+    }));
+    emit runningChanged();
+}
+
+void DuplicateFileTool::cancel()
+{
+    m_watcher->cancel();
+}
+
+QString DuplicateFileTool::report() const
+{
+    const QDir folder(m_resultFolder);
+    QString text;
+    for (const DuplicateFinder::Group &group : m_groups) {
+        text += QStringLiteral("# %1 字节 × %2  %3\n")
+                    .arg(group.size)
+                    .arg(group.paths.size())
+                    .arg(QString::fromLatin1(group.digest));
+        for (const QString &path : group.paths) {
+            text += QDir::toNativeSeparators(folder.filePath(path)) + '\n';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+void DuplicateFileTool::onProgressValueChanged(int value)
+{
+    m_processedFiles = qMax(0, value - m_watcher->progressMinimum());
+    emit progressChanged();
+}
+
+void DuplicateFileTool::onFinished()
+{
+    RunResult result;
+    result.message = QStringLiteral("已取消");
+    if (!m_watcher->isCanceled() && m_watcher->future().resultCount() > 0) {
+        result = m_watcher->result();
+    }
+
+    m_processedFiles = qMax(0, m_watcher->progressValue() - m_watcher->progressMinimum());
+    m_resultFolder = result.folder;
+    m_groups = result.groups;
+    m_problems = result.problems;
+    emit groupsChanged();
+    emit problemsChanged();
+    emit progressChanged();
+    setStatusMessage(result.message);
+    emit finished(result.success, result.message);
+    emit runningChanged();
+}
+
+void DuplicateFileTool::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
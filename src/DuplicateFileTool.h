@@ -0,0 +1,113 @@
+#ifndef DUPLICATEFILETOOL_H
+#define DUPLICATEFILETOOL_H
+
+#include "DuplicateFinder.h"
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+#include <atomic>
+#include <memory>
+
+// 重复文件查找：按大小、首尾摘要、完整摘要三步筛选，结果按组列出并统计可释放的空间。
+// 遍历与读取都在线程池中进行，界面线程只接收进度与结果。
+class DuplicateFileTool : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString folderPath READ folderPath WRITE setFolderPath NOTIFY folderPathChanged)
+    // 完整比较使用的摘要
+    Q_PROPERTY(QString algorithm READ algorithm WRITE setAlgorithm NOTIFY algorithmChanged)
+    // 小于该字节数的文件不参与比较
+    Q_PROPERTY(qint64 minimumSize READ minimumSize WRITE setMinimumSize NOTIFY minimumSizeChanged)
+    // 同时读取的文件数，文件在机械硬盘上时设为 1 可避免磁头来回寻道
+    Q_PROPERTY(int threadCount READ threadCount WRITE setThreadCount NOTIFY threadCountChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    // 0 按大小分组，1 比较首尾，2 完整比较
+    Q_PROPERTY(int stage READ stage NOTIFY progressChanged)
+    Q_PROPERTY(int totalFiles READ totalFiles NOTIFY progressChanged)
+    Q_PROPERTY(int processedFiles READ processedFiles NOTIFY progressChanged)
+    // 每组为 { size, digest, paths, reclaimable }
+    Q_PROPERTY(QVariantList groups READ groups NOTIFY groupsChanged)
+    Q_PROPERTY(int groupCount READ groupCount NOTIFY groupsChanged)
+    // 除每组第一个文件外的重复文件数
+    Q_PROPERTY(int duplicateCount READ duplicateCount NOTIFY groupsChanged)
+    Q_PROPERTY(qint64 reclaimableBytes READ reclaimableBytes NOTIFY groupsChanged)
+    Q_PROPERTY(QStringList problems READ problems NOTIFY problemsChanged)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    explicit DuplicateFileTool(QObject *parent = nullptr);
+    ~DuplicateFileTool() override;
+
+    QString folderPath() const;
+    void setFolderPath(const QString &folderPath);
+
+    QString algorithm() const;
+    void setAlgorithm(const QString &algorithm);
+
+    qint64 minimumSize() const;
+    void setMinimumSize(qint64 minimumSize);
+
+    int threadCount() const;
+    void setThreadCount(int threadCount);
+
+    bool running() const;
+    int stage() const;
+    int totalFiles() const;
+    int processedFiles() const;
+    QVariantList groups() const;
+    int groupCount() const;
+    int duplicateCount() const;
+    qint64 reclaimableBytes() const;
+    QStringList problems() const;
+    QString statusMessage() const;
+
+    Q_INVOKABLE void scan();
+    Q_INVOKABLE void cancel();
+    // 结果的纯文本形式，每组先列大小与摘要，再逐行列出文件的完整路径
+    Q_INVOKABLE QString report() const;
+
+signals:
+    void folderPathChanged();
+    void algorithmChanged();
+    void minimumSizeChanged();
+    void threadCountChanged();
+    void runningChanged();
+    void progressChanged();
+    void groupsChanged();
+    void problemsChanged();
+    void statusMessageChanged();
+    void finished(bool success, const QString &message);
+
+private:
+    struct RunResult {
+        bool success = false;
+        QString message;
+        QString folder;
+        QList<DuplicateFinder::Group> groups;
+        QStringList problems;
+    };
+
+    void onProgressValueChanged(int value);
+    void onFinished();
+    void setStatusMessage(const QString &message);
+
+    QString m_folderPath;
+    QString m_algorithm;
+    qint64 m_minimumSize;
+    int m_threadCount;
+    QString m_statusMessage;
+    QString m_resultFolder;
+    QList<DuplicateFinder::Group> m_groups;
+    QStringList m_problems;
+    int m_processedFiles;
+
+    // 工作线程写入当前步骤，上一次任务可能尚未结束，因此每次任务单独创建
+    std::shared_ptr<std::atomic<int>> m_stage;
+    QFutureWatcher<RunResult> *m_watcher;
+};
+
+#endif // DUPLICATEFILETOOL_H
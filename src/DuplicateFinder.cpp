@@ -0,0 +1,311 @@
+#include "DuplicateFinder.h"
+#include "FileDigest.h"
+#include "HashCache.h"
+#include "XXH3.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+// 逐个或在独立线程池中处理 indices；blockingMap 的调用线程也参与处理，池中只需再开 threadCount - 1 个线程
+template <typename Function>
+void forEachParallel(const QList<qsizetype> &indices, int threadCount, Function function)
+{
+    if (threadCount <= 1) {
+        for (qsizetype index : indices) {
+            function(index);
+        }
+        return;
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount - 1);
+    QtConcurrent::blockingMap(&pool, indices, [&function](const qsizetype &index) {
+        function(index);
+    });
+}
+
+// 把 indices 按 key 分组，只返回至少两个成员的组；组内保持 indices 中的顺序
+template <typename Key, typename KeyFunction>
+QList<QList<qsizetype>> collisions(const QList<qsizetype> &indices, KeyFunction key)
+{
+    QHash<Key, qsizetype> slots;
+    QList<QList<qsizetype>> groups;
+    for (qsizetype index : indices) {
+        auto it = slots.find(key(index));
+        if (it == slots.end()) {
+            it = slots.insert(key(index), groups.size());
+            groups.append(QList<qsizetype>());
+        }
+        groups[it.value()].append(index);
+    }
+    QList<QList<qsizetype>> result;
+    for (QList<qsizetype> &group : groups) {
+        if (group.size() > 1) {
+            result.append(std::move(group));
+        }
+    }
+    return result;
+}
+
+QList<qsizetype> flatten(const QList<QList<qsizetype>> &groups)
+{
+    QList<qsizetype> result;
+    for (const QList<qsizetype> &group : groups) {
+        result.append(group);
+    }
+    // 按原列表（目录顺序）读取，机械硬盘上磁头来回移动更少
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}
+
+QList<DuplicateFinder::File> DuplicateFinder::collectFiles(const QString &root, qint64 minimumSize)
+{
+    const QDir rootDir(root);
+    QList<QPair<QPair<QString, QString>, qint64>> files;
+    QDirIterator it(root, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        const QFileInfo info = it.fileInfo();
+        if (info.isSymLink() || info.size() < qMax<qint64>(minimumSize, 0)) {
+            continue;
+        }
+        const QString relative = rootDir.relativeFilePath(path);
+        const qsizetype slash = relative.lastIndexOf('/');
+        files.append({{slash < 0 ? QString() : relative.left(slash), relative.mid(slash + 1)}, info.size()});
+    }
+    std::sort(files.begin(), files.end());
+
+    QList<File> result;
+    result.reserve(files.size());
+    for (const auto &file : std::as_const(files)) {
+        const QPair<QString, QString> &name = file.first;
+        result.append({name.first.isEmpty() ? name.second : name.first + '/' + name.second, file.second});
+    }
+    return result;
+}
+
+bool DuplicateFinder::edgeDigest(const QString &path, qint64 size, const QString &algorithm, QByteArray *digest,
+                                 bool *complete, QString *errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) {
+            *errorMessage = file.errorString();
+        }
+        return false;
+    }
+
+    QByteArray head = file.read(qMin(size, 2 * kEdgeLength));
+    if (size <= 2 * kEdgeLength) {
+        std::unique_ptr<FileDigest> full = FileDigest::create(algorithm);
+        if (!full) {
+            if (errorMessage) {
+                *errorMessage = QStringLiteral("不支持的哈希算法: %1").arg(algorithm);
+            }
+            return false;
+        }
+        if (head.size() != size) {
+            if (errorMessage) {
+                *errorMessage = QStringLiteral("文件读取不完整");
+            }
+            return false;
+        }
+        full->addData(head.constData(), head.size());
+        *digest = full->result();
+        *complete = true;
+        return true;
+    }
+
+    head.truncate(kEdgeLength);
+    QByteArray tail;
+    if (file.seek(size - kEdgeLength)) {
+        tail = file.read(kEdgeLength);
+    }
+    if (head.size() != kEdgeLength || tail.size() != kEdgeLength) {
+        if (errorMessage) {
+            *errorMessage = file.error() != QFileDevice::NoError ? file.errorString() : QStringLiteral("文件读取不完整");
+        }
+        return false;
+    }
+    XXH3 hash(XXH3::Bits128);
+    hash.addData(head);
+    hash.addData(tail);
+    *digest = hash.result();
+    *complete = false;
+    return true;
+}
+
+QList<DuplicateFinder::Group> DuplicateFinder::find(const QString &root, const QList<File> &files,
+                                                    const QString &algorithm, int threadCount,
+                                                    const ProgressFunction &progress, QStringList *errors,
+                                                    bool *canceled)
+{
+    const QDir rootDir(root);
+    std::atomic<bool> stop(false);
+    const auto finish = [&]() {
+        if (canceled) {
+            *canceled = stop.load();
+        }
+    };
+    const auto report = [&](Stage stage, int processed, int total) {
+        if (progress && !progress(stage, processed, total)) {
+            stop.store(true);
+        }
+    };
+
+    // 1. 按大小分组；同一文件的硬链接（设备与 inode 相同）只保留路径最靠前的一个
+    QList<qsizetype> all(files.size());
+    std::iota(all.begin(), all.end(), 0);
+    const QList<QList<qsizetype>> sameSize = collisions<qint64>(all, [&files](qsizetype i) {
+        return files.at(i).size;
+    });
+    QList<qsizetype> candidates;
+    int linkProcessed = 0;
+    int linkTotal = 0;
+    for (const QList<qsizetype> &group : sameSize) {
+        linkTotal += int(group.size());
+    }
+    report(Stage::Size, 0, linkTotal);
+    for (const QList<qsizetype> &group : sameSize) {
+        QSet<QByteArray> identities;
+        for (qsizetype index : group) {
+            HashCache::FileKey key;
+            const bool known = HashCache::fileKey(rootDir.filePath(files.at(index).path), &key);
+            if (!known || !identities.contains(key.identity)) {
+                identities.insert(key.identity);
+                candidates.append(index);
+            }
+            report(Stage::Size, ++linkProcessed, linkTotal);
+        }
+        if (stop.load()) {
+            finish();
+            return {};
+        }
+    }
+    candidates = flatten(collisions<qint64>(candidates, [&files](qsizetype i) {
+        return files.at(i).size;
+    }));
+
+    // 2. 同大小的文件比较首尾
+    QList<QByteArray> digests(files.size());
+    QList<bool> complete(files.size(), false);
+    QList<QString> failures(files.size());
+    std::atomic<int> processed(0);
+    const int edgeTotal = int(candidates.size());
+    report(Stage::Edge, 0, edgeTotal);
+    forEachParallel(candidates, threadCount, [&](qsizetype index) {
+        if (stop.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const File &file = files.at(index);
+        bool whole = false;
+        QString errorMessage;
+        if (edgeDigest(rootDir.filePath(file.path), file.size, algorithm, &digests[index], &whole, &errorMessage)) {
+            complete[index] = whole;
+        } else {
+            failures[index] = errorMessage;
+        }
+        report(Stage::Edge, ++processed, edgeTotal);
+    });
+    if (stop.load()) {
+        finish();
+        return {};
+    }
+
+    const auto readable = [&failures](const QList<qsizetype> &indices) {
+        QList<qsizetype> result;
+        for (qsizetype index : indices) {
+            if (failures.at(index).isEmpty()) {
+                result.append(index);
+            }
+        }
+        return result;
+    };
+    const auto sizeAndDigest = [&files, &digests](qsizetype i) {
+        return qMakePair(files.at(i).size, digests.at(i));
+    };
+    QList<QList<qsizetype>> confirmed;
+    QList<qsizetype> fullCandidates;
+    for (const QList<qsizetype> &group : collisions<QPair<qint64, QByteArray>>(readable(candidates), sizeAndDigest)) {
+        // 小文件在第 2 步已经读完，摘要就是最终结果
+        if (complete.at(group.constFirst())) {
+            confirmed.append(group);
+        } else {
+            fullCandidates.append(group);
+        }
+    }
+    std::sort(fullCandidates.begin(), fullCandidates.end());
+
+    // 3. 首尾仍相同的文件完整比较
+    processed.store(0);
+    const int fullTotal = int(fullCandidates.size());
+    report(Stage::Full, 0, fullTotal);
+    forEachParallel(fullCandidates, threadCount, [&](qsizetype index) {
+        if (stop.load(std::memory_order_relaxed)) {
+            return;
+        }
+        const FileDigest::FileResult result = FileDigest::hashFile(
+            rootDir.filePath(files.at(index).path), {algorithm}, [&stop](qint64, qint64) {
+                return !stop.load(std::memory_order_relaxed);
+            });
+        if (result.canceled) {
+            return;
+        }
+        if (result.success) {
+            digests[index] = result.digests.value(0);
+        } else {
+            failures[index] = result.errorMessage;
+        }
+        report(Stage::Full, ++processed, fullTotal);
+    });
+    if (stop.load()) {
+        finish();
+        return {};
+    }
+    confirmed.append(collisions<QPair<qint64, QByteArray>>(readable(fullCandidates), sizeAndDigest));
+
+    if (errors) {
+        for (qsizetype i = 0; i < files.size(); ++i) {
+            if (!failures.at(i).isEmpty()) {
+                errors->append(QStringLiteral("[读取失败] %1: %2").arg(files.at(i).path, failures.at(i)));
+            }
+        }
+    }
+
+    QList<Group> groups;
+    groups.reserve(confirmed.size());
+    for (const QList<qsizetype> &members : std::as_const(confirmed)) {
+        Group group;
+        group.size = files.at(members.constFirst()).size;
+        group.digest = digests.at(members.constFirst()).toHex();
+        for (qsizetype index : members) {
+            group.paths.append(files.at(index).path);
+        }
+        std::sort(group.paths.begin(), group.paths.end());
+        groups.append(group);
+    }
+    std::sort(groups.begin(), groups.end(), [](const Group &a, const Group &b) {
+        if (a.reclaimableBytes() != b.reclaimableBytes()) {
+            return a.reclaimableBytes() > b.reclaimableBytes();
+        }
+        return a.paths.constFirst() < b.paths.constFirst();
+    });
+    finish();
+    return groups;
+}
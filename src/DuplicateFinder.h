@@ -0,0 +1,60 @@
+#ifndef DUPLICATEFINDER_H
+#define DUPLICATEFINDER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+// 查找内容相同的文件，分三步逐步缩小范围，只有到最后仍然相同的文件才会被完整读取：
+//   1. 按大小分组，大小唯一的文件直接排除（只需遍历目录）；
+//   2. 同大小的文件比较首尾各 64 KiB 的 XXH3-128，不超过 128 KiB 的文件在这一步就读完整个文件；
+//   3. 首尾仍相同的文件完整计算摘要。
+// 第 2、3 步用独立的线程池并行读取，同一文件的多个硬链接只算一个。
+class DuplicateFinder
+{
+public:
+    // 第 2 步从文件开头和结尾各读取的字节数
+    static constexpr qint64 kEdgeLength = 64 * 1024;
+
+    struct File {
+        // 相对 collectFiles 的 root，分隔符为 '/'
+        QString path;
+        qint64 size = 0;
+    };
+
+    struct Group {
+        qint64 size = 0;
+        // 小写十六进制摘要
+        QByteArray digest;
+        // 按路径排序
+        QStringList paths;
+
+        // 每组只保留一份时可以释放的空间
+        qint64 reclaimableBytes() const { return size * (paths.size() - 1); }
+    };
+
+    enum class Stage { Size, Edge, Full };
+
+    // 每一步开始时以 processed = 0 调用一次，之后每处理完一个文件调用一次，可能来自不同的工作线程；返回 false 时取消
+    using ProgressFunction = std::function<bool(Stage stage, int processed, int total)>;
+
+    // 递归列出 root 下不小于 minimumSize 的普通文件（不进入目录符号链接），按目录、再按文件名排序
+    static QList<File> collectFiles(const QString &root, qint64 minimumSize = 1);
+
+    // 在 root 下的 files 中查找重复文件，algorithm 为完整比较使用的摘要（FileDigest 支持的算法名）。
+    // threadCount 就是同时读取的文件数，机械硬盘上应设为 1。
+    // 结果按可释放空间从大到小排列；无法读取的文件写入 errors 并排除。被取消时返回空列表并置 canceled
+    static QList<Group> find(const QString &root, const QList<File> &files, const QString &algorithm, int threadCount,
+                             const ProgressFunction &progress = ProgressFunction(), QStringList *errors = nullptr,
+                             bool *canceled = nullptr);
+
+    // 第 2 步的摘要：文件不超过 2 * kEdgeLength 时直接用 algorithm 计算整个文件并置 complete，
+    // 否则为首尾各 kEdgeLength 字节的 XXH3-128
+    static bool edgeDigest(const QString &path, qint64 size, const QString &algorithm, QByteArray *digest,
+                           bool *complete, QString *errorMessage = nullptr);
+};
+
+#endif // DUPLICATEFINDER_H
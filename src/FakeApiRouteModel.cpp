@@ -0,0 +1,108 @@
+#include "FakeApiRouteModel.h"
+
+FakeApiRouteModel::FakeApiRouteModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int FakeApiRouteModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_routes.size();
+}
+
+QVariant FakeApiRouteModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_routes.size()) {
+        return QVariant();
+    }
+
+    const QVariantMap route = m_routes.at(index.row()).toMap();
+    switch (role) {
+    case Qt::DisplayRole:
+    case PathRole:
+        return route.value("path");
+    case MethodsRole:
+        return route.value("methods");
+    case StatusCodeRole:
+        return route.value("statusCode");
+    case EnabledRole:
+        return route.value("enabled");
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> FakeApiRouteModel::roleNames() const
+{
+    return {
+        {PathRole, "path"},
+        {MethodsRole, "methods"},
+        {StatusCodeRole, "statusCode"},
+        {EnabledRole, "enabled"}
+    };
+}
+
+const QVariantList &FakeApiRouteModel::routes() const
+{
+    return m_routes;
+}
+
+QVariantMap FakeApiRouteModel::routeAt(int index) const
+{
+    if (index >= 0 && index < m_routes.size()) {
+        return m_routes.at(index).toMap();
+    }
+    return QVariantMap();
+}
+
+void FakeApiRouteModel::appendRoute(const QVariantMap &route)
+{
+    appendRoutes(QVariantList{route});
+}
+
+void FakeApiRouteModel::appendRoutes(const QVariantList &routes)
+{
+    if (routes.isEmpty()) {
+        return;
+    }
+
+    const int first = m_routes.size();
+    beginInsertRows(QModelIndex(), first, first + routes.size() - 1);
+    m_routes.append(routes);
+    endInsertRows();
+    emit countChanged();
+}
+
+void FakeApiRouteModel::replaceRoute(int index, const QVariantMap &route)
+{
+    if (index < 0 || index >= m_routes.size()) {
+        return;
+    }
+
+    m_routes[index] = route;
+    const QModelIndex modelIndex = createIndex(index, 0);
+    emit dataChanged(modelIndex, modelIndex);
+}
+
+void FakeApiRouteModel::removeRoute(int index)
+{
+    if (index < 0 || index >= m_routes.size()) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), index, index);
+    m_routes.removeAt(index);
+    endRemoveRows();
+    emit countChanged();
+}
+
+void FakeApiRouteModel::resetRoutes(const QVariantList &routes)
+{
+    beginResetModel();
+    m_routes = routes;
+    endResetModel();
+    emit countChanged();
+}
@@ -0,0 +1,44 @@
+#ifndef FAKEAPIROUTEMODEL_H
+#define FAKEAPIROUTEMODEL_H
+
+#include <QAbstractListModel>
+#include <QVariantList>
+#include <QVariantMap>
+
+// Fake API 路由列表模型：增删改只通知受影响的行，避免整表重建
+class FakeApiRouteModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+    enum RouteRoles {
+        PathRole = Qt::UserRole + 1,
+        MethodsRole,
+        StatusCodeRole,
+        EnabledRole
+    };
+
+    explicit FakeApiRouteModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    const QVariantList &routes() const;
+    QVariantMap routeAt(int index) const;
+
+    void appendRoute(const QVariantMap &route);
+    void appendRoutes(const QVariantList &routes);
+    void replaceRoute(int index, const QVariantMap &route);
+    void removeRoute(int index);
+    void resetRoutes(const QVariantList &routes);
+
+signals:
+    void countChanged();
+
+private:
+    QVariantList m_routes;
+};
+
+#endif // FAKEAPIROUTEMODEL_H
@@ -7,6 +7,13 @@
 #include <QThread>
 #include <QFileDialog>
 #include <QStandardPaths>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+// 每个事件循环周期插入的路由数，保证大规范导入时界面不卡顿
+const int kImportBatchSize = 200;
+}
 
 FakeApiServer::FakeApiServer(QObject *parent)
     : QObject(parent)
@@ -14,9 +21,19 @@ FakeApiServer::FakeApiServer(QObject *parent)
     , m_port(3000)
     , m_isRunning(false)
     , m_requestCount(0)
+    , m_routeModel(new FakeApiRouteModel(this))
     , m_selectedIndex(-1)
+    , m_routeIndexDirty(true)
+    , m_importWatcher(new QFutureWatcher<OpenApiImporter::Result>(this))
+    , m_pendingImportOffset(0)
+    , m_importBatchTimer(new QTimer(this))
 {
     connect(m_server, &QTcpServer::newConnection, this, &FakeApiServer::onNewConnection);
+    connect(m_importWatcher, &QFutureWatcher<OpenApiImporter::Result>::finished,
+            this, &FakeApiServer::onOpenApiParsed);
+    m_importBatchTimer->setSingleShot(true);
+    m_importBatchTimer->setInterval(0);
+    connect(m_importBatchTimer, &QTimer::timeout, this, &FakeApiServer::appendImportBatch);
 }
 
 FakeApiServer::~FakeApiServer()
@@ -54,7 +71,22 @@ int FakeApiServer::requestCount() const
 
 QVariantList FakeApiServer::routes() const
 {
-    return m_routes;
+    return m_routeModel->routes();
+}
+
+int FakeApiServer::routeCount() const
+{
+    return m_routeModel->rowCount();
+}
+
+QAbstractListModel *FakeApiServer::routeModel() const
+{
+    return m_routeModel;
+}
+
+bool FakeApiServer::isImporting() const
+{
+    return m_importWatcher->isRunning() || m_pendingImportOffset < m_pendingImport.size();
 }
 
 int FakeApiServer::selectedIndex() const
@@ -85,7 +117,7 @@ bool FakeApiServer::startServer()
         return true;
     }
 
-    if (m_routes.isEmpty()) {
+    if (m_routeModel->rowCount() == 0) {
         setStatusMessage("请先添加至少一个路由");
         emit logMessage("[错误] 未配置任何路由");
         return false;
@@ -113,7 +145,7 @@ bool FakeApiServer::startServer()
     setStatusMessage(successMsg);
     emit logMessage(QString("[启动] %1").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")));
     emit logMessage(QString("[信息] 监听端口: %1").arg(m_port));
-    emit logMessage(QString("[信息] 已配置 %1 个路由").arg(m_routes.size()));
+    emit logMessage(QString("[信息] 已配置 %1 个路由").arg(m_routeModel->rowCount()));
 
     return true;
 }
@@ -134,6 +166,7 @@ void FakeApiServer::stopServer()
 
 void FakeApiServer::addRoute(const QString &path)
 {
+    cancelImport();
     QVariantMap route;
     route["path"] = path.isEmpty() ? "/api/new" : path;
     route["methods"] = QVariantList{"GET"};
@@ -144,22 +177,22 @@ void FakeApiServer::addRoute(const QString &path)
     route["delay"] = 0;
     route["enabled"] = true;
     
-    m_routes.append(route);
-    emit routesChanged();
+    m_routeModel->appendRoute(route);
+    markRoutesChanged();
     
     // 自动选中新添加的路由
-    setSelectedIndex(m_routes.size() - 1);
+    setSelectedIndex(m_routeModel->rowCount() - 1);
 }
 
 void FakeApiServer::removeRoute(int index)
 {
-    if (index >= 0 && index < m_routes.size()) {
-        m_routes.removeAt(index);
-        emit routesChanged();
+    if (index >= 0 && index < m_routeModel->rowCount()) {
+        m_routeModel->removeRoute(index);
+        markRoutesChanged();
         
         // 调整选中索引
-        if (m_selectedIndex >= m_routes.size()) {
-            setSelectedIndex(m_routes.size() - 1);
+        if (m_selectedIndex >= m_routeModel->rowCount()) {
+            setSelectedIndex(m_routeModel->rowCount() - 1);
         } else if (m_selectedIndex == index) {
             setSelectedIndex(-1);
         }
@@ -168,32 +201,30 @@ void FakeApiServer::removeRoute(int index)
 
 void FakeApiServer::updateRoute(int index, const QVariantMap &routeData)
 {
-    if (index >= 0 && index < m_routes.size()) {
-        m_routes[index] = routeData;
-        emit routesChanged();
+    if (index >= 0 && index < m_routeModel->rowCount()) {
+        m_routeModel->replaceRoute(index, routeData);
+        markRoutesChanged();
     }
 }
 
 QVariantMap FakeApiServer::getRoute(int index) const
 {
-    if (index >= 0 && index < m_routes.size()) {
-        return m_routes[index].toMap();
-    }
-    return QVariantMap();
+    return m_routeModel->routeAt(index);
 }
 
 void FakeApiServer::clearRoutes()
 {
-    m_routes.clear();
+    cancelImport();
+    m_routeModel->resetRoutes(QVariantList());
     m_selectedIndex = -1;
-    emit routesChanged();
+    markRoutesChanged();
     emit selectedIndexChanged();
 }
 
 QString FakeApiServer::exportRoutes() const
 {
     QJsonArray arr;
-    for (const QVariant &route : m_routes) {
+    for (const QVariant &route : m_routeModel->routes()) {
         arr.append(QJsonObject::fromVariantMap(route.toMap()));
     }
     QJsonDocument doc(arr);
@@ -216,16 +247,19 @@ bool FakeApiServer::importRoutes(const QString &json)
     }
     
     QJsonArray arr = doc.array();
-    m_routes.clear();
+    QVariantList routes;
+    routes.reserve(arr.size());
     
     for (const QJsonValue &val : arr) {
         if (val.isObject()) {
-            m_routes.append(val.toObject().toVariantMap());
+            routes.append(val.toObject().toVariantMap());
         }
     }
     
-    emit routesChanged();
-    emit logMessage(QString("[信息] 成功导入 %1 个路由").arg(m_routes.size()));
+    cancelImport();
+    m_routeModel->resetRoutes(routes);
+    markRoutesChanged();
+    emit logMessage(QString("[信息] 成功导入 %1 个路由").arg(routes.size()));
     return true;
 }
 
@@ -247,7 +281,7 @@ bool FakeApiServer::exportToFile(const QString &filePath) const
     root["port"] = m_port;
     
     QJsonArray routesArr;
-    for (const QVariant &route : m_routes) {
+    for (const QVariant &route : m_routeModel->routes()) {
         routesArr.append(QJsonObject::fromVariantMap(route.toMap()));
     }
     root["routes"] = routesArr;
@@ -279,8 +313,19 @@ bool FakeApiServer::importFromFile(const QString &filePath)
     QJsonDocument doc = QJsonDocument::fromJson(data, &error);
     
     if (error.error != QJsonParseError::NoError) {
-        emit logMessage("[错误] 文件解析失败: " + error.errorString());
-        return false;
+        // 非 JSON 配置时按 OpenAPI（YAML）规范导入；YAML 解析与格式判断都在工作线程中进行，
+        // 不是规范时由 importFinished(false) 报告
+        return startOpenApiImport(localPath, [data]() {
+            return OpenApiImporter::importData(data);
+        });
+    }
+    
+    if (doc.isObject() && (doc.object().contains("openapi") || doc.object().contains("swagger"))) {
+        // 已解析的 JSON 直接交给工作线程转换，不再读取与解析一遍
+        const QJsonObject root = doc.object();
+        return startOpenApiImport(localPath, [root]() {
+            return OpenApiImporter::importDocument(root);
+        });
     }
     
     if (!doc.isObject()) {
@@ -306,18 +351,21 @@ bool FakeApiServer::importFromFile(const QString &filePath)
     // 恢复路由
     if (root.contains("routes") && root["routes"].isArray()) {
         QJsonArray arr = root["routes"].toArray();
-        m_routes.clear();
+        QVariantList routes;
+        routes.reserve(arr.size());
         m_selectedIndex = -1;
         
         for (const QJsonValue &val : arr) {
             if (val.isObject()) {
-                m_routes.append(val.toObject().toVariantMap());
+                routes.append(val.toObject().toVariantMap());
             }
         }
         
-        emit routesChanged();
+        cancelImport();
+        m_routeModel->resetRoutes(routes);
+        markRoutesChanged();
         emit selectedIndexChanged();
-        emit logMessage(QString("[信息] 成功导入 %1 个路由，端口: %2").arg(m_routes.size()).arg(m_port));
+        emit logMessage(QString("[信息] 成功导入 %1 个路由，端口: %2").arg(routes.size()).arg(m_port));
         return true;
     }
     
@@ -349,6 +397,119 @@ QString FakeApiServer::selectImportFile()
     return filePath;
 }
 
+bool FakeApiServer::importOpenApiFile(const QString &filePath)
+{
+    QString localPath = filePath;
+    if (localPath.startsWith("file:///")) {
+        localPath = QUrl(localPath).toLocalFile();
+    }
+    if (!QFileInfo::exists(localPath)) {
+        emit logMessage("[错误] 无法打开文件: " + localPath);
+        return false;
+    }
+
+    return startOpenApiImport(localPath, [localPath]() {
+        return OpenApiImporter::importFile(localPath);
+    });
+}
+
+bool FakeApiServer::startOpenApiImport(const QString &localPath, const std::function<OpenApiImporter::Result()> &task)
+{
+    if (isImporting()) {
+        emit logMessage("[错误] 正在导入，请稍候");
+        return false;
+    }
+
+    emit logMessage(QString("[信息] 正在解析 OpenAPI 规范: %1").arg(QFileInfo(localPath).fileName()));
+    m_importWatcher->setFuture(QtConcurrent::run(task));
+    emit isImportingChanged();
+    return true;
+}
+
+QString FakeApiServer::selectOpenApiFile()
+{
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    QString filePath = QFileDialog::getOpenFileName(
+        nullptr,
+        "导入 OpenAPI / Swagger 规范",
+        defaultPath,
+        "OpenAPI 规范 (*.json *.yaml *.yml);;所有文件 (*.*)"
+    );
+    return filePath;
+}
+
+void FakeApiServer::onOpenApiParsed()
+{
+    // 解析期间被 cancelImport() 放弃，importFinished(false) 已经发出
+    if (m_importWatcher->isCanceled()) {
+        emit isImportingChanged();
+        return;
+    }
+
+    const OpenApiImporter::Result result = m_importWatcher->result();
+    if (!result.success) {
+        emit logMessage("[错误] " + result.errorMessage);
+        emit isImportingChanged();
+        emit importFinished(false);
+        return;
+    }
+
+    emit logMessage(QString("[信息] %1 (OpenAPI %2): %3 个接口")
+        .arg(result.title.isEmpty() ? QString("未命名规范") : result.title, result.specVersion)
+        .arg(result.routes.size()));
+
+    // 替换现有路由，后续分批插入，列表只创建可见行的委托
+    m_routeModel->resetRoutes(QVariantList());
+    m_selectedIndex = -1;
+    emit selectedIndexChanged();
+    markRoutesChanged();
+
+    m_pendingImport = result.routes;
+    m_pendingImportOffset = 0;
+    appendImportBatch();
+}
+
+void FakeApiServer::appendImportBatch()
+{
+    const int remaining = m_pendingImport.size() - m_pendingImportOffset;
+    if (remaining > 0) {
+        const int count = qMin(kImportBatchSize, remaining);
+        m_routeModel->appendRoutes(m_pendingImport.mid(m_pendingImportOffset, count));
+        m_pendingImportOffset += count;
+        markRoutesChanged();
+    }
+
+    if (m_pendingImportOffset < m_pendingImport.size()) {
+        m_importBatchTimer->start();
+        return;
+    }
+
+    emit logMessage(QString("[信息] 成功导入 %1 个路由").arg(m_pendingImport.size()));
+    m_pendingImport.clear();
+    m_pendingImportOffset = 0;
+    emit isImportingChanged();
+    emit importFinished(true);
+}
+
+void FakeApiServer::cancelImport()
+{
+    if (!isImporting()) {
+        return;
+    }
+
+    // 后台解析无法中途停下，取消后 onOpenApiParsed() 丢弃它的结果
+    const bool parsing = m_importWatcher->isRunning();
+    m_importWatcher->cancel();
+    m_importBatchTimer->stop();
+    m_pendingImport.clear();
+    m_pendingImportOffset = 0;
+    emit logMessage("[信息] 路由列表已改动，取消未完成的 OpenAPI 导入");
+    if (!parsing) {
+        emit isImportingChanged();
+    }
+    emit importFinished(false);
+}
+
 void FakeApiServer::onNewConnection()
 {
     while (m_server->hasPendingConnections()) {
@@ -375,42 +536,109 @@ void FakeApiServer::onDisconnected()
     }
 }
 
-int FakeApiServer::findMatchingRoute(const QString &method, const QString &path)
+void FakeApiServer::markRoutesChanged()
 {
-    for (int i = 0; i < m_routes.size(); ++i) {
-        QVariantMap route = m_routes[i].toMap();
-        
+    m_routeIndexDirty = true;
+    emit routesChanged();
+}
+
+bool FakeApiServer::methodAllowed(const QStringList &methods, const QString &method)
+{
+    return methods.contains(method, Qt::CaseInsensitive);
+}
+
+void FakeApiServer::rebuildRouteIndex()
+{
+    m_exactRoutes.clear();
+    m_patternRoutes.clear();
+
+    static const QRegularExpression paramPattern("\\{[^/{}]+\\}");
+    const QVariantList &routes = m_routeModel->routes();
+    for (int i = 0; i < routes.size(); ++i) {
+        const QVariantMap route = routes[i].toMap();
         if (!route["enabled"].toBool()) {
             continue;
         }
-        
-        QString routePath = route["path"].toString();
-        QVariantList methods = route["methods"].toList();
-        
-        // 检查方法是否匹配
-        bool methodMatch = false;
-        for (const QVariant &m : methods) {
-            if (m.toString().toUpper() == method.toUpper()) {
-                methodMatch = true;
+
+        RouteMatcher matcher;
+        matcher.index = i;
+        for (const QVariant &m : route["methods"].toList()) {
+            matcher.methods.append(m.toString().toUpper());
+        }
+
+        const QString routePath = route["path"].toString();
+        if (!routePath.contains('*') && !routePath.contains('{')) {
+            m_exactRoutes[routePath].append(matcher);
+            continue;
+        }
+
+        // 通配符 * 匹配任意字符，OpenAPI 风格的 {param} 匹配单个路径段
+        QString pattern;
+        int last = 0;
+        QRegularExpressionMatchIterator it = paramPattern.globalMatch(routePath);
+        auto appendLiteral = [&pattern](const QString &literal) {
+            pattern += QRegularExpression::escape(literal).replace("\\*", ".*");
+        };
+        while (it.hasNext()) {
+            const QRegularExpressionMatch match = it.next();
+            appendLiteral(routePath.mid(last, match.capturedStart() - last));
+            pattern += "[^/]+";
+            last = match.capturedEnd();
+        }
+        appendLiteral(routePath.mid(last));
+
+        matcher.pattern = QRegularExpression(QRegularExpression::anchoredPattern(pattern));
+        matcher.pattern.optimize();
+        m_patternRoutes.append(matcher);
+    }
+
+    m_routeIndexDirty = false;
+}
+
+int FakeApiServer::findMatchingRoute(const QString &method, const QString &path)
+{
+    if (m_routeIndexDirty) {
+        rebuildRouteIndex();
+    }
+
+    // 保持“按列表顺序第一个匹配”的语义：精确匹配与模式匹配取较小的下标
+    int best = -1;
+    const auto exact = m_exactRoutes.constFind(path);
+    if (exact != m_exactRoutes.constEnd()) {
+        for (const RouteMatcher &matcher : *exact) {
+            if (methodAllowed(matcher.methods, method)) {
+                best = matcher.index;
                 break;
             }
         }
-        if (!methodMatch) continue;
-        
-        // 简单路径匹配（支持通配符*）
-        QString pattern = routePath;
-        pattern.replace("*", ".*");
-        QRegularExpression regex("^" + pattern + "$");
-        if (regex.match(path).hasMatch()) {
-            return i;
+    }
+
+    for (const RouteMatcher &matcher : std::as_const(m_patternRoutes)) {
+        if (best >= 0 && matcher.index > best) {
+            break;
         }
-        
-        // 精确匹配
-        if (routePath == path) {
-            return i;
+        if (methodAllowed(matcher.methods, method) && matcher.pattern.match(path).hasMatch()) {
+            return matcher.index;
+        }
+    }
+    return best;
+}
+
+bool FakeApiServer::hasRouteForPath(const QString &path)
+{
+    if (m_routeIndexDirty) {
+        rebuildRouteIndex();
+    }
+
+    if (m_exactRoutes.contains(path)) {
+        return true;
+    }
+    for (const RouteMatcher &matcher : std::as_const(m_patternRoutes)) {
+        if (matcher.pattern.match(path).hasMatch()) {
+            return true;
         }
     }
-    return -1;
+    return false;
 }
 
 void FakeApiServer::handleRequest(QTcpSocket *socket, const QByteArray &requestData)
@@ -447,13 +675,10 @@ void FakeApiServer::handleRequest(QTcpSocket *socket, const QByteArray &requestD
     
     if (matchedIndex < 0) {
         // 检查是否有路径匹配但方法不匹配
-        for (int i = 0; i < m_routes.size(); ++i) {
-            QVariantMap route = m_routes[i].toMap();
-            if (route["path"].toString() == path && route["enabled"].toBool()) {
-                sendErrorResponse(socket, 405, "Method Not Allowed");
-                emit logMessage(QString("[405] %1 %2 - 方法不允许").arg(method, path));
-                return;
-            }
+        if (hasRouteForPath(path)) {
+            sendErrorResponse(socket, 405, "Method Not Allowed");
+            emit logMessage(QString("[405] %1 %2 - 方法不允许").arg(method, path));
+            return;
         }
         
         sendErrorResponse(socket, 404, "Not Found");
@@ -461,7 +686,7 @@ void FakeApiServer::handleRequest(QTcpSocket *socket, const QByteArray &requestD
         return;
     }
 
-    QVariantMap route = m_routes[matchedIndex].toMap();
+    QVariantMap route = m_routeModel->routeAt(matchedIndex);
     
     // 获取响应配置
     int statusCode = route["statusCode"].toInt();
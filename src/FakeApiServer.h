@@ -10,6 +10,14 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QHash>
+#include <QRegularExpression>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <functional>
+
+#include "FakeApiRouteModel.h"
+#include "OpenApiImporter.h"
 
 class FakeApiServer : public QObject
 {
@@ -19,6 +27,9 @@ class FakeApiServer : public QObject
     Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
     Q_PROPERTY(int requestCount READ requestCount NOTIFY requestCountChanged)
     Q_PROPERTY(QVariantList routes READ routes NOTIFY routesChanged)
+    Q_PROPERTY(int routeCount READ routeCount NOTIFY routesChanged)
+    Q_PROPERTY(QAbstractListModel *routeModel READ routeModel CONSTANT)
+    Q_PROPERTY(bool isImporting READ isImporting NOTIFY isImportingChanged)
     Q_PROPERTY(int selectedIndex READ selectedIndex WRITE setSelectedIndex NOTIFY selectedIndexChanged)
 
 public:
@@ -33,6 +44,9 @@ public:
     int requestCount() const;
     
     QVariantList routes() const;
+    int routeCount() const;
+    QAbstractListModel *routeModel() const;
+    bool isImporting() const;
     int selectedIndex() const;
     void setSelectedIndex(int index);
 
@@ -54,6 +68,10 @@ public:
     Q_INVOKABLE QString selectExportFile();
     Q_INVOKABLE QString selectImportFile();
 
+    // OpenAPI 3 / Swagger 2 规范导入（后台解析，分批加入路由列表）
+    Q_INVOKABLE bool importOpenApiFile(const QString &filePath);
+    Q_INVOKABLE QString selectOpenApiFile();
+
 signals:
     void portChanged();
     void isRunningChanged();
@@ -61,14 +79,25 @@ signals:
     void requestCountChanged();
     void routesChanged();
     void selectedIndexChanged();
+    void isImportingChanged();
+    // OpenAPI 规范后台导入结束，失败时原因已通过 logMessage 给出
+    void importFinished(bool success);
     void logMessage(const QString &message);
 
 private slots:
     void onNewConnection();
     void onReadyRead();
     void onDisconnected();
+    void onOpenApiParsed();
+    void appendImportBatch();
 
 private:
+    struct RouteMatcher {
+        int index;
+        QStringList methods;
+        QRegularExpression pattern;
+    };
+
     void handleRequest(QTcpSocket *socket, const QByteArray &requestData);
     void sendResponse(QTcpSocket *socket, int statusCode, const QString &statusText,
                       const QString &contentType, const QByteArray &body,
@@ -77,14 +106,33 @@ private:
     void setStatusMessage(const QString &message);
     QString getMimeTypeForResponseType(const QString &responseType) const;
     int findMatchingRoute(const QString &method, const QString &path);
+    bool hasRouteForPath(const QString &path);
+    void rebuildRouteIndex();
+    void markRoutesChanged();
+    // 在工作线程中运行 task 并分批加入结果；正在导入时返回 false
+    bool startOpenApiImport(const QString &localPath, const std::function<OpenApiImporter::Result()> &task);
+    // 清空、新增或整体替换路由时放弃未完成的导入，并发出 importFinished(false)
+    void cancelImport();
+    static bool methodAllowed(const QStringList &methods, const QString &method);
 
     QTcpServer *m_server;
     int m_port;
     bool m_isRunning;
     QString m_statusMessage;
     int m_requestCount;
-    QVariantList m_routes;
+    FakeApiRouteModel *m_routeModel;
     int m_selectedIndex;
+
+    // 路由匹配索引：精确路径走哈希，含 {param} 或 * 的路径预编译正则
+    bool m_routeIndexDirty;
+    QHash<QString, QList<RouteMatcher>> m_exactRoutes;
+    QList<RouteMatcher> m_patternRoutes;
+
+    QFutureWatcher<OpenApiImporter::Result> *m_importWatcher;
+    QVariantList m_pendingImport;
+    int m_pendingImportOffset;
+    // 分批插入的下一批；cancelImport() 时停止
+    QTimer *m_importBatchTimer;
 };
 
 #endif // FAKEAPISERVER_H
@@ -0,0 +1,228 @@
+#include "FileCipher.h"
+#include "BlockCipherContext.h"
+#include "GcmMode.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QPromise>
+#include <QSaveFile>
+#include <QUrl>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <cstring>
+#include <optional>
+
+namespace {
+
+constexpr qsizetype kBlockSize = BlockCipherContext::kBlockSize;
+
+// 读满 length 字节，只有到达文件末尾时才会更少；保证除最后一块外每块都是 16 的倍数
+qint64 readFull(QFile &file, quint8 *buffer, qint64 length)
+{
+    qint64 total = 0;
+    while (total < length) {
+        const qint64 n = file.read(reinterpret_cast<char *>(buffer) + total, length - total);
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        total += n;
+    }
+    return total;
+}
+
+}
+
+FileCipher::Result FileCipher::run(const Options &options, const ProgressFunction &progress)
+{
+    Result result;
+    const qsizetype chunkSize = options.chunkSize;
+    if (chunkSize <= 0 || chunkSize % kBlockSize != 0) {
+        result.errorMessage = QStringLiteral("分块大小必须是16字节的倍数");
+        return result;
+    }
+    if ((options.mode == Mode::CBC || options.mode == Mode::CTR) && options.iv.size() != kBlockSize) {
+        result.errorMessage = QStringLiteral("IV长度必须为16字节（32个十六进制字符）");
+        return result;
+    }
+    if (QFileInfo(options.inputPath).absoluteFilePath() == QFileInfo(options.outputPath).absoluteFilePath()) {
+        result.errorMessage = QStringLiteral("输出文件不能与输入文件相同");
+        return result;
+    }
+
+    QFile input(options.inputPath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        result.errorMessage = QStringLiteral("无法打开文件: %1").arg(options.inputPath);
+        return result;
+    }
+
+    const bool padded = options.mode == Mode::ECB || options.mode == Mode::CBC;
+    const qint64 inputSize = input.size();
+    if (padded && !options.encrypt && (inputSize == 0 || inputSize % kBlockSize != 0)) {
+        result.errorMessage = QStringLiteral("密文长度必须是16字节的倍数");
+        return result;
+    }
+
+    // 写入临时文件，全部成功后才替换目标文件
+    QSaveFile output(options.outputPath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        result.errorMessage = QStringLiteral("无法创建文件: %1").arg(options.outputPath);
+        return result;
+    }
+
+    // 输入缓冲区多留一个分组放置末尾填充
+    QByteArray inBuffer(chunkSize + kBlockSize, Qt::Uninitialized);
+    QByteArray outBuffer(chunkSize + kBlockSize, Qt::Uninitialized);
+    quint8 *in = reinterpret_cast<quint8 *>(inBuffer.data());
+    quint8 *out = reinterpret_cast<quint8 *>(outBuffer.data());
+
+    const bool gcm = options.mode == Mode::GCM;
+    // GCM 解密需要读两遍：先认证，再解密
+    const qint64 total = gcm && !options.encrypt ? inputSize * 2 : inputSize;
+    qint64 processed = 0;
+    const auto report = [&](qint64 length) {
+        processed += length;
+        return !progress || progress(processed, total);
+    };
+
+    std::optional<GcmMode::Stream> gcmStream;
+    if (gcm) {
+        gcmStream.emplace(options.encryptBlocks, options.iv, options.aad);
+    }
+
+    if (gcm && !options.encrypt) {
+        for (;;) {
+            const qint64 n = readFull(input, in, chunkSize);
+            if (n < 0) {
+                result.errorMessage = QStringLiteral("读取文件失败: %1").arg(options.inputPath);
+                return result;
+            }
+            gcmStream->authenticate(in, n);
+            if (!report(n)) {
+                result.canceled = true;
+                return result;
+            }
+            if (input.atEnd()) {
+                break;
+            }
+        }
+        if (!gcmStream->verify(options.tag)) {
+            result.errorMessage = QStringLiteral("认证失败：标签不匹配，密文、附加数据或密钥有误");
+            return result;
+        }
+        input.seek(0);
+    }
+
+    // CBC 的前一密文块，或 CTR 的当前计数器
+    quint8 chain[kBlockSize] = {};
+    if (options.mode == Mode::CBC || options.mode == Mode::CTR) {
+        std::memcpy(chain, options.iv.constData(), kBlockSize);
+    }
+
+    for (;;) {
+        const qint64 n = readFull(input, in, chunkSize);
+        if (n < 0) {
+            result.errorMessage = QStringLiteral("读取文件失败: %1").arg(options.inputPath);
+            return result;
+        }
+        const bool last = input.atEnd();
+        qsizetype length = qsizetype(n);
+
+        switch (options.mode) {
+        case Mode::ECB:
+            if (options.encrypt) {
+                if (last) {
+                    length = BlockCipherContext::pkcs7Pad(in, length);
+                }
+                ParallelBlockCipher::ecb(options.encryptBlocks, in, out, length);
+            } else {
+                ParallelBlockCipher::ecb(options.decryptBlocks, in, out, length);
+            }
+            break;
+        case Mode::CBC:
+            if (options.encrypt) {
+                if (last) {
+                    length = BlockCipherContext::pkcs7Pad(in, length);
+                }
+                // CBC 加密逐块串行
+                for (qsizetype i = 0; i < length; i += kBlockSize) {
+                    for (int j = 0; j < kBlockSize; ++j) {
+                        out[i + j] = in[i + j] ^ chain[j];
+                    }
+                    options.encryptBlocks(out + i, out + i, 1);
+                    std::memcpy(chain, out + i, kBlockSize);
+                }
+            } else if (length > 0) {
+                ParallelBlockCipher::cbcDecrypt(options.decryptBlocks, chain, in, out, length);
+                std::memcpy(chain, in + length - kBlockSize, kBlockSize);
+            }
+            break;
+        case Mode::CTR:
+            ParallelBlockCipher::ctr(options.encryptBlocks, chain, in, out, length);
+            ParallelBlockCipher::advanceCounter(chain, quint64(length / kBlockSize));
+            break;
+        case Mode::GCM:
+            gcmStream->crypt(in, out, length);
+            if (options.encrypt) {
+                gcmStream->authenticate(out, length);
+            }
+            break;
+        }
+
+        if (padded && !options.encrypt && last) {
+            length = BlockCipherContext::pkcs7Unpad(out, length);
+            if (length < 0) {
+                result.errorMessage = QStringLiteral("填充无效：密钥、IV或模式有误");
+                return result;
+            }
+        }
+
+        if (output.write(reinterpret_cast<const char *>(out), length) != length) {
+            result.errorMessage = QStringLiteral("写入文件失败: %1").arg(options.outputPath);
+            return result;
+        }
+        result.bytesWritten += length;
+
+        if (!report(n)) {
+            result.canceled = true;
+            return result;
+        }
+        if (last) {
+            break;
+        }
+    }
+
+    if (gcm && options.encrypt) {
+        result.tag.resize(GcmMode::kTagLength);
+        gcmStream->finish(reinterpret_cast<quint8 *>(result.tag.data()));
+    }
+
+    if (!output.commit()) {
+        result.errorMessage = QStringLiteral("写入文件失败: %1").arg(options.outputPath);
+        return result;
+    }
+
+    result.success = true;
+    return result;
+}
+
+QFuture<FileCipher::Result> FileCipher::start(const Options &options)
+{
+    return QtConcurrent::run([options](QPromise<Result> &promise) {
+        promise.setProgressRange(0, kProgressRange);
+        promise.addResult(run(options, [&promise](qint64 processed, qint64 total) {
+            promise.setProgressValue(total > 0 ? int(processed * kProgressRange / total) : kProgressRange);
+            return !promise.isCanceled();
+        }));
+    });
+}
+
+QString FileCipher::localPath(const QString &pathOrUrl)
+{
+    if (pathOrUrl.startsWith("file:")) {
+        return QUrl(pathOrUrl).toLocalFile();
+    }
+    return pathOrUrl;
+}
@@ -0,0 +1,61 @@
+#ifndef FILECIPHER_H
+#define FILECIPHER_H
+
+#include "ParallelBlockCipher.h"
+
+#include <QByteArray>
+#include <QFuture>
+#include <QString>
+
+#include <functional>
+
+// 文件到文件的分块流式加解密，AES 与 SM4 共用。
+// 固定大小缓冲区逐块读写，CBC 链与 CTR/GCM 计数器跨块延续，只在文件末尾填充/去填充，
+// 内存占用与文件大小无关。不依赖 QObject，可直接在工作线程中运行。
+class FileCipher
+{
+public:
+    enum class Mode { ECB, CBC, CTR, GCM };
+
+    struct Options {
+        Mode mode = Mode::ECB;
+        bool encrypt = true;
+        // 分组加密 / 解密函数（CTR、GCM 只用加密方向），在工作线程中调用，须自行持有密钥
+        ParallelBlockCipher::BlockFunction encryptBlocks;
+        ParallelBlockCipher::BlockFunction decryptBlocks;
+        QByteArray iv;
+        // GCM：附加数据；解密时为待校验的标签
+        QByteArray aad;
+        QByteArray tag;
+        QString inputPath;
+        QString outputPath;
+        // 每次读入的字节数，须为 16 的倍数
+        qsizetype chunkSize = kDefaultChunkSize;
+    };
+
+    struct Result {
+        bool success = false;
+        bool canceled = false;
+        QString errorMessage;
+        qint64 bytesWritten = 0;
+        // GCM 加密输出的 16 字节标签
+        QByteArray tag;
+    };
+
+    // 每处理完一块调用一次；返回 false 表示取消
+    using ProgressFunction = std::function<bool(qint64 processed, qint64 total)>;
+
+    // 失败或取消时不会留下不完整的输出文件；GCM 解密先整文件认证，通过后才写出明文
+    static Result run(const Options &options, const ProgressFunction &progress = ProgressFunction());
+
+    // 在全局线程池中运行；进度范围 0~kProgressRange，可通过 QFuture::cancel() 取消
+    static QFuture<Result> start(const Options &options);
+
+    // QML 文件对话框给出的 file:/// 地址转换为本地路径
+    static QString localPath(const QString &pathOrUrl);
+
+    static constexpr qsizetype kDefaultChunkSize = 4 * 1024 * 1024;
+    static constexpr int kProgressRange = 1000;
+};
+
+#endif // FILECIPHER_H
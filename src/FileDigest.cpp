@@ -0,0 +1,370 @@
+#include "FileDigest.h"
+#include "Blake3.h"
+#include "Crc32.h"
+#include "HashCache.h"
+#include "SM3.h"
+#include "XXH3.h"
+
+#include <QByteArrayView>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QIODevice>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <utility>
+#include <vector>
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 提示内核按顺序预读映射区域，读过的页可以尽早回收
+void adviseSequential(uchar *data, qint64 length)
+{
+#if defined(Q_OS_UNIX) && defined(MADV_SEQUENTIAL)
+    // madvise 要求起始地址按页对齐，QFile::map 返回的地址可能带有页内偏移
+    const quintptr pageSize = quintptr(sysconf(_SC_PAGESIZE));
+    const quintptr begin = quintptr(data) & ~(pageSize - 1);
+    madvise(reinterpret_cast<void *>(begin), size_t(quintptr(data) + quintptr(length) - begin), MADV_SEQUENTIAL);
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(length);
+#endif
+}
+
+class CryptographicHashDigest : public FileDigest
+{
+public:
+    explicit CryptographicHashDigest(QCryptographicHash::Algorithm algorithm)
+        : m_hash(algorithm)
+    {
+    }
+
+    void addData(const char *data, qsizetype length) override
+    {
+        m_hash.addData(QByteArrayView(data, length));
+    }
+
+    QByteArray result() const override
+    {
+        return m_hash.result();
+    }
+
+private:
+    QCryptographicHash m_hash;
+};
+
+class SM3Digest : public FileDigest
+{
+public:
+    void addData(const char *data, qsizetype length) override
+    {
+        m_sm3.addData(data, length);
+    }
+
+    QByteArray result() const override
+    {
+        return m_sm3.result();
+    }
+
+private:
+    SM3 m_sm3;
+};
+
+class Blake3Digest : public FileDigest
+{
+public:
+    void addData(const char *data, qsizetype length) override
+    {
+        m_blake3.addData(data, length);
+    }
+
+    QByteArray result() const override
+    {
+        return m_blake3.result();
+    }
+
+private:
+    Blake3 m_blake3;
+};
+
+class Crc32Digest : public FileDigest
+{
+public:
+    explicit Crc32Digest(Crc32::Variant variant)
+        : m_crc(variant)
+    {
+    }
+
+    void addData(const char *data, qsizetype length) override
+    {
+        m_crc.addData(data, length);
+    }
+
+    QByteArray result() const override
+    {
+        return m_crc.result();
+    }
+
+private:
+    Crc32 m_crc;
+};
+
+class XXH3Digest : public FileDigest
+{
+public:
+    explicit XXH3Digest(XXH3::Width width)
+        : m_xxh3(width)
+    {
+    }
+
+    void addData(const char *data, qsizetype length) override
+    {
+        m_xxh3.addData(data, length);
+    }
+
+    QByteArray result() const override
+    {
+        return m_xxh3.result();
+    }
+
+private:
+    XXH3 m_xxh3;
+};
+
+}
+
+std::unique_ptr<FileDigest> FileDigest::create(const QString &algorithm)
+{
+    const QString normalized = algorithm.trimmed().toUpper();
+    if (normalized == QStringLiteral("MD5")) {
+        return std::make_unique<CryptographicHashDigest>(QCryptographicHash::Md5);
+    }
+    if (normalized == QStringLiteral("SHA1")) {
+        return std::make_unique<CryptographicHashDigest>(QCryptographicHash::Sha1);
+    }
+    if (normalized == QStringLiteral("SHA256")) {
+        return std::make_unique<CryptographicHashDigest>(QCryptographicHash::Sha256);
+    }
+    if (normalized == QStringLiteral("SHA384")) {
+        return std::make_unique<CryptographicHashDigest>(QCryptographicHash::Sha384);
+    }
+    if (normalized == QStringLiteral("SHA512")) {
+        return std::make_unique<CryptographicHashDigest>(QCryptographicHash::Sha512);
+    }
+    if (normalized == QStringLiteral("SM3")) {
+        return std::make_unique<SM3Digest>();
+    }
+    if (normalized == QStringLiteral("BLAKE3")) {
+        return std::make_unique<Blake3Digest>();
+    }
+    if (normalized == QStringLiteral("CRC32")) {
+        return std::make_unique<Crc32Digest>(Crc32::Ieee);
+    }
+    if (normalized == QStringLiteral("CRC32C")) {
+        return std::make_unique<Crc32Digest>(Crc32::Castagnoli);
+    }
+    if (normalized == QStringLiteral("XXH3")) {
+        return std::make_unique<XXH3Digest>(XXH3::Bits64);
+    }
+    if (normalized == QStringLiteral("XXH128")) {
+        return std::make_unique<XXH3Digest>(XXH3::Bits128);
+    }
+    return nullptr;
+}
+
+bool FileDigest::addDevice(QIODevice *device)
+{
+    return addDevice(device, {this});
+}
+
+bool FileDigest::addMappedFile(QFile *file, const QList<FileDigest *> &digests, const ProgressFunction &progress)
+{
+    const qint64 total = file->size();
+    for (qint64 offset = 0; offset < total; offset += kMapSegmentSize) {
+        const qint64 length = qMin(kMapSegmentSize, total - offset);
+        uchar *data = file->map(offset, length);
+        if (!data) {
+            // 映射失败（如网络文件系统）时从当前位置起改为普通读取
+            if (!file->seek(offset)) {
+                return false;
+            }
+            return addDevice(file, digests, [&](qint64 processed, qint64) {
+                return !progress || progress(offset + processed, total);
+            });
+        }
+        adviseSequential(data, length);
+
+        // 按预读块大小分段，段间报告进度；多个摘要时各摘要并行处理同一段
+        QList<FileDigest *> targets = digests;
+        bool canceled = false;
+        for (qint64 position = 0; position < length && !canceled; position += kReadAheadBufferSize) {
+            const char *chunk = reinterpret_cast<const char *>(data) + position;
+            const qsizetype chunkLength = qsizetype(qMin<qint64>(kReadAheadBufferSize, length - position));
+            if (digests.size() == 1) {
+                digests.constFirst()->addData(chunk, chunkLength);
+            } else {
+                QtConcurrent::blockingMap(targets, [chunk, chunkLength](FileDigest *digest) {
+                    digest->addData(chunk, chunkLength);
+                });
+            }
+            canceled = progress && !progress(offset + position + chunkLength, total);
+        }
+        file->unmap(data);
+        if (canceled) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FileDigest::addDevice(QIODevice *device, const QList<FileDigest *> &digests, const ProgressFunction &progress)
+{
+    const qint64 total = device->isSequential() ? 0 : device->size() - device->pos();
+    qint64 processed = 0;
+    auto report = [&](qint64 length) {
+        processed += length;
+        return !progress || progress(processed, total);
+    };
+
+    if (!device->isSequential() && total <= kReadBufferSize) {
+        // 小文件一次读完，不值得启动预读
+        QByteArray buffer(qsizetype(total), Qt::Uninitialized);
+        while (true) {
+            const qint64 count = device->read(buffer.data(), buffer.size());
+            if (count <= 0) {
+                return count == 0;
+            }
+            for (FileDigest *digest : digests) {
+                digest->addData(buffer.constData(), count);
+            }
+            if (!report(count)) {
+                return false;
+            }
+        }
+    }
+
+    QByteArray buffers[2] = {QByteArray(kReadAheadBufferSize, Qt::Uninitialized),
+                             QByteArray(kReadAheadBufferSize, Qt::Uninitialized)};
+    qint64 lengths[2] = {device->read(buffers[0].data(), kReadAheadBufferSize), 0};
+    if (lengths[0] < 0) {
+        return false;
+    }
+
+    // 任务 0 预读下一块，其余任务各自把当前块计入一个摘要
+    QList<int> tasks;
+    for (int i = 0; i <= digests.size(); ++i) {
+        tasks.append(i);
+    }
+
+    int current = 0;
+    while (lengths[current] > 0) {
+        const int next = 1 - current;
+        QtConcurrent::blockingMap(tasks, [&](int task) {
+            if (task == 0) {
+                lengths[next] = device->read(buffers[next].data(), kReadAheadBufferSize);
+            } else {
+                digests[task - 1]->addData(buffers[current].constData(), lengths[current]);
+            }
+        });
+        if (lengths[next] < 0 || !report(lengths[current])) {
+            return false;
+        }
+        current = next;
+    }
+    return true;
+}
+
+FileDigest::FileResult FileDigest::hashFile(const QString &path, const QStringList &algorithms,
+                                            const ProgressFunction &progress, IoBackend backend)
+{
+    FileResult result;
+    std::vector<std::unique_ptr<FileDigest>> owners;
+    QList<FileDigest *> digests;
+    for (const QString &algorithm : algorithms) {
+        owners.push_back(create(algorithm));
+        if (!owners.back()) {
+            result.errorMessage = QStringLiteral("不支持的哈希算法: %1").arg(algorithm);
+            return result;
+        }
+        digests.append(owners.back().get());
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.errorMessage = QStringLiteral("文件无法读取: %1").arg(file.errorString());
+        return result;
+    }
+
+    bool canceled = false;
+    const ProgressFunction report = [&](qint64 processed, qint64 total) {
+        result.bytesRead = processed;
+        canceled = progress && !progress(processed, total);
+        return !canceled;
+    };
+    const bool map = backend == IoBackend::Map
+                     || (backend == IoBackend::Auto && file.size() >= kMapThreshold);
+    const bool completed = map ? addMappedFile(&file, digests, report) : addDevice(&file, digests, report);
+    if (!completed) {
+        result.canceled = canceled;
+        if (!canceled) {
+            result.errorMessage = QStringLiteral("文件读取失败: %1").arg(file.errorString());
+        }
+        return result;
+    }
+
+    for (const FileDigest *digest : std::as_const(digests)) {
+        result.digests.append(digest->result());
+    }
+    result.success = true;
+    return result;
+}
+
+FileDigest::FileResult FileDigest::hashFile(const QString &path, const QStringList &algorithms, HashCache *cache,
+                                            bool forceRehash, const ProgressFunction &progress)
+{
+    HashCache::FileKey key;
+    if (!cache || !HashCache::fileKey(path, &key)) {
+        return hashFile(path, algorithms, progress);
+    }
+
+    FileResult result;
+    if (!forceRehash && cache->lookup(key, algorithms, &result.digests)) {
+        result.success = true;
+        result.cached = true;
+        result.bytesRead = key.size;
+        if (progress) {
+            progress(key.size, key.size);
+        }
+        return result;
+    }
+
+    result = hashFile(path, algorithms, progress);
+    // 读取期间文件被改写过时，算出的摘要不对应任何一个版本，不能写入缓存
+    HashCache::FileKey after;
+    if (result.success && HashCache::fileKey(path, &after) && after == key) {
+        cache->insert(key, algorithms, result.digests);
+    }
+    return result;
+}
+
+QFuture<FileDigest::FileResult> FileDigest::start(const QString &path, const QStringList &algorithms,
+                                                  HashCache *cache, bool forceRehash)
+{
+    return QtConcurrent::run([path, algorithms, cache, forceRehash](QPromise<FileResult> &promise) {
+        promise.setProgressRange(0, kProgressRange);
+        const FileResult result = hashFile(path, algorithms, cache, forceRehash, [&promise](qint64 processed, qint64 total) {
+            promise.setProgressValue(total > 0 ? int(processed * kProgressRange / total) : kProgressRange);
+            return !promise.isCanceled();
+        });
+        // 在工作线程中保存缓存，不占用界面线程
+        if (cache && result.success && !result.cached) {
+            cache->flush();
+        }
+        promise.addResult(result);
+    });
+}
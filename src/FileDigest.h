@@ -0,0 +1,83 @@
+#ifndef FILEDIGEST_H
+#define FILEDIGEST_H
+
+#include <QByteArray>
+#include <QFuture>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+
+class HashCache;
+class QFile;
+class QIODevice;
+
+// 文件哈希工具共用的摘要接口：QCryptographicHash 支持的算法之外再加上 SM3、BLAKE3，
+// 以及只用于发现损坏的非加密校验 CRC32 / CRC32C / XXH3，
+// FileHashCalculator 与 FileUtilityTool 按算法名创建，分段输入，内存占用固定。
+class FileDigest
+{
+public:
+    // 不超过该大小的文件用一块缓冲区直接读完，不启动预读
+    static constexpr qsizetype kReadBufferSize = 1024 * 1024;
+    // 预读缓冲区与映射分段的块大小，块大一些可以摊薄每块一次的线程调度开销
+    static constexpr qsizetype kReadAheadBufferSize = 4 * 1024 * 1024;
+    static constexpr int kProgressRange = 1000;
+    // 不小于该大小的文件默认内存映射读取，省去从内核缓冲区到用户缓冲区的复制
+    static constexpr qint64 kMapThreshold = 16 * 1024 * 1024;
+    // 每次映射的长度，32 位系统上也不会耗尽地址空间
+    static constexpr qint64 kMapSegmentSize = 256 * 1024 * 1024;
+
+    // hashFile 的读取方式：Auto 按文件大小选择；Map 映射失败时退回 Read
+    enum class IoBackend { Auto, Read, Map };
+
+    struct FileResult {
+        bool success = false;
+        bool canceled = false;
+        QString errorMessage;
+        qint64 bytesRead = 0;
+        // 摘要来自 HashCache，没有读取文件
+        bool cached = false;
+        // 与 algorithms 顺序一致的原始摘要
+        QList<QByteArray> digests;
+    };
+
+    // 每读完一块调用一次；返回 false 表示取消
+    using ProgressFunction = std::function<bool(qint64 processed, qint64 total)>;
+
+    virtual ~FileDigest() = default;
+
+    virtual void addData(const char *data, qsizetype length) = 0;
+    virtual QByteArray result() const = 0;
+
+    // 算法名不区分大小写：MD5、SHA1、SHA256、SHA384、SHA512、SM3、BLAKE3、CRC32、CRC32C、XXH3、XXH128；不支持时返回 nullptr
+    static std::unique_ptr<FileDigest> create(const QString &algorithm);
+
+    // 把设备剩余的内容全部计入摘要，读取出错时返回 false
+    bool addDevice(QIODevice *device);
+
+    // 只读一遍设备，同时计入多个摘要：两块缓冲区轮换，摘要在线程池中处理当前块的同时
+    // 另一个任务预读下一块，总耗时接近顺序读一遍文件。读取出错或被取消时返回 false
+    static bool addDevice(QIODevice *device, const QList<FileDigest *> &digests,
+                          const ProgressFunction &progress = ProgressFunction());
+
+    // 打开文件并计算 algorithms 中的全部摘要，不依赖 QObject，可直接在工作线程中运行
+    static FileResult hashFile(const QString &path, const QStringList &algorithms,
+                               const ProgressFunction &progress = ProgressFunction(),
+                               IoBackend backend = IoBackend::Auto);
+    // 先查 cache（forceRehash 时跳过），全部命中则不读文件；计算期间文件未被改动时把结果写回 cache，
+    // 由调用者在一批文件算完后调用 HashCache::flush() 保存
+    static FileResult hashFile(const QString &path, const QStringList &algorithms, HashCache *cache,
+                               bool forceRehash, const ProgressFunction &progress = ProgressFunction());
+    // 在全局线程池中运行，算完后保存 cache；进度范围 0~kProgressRange，可通过 QFuture::cancel() 取消
+    static QFuture<FileResult> start(const QString &path, const QStringList &algorithms,
+                                     HashCache *cache = nullptr, bool forceRehash = false);
+
+private:
+    // 分段映射整个文件直接计入摘要，映射失败时从失败处退回普通读取
+    static bool addMappedFile(QFile *file, const QList<FileDigest *> &digests, const ProgressFunction &progress);
+};
+
+#endif // FILEDIGEST_H
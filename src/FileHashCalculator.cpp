@@ -1,13 +1,30 @@
 #include "FileHashCalculator.h"
+#include "HashCache.h"
 
-#include <QCryptographicHash>
-#include <QFile>
+#include <QFileInfo>
 
 FileHashCalculator::FileHashCalculator(QObject *parent)
     : QObject(parent)
     , m_algorithm("MD5")
     , m_uppercase(false)
+    , m_forceRehash(false)
+    , m_fromCache(false)
+    , m_watcher(new QFutureWatcher<FileDigest::FileResult>(this))
+    , m_totalBytes(0)
+    , m_progress(0.0)
+    , m_bytesPerSecond(0.0)
+    , m_etaSeconds(-1)
 {
+    connect(m_watcher, &QFutureWatcher<FileDigest::FileResult>::progressValueChanged,
+            this, &FileHashCalculator::onProgressValueChanged);
+    connect(m_watcher, &QFutureWatcher<FileDigest::FileResult>::finished, this, &FileHashCalculator::onFinished);
+}
+
+FileHashCalculator::~FileHashCalculator()
+{
+    // 工作线程仍在读文件时等待它结束
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
 }
 
 QString FileHashCalculator::filePath() const
@@ -56,66 +73,158 @@ void FileHashCalculator::setUppercase(bool uppercase)
     if (m_uppercase != uppercase) {
         m_uppercase = uppercase;
         emit uppercaseChanged();
+        updateResult();
+    }
+}
+
+bool FileHashCalculator::forceRehash() const
+{
+    return m_forceRehash;
+}
+
+void FileHashCalculator::setForceRehash(bool forceRehash)
+{
+    if (m_forceRehash != forceRehash) {
+        m_forceRehash = forceRehash;
+        emit forceRehashChanged();
     }
 }
 
+bool FileHashCalculator::fromCache() const
+{
+    return m_fromCache;
+}
+
+bool FileHashCalculator::running() const
+{
+    return m_watcher->isRunning();
+}
+
+double FileHashCalculator::progress() const
+{
+    return m_progress;
+}
+
+double FileHashCalculator::bytesPerSecond() const
+{
+    return m_bytesPerSecond;
+}
+
+int FileHashCalculator::etaSeconds() const
+{
+    return m_etaSeconds;
+}
+
 void FileHashCalculator::calculate()
 {
+    if (running()) {
+        m_watcher->cancel();
+    }
+    m_digestHex.clear();
+    m_fromCache = false;
+    updateResult();
+    resetProgress();
+
     if (m_filePath.trimmed().isEmpty()) {
-        setResult("");
         setErrorMessage("文件路径不能为空");
+        emit runningChanged();
         return;
     }
 
-    QFile file(m_filePath);
-    if (!file.exists()) {
-        setResult("");
+    QFileInfo info(m_filePath);
+    if (!info.exists()) {
         setErrorMessage("文件不存在");
+        emit runningChanged();
         return;
     }
-    if (!file.open(QIODevice::ReadOnly)) {
-        setResult("");
-        setErrorMessage("文件无法读取: " + file.errorString());
-        return;
-    }
-
-    QCryptographicHash hash(static_cast<QCryptographicHash::Algorithm>(hashAlgorithm()));
-    while (!file.atEnd()) {
-        hash.addData(file.read(1024 * 1024));
-    }
-
-    QString value = QString::fromLatin1(hash.result().toHex());
-    if (m_uppercase) {
-        value = value.toUpper();
-    }
 
     setErrorMessage("");
-    setResult(value);
+    m_totalBytes = info.size();
+    m_timer.start();
+    m_watcher->setFuture(FileDigest::start(m_filePath, {hashAlgorithm()}, &HashCache::instance(), m_forceRehash));
+    emit runningChanged();
+}
+
+void FileHashCalculator::cancel()
+{
+    m_watcher->cancel();
 }
 
 void FileHashCalculator::clear()
 {
+    m_watcher->cancel();
     setFilePath("");
-    setResult("");
+    m_digestHex.clear();
+    m_fromCache = false;
+    updateResult();
     setErrorMessage("");
+    resetProgress();
 }
 
-int FileHashCalculator::hashAlgorithm() const
+QString FileHashCalculator::hashAlgorithm() const
 {
     const QString normalized = m_algorithm.toUpper();
-    if (normalized == "SHA1") {
-        return QCryptographicHash::Sha1;
+    if (normalized == "SHA1" || normalized == "SHA256" || normalized == "SM3" || normalized == "BLAKE3"
+        || normalized == "CRC32" || normalized == "CRC32C" || normalized == "XXH3" || normalized == "XXH128") {
+        return normalized;
     }
-    if (normalized == "SHA256") {
-        return QCryptographicHash::Sha256;
+    return "MD5";
+}
+
+void FileHashCalculator::onProgressValueChanged(int value)
+{
+    m_progress = double(value) / FileDigest::kProgressRange;
+
+    // 进度信号经 QFutureWatcher 节流后才到达界面线程，每次到达时重新估算速度与剩余时间
+    const qint64 elapsedMs = m_timer.elapsed();
+    const double processed = m_progress * double(m_totalBytes);
+    if (elapsedMs > 0 && processed > 0) {
+        m_bytesPerSecond = processed * 1000.0 / double(elapsedMs);
+        m_etaSeconds = int((double(m_totalBytes) - processed) / m_bytesPerSecond + 0.5);
+    }
+    emit progressChanged();
+}
+
+void FileHashCalculator::onFinished()
+{
+    // 取消后不会产生结果
+    FileDigest::FileResult result;
+    result.canceled = true;
+    if (!m_watcher->isCanceled() && m_watcher->future().resultCount() > 0) {
+        result = m_watcher->result();
+    }
+
+    if (result.success) {
+        m_digestHex = QString::fromLatin1(result.digests.value(0).toHex());
+        m_fromCache = result.cached;
+        const qint64 elapsedMs = m_timer.elapsed();
+        m_progress = 1.0;
+        m_bytesPerSecond = elapsedMs > 0 ? double(result.bytesRead) * 1000.0 / double(elapsedMs) : m_bytesPerSecond;
+        m_etaSeconds = 0;
+        emit progressChanged();
+        setErrorMessage("");
+        updateResult();
+        emit finished(true, m_result);
+    } else {
+        setErrorMessage(result.canceled ? QStringLiteral("已取消") : result.errorMessage);
+        emit finished(false, m_errorMessage);
     }
-    return QCryptographicHash::Md5;
+    emit runningChanged();
+}
+
+void FileHashCalculator::resetProgress()
+{
+    m_progress = 0.0;
+    m_bytesPerSecond = 0.0;
+    m_etaSeconds = -1;
+    emit progressChanged();
 }
 
-void FileHashCalculator::setResult(const QString &result)
+void FileHashCalculator::updateResult()
 {
-    if (m_result != result) {
-        m_result = result;
+    const QString value = m_uppercase ? m_digestHex.toUpper() : m_digestHex;
+    if (m_result != value) {
+        m_result = value;
         emit resultChanged();
     }
 }
@@ -1,9 +1,15 @@
 #ifndef FILEHASHCALCULATOR_H
 #define FILEHASHCALCULATOR_H
 
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QObject>
 #include <QString>
 
+#include "FileDigest.h"
+
+// 单个文件的哈希计算。读取与计算在线程池中进行，界面线程只接收进度与结果，
+// 计算过程中可以随时取消；速度与剩余时间按已读字节数估算。
 class FileHashCalculator : public QObject
 {
     Q_OBJECT
@@ -12,9 +18,19 @@ class FileHashCalculator : public QObject
     Q_PROPERTY(QString result READ result NOTIFY resultChanged)
     Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
     Q_PROPERTY(bool uppercase READ uppercase WRITE setUppercase NOTIFY uppercaseChanged)
+    // 忽略缓存重新读取文件，结果仍会写回缓存
+    Q_PROPERTY(bool forceRehash READ forceRehash WRITE setForceRehash NOTIFY forceRehashChanged)
+    // 结果来自缓存，文件自上次计算后未被改动
+    Q_PROPERTY(bool fromCache READ fromCache NOTIFY resultChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(double bytesPerSecond READ bytesPerSecond NOTIFY progressChanged)
+    // 预计剩余秒数，尚无法估算时为 -1
+    Q_PROPERTY(int etaSeconds READ etaSeconds NOTIFY progressChanged)
 
 public:
     explicit FileHashCalculator(QObject *parent = nullptr);
+    ~FileHashCalculator() override;
 
     QString filePath() const;
     void setFilePath(const QString &filePath);
@@ -28,7 +44,18 @@ public:
     bool uppercase() const;
     void setUppercase(bool uppercase);
 
+    bool forceRehash() const;
+    void setForceRehash(bool forceRehash);
+    bool fromCache() const;
+
+    bool running() const;
+    double progress() const;
+    double bytesPerSecond() const;
+    int etaSeconds() const;
+
+    // 在后台开始计算，完成后发出 finished；正在计算时会先取消上一次
     Q_INVOKABLE void calculate();
+    Q_INVOKABLE void cancel();
     Q_INVOKABLE void clear();
 
 signals:
@@ -37,10 +64,18 @@ signals:
     void resultChanged();
     void errorMessageChanged();
     void uppercaseChanged();
+    void forceRehashChanged();
+    void runningChanged();
+    void progressChanged();
+    // 成功时 message 为哈希值，失败时为错误信息
+    void finished(bool success, const QString &message);
 
 private:
-    int hashAlgorithm() const;
-    void setResult(const QString &result);
+    QString hashAlgorithm() const;
+    void onProgressValueChanged(int value);
+    void onFinished();
+    void resetProgress();
+    void updateResult();
     void setErrorMessage(const QString &message);
 
     QString m_filePath;
@@ -48,6 +83,17 @@ private:
     QString m_result;
     QString m_errorMessage;
     bool m_uppercase;
+    bool m_forceRehash;
+    bool m_fromCache;
+    // 小写十六进制摘要，切换大小写时无需重新计算
+    QString m_digestHex;
+
+    QFutureWatcher<FileDigest::FileResult> *m_watcher;
+    QElapsedTimer m_timer;
+    qint64 m_totalBytes;
+    double m_progress;
+    double m_bytesPerSecond;
+    int m_etaSeconds;
 };
 
 #endif // FILEHASHCALCULATOR_H
@@ -1,23 +1,40 @@
 #include "FileUtilityTool.h"
+#include "FileDigest.h"
+#include "HashCache.h"
+#include "ImageCompressor.h"
 
 #include <QBuffer>
 #include <QByteArray>
 #include <QDir>
-#include <QFile>
 #include <QFileInfo>
-#include <QImage>
-#include <QImageIOHandler>
 #include <QImageReader>
 #include <QImageWriter>
 #include <QMimeDatabase>
 #include <QtGlobal>
 
+namespace {
+
+const QStringList kInfoAlgorithms = {QStringLiteral("MD5"), QStringLiteral("SHA1"), QStringLiteral("SHA256")};
+
+}
+
 FileUtilityTool::FileUtilityTool(QObject *parent)
     : QObject(parent)
-    , m_maxBase64SizeBytes(10 * 1024 * 1024)
+    , m_hashesFromCache(false)
+    , m_forceRehash(false)
+    , m_hashWatcher(new QFutureWatcher<FileDigest::FileResult>(this))
     , m_originalSize(0)
     , m_compressedSize(0)
 {
+    connect(m_hashWatcher, &QFutureWatcher<FileDigest::FileResult>::finished,
+            this, &FileUtilityTool::onHashesFinished);
+}
+
+FileUtilityTool::~FileUtilityTool()
+{
+    // 工作线程仍在读文件时等待它结束
+    m_hashWatcher->cancel();
+    m_hashWatcher->waitForFinished();
 }
 
 QString FileUtilityTool::filePath() const
@@ -63,24 +80,56 @@ QString FileUtilityTool::sha512() const
     return m_sha512;
 }
 
-QString FileUtilityTool::base64Result() const
+QString FileUtilityTool::sm3() const
 {
-    return m_base64Result;
+    return m_sm3;
 }
 
-qint64 FileUtilityTool::maxBase64SizeBytes() const
+QString FileUtilityTool::blake3() const
 {
-    return m_maxBase64SizeBytes;
+    return m_blake3;
 }
 
-void FileUtilityTool::setMaxBase64SizeBytes(qint64 bytes)
+QString FileUtilityTool::crc32() const
 {
-    if (bytes < 1024) {
-        bytes = 1024;
-    }
-    if (m_maxBase64SizeBytes != bytes) {
-        m_maxBase64SizeBytes = bytes;
-        emit maxBase64SizeBytesChanged();
+    return m_crc32;
+}
+
+QString FileUtilityTool::crc32c() const
+{
+    return m_crc32c;
+}
+
+QString FileUtilityTool::xxh3() const
+{
+    return m_xxh3;
+}
+
+QString FileUtilityTool::xxh128() const
+{
+    return m_xxh128;
+}
+
+bool FileUtilityTool::hashesFromCache() const
+{
+    return m_hashesFromCache;
+}
+
+bool FileUtilityTool::hashing() const
+{
+    return m_hashWatcher->isRunning();
+}
+
+bool FileUtilityTool::forceRehash() const
+{
+    return m_forceRehash;
+}
+
+void FileUtilityTool::setForceRehash(bool forceRehash)
+{
+    if (m_forceRehash != forceRehash) {
+        m_forceRehash = forceRehash;
+        emit forceRehashChanged();
     }
 }
 
@@ -101,70 +150,38 @@ qint64 FileUtilityTool::compressedSize() const
 
 bool FileUtilityTool::calculateAllHashes()
 {
+    clearHashes();
     if (!validateReadableFile()) {
-        clearHashes();
-        return false;
-    }
-
-    m_md5 = hashFile(QCryptographicHash::Md5);
-    m_sha1 = hashFile(QCryptographicHash::Sha1);
-    m_sha256 = hashFile(QCryptographicHash::Sha256);
-    m_sha384 = hashFile(QCryptographicHash::Sha384);
-    m_sha512 = hashFile(QCryptographicHash::Sha512);
-    if (m_md5.isEmpty() || m_sha1.isEmpty() || m_sha256.isEmpty() || m_sha384.isEmpty() || m_sha512.isEmpty()) {
         return false;
     }
 
     setErrorMessage("");
-    emit hashesChanged();
+    startHashing({QStringLiteral("MD5"), QStringLiteral("SHA1"), QStringLiteral("SHA256"), QStringLiteral("SHA384"),
+                  QStringLiteral("SHA512"), QStringLiteral("SM3"), QStringLiteral("BLAKE3"), QStringLiteral("CRC32"),
+                  QStringLiteral("CRC32C"), QStringLiteral("XXH3"), QStringLiteral("XXH128")});
     return true;
 }
 
 void FileUtilityTool::clearHashes()
 {
+    if (m_hashWatcher->isRunning()) {
+        m_hashWatcher->cancel();
+    }
     m_md5.clear();
     m_sha1.clear();
     m_sha256.clear();
     m_sha384.clear();
     m_sha512.clear();
+    m_sm3.clear();
+    m_blake3.clear();
+    m_crc32.clear();
+    m_crc32c.clear();
+    m_xxh3.clear();
+    m_xxh128.clear();
+    m_hashesFromCache = false;
     emit hashesChanged();
 }
 
-bool FileUtilityTool::encodeFileToBase64()
-{
-    if (!validateReadableFile()) {
-        clearBase64();
-        return false;
-    }
-
-    QFileInfo info(m_filePath);
-    if (info.size() > m_maxBase64SizeBytes) {
-        clearBase64();
-        setErrorMessage(QStringLiteral("文件过大，当前限制为 %1").arg(formatFileSize(m_maxBase64SizeBytes)));
-        return false;
-    }
-
-    QFile file(m_filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        clearBase64();
-        setErrorMessage(QStringLiteral("文件无法读取: %1").arg(file.errorString()));
-        return false;
-    }
-
-    m_base64Result = QString::fromLatin1(file.readAll().toBase64());
-    setErrorMessage("");
-    emit base64Changed();
-    return true;
-}
-
-void FileUtilityTool::clearBase64()
-{
-    if (!m_base64Result.isEmpty()) {
-        m_base64Result.clear();
-        emit base64Changed();
-    }
-}
-
 bool FileUtilityTool::compressImage(const QString &outputPath, const QString &format, int quality, int maxWidth, int maxHeight)
 {
     if (!validateReadableFile()) {
@@ -176,45 +193,26 @@ bool FileUtilityTool::compressImage(const QString &outputPath, const QString &fo
     m_compressedSize = 0;
     m_imageOutputPath.clear();
 
-    QImageReader reader(m_filePath);
-    reader.setAutoTransform(true);
-    QImage image = reader.read();
-    if (image.isNull()) {
-        setErrorMessage(QStringLiteral("图片读取失败: %1").arg(reader.errorString()));
-        emit imageCompressionChanged();
-        return false;
-    }
-
-    if (maxWidth > 0 && maxHeight > 0 && (image.width() > maxWidth || image.height() > maxHeight)) {
-        image = image.scaled(maxWidth, maxHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
-
     QString targetFormat = normalizedFormat(format);
     QString targetPath = outputPath.trimmed();
     if (targetPath.isEmpty()) {
         targetPath = defaultCompressedImagePath(targetFormat);
     }
 
-    QFileInfo outputInfo(targetPath);
-    if (!outputInfo.dir().exists() && !QDir().mkpath(outputInfo.absolutePath())) {
-        setErrorMessage(QStringLiteral("输出目录无法创建"));
-        emit imageCompressionChanged();
-        return false;
-    }
-
-    QImageWriter writer(targetPath, targetFormat.toLatin1());
-    if (writer.supportsOption(QImageIOHandler::Quality)) {
-        writer.setQuality(qBound(1, quality, 100));
-    }
-    if (!writer.write(image)) {
-        setErrorMessage(QStringLiteral("图片压缩失败: %1").arg(writer.errorString()));
+    ImageCompressor::Options options;
+    options.format = targetFormat.toLatin1();
+    options.quality = quality;
+    options.maxWidth = maxWidth;
+    options.maxHeight = maxHeight;
+    const ImageCompressor::Result result = ImageCompressor::compress(m_filePath, targetPath, options);
+    if (!result.success) {
+        setErrorMessage(result.errorMessage);
         emit imageCompressionChanged();
         return false;
     }
 
-    QFileInfo compressedInfo(targetPath);
     m_imageOutputPath = targetPath;
-    m_compressedSize = compressedInfo.size();
+    m_compressedSize = result.outputBytes;
     setErrorMessage("");
     emit imageCompressionChanged();
     return true;
@@ -265,10 +263,20 @@ QVariantMap FileUtilityTool::fileInfo()
     infoMap.insert(QStringLiteral("readable"), info.isReadable());
     infoMap.insert(QStringLiteral("writable"), info.isWritable());
     infoMap.insert(QStringLiteral("executable"), info.isExecutable());
-    infoMap.insert(QStringLiteral("md5"), hashFile(QCryptographicHash::Md5));
-    infoMap.insert(QStringLiteral("sha1"), hashFile(QCryptographicHash::Sha1));
-    infoMap.insert(QStringLiteral("sha256"), hashFile(QCryptographicHash::Sha256));
     setErrorMessage(QString());
+
+    // 界面线程只查缓存；没有命中时在后台计算，不阻塞界面
+    HashCache::FileKey key;
+    QList<QByteArray> digests;
+    if (!m_forceRehash && HashCache::fileKey(m_filePath, &key)
+        && HashCache::instance().lookup(key, kInfoAlgorithms, &digests)) {
+        infoMap.insert(QStringLiteral("md5"), QString::fromLatin1(digests.value(0).toHex()));
+        infoMap.insert(QStringLiteral("sha1"), QString::fromLatin1(digests.value(1).toHex()));
+        infoMap.insert(QStringLiteral("sha256"), QString::fromLatin1(digests.value(2).toHex()));
+    } else {
+        clearHashes();
+        startHashing(kInfoAlgorithms);
+    }
     return infoMap;
 }
 
@@ -315,19 +323,55 @@ bool FileUtilityTool::validateReadableFile()
     return true;
 }
 
-QString FileUtilityTool::hashFile(QCryptographicHash::Algorithm algorithm)
+void FileUtilityTool::startHashing(const QStringList &algorithms)
 {
-    QFile file(m_filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        setErrorMessage(QStringLiteral("文件无法读取: %1").arg(file.errorString()));
-        return QString();
+    m_hashAlgorithms = algorithms;
+    // 所有算法共用一次读取；文件未改动时直接取缓存，算完后在工作线程中保存缓存
+    m_hashWatcher->setFuture(FileDigest::start(m_filePath, algorithms, &HashCache::instance(), m_forceRehash));
+    emit hashingChanged();
+}
+
+void FileUtilityTool::onHashesFinished()
+{
+    // 取消后不会产生结果
+    FileDigest::FileResult result;
+    result.canceled = true;
+    if (!m_hashWatcher->isCanceled() && m_hashWatcher->future().resultCount() > 0) {
+        result = m_hashWatcher->result();
     }
 
-    QCryptographicHash hash(algorithm);
-    while (!file.atEnd()) {
-        hash.addData(file.read(1024 * 1024));
+    if (result.success) {
+        for (qsizetype i = 0; i < m_hashAlgorithms.size() && i < result.digests.size(); ++i) {
+            if (QString *field = hashField(m_hashAlgorithms.at(i))) {
+                *field = QString::fromLatin1(result.digests.at(i).toHex());
+            }
+        }
+        m_hashesFromCache = result.cached;
+        setErrorMessage("");
+        emit hashesChanged();
+    } else if (!result.canceled) {
+        setErrorMessage(result.errorMessage);
+    }
+    emit hashingChanged();
+    emit hashesFinished(result.success);
+}
+
+QString *FileUtilityTool::hashField(const QString &algorithm)
+{
+    const struct {
+        const char *name;
+        QString *field;
+    } fields[] = {
+        {"MD5", &m_md5},       {"SHA1", &m_sha1},     {"SHA256", &m_sha256}, {"SHA384", &m_sha384},
+        {"SHA512", &m_sha512}, {"SM3", &m_sm3},       {"BLAKE3", &m_blake3}, {"CRC32", &m_crc32},
+        {"CRC32C", &m_crc32c}, {"XXH3", &m_xxh3},     {"XXH128", &m_xxh128},
+    };
+    for (const auto &entry : fields) {
+        if (algorithm.compare(QLatin1String(entry.name), Qt::CaseInsensitive) == 0) {
+            return entry.field;
+        }
     }
-    return QString::fromLatin1(hash.result().toHex());
+    return nullptr;
 }
 
 void FileUtilityTool::setErrorMessage(const QString &message)
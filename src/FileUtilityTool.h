@@ -1,12 +1,14 @@
 #ifndef FILEUTILITYTOOL_H
 #define FILEUTILITYTOOL_H
 
-#include <QCryptographicHash>
+#include <QFutureWatcher>
 #include <QObject>
 #include <QString>
 #include <QStringList>
 #include <QVariantMap>
 
+#include "FileDigest.h"
+
 class FileUtilityTool : public QObject
 {
     Q_OBJECT
@@ -17,14 +19,25 @@ class FileUtilityTool : public QObject
     Q_PROPERTY(QString sha256 READ sha256 NOTIFY hashesChanged)
     Q_PROPERTY(QString sha384 READ sha384 NOTIFY hashesChanged)
     Q_PROPERTY(QString sha512 READ sha512 NOTIFY hashesChanged)
-    Q_PROPERTY(QString base64Result READ base64Result NOTIFY base64Changed)
-    Q_PROPERTY(qint64 maxBase64SizeBytes READ maxBase64SizeBytes WRITE setMaxBase64SizeBytes NOTIFY maxBase64SizeBytesChanged)
+    Q_PROPERTY(QString sm3 READ sm3 NOTIFY hashesChanged)
+    Q_PROPERTY(QString blake3 READ blake3 NOTIFY hashesChanged)
+    Q_PROPERTY(QString crc32 READ crc32 NOTIFY hashesChanged)
+    Q_PROPERTY(QString crc32c READ crc32c NOTIFY hashesChanged)
+    Q_PROPERTY(QString xxh3 READ xxh3 NOTIFY hashesChanged)
+    Q_PROPERTY(QString xxh128 READ xxh128 NOTIFY hashesChanged)
+    // 上一次计算的摘要全部来自缓存
+    Q_PROPERTY(bool hashesFromCache READ hashesFromCache NOTIFY hashesChanged)
+    // 正在后台计算摘要
+    Q_PROPERTY(bool hashing READ hashing NOTIFY hashingChanged)
+    // 忽略缓存重新读取文件，结果仍会写回缓存
+    Q_PROPERTY(bool forceRehash READ forceRehash WRITE setForceRehash NOTIFY forceRehashChanged)
     Q_PROPERTY(QString imageOutputPath READ imageOutputPath NOTIFY imageCompressionChanged)
     Q_PROPERTY(qint64 originalSize READ originalSize NOTIFY imageCompressionChanged)
     Q_PROPERTY(qint64 compressedSize READ compressedSize NOTIFY imageCompressionChanged)
 
 public:
     explicit FileUtilityTool(QObject *parent = nullptr);
+    ~FileUtilityTool() override;
 
     QString filePath() const;
     void setFilePath(const QString &filePath);
@@ -35,22 +48,31 @@ public:
     QString sha256() const;
     QString sha384() const;
     QString sha512() const;
-    QString base64Result() const;
-
-    qint64 maxBase64SizeBytes() const;
-    void setMaxBase64SizeBytes(qint64 bytes);
+    QString sm3() const;
+    QString blake3() const;
+    QString crc32() const;
+    QString crc32c() const;
+    QString xxh3() const;
+    QString xxh128() const;
+    bool hashesFromCache() const;
+    bool hashing() const;
+    bool forceRehash() const;
+    void setForceRehash(bool forceRehash);
 
     QString imageOutputPath() const;
     qint64 originalSize() const;
     qint64 compressedSize() const;
 
+    // 在后台计算全部摘要，完成后更新各摘要属性并发出 hashesFinished；正在计算时先取消上一次。
+    // 文件无法读取时立即返回 false
     Q_INVOKABLE bool calculateAllHashes();
+    // 清空摘要并取消正在进行的计算
     Q_INVOKABLE void clearHashes();
-    Q_INVOKABLE bool encodeFileToBase64();
-    Q_INVOKABLE void clearBase64();
     Q_INVOKABLE bool compressImage(const QString &outputPath, const QString &format, int quality, int maxWidth, int maxHeight);
     Q_INVOKABLE QString defaultCompressedImagePath(const QString &format) const;
     Q_INVOKABLE QString formatFileSize(qint64 bytes) const;
+    // 文件的元信息。md5、sha1、sha256 只从缓存中取，不读文件；缓存中没有时留空，
+    // 并在后台计算，完成后通过 hashesChanged 更新 md5/sha1/sha256 属性
     Q_INVOKABLE QVariantMap fileInfo();
     Q_INVOKABLE QStringList supportedReadImageFormats() const;
     Q_INVOKABLE QStringList supportedWriteImageFormats() const;
@@ -59,13 +81,17 @@ signals:
     void filePathChanged();
     void errorMessageChanged();
     void hashesChanged();
-    void base64Changed();
-    void maxBase64SizeBytesChanged();
+    void hashingChanged();
+    void hashesFinished(bool success);
+    void forceRehashChanged();
     void imageCompressionChanged();
 
 private:
     bool validateReadableFile();
-    QString hashFile(QCryptographicHash::Algorithm algorithm);
+    void startHashing(const QStringList &algorithms);
+    void onHashesFinished();
+    // 算法对应的摘要属性，未知算法返回 nullptr
+    QString *hashField(const QString &algorithm);
     void setErrorMessage(const QString &message);
     QString normalizedFormat(const QString &format) const;
 
@@ -76,8 +102,17 @@ private:
     QString m_sha256;
     QString m_sha384;
     QString m_sha512;
-    QString m_base64Result;
-    qint64 m_maxBase64SizeBytes;
+    QString m_sm3;
+    QString m_blake3;
+    QString m_crc32;
+    QString m_crc32c;
+    QString m_xxh3;
+    QString m_xxh128;
+    bool m_hashesFromCache;
+    bool m_forceRehash;
+    // 正在计算的算法，与结果中的摘要顺序一致
+    QStringList m_hashAlgorithms;
+    QFutureWatcher<FileDigest::FileResult> *m_hashWatcher;
     QString m_imageOutputPath;
     qint64 m_originalSize;
     qint64 m_compressedSize;
@@ -0,0 +1,377 @@
+#include "FolderHashTool.h"
+#include "ChecksumManifest.h"
+#include "FileDigest.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+// 同时读取的文件数上限，再多对 SSD 也不会更快，只会增加内存占用
+constexpr int kMaxThreadCount = 8;
+
+}
+
+FolderHashTool::FolderHashTool(QObject *parent)
+    : QObject(parent)
+    , m_algorithm("SHA256")
+    , m_threadCount(qBound(1, QThread::idealThreadCount(), 4))
+    , m_processedFiles(0)
+    , m_counters(std::make_shared<Counters>())
+    , m_watcher(new QFutureWatcher<RunResult>(this))
+{
+    connect(m_watcher, &QFutureWatcher<RunResult>::progressValueChanged,
+            this, &FolderHashTool::onProgressValueChanged);
+    connect(m_watcher, &QFutureWatcher<RunResult>::progressRangeChanged,
+            this, &FolderHashTool::progressChanged);
+    connect(m_watcher, &QFutureWatcher<RunResult>::finished, this, &FolderHashTool::onFinished);
+}
+
+FolderHashTool::~FolderHashTool()
+{
+    m_watcher->cancel();
+    m_watcher->waitForFinished();
+}
+
+QString FolderHashTool::folderPath() const
+{
+    return m_folderPath;
+}
+
+void FolderHashTool::setFolderPath(const QString &folderPath)
+{
+    if (m_folderPath != folderPath) {
+        m_folderPath = folderPath;
+        emit folderPathChanged();
+    }
+}
+
+QString FolderHashTool::manifestPath() const
+{
+    return m_manifestPath;
+}
+
+void FolderHashTool::setManifestPath(const QString &manifestPath)
+{
+    if (m_manifestPath != manifestPath) {
+        m_manifestPath = manifestPath;
+        emit manifestPathChanged();
+    }
+}
+
+QString FolderHashTool::algorithm() const
+{
+    return m_algorithm;
+}
+
+void FolderHashTool::setAlgorithm(const QString &algorithm)
+{
+    if (m_algorithm != algorithm) {
+        m_algorithm = algorithm;
+        emit algorithmChanged();
+    }
+}
+
+int FolderHashTool::threadCount() const
+{
+    return m_threadCount;
+}
+
+void FolderHashTool::setThreadCount(int threadCount)
+{
+    threadCount = qBound(1, threadCount, kMaxThreadCount);
+    if (m_threadCount != threadCount) {
+        m_threadCount = threadCount;
+        emit threadCountChanged();
+    }
+}
+
+bool FolderHashTool::running() const
+{
+    return m_watcher->isRunning();
+}
+
+int FolderHashTool::totalFiles() const
+{
+    return m_watcher->progressMaximum();
+}
+
+int FolderHashTool::processedFiles() const
+{
+    return m_processedFiles;
+}
+
+int FolderHashTool::okCount() const
+{
+    return m_counters->ok.load();
+}
+
+int FolderHashTool::mismatchCount() const
+{
+    return m_counters->mismatch.load();
+}
+
+int FolderHashTool::missingCount() const
+{
+    return m_counters->missing.load();
+}
+
+int FolderHashTool::failedCount() const
+{
+    return m_counters->failed.load();
+}
+
+QStringList FolderHashTool::problems() const
+{
+    return m_problems;
+}
+
+QString FolderHashTool::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+QString FolderHashTool::defaultManifestPath() const
+{
+    if (m_folderPath.trimmed().isEmpty()) {
+        return QString();
+    }
+    const QDir folder(m_folderPath);
+    const QString name = folder.dirName().isEmpty() ? QStringLiteral("checksums") : folder.dirName();
+    return folder.filePath(name + '.' + ChecksumManifest::suffixForAlgorithm(m_algorithm));
+}
+
+void FolderHashTool::generate()
+{
+    if (m_folderPath.trimmed().isEmpty() || !QFileInfo(m_folderPath).isDir()) {
+        setStatusMessage("文件夹不存在");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+    const QString algorithm = m_algorithm.trimmed().toUpper();
+    if (!FileDigest::create(algorithm)) {
+        setStatusMessage(QStringLiteral("不支持的哈希算法: %1").arg(m_algorithm));
+        emit finished(false, m_statusMessage);
+        return;
+    }
+    if (m_manifestPath.trimmed().isEmpty()) {
+        setManifestPath(defaultManifestPath());
+    }
+
+    const QString folder = m_folderPath;
+    const QString manifest = m_manifestPath;
+    const int threads = m_threadCount;
+    resetCounts();
+    const std::shared_ptr<Counters> counters = m_counters;
+    setStatusMessage("正在计算...");
+
+    start(QtConcurrent::run([folder, manifest, algorithm, threads, counters](QPromise<RunResult> &promise) {
+        RunResult result;
+        QList<ChecksumManifest::Entry> entries;
+        for (const QString &path : ChecksumManifest::collectFiles(folder, manifest)) {
+            entries.append({path, QByteArray()});
+        }
+        promise.setProgressRange(0, int(entries.size()));
+
+        std::atomic<int> processed(0);
+        const QList<ChecksumManifest::Check> checks = ChecksumManifest::hashFiles(
+            folder, entries, algorithm, threads,
+            [&](const ChecksumManifest::Entry &, const ChecksumManifest::Check &check) {
+                (check.status == ChecksumManifest::Status::Ok ? counters->ok : counters->failed)++;
+                promise.setProgressValue(++processed);
+                return !promise.isCanceled();
+            },
+            [&promise]() { return promise.isCanceled(); });
+        if (promise.isCanceled()) {
+            return;
+        }
+
+        // 清单中的路径相对清单所在目录，清单不在该文件夹内时也能直接用 sha256sum -c 校验
+        const QDir folderDir(folder);
+        const QDir manifestDir = QFileInfo(manifest).absoluteDir();
+        QList<ChecksumManifest::Entry> written;
+        for (qsizetype i = 0; i < entries.size(); ++i) {
+            const ChecksumManifest::Check &check = checks.at(i);
+            if (check.status == ChecksumManifest::Status::Ok) {
+                written.append({manifestDir.relativeFilePath(folderDir.filePath(entries.at(i).path)), check.digest});
+            } else {
+                result.problems.append(QStringLiteral("[读取失败] %1: %2").arg(entries.at(i).path, check.errorMessage));
+            }
+        }
+
+        QSaveFile file(manifest);
+        const QByteArray text = ChecksumManifest::format(written);
+        if (!file.open(QIODevice::WriteOnly) || file.write(text) != text.size() || !file.commit()) {
+            result.message = QStringLiteral("清单无法写入: %1").arg(file.errorString());
+            promise.addResult(result);
+            return;
+        }
+
+        result.success = result.problems.isEmpty();
+        result.message = QStringLiteral("已写入 %1 个文件的 %2 清单").arg(written.size()).arg(algorithm);
+        if (!result.problems.isEmpty()) {
+            result.message += QStringLiteral("，%1 个文件无法读取").arg(result.problems.size());
+        }
+        promise.addResult(result);
+    }));
+}
+
+void FolderHashTool::verify()
+{
+    if (m_manifestPath.trimmed().isEmpty() || !QFileInfo::exists(m_manifestPath)) {
+        setStatusMessage("清单文件不存在");
+        emit finished(false, m_statusMessage);
+        return;
+    }
+
+    const QString manifest = m_manifestPath;
+    const int threads = m_threadCount;
+    resetCounts();
+    const std::shared_ptr<Counters> counters = m_counters;
+    setStatusMessage("正在校验...");
+
+    start(QtConcurrent::run([manifest, threads, counters](QPromise<RunResult> &promise) {
+        RunResult result;
+        QFile file(manifest);
+        if (!file.open(QIODevice::ReadOnly)) {
+            result.message = QStringLiteral("清单无法读取: %1").arg(file.errorString());
+            promise.addResult(result);
+            return;
+        }
+
+        int malformed = 0;
+        QString algorithm;
+        const QList<ChecksumManifest::Entry> entries = ChecksumManifest::parse(file.readAll(), &malformed, &algorithm);
+        if (entries.isEmpty()) {
+            result.message = QStringLiteral("清单中没有可识别的条目");
+            promise.addResult(result);
+            return;
+        }
+        // BSD 格式自带算法名，其次看扩展名，最后按摘要长度推断
+        if (algorithm.isEmpty() || !FileDigest::create(algorithm)) {
+            algorithm = ChecksumManifest::algorithmForFile(manifest);
+        }
+        if (algorithm.isEmpty()) {
+            algorithm = ChecksumManifest::algorithmForDigestLength(int(entries.constFirst().digest.size()));
+        }
+        if (algorithm.isEmpty()) {
+            result.message = QStringLiteral("无法确定清单使用的哈希算法");
+            promise.addResult(result);
+            return;
+        }
+        promise.setProgressRange(0, int(entries.size()));
+
+        std::atomic<int> processed(0);
+        const QList<ChecksumManifest::Check> checks = ChecksumManifest::hashFiles(
+            QFileInfo(manifest).absolutePath(), entries, algorithm, threads,
+            [&](const ChecksumManifest::Entry &, const ChecksumManifest::Check &check) {
+                switch (check.status) {
+                case ChecksumManifest::Status::Ok:
+                    counters->ok++;
+                    break;
+                case ChecksumManifest::Status::Mismatch:
+                    counters->mismatch++;
+                    break;
+                case ChecksumManifest::Status::Missing:
+                    counters->missing++;
+                    break;
+                default:
+                    counters->failed++;
+                    break;
+                }
+                promise.setProgressValue(++processed);
+                return !promise.isCanceled();
+            },
+            [&promise]() { return promise.isCanceled(); });
+        if (promise.isCanceled()) {
+            return;
+        }
+
+        for (qsizetype i = 0; i < entries.size(); ++i) {
+            const ChecksumManifest::Check &check = checks.at(i);
+            const QString &path = entries.at(i).path;
+            switch (check.status) {
+            case ChecksumManifest::Status::Mismatch:
+                result.problems.append(QStringLiteral("[不一致] %1").arg(path));
+                break;
+            case ChecksumManifest::Status::Missing:
+                result.problems.append(QStringLiteral("[缺失] %1").arg(path));
+                break;
+            case ChecksumManifest::Status::Failed:
+                result.problems.append(QStringLiteral("[读取失败] %1: %2").arg(path, check.errorMessage));
+                break;
+            default:
+                break;
+            }
+        }
+        if (malformed > 0) {
+            result.problems.append(QStringLiteral("[格式错误] %1 行无法识别").arg(malformed));
+        }
+
+        result.success = result.problems.isEmpty();
+        result.message = QStringLiteral("%1 校验完成：%2 个一致，%3 个不一致，%4 个缺失")
+                             .arg(algorithm)
+                             .arg(counters->ok.load())
+                             .arg(counters->mismatch.load())
+                             .arg(counters->missing.load());
+        promise.addResult(result);
+    }));
+}
+
+void FolderHashTool::cancel()
+{
+    m_watcher->cancel();
+}
+
+void FolderHashTool::start(const QFuture<RunResult> &future)
+{
+    m_watcher->setFuture(future);
+    emit runningChanged();
+}
+
+void FolderHashTool::onProgressValueChanged(int value)
+{
+    // 计数由工作线程直接累加，这里只在进度信号到达时刷新界面
+    m_processedFiles = value;
+    emit progressChanged();
+}
+
+void FolderHashTool::onFinished()
+{
+    RunResult result;
+    result.message = QStringLiteral("已取消");
+    if (!m_watcher->isCanceled() && m_watcher->future().resultCount() > 0) {
+        result = m_watcher->result();
+    }
+
+    m_processedFiles = m_watcher->progressValue();
+    m_problems = result.problems;
+    emit problemsChanged();
+    emit progressChanged();
+    setStatusMessage(result.message);
+    emit finished(result.success, result.message);
+    emit runningChanged();
+}
+
+void FolderHashTool::resetCounts()
+{
+    // 上一次任务被取消后可能仍在收尾，换一组新计数，不与它共用
+    m_watcher->cancel();
+    m_counters = std::make_shared<Counters>();
+    m_processedFiles = 0;
+    m_problems.clear();
+    emit problemsChanged();
+    emit progressChanged();
+}
+
+void FolderHashTool::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
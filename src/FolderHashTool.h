@@ -0,0 +1,111 @@
+#ifndef FOLDERHASHTOOL_H
+#define FOLDERHASHTOOL_H
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <memory>
+
+// 文件夹哈希：遍历目录生成 sha256sum / md5sum 兼容的校验清单，或读取已有清单逐项校验。
+// 遍历、计算与写清单都在线程池中进行，多个文件并行计算，界面线程只接收计数与结果。
+class FolderHashTool : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString folderPath READ folderPath WRITE setFolderPath NOTIFY folderPathChanged)
+    Q_PROPERTY(QString manifestPath READ manifestPath WRITE setManifestPath NOTIFY manifestPathChanged)
+    Q_PROPERTY(QString algorithm READ algorithm WRITE setAlgorithm NOTIFY algorithmChanged)
+    // 同时读取的文件数，文件在机械硬盘上时设为 1 可避免磁头来回寻道
+    Q_PROPERTY(int threadCount READ threadCount WRITE setThreadCount NOTIFY threadCountChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(int totalFiles READ totalFiles NOTIFY progressChanged)
+    Q_PROPERTY(int processedFiles READ processedFiles NOTIFY progressChanged)
+    Q_PROPERTY(int okCount READ okCount NOTIFY progressChanged)
+    Q_PROPERTY(int mismatchCount READ mismatchCount NOTIFY progressChanged)
+    Q_PROPERTY(int missingCount READ missingCount NOTIFY progressChanged)
+    Q_PROPERTY(int failedCount READ failedCount NOTIFY progressChanged)
+    // 不一致、缺失或无法读取的文件，每项一行
+    Q_PROPERTY(QStringList problems READ problems NOTIFY problemsChanged)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    explicit FolderHashTool(QObject *parent = nullptr);
+    ~FolderHashTool() override;
+
+    QString folderPath() const;
+    void setFolderPath(const QString &folderPath);
+
+    QString manifestPath() const;
+    void setManifestPath(const QString &manifestPath);
+
+    QString algorithm() const;
+    void setAlgorithm(const QString &algorithm);
+
+    int threadCount() const;
+    void setThreadCount(int threadCount);
+
+    bool running() const;
+    int totalFiles() const;
+    int processedFiles() const;
+    int okCount() const;
+    int mismatchCount() const;
+    int missingCount() const;
+    int failedCount() const;
+    QStringList problems() const;
+    QString statusMessage() const;
+
+    // 文件夹内默认的清单路径，如 <文件夹>/<文件夹名>.sha256
+    Q_INVOKABLE QString defaultManifestPath() const;
+    // 计算 folderPath 下全部文件并写入 manifestPath（为空时使用默认路径）
+    Q_INVOKABLE void generate();
+    // 按 manifestPath 校验，路径相对清单所在目录；算法由扩展名或摘要长度推断
+    Q_INVOKABLE void verify();
+    Q_INVOKABLE void cancel();
+
+signals:
+    void folderPathChanged();
+    void manifestPathChanged();
+    void algorithmChanged();
+    void threadCountChanged();
+    void runningChanged();
+    void progressChanged();
+    void problemsChanged();
+    void statusMessageChanged();
+    void finished(bool success, const QString &message);
+
+private:
+    struct Counters {
+        std::atomic<int> ok{0};
+        std::atomic<int> mismatch{0};
+        std::atomic<int> missing{0};
+        std::atomic<int> failed{0};
+    };
+
+    struct RunResult {
+        bool success = false;
+        QString message;
+        QStringList problems;
+    };
+
+    void start(const QFuture<RunResult> &future);
+    void onProgressValueChanged(int value);
+    void onFinished();
+    void resetCounts();
+    void setStatusMessage(const QString &message);
+
+    QString m_folderPath;
+    QString m_manifestPath;
+    QString m_algorithm;
+    int m_threadCount;
+    QString m_statusMessage;
+    QStringList m_problems;
+    int m_processedFiles;
+
+    // 工作线程与界面线程共享，上一次任务可能尚未结束，因此每次任务单独创建
+    std::shared_ptr<Counters> m_counters;
+    QFutureWatcher<RunResult> *m_watcher;
+};
+
+#endif // FOLDERHASHTOOL_H
@@ -0,0 +1,138 @@
+#include "GHash.h"
+#include "CpuFeatures.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+// 右移 4 位时移出的低 4 位对应的约简值（多项式 x^128 + x^7 + x^2 + x + 1）
+constexpr quint64 LAST4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+void initTable(const quint8 *hashKey, GHash::Key *key)
+{
+    quint64 vh = qFromBigEndian<quint64>(hashKey);
+    quint64 vl = qFromBigEndian<quint64>(hashKey + 8);
+
+    // 第 8 项为 H 本身，4、2、1 依次为 H·x、H·x^2、H·x^3
+    key->hh[0] = key->hl[0] = 0;
+    key->hh[8] = vh;
+    key->hl[8] = vl;
+    for (int i = 4; i > 0; i >>= 1) {
+        const quint64 carry = (vl & 1) ? 0xe1000000u : 0;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (carry << 32);
+        key->hh[i] = vh;
+        key->hl[i] = vl;
+    }
+    // 其余各项由线性组合得到
+    for (int i = 2; i <= 8; i *= 2) {
+        for (int j = 1; j < i; ++j) {
+            key->hh[i + j] = key->hh[i] ^ key->hh[j];
+            key->hl[i + j] = key->hl[i] ^ key->hl[j];
+        }
+    }
+}
+
+// state = state · H，每次处理 4 位
+void multiplyTable(const GHash::Key &key, quint8 *state)
+{
+    quint8 nibble = state[15] & 0x0f;
+    quint64 zh = key.hh[nibble];
+    quint64 zl = key.hl[nibble];
+
+    for (int i = 15; i >= 0; --i) {
+        const quint8 lo = state[i] & 0x0f;
+        const quint8 hi = state[i] >> 4;
+
+        if (i != 15) {
+            const quint8 rem = zl & 0x0f;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (LAST4[rem] << 48);
+            zh ^= key.hh[lo];
+            zl ^= key.hl[lo];
+        }
+
+        const quint8 rem = zl & 0x0f;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (LAST4[rem] << 48);
+        zh ^= key.hh[hi];
+        zl ^= key.hl[hi];
+    }
+
+    qToBigEndian(zh, state);
+    qToBigEndian(zl, state + 8);
+}
+
+void updateTable(const GHash::Key &key, quint8 *state, const quint8 *blocks, size_t count)
+{
+    for (size_t b = 0; b < count; ++b, blocks += 16) {
+        for (int i = 0; i < 16; ++i) {
+            state[i] ^= blocks[i];
+        }
+        multiplyTable(key, state);
+    }
+}
+
+bool useClmul()
+{
+#if defined(Q_PROCESSOR_X86)
+    static const bool supported = CpuFeatures::hasPclmul() && CpuFeatures::hasSsse3();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+}
+
+GHash::GHash(const quint8 *hashKey, bool allowHardware)
+    : m_clmul(allowHardware && useClmul())
+{
+    std::memset(m_state, 0, sizeof(m_state));
+#if defined(Q_PROCESSOR_X86)
+    if (m_clmul) {
+        GHashHw::initClmul(hashKey, m_key.powers);
+        return;
+    }
+#endif
+    initTable(hashKey, &m_key);
+}
+
+void GHash::update(const quint8 *data, qsizetype length)
+{
+    const size_t blocks = size_t(length / 16);
+#if defined(Q_PROCESSOR_X86)
+    if (m_clmul) {
+        GHashHw::updateClmul(m_key.powers, m_state, data, blocks);
+    } else
+#endif
+    {
+        updateTable(m_key, m_state, data, blocks);
+    }
+
+    const qsizetype tail = length % 16;
+    if (tail > 0) {
+        quint8 last[16] = {};
+        std::memcpy(last, data + blocks * 16, size_t(tail));
+        update(last, 16);
+    }
+}
+
+void GHash::finish(quint64 aadLength, quint64 textLength, quint8 *out)
+{
+    quint8 lengths[16];
+    qToBigEndian(aadLength * 8, lengths);
+    qToBigEndian(textLength * 8, lengths + 8);
+    update(lengths, 16);
+    std::memcpy(out, m_state, sizeof(m_state));
+}
+
+const char *GHash::implementationName()
+{
+    return useClmul() ? "PCLMULQDQ" : "4-bit table";
+}
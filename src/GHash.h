@@ -0,0 +1,46 @@
+#ifndef GHASH_H
+#define GHASH_H
+
+#include <QtGlobal>
+
+#include <cstddef>
+
+// GCM 的 GHASH 认证函数（GF(2^128) 上的乘加）。
+// 可移植实现为 4 位查表（Shoup 方法）；x86 上 CPU 支持 PCLMULQDQ 时改用无进位乘法指令，运行时选择。
+class GHash
+{
+public:
+    // hashKey 为 16 字节的 H = E(K, 0^128)；allowHardware 为 false 时固定使用查表实现
+    explicit GHash(const quint8 *hashKey, bool allowHardware = true);
+
+    // 吸收一段数据，末尾不足 16 字节的部分补零；AAD 与密文需分别调用
+    void update(const quint8 *data, qsizetype length);
+    // 追加 AAD 与密文的比特长度块，输出 16 字节的 GHASH 结果
+    void finish(quint64 aadLength, quint64 textLength, quint8 *out);
+
+    // 当前 CPU 使用的实现名称
+    static const char *implementationName();
+
+    struct Key {
+        // 4 位查表：H 与 0..15 的乘积，按高/低 64 位存放
+        quint64 hl[16];
+        quint64 hh[16];
+        // PCLMULQDQ 实现使用的 H^1..H^4（字节反序）
+        alignas(16) quint8 powers[64];
+    };
+
+private:
+    Key m_key;
+    bool m_clmul;
+    alignas(16) quint8 m_state[16];
+};
+
+// PCLMULQDQ 实现位于 GHash_x86.cpp，该文件使用单独的编译选项
+namespace GHashHw {
+#if defined(Q_PROCESSOR_X86)
+void initClmul(const quint8 *hashKey, quint8 *powers);
+void updateClmul(const quint8 *powers, quint8 *state, const quint8 *blocks, size_t count);
+#endif
+}
+
+#endif // GHASH_H
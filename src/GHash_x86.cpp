@@ -0,0 +1,127 @@
+#include "GHash.h"
+
+// PCLMULQDQ 实现。GCC/Clang 下本文件以 -mpclmul -mssse3 单独编译，
+// 只有 CpuFeatures 检测到 PCLMULQDQ 与 SSSE3 时才会被调用。
+// 算法参考 Intel《Carry-Less Multiplication and Its Usage for Computing the GCM Mode》：
+// 数据按字节反序后做 128x128 无进位乘法，整体左移 1 位，再按 x^128 + x^7 + x^2 + x + 1 约简。
+#if defined(Q_PROCESSOR_X86)
+
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+
+namespace {
+
+// 一次聚合 4 个分组：X·H^4 + B1·H^3 + B2·H^2 + B3·H，只做一次约简
+constexpr size_t kAggregatedBlocks = 4;
+
+inline __m128i byteSwap(__m128i v)
+{
+    const __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(v, mask);
+}
+
+inline __m128i load(const quint8 *p)
+{
+    return byteSwap(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+// 256 位乘积，lo/hi 为低/高 128 位
+inline void multiply(__m128i a, __m128i b, __m128i *lo, __m128i *hi)
+{
+    __m128i low = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i high = _mm_clmulepi64_si128(a, b, 0x11);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    *lo = _mm_xor_si128(low, _mm_slli_si128(mid, 8));
+    *hi = _mm_xor_si128(high, _mm_srli_si128(mid, 8));
+}
+
+inline __m128i reduce(__m128i lo, __m128i hi)
+{
+    // 比特反序表示下的乘积需整体左移 1 位
+    __m128i carryLo = _mm_srli_epi32(lo, 31);
+    __m128i carryHi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    const __m128i cross = _mm_srli_si128(carryLo, 12);
+    carryHi = _mm_slli_si128(carryHi, 4);
+    carryLo = _mm_slli_si128(carryLo, 4);
+    lo = _mm_or_si128(lo, carryLo);
+    hi = _mm_or_si128(hi, carryHi);
+    hi = _mm_or_si128(hi, cross);
+
+    // 第一阶段约简
+    __m128i t = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    const __m128i spill = _mm_srli_si128(t, 4);
+    t = _mm_slli_si128(t, 12);
+    lo = _mm_xor_si128(lo, t);
+
+    // 第二阶段约简
+    __m128i u = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    u = _mm_xor_si128(u, spill);
+    lo = _mm_xor_si128(lo, u);
+    return _mm_xor_si128(hi, lo);
+}
+
+inline __m128i gfMultiply(__m128i a, __m128i b)
+{
+    __m128i lo;
+    __m128i hi;
+    multiply(a, b, &lo, &hi);
+    return reduce(lo, hi);
+}
+
+inline __m128i power(const quint8 *powers, int n)
+{
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(powers + (n - 1) * 16));
+}
+
+}
+
+namespace GHashHw {
+
+void initClmul(const quint8 *hashKey, quint8 *powers)
+{
+    const __m128i h = load(hashKey);
+    __m128i hn = h;
+    for (int n = 1; n <= 4; ++n) {
+        _mm_store_si128(reinterpret_cast<__m128i *>(powers + (n - 1) * 16), hn);
+        hn = gfMultiply(hn, h);
+    }
+}
+
+void updateClmul(const quint8 *powers, quint8 *state, const quint8 *blocks, size_t count)
+{
+    const __m128i h1 = power(powers, 1);
+    const __m128i h2 = power(powers, 2);
+    const __m128i h3 = power(powers, 3);
+    const __m128i h4 = power(powers, 4);
+    __m128i x = load(state);
+
+    for (; count >= kAggregatedBlocks; count -= kAggregatedBlocks, blocks += 64) {
+        __m128i lo;
+        __m128i hi;
+        __m128i partLo;
+        __m128i partHi;
+        multiply(_mm_xor_si128(x, load(blocks)), h4, &lo, &hi);
+        multiply(load(blocks + 16), h3, &partLo, &partHi);
+        lo = _mm_xor_si128(lo, partLo);
+        hi = _mm_xor_si128(hi, partHi);
+        multiply(load(blocks + 32), h2, &partLo, &partHi);
+        lo = _mm_xor_si128(lo, partLo);
+        hi = _mm_xor_si128(hi, partHi);
+        multiply(load(blocks + 48), h1, &partLo, &partHi);
+        lo = _mm_xor_si128(lo, partLo);
+        hi = _mm_xor_si128(hi, partHi);
+        x = reduce(lo, hi);
+    }
+
+    for (; count > 0; --count, blocks += 16) {
+        x = gfMultiply(_mm_xor_si128(x, load(blocks)), h1);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), byteSwap(x));
+}
+
+}
+
+#endif
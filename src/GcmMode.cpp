@@ -0,0 +1,131 @@
+#include "GcmMode.h"
+
+#include <cstring>
+
+namespace {
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+
+}
+
+const quint8 *GcmMode::Stream::deriveHashKey(const ParallelBlockCipher::BlockFunction &encrypt, quint8 *hashKey)
+{
+    // H = E(K, 0^128)
+    std::memset(hashKey, 0, 16);
+    encrypt(hashKey, hashKey, 1);
+    return hashKey;
+}
+
+GcmMode::Stream::Stream(const ParallelBlockCipher::BlockFunction &encrypt,
+                        const QByteArray &iv, const QByteArray &aad)
+    : Stream(encrypt, bytes(iv), iv.size(), bytes(aad), aad.size())
+{
+}
+
+GcmMode::Stream::Stream(const ParallelBlockCipher::BlockFunction &encrypt,
+                        const quint8 *iv, qsizetype ivLength, const quint8 *aad, qsizetype aadLength)
+    : m_encrypt(encrypt)
+    , m_ghash(deriveHashKey(encrypt, m_hashKey))
+    , m_aadLength(quint64(aadLength))
+    , m_textLength(0)
+{
+    if (ivLength == 12) {
+        // 96 位 IV：J0 = IV || 0^31 || 1
+        std::memset(m_j0, 0, sizeof(m_j0));
+        std::memcpy(m_j0, iv, 12);
+        m_j0[15] = 1;
+    } else {
+        GHash ghash(m_hashKey);
+        ghash.update(iv, ivLength);
+        ghash.finish(0, quint64(ivLength), m_j0);
+    }
+
+    // 数据部分从 inc32(J0) 开始计数
+    std::memcpy(m_counter, m_j0, sizeof(m_counter));
+    ParallelBlockCipher::advanceCounter(m_counter, 1, ParallelBlockCipher::Counter::Low32);
+
+    m_ghash.update(aad, aadLength);
+}
+
+void GcmMode::Stream::crypt(const quint8 *in, quint8 *out, qsizetype length)
+{
+    ParallelBlockCipher::ctr(m_encrypt, m_counter, in, out, length, ParallelBlockCipher::Counter::Low32);
+    ParallelBlockCipher::advanceCounter(m_counter, quint64(length / 16), ParallelBlockCipher::Counter::Low32);
+}
+
+void GcmMode::Stream::authenticate(const quint8 *ciphertext, qsizetype length)
+{
+    m_ghash.update(ciphertext, length);
+    m_textLength += quint64(length);
+}
+
+void GcmMode::Stream::finish(quint8 *tag)
+{
+    m_ghash.finish(m_aadLength, m_textLength, tag);
+
+    quint8 mask[16];
+    m_encrypt(m_j0, mask, 1);
+    for (int i = 0; i < 16; ++i) {
+        tag[i] ^= mask[i];
+    }
+}
+
+bool GcmMode::Stream::verify(const QByteArray &tag)
+{
+    return verify(bytes(tag), tag.size());
+}
+
+bool GcmMode::Stream::verify(const quint8 *tag, qsizetype tagLength)
+{
+    if (tagLength < kMinTagLength || tagLength > kTagLength) {
+        return false;
+    }
+
+    quint8 expected[kTagLength];
+    finish(expected);
+
+    // 常量时间比较，避免通过耗时推测标签
+    quint8 diff = 0;
+    for (qsizetype i = 0; i < tagLength; ++i) {
+        diff |= expected[i] ^ tag[i];
+    }
+    return diff == 0;
+}
+
+QByteArray GcmMode::encrypt(const ParallelBlockCipher::BlockFunction &encrypt,
+                            const QByteArray &iv, const QByteArray &aad,
+                            const QByteArray &plaintext, QByteArray *tag)
+{
+    Stream stream(encrypt, iv, aad);
+
+    QByteArray ciphertext(plaintext.size(), Qt::Uninitialized);
+    quint8 *out = reinterpret_cast<quint8 *>(ciphertext.data());
+    stream.crypt(bytes(plaintext), out, plaintext.size());
+    stream.authenticate(out, ciphertext.size());
+
+    tag->resize(kTagLength);
+    stream.finish(reinterpret_cast<quint8 *>(tag->data()));
+    return ciphertext;
+}
+
+bool GcmMode::decrypt(const ParallelBlockCipher::BlockFunction &encrypt,
+                      const QByteArray &iv, const QByteArray &aad,
+                      const QByteArray &ciphertext, const QByteArray &tag,
+                      QByteArray *plaintext)
+{
+    Stream stream(encrypt, iv, aad);
+
+    // 先认证后解密
+    stream.authenticate(bytes(ciphertext), ciphertext.size());
+    if (!stream.verify(tag)) {
+        return false;
+    }
+
+    QByteArray result(ciphertext.size(), Qt::Uninitialized);
+    stream.crypt(bytes(ciphertext), reinterpret_cast<quint8 *>(result.data()), ciphertext.size());
+    *plaintext = result;
+    return true;
+}
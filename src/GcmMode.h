@@ -0,0 +1,61 @@
+#ifndef GCMMODE_H
+#define GCMMODE_H
+
+#include "GHash.h"
+#include "ParallelBlockCipher.h"
+
+#include <QByteArray>
+
+// 基于任意 128 位分组密码的 GCM 认证加密（NIST SP 800-38D），AES 与 SM4 共用。
+// 计数器部分交给 ParallelBlockCipher 多线程处理，认证部分由 GHash 完成。
+class GcmMode
+{
+public:
+    static constexpr int kTagLength = 16;
+    // 校验时允许的最短截断标签（SP 800-38D 允许 96~128 位）
+    static constexpr int kMinTagLength = 12;
+
+    // encrypt 为分组加密函数（GCM 解密同样只用加密方向）；iv 推荐 12 字节，其他长度按标准经 GHASH 派生
+    static QByteArray encrypt(const ParallelBlockCipher::BlockFunction &encrypt,
+                              const QByteArray &iv, const QByteArray &aad,
+                              const QByteArray &plaintext, QByteArray *tag);
+
+    // 标签不匹配时返回 false，且不输出任何明文
+    static bool decrypt(const ParallelBlockCipher::BlockFunction &encrypt,
+                        const QByteArray &iv, const QByteArray &aad,
+                        const QByteArray &ciphertext, const QByteArray &tag,
+                        QByteArray *plaintext);
+
+    // 分段处理一条消息（如大文件）：计数器与 GHASH 状态在各段之间延续。
+    // 除最后一段外，每次 crypt / authenticate 的长度须为 16 的倍数。
+    class Stream
+    {
+    public:
+        Stream(const ParallelBlockCipher::BlockFunction &encrypt, const QByteArray &iv, const QByteArray &aad);
+        Stream(const ParallelBlockCipher::BlockFunction &encrypt,
+               const quint8 *iv, qsizetype ivLength, const quint8 *aad, qsizetype aadLength);
+
+        // 加密或解密一段数据，in 与 out 可以相同
+        void crypt(const quint8 *in, quint8 *out, qsizetype length);
+        // 把一段密文计入认证
+        void authenticate(const quint8 *ciphertext, qsizetype length);
+        // 结束认证，输出 16 字节标签
+        void finish(quint8 *tag);
+        // 与 finish 的结果做常量时间比较，支持 12~16 字节的截断标签
+        bool verify(const QByteArray &tag);
+        bool verify(const quint8 *tag, qsizetype tagLength);
+
+    private:
+        static const quint8 *deriveHashKey(const ParallelBlockCipher::BlockFunction &encrypt, quint8 *hashKey);
+
+        ParallelBlockCipher::BlockFunction m_encrypt;
+        quint8 m_hashKey[16];
+        quint8 m_j0[16];
+        quint8 m_counter[16];
+        GHash m_ghash;
+        quint64 m_aadLength;
+        quint64 m_textLength;
+    };
+};
+
+#endif // GCMMODE_H
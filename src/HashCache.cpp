@@ -0,0 +1,296 @@
+#include "HashCache.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+constexpr quint32 kMagic = 0x48434348; // "HCCH"
+constexpr quint32 kVersion = 1;
+
+QString normalizedAlgorithm(const QString &algorithm)
+{
+    return algorithm.trimmed().toUpper();
+}
+
+}
+
+bool HashCache::fileKey(const QString &path, FileKey *key)
+{
+#if defined(Q_OS_WIN)
+    const HANDLE handle = CreateFileW(reinterpret_cast<const wchar_t *>(QDir::toNativeSeparators(path).utf16()),
+                                      0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                      OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    BY_HANDLE_FILE_INFORMATION info;
+    const bool ok = GetFileInformationByHandle(handle, &info);
+    CloseHandle(handle);
+    if (!ok || (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return false;
+    }
+    const quint64 identity[2] = {info.dwVolumeSerialNumber,
+                                 (quint64(info.nFileIndexHigh) << 32) | info.nFileIndexLow};
+    key->identity = QByteArray(reinterpret_cast<const char *>(identity), sizeof(identity));
+    key->size = qint64((quint64(info.nFileSizeHigh) << 32) | info.nFileSizeLow);
+    key->modified = qint64((quint64(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime);
+    return true;
+#elif defined(Q_OS_UNIX)
+    struct stat info;
+    if (::stat(QFile::encodeName(path).constData(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+    const quint64 identity[2] = {quint64(info.st_dev), quint64(info.st_ino)};
+    key->identity = QByteArray(reinterpret_cast<const char *>(identity), sizeof(identity));
+    key->size = qint64(info.st_size);
+#if defined(Q_OS_DARWIN)
+    key->modified = qint64(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    key->modified = qint64(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+    return true;
+#else
+    const QFileInfo info(path);
+    if (!info.isFile()) {
+        return false;
+    }
+    key->identity = info.absoluteFilePath().toUtf8();
+    key->size = info.size();
+    key->modified = info.lastModified().toMSecsSinceEpoch();
+    return true;
+#endif
+}
+
+HashCache::HashCache(const QString &storagePath, int maxEntries)
+    : m_storagePath(storagePath)
+    , m_maxEntries(qMax(1, maxEntries))
+    , m_loaded(false)
+    , m_dirty(false)
+    , m_clock(0)
+{
+}
+
+HashCache::~HashCache()
+{
+    flush();
+}
+
+HashCache &HashCache::instance()
+{
+    static HashCache cache(QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
+                               .filePath(QStringLiteral("hash-cache.bin")));
+    return cache;
+}
+
+QString HashCache::storagePath() const
+{
+    return m_storagePath;
+}
+
+int HashCache::maxEntries() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_maxEntries;
+}
+
+void HashCache::setMaxEntries(int maxEntries)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maxEntries = qMax(1, maxEntries);
+    ensureLoaded();
+    if (m_records.size() > m_maxEntries) {
+        evict();
+        m_dirty = true;
+    }
+}
+
+int HashCache::size()
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+    return int(m_records.size());
+}
+
+bool HashCache::lookup(const FileKey &key, const QStringList &algorithms, QList<QByteArray> *digests)
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    const auto it = m_records.find(key.identity);
+    if (it == m_records.end() || it->size != key.size || it->modified != key.modified) {
+        return false;
+    }
+
+    QList<QByteArray> found;
+    for (const QString &algorithm : algorithms) {
+        const QByteArray digest = it->digests.value(normalizedAlgorithm(algorithm));
+        if (digest.isEmpty()) {
+            return false;
+        }
+        found.append(digest);
+    }
+    // 命中只更新内存中的使用序号，随下一次保存一起写入
+    it->lastUsed = ++m_clock;
+    *digests = found;
+    return true;
+}
+
+void HashCache::insert(const FileKey &key, const QStringList &algorithms, const QList<QByteArray> &digests)
+{
+    if (key.identity.isEmpty() || algorithms.size() != digests.size()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+
+    Record &record = m_records[key.identity];
+    if (record.size != key.size || record.modified != key.modified) {
+        record.digests.clear();
+        record.size = key.size;
+        record.modified = key.modified;
+    }
+    for (qsizetype i = 0; i < algorithms.size(); ++i) {
+        record.digests.insert(normalizedAlgorithm(algorithms.at(i)), digests.at(i));
+    }
+    record.lastUsed = ++m_clock;
+
+    evict();
+    m_dirty = true;
+}
+
+void HashCache::remove(const FileKey &key)
+{
+    QMutexLocker locker(&m_mutex);
+    ensureLoaded();
+    if (m_records.remove(key.identity) > 0) {
+        m_dirty = true;
+    }
+}
+
+void HashCache::clear()
+{
+    QMutexLocker saveLocker(&m_saveMutex);
+    QMutexLocker locker(&m_mutex);
+    m_loaded = true;
+    m_dirty = false;
+    m_records.clear();
+    QFile::remove(m_storagePath);
+}
+
+bool HashCache::flush()
+{
+    QMutexLocker saveLocker(&m_saveMutex);
+    QHash<QByteArray, Record> records;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty) {
+            return true;
+        }
+        // 隐式共享，复制只是增加引用计数；写文件期间其他线程的修改会让 m_records 脱离共享
+        records = m_records;
+        m_dirty = false;
+    }
+
+    if (!save(records)) {
+        QMutexLocker locker(&m_mutex);
+        m_dirty = true;
+        return false;
+    }
+    return true;
+}
+
+void HashCache::ensureLoaded()
+{
+    if (m_loaded) {
+        return;
+    }
+    m_loaded = true;
+
+    QFile file(m_storagePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    stream >> magic >> version >> count;
+    if (magic != kMagic || version != kVersion || count < 0) {
+        return;
+    }
+
+    QHash<QByteArray, Record> records;
+    records.reserve(count);
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray identity;
+        Record record;
+        stream >> identity >> record.size >> record.modified >> record.lastUsed >> record.digests;
+        m_clock = qMax(m_clock, record.lastUsed);
+        records.insert(identity, record);
+    }
+    // 文件损坏时整体丢弃，缓存只是加速手段，重新计算即可
+    if (stream.status() == QDataStream::Ok) {
+        m_records = records;
+        evict();
+    }
+}
+
+void HashCache::evict()
+{
+    if (m_records.size() <= m_maxEntries) {
+        return;
+    }
+
+    QList<quint64> uses;
+    uses.reserve(m_records.size());
+    for (auto it = m_records.cbegin(); it != m_records.cend(); ++it) {
+        uses.append(it->lastUsed);
+    }
+    // 一次淘汰到上限的 90%，避免缓存满后每次写入都要排序
+    const qsizetype keep = qMax<qsizetype>(1, m_maxEntries - m_maxEntries / 10);
+    const qsizetype drop = m_records.size() - keep;
+    std::nth_element(uses.begin(), uses.begin() + (drop - 1), uses.end());
+    const quint64 threshold = uses.at(drop - 1);
+
+    for (auto it = m_records.begin(); it != m_records.end();) {
+        if (it->lastUsed <= threshold) {
+            it = m_records.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool HashCache::save(const QHash<QByteArray, Record> &records) const
+{
+    QDir().mkpath(QFileInfo(m_storagePath).absolutePath());
+    QSaveFile file(m_storagePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kMagic << kVersion << qint32(records.size());
+    for (auto it = records.cbegin(); it != records.cend(); ++it) {
+        stream << it.key() << it->size << it->modified << it->lastUsed << it->digests;
+    }
+    return stream.status() == QDataStream::Ok && file.commit();
+}
@@ -0,0 +1,84 @@
+#ifndef HASHCACHE_H
+#define HASHCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+// 文件摘要的持久化缓存：以文件所在设备与 inode（Windows 上为卷序列号与文件索引）识别文件，
+// 大小或修改时间变化即视为失效。同一文件的不同算法共用一条记录，条目超过上限时淘汰最久未用的。
+// 数据保存在一个小的二进制文件中。写入只改内存，由 flush() 或析构时一次整体替换，
+// 避免每算完一个文件就重写整个缓存；可被多个线程同时使用。
+class HashCache
+{
+public:
+    static constexpr int kDefaultMaxEntries = 4096;
+
+    struct FileKey {
+        // 设备号与 inode 打包后的字节串，取不到时为文件的绝对路径
+        QByteArray identity;
+        qint64 size = -1;
+        // 修改时间，精度取决于平台（Unix 为纳秒，Windows 为 100 纳秒）
+        qint64 modified = 0;
+
+        bool operator==(const FileKey &other) const
+        {
+            return identity == other.identity && size == other.size && modified == other.modified;
+        }
+        bool operator!=(const FileKey &other) const { return !(*this == other); }
+    };
+
+    // 读取文件的身份信息，文件不存在时返回 false
+    static bool fileKey(const QString &path, FileKey *key);
+
+    explicit HashCache(const QString &storagePath, int maxEntries = kDefaultMaxEntries);
+    // 保存尚未写入文件的修改
+    ~HashCache();
+
+    // 应用数据目录下的 hash-cache.bin，程序内各处共用
+    static HashCache &instance();
+
+    QString storagePath() const;
+    int maxEntries() const;
+    // 缩小上限时立即淘汰多出的条目
+    void setMaxEntries(int maxEntries);
+    int size();
+
+    // algorithms 的摘要全部命中时返回 true，digests 与 algorithms 顺序一致
+    bool lookup(const FileKey &key, const QStringList &algorithms, QList<QByteArray> *digests);
+    // 写入内存并标记为待保存；同一文件已有的其他算法摘要保留，大小或修改时间不同时整条替换
+    void insert(const FileKey &key, const QStringList &algorithms, const QList<QByteArray> &digests);
+    void remove(const FileKey &key);
+    void clear();
+    // 有待保存的修改时整体写回文件，没有时什么也不做。一次计算结束后调用，写文件期间不阻塞查询
+    bool flush();
+
+private:
+    struct Record {
+        qint64 size = -1;
+        qint64 modified = 0;
+        quint64 lastUsed = 0;
+        QHash<QString, QByteArray> digests;
+    };
+
+    void ensureLoaded();
+    void evict();
+    bool save(const QHash<QByteArray, Record> &records) const;
+
+    mutable QMutex m_mutex;
+    // 串行化 flush() 与 clear()，保证后取的快照不会被先取的覆盖；先于 m_mutex 加锁
+    QMutex m_saveMutex;
+    QString m_storagePath;
+    int m_maxEntries;
+    bool m_loaded;
+    // 内存中有尚未写入文件的修改
+    bool m_dirty;
+    // 单调递增的使用序号，用于淘汰最久未用的条目
+    quint64 m_clock;
+    QHash<QByteArray, Record> m_records;
+};
+
+#endif // HASHCACHE_H
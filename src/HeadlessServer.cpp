@@ -0,0 +1,133 @@
+#include "HeadlessServer.h"
+#include "FolderHttpServer.h"
+#include "FakeApiServer.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+namespace {
+
+// appHoneycomb 在 Windows 上是 GUI 子系统程序，从终端启动时需要手动挂到父进程的控制台
+void attachConsole()
+{
+#ifdef Q_OS_WIN
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        freopen("CONOUT$", "w", stdout);
+        freopen("CONOUT$", "w", stderr);
+    }
+#endif
+}
+
+template <typename Server>
+void forwardLog(Server *server, bool quiet)
+{
+    QObject::connect(server, &Server::logMessage, server, [quiet](const QString &message) {
+        // 每个请求一行的访问日志在 --quiet 时省略，错误与启动信息始终输出
+        if (quiet && message.size() > 1 && message.startsWith("[") && message.at(1).isDigit()) {
+            return;
+        }
+        QTextStream(stdout) << message << Qt::endl;
+    });
+}
+
+}
+
+bool HeadlessServer::isHeadlessCommand(int argc, char *argv[])
+{
+    return argc > 1 && (std::strcmp(argv[1], "serve") == 0 || std::strcmp(argv[1], "mock") == 0);
+}
+
+int HeadlessServer::run(int argc, char *argv[])
+{
+    attachConsole();
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Honeycomb");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("蜂巢工具箱无界面服务模式\n"
+                                     "  serve <目录>       将文件夹映射为 HTTP 服务\n"
+                                     "  mock <配置文件>    按 .fapi 配置或 OpenAPI 规范启动 Fake API");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "serve 或 mock");
+    parser.addPositionalArgument("path", "目录或配置文件路径");
+
+    QCommandLineOption portOption({"p", "port"}, "监听端口", "port");
+    QCommandLineOption quietOption({"q", "quiet"}, "不输出逐条访问日志");
+    parser.addOptions({portOption, quietOption});
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() < 2) {
+        parser.showHelp(1);
+    }
+
+    const QString command = args.at(0);
+    const QString path = QFileInfo(args.at(1)).absoluteFilePath();
+    const bool quiet = parser.isSet(quietOption);
+
+    int port = 0;
+    if (parser.isSet(portOption)) {
+        bool ok = false;
+        port = parser.value(portOption).toInt(&ok);
+        if (!ok || port < 1 || port > 65535) {
+            QTextStream(stderr) << "[错误] 无效的端口: " << parser.value(portOption) << Qt::endl;
+            return 1;
+        }
+    }
+
+    if (command == "serve") {
+        FolderHttpServer server;
+        forwardLog(&server, quiet);
+        server.setFolderPath(path);
+        if (port > 0) {
+            server.setPort(port);
+        }
+        if (!server.startServer()) {
+            return 1;
+        }
+        return app.exec();
+    }
+
+    FakeApiServer server;
+    forwardLog(&server, quiet);
+    if (!server.importFromFile(path)) {
+        return 1;
+    }
+    // 命令行指定的端口优先于配置文件中的端口
+    if (port > 0) {
+        server.setPort(port);
+    }
+
+    // OpenAPI 规范在后台解析，导入完成后再启动监听
+    auto startWhenReady = [&server]() {
+        if (!server.isImporting() && !server.isRunning() && !server.startServer()) {
+            QCoreApplication::exit(1);
+        }
+    };
+    if (server.isImporting()) {
+        // 不是 JSON 配置的文件交给后台按 OpenAPI 规范解析，解析失败时与配置无法读取一样退出
+        QObject::connect(&server, &FakeApiServer::importFinished, &app, [startWhenReady](bool success) {
+            if (success) {
+                startWhenReady();
+            } else {
+                QCoreApplication::exit(1);
+            }
+        });
+    } else {
+        startWhenReady();
+        if (!server.isRunning()) {
+            return 1;
+        }
+    }
+    return app.exec();
+}
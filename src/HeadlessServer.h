@@ -0,0 +1,16 @@
+#ifndef HEADLESSSERVER_H
+#define HEADLESSSERVER_H
+
+// 无界面服务模式：
+//   appHoneycomb serve <目录> [--port N]      文件夹映射
+//   appHoneycomb mock <配置.fapi> [--port N]  Fake API（也支持 OpenAPI 规范）
+// 只创建 QCoreApplication，不初始化 WebEngine、不加载 QML，适合在构建机上使用。
+class HeadlessServer
+{
+public:
+    // 在创建任何 Qt 应用对象之前调用，仅检查 argv[1] 是否为子命令
+    static bool isHeadlessCommand(int argc, char *argv[]);
+    static int run(int argc, char *argv[]);
+};
+
+#endif // HEADLESSSERVER_H
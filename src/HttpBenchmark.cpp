@@ -0,0 +1,649 @@
+#include "HttpBenchmark.h"
+
+namespace {
+const int kMaxHeaderSize = 64 * 1024;
+const int kReconnectDelayMs = 10;
+
+QString formatBytes(double bytes)
+{
+    const char *units[] = {"B", "KB", "MB", "GB"};
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 3) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    return QString("%1 %2").arg(bytes, 0, 'f', unit == 0 ? 0 : 2).arg(QString(units[unit]));
+}
+}
+
+HttpBenchmark::HttpBenchmark(QObject *parent)
+    : QObject(parent)
+    , m_url("http://127.0.0.1:8080/")
+    , m_connections(10)
+    , m_rate(0)
+    , m_duration(10)
+    , m_keepAlive(true)
+    , m_running(false)
+    , m_scheduleTimer(new QTimer(this))
+    , m_progressTimer(new QTimer(this))
+    , m_durationTimer(new QTimer(this))
+    , m_intervalNs(0)
+    , m_elapsedNs(0)
+    , m_completed(0)
+    , m_errors(0)
+    , m_non2xx(0)
+    , m_reconnects(0)
+    , m_bytes(0)
+{
+    m_scheduleTimer->setTimerType(Qt::PreciseTimer);
+    m_scheduleTimer->setInterval(1);
+    m_progressTimer->setInterval(500);
+    m_durationTimer->setSingleShot(true);
+
+    connect(m_scheduleTimer, &QTimer::timeout, this, &HttpBenchmark::onScheduleTick);
+    connect(m_progressTimer, &QTimer::timeout, this, &HttpBenchmark::onProgressTick);
+    connect(m_durationTimer, &QTimer::timeout, this, &HttpBenchmark::stop);
+}
+
+HttpBenchmark::~HttpBenchmark()
+{
+    m_running = false;
+    for (Connection &connection : m_pool) {
+        dropSocket(connection);
+    }
+}
+
+QString HttpBenchmark::url() const
+{
+    return m_url;
+}
+
+void HttpBenchmark::setUrl(const QString &url)
+{
+    if (m_url != url) {
+        m_url = url;
+        emit urlChanged();
+    }
+}
+
+int HttpBenchmark::connections() const
+{
+    return m_connections;
+}
+
+void HttpBenchmark::setConnections(int connections)
+{
+    connections = qBound(1, connections, 1000);
+    if (m_connections != connections) {
+        m_connections = connections;
+        emit connectionsChanged();
+    }
+}
+
+int HttpBenchmark::rate() const
+{
+    return m_rate;
+}
+
+void HttpBenchmark::setRate(int rate)
+{
+    rate = qBound(0, rate, 1000000);
+    if (m_rate != rate) {
+        m_rate = rate;
+        emit rateChanged();
+    }
+}
+
+int HttpBenchmark::duration() const
+{
+    return m_duration;
+}
+
+void HttpBenchmark::setDuration(int seconds)
+{
+    seconds = qBound(1, seconds, 3600);
+    if (m_duration != seconds) {
+        m_duration = seconds;
+        emit durationChanged();
+    }
+}
+
+bool HttpBenchmark::keepAlive() const
+{
+    return m_keepAlive;
+}
+
+void HttpBenchmark::setKeepAlive(bool keepAlive)
+{
+    if (m_keepAlive != keepAlive) {
+        m_keepAlive = keepAlive;
+        emit keepAliveChanged();
+    }
+}
+
+bool HttpBenchmark::running() const
+{
+    return m_running;
+}
+
+qint64 HttpBenchmark::completedRequests() const
+{
+    return m_completed;
+}
+
+qint64 HttpBenchmark::errorCount() const
+{
+    return m_errors;
+}
+
+qint64 HttpBenchmark::non2xxCount() const
+{
+    return m_non2xx;
+}
+
+qint64 HttpBenchmark::reconnectCount() const
+{
+    return m_reconnects;
+}
+
+double HttpBenchmark::requestsPerSecond() const
+{
+    const qint64 elapsed = m_running ? m_clock.nsecsElapsed() : m_elapsedNs;
+    return elapsed > 0 ? double(m_completed) * 1e9 / double(elapsed) : 0.0;
+}
+
+double HttpBenchmark::bytesPerSecond() const
+{
+    const qint64 elapsed = m_running ? m_clock.nsecsElapsed() : m_elapsedNs;
+    return elapsed > 0 ? double(m_bytes) * 1e9 / double(elapsed) : 0.0;
+}
+
+double HttpBenchmark::p50Latency() const
+{
+    return m_histogram.valueAtPercentile(50.0) / 1000.0;
+}
+
+double HttpBenchmark::p99Latency() const
+{
+    return m_histogram.valueAtPercentile(99.0) / 1000.0;
+}
+
+double HttpBenchmark::maxLatency() const
+{
+    return m_histogram.max() / 1000.0;
+}
+
+QString HttpBenchmark::report() const
+{
+    return m_report;
+}
+
+QString HttpBenchmark::statusMessage() const
+{
+    return m_statusMessage;
+}
+
+const LatencyHistogram &HttpBenchmark::histogram() const
+{
+    return m_histogram;
+}
+
+void HttpBenchmark::setStatusMessage(const QString &message)
+{
+    if (m_statusMessage != message) {
+        m_statusMessage = message;
+        emit statusMessageChanged();
+    }
+}
+
+bool HttpBenchmark::start()
+{
+    if (m_running) {
+        return true;
+    }
+
+    const QUrl target = QUrl::fromUserInput(m_url.trimmed());
+    if (!target.isValid() || target.scheme() != "http" || target.host().isEmpty()) {
+        setStatusMessage("仅支持 http:// 开头的地址");
+        return false;
+    }
+    m_target = target;
+
+    QByteArray path = target.path(QUrl::FullyEncoded).toUtf8();
+    if (path.isEmpty()) {
+        path = "/";
+    }
+    if (target.hasQuery()) {
+        path += "?" + target.query(QUrl::FullyEncoded).toUtf8();
+    }
+    QByteArray host = target.host(QUrl::FullyEncoded).toUtf8();
+    if (target.port() != -1) {
+        host += ":" + QByteArray::number(target.port());
+    }
+    m_requestBytes = "GET " + path + " HTTP/1.1\r\n"
+                     "Host: " + host + "\r\n"
+                     "User-Agent: Honeycomb-HttpBench/1.0\r\n"
+                     "Accept: */*\r\n"
+                     "Connection: " + QByteArray(m_keepAlive ? "keep-alive" : "close") + "\r\n"
+                     "\r\n";
+
+    m_histogram.reset();
+    m_completed = 0;
+    m_errors = 0;
+    m_non2xx = 0;
+    m_reconnects = 0;
+    m_bytes = 0;
+    m_elapsedNs = 0;
+    m_report.clear();
+    emit reportChanged();
+
+    // 开环模式下每个连接按 连接数/速率 的间隔发送，各连接相位错开
+    m_intervalNs = m_rate > 0 ? qint64(1e9 * m_connections / m_rate) : 0;
+    m_running = true;
+    m_clock.start();
+
+    m_pool.clear();
+    m_socketIndex.clear();
+    m_pool.resize(m_connections);
+    for (int i = 0; i < m_pool.size(); ++i) {
+        Connection &connection = m_pool[i];
+        connection.index = i;
+        connection.nextSendNs = m_intervalNs * i / m_connections;
+        openConnection(connection);
+    }
+
+    if (m_rate > 0) {
+        m_scheduleTimer->start();
+    }
+    m_progressTimer->start();
+    m_durationTimer->start(m_duration * 1000);
+
+    emit runningChanged();
+    emit progressChanged();
+    setStatusMessage(m_rate > 0
+        ? QString("压测中：%1 个连接，目标 %2 req/s").arg(m_connections).arg(m_rate)
+        : QString("压测中：%1 个连接，闭环模式").arg(m_connections));
+    return true;
+}
+
+void HttpBenchmark::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_elapsedNs = m_clock.nsecsElapsed();
+    m_running = false;
+    m_scheduleTimer->stop();
+    m_progressTimer->stop();
+    m_durationTimer->stop();
+
+    // 未完成的请求不计入结果
+    for (Connection &connection : m_pool) {
+        dropSocket(connection);
+    }
+
+    buildReport();
+    emit runningChanged();
+    emit progressChanged();
+    emit reportChanged();
+    setStatusMessage(QString("压测完成：%1 个请求，%2 req/s")
+                         .arg(m_completed)
+                         .arg(requestsPerSecond(), 0, 'f', 1));
+    emit finished();
+}
+
+HttpBenchmark::Connection *HttpBenchmark::connectionFor(QObject *socket)
+{
+    const auto it = m_socketIndex.constFind(socket);
+    return it != m_socketIndex.constEnd() ? &m_pool[it.value()] : nullptr;
+}
+
+void HttpBenchmark::openConnection(Connection &connection)
+{
+    dropSocket(connection);
+
+    QTcpSocket *socket = new QTcpSocket(this);
+    connect(socket, &QTcpSocket::connected, this, &HttpBenchmark::onConnected);
+    connect(socket, &QTcpSocket::readyRead, this, &HttpBenchmark::onReadyRead);
+    connect(socket, &QTcpSocket::disconnected, this, &HttpBenchmark::onDisconnected);
+    connect(socket, &QTcpSocket::errorOccurred, this, &HttpBenchmark::onSocketError);
+
+    connection.socket = socket;
+    m_socketIndex.insert(socket, connection.index);
+    connection.buffer.clear();
+    connection.busy = false;
+    resetResponseState(connection);
+    socket->connectToHost(m_target.host(), quint16(m_target.port(80)));
+}
+
+void HttpBenchmark::dropSocket(Connection &connection)
+{
+    if (!connection.socket) {
+        return;
+    }
+    m_socketIndex.remove(connection.socket);
+    connection.socket->disconnect(this);
+    connection.socket->abort();
+    connection.socket->deleteLater();
+    connection.socket = nullptr;
+    connection.busy = false;
+}
+
+void HttpBenchmark::onConnected()
+{
+    Connection *connection = connectionFor(sender());
+    if (!connection) {
+        return;
+    }
+    connection->socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    trySend(*connection);
+}
+
+void HttpBenchmark::trySend(Connection &connection)
+{
+    if (!m_running || connection.busy || !connection.socket
+        || connection.socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    if (m_rate == 0) {
+        sendRequest(connection, m_clock.nsecsElapsed());
+        return;
+    }
+
+    // 落后于计划时立即补发，延迟仍按计划时间计算
+    if (m_clock.nsecsElapsed() >= connection.nextSendNs) {
+        const qint64 intended = connection.nextSendNs;
+        connection.nextSendNs += m_intervalNs;
+        sendRequest(connection, intended);
+    }
+}
+
+void HttpBenchmark::sendRequest(Connection &connection, qint64 intendedNs)
+{
+    connection.busy = true;
+    connection.intendedNs = intendedNs;
+    resetResponseState(connection);
+    connection.socket->write(m_requestBytes);
+}
+
+void HttpBenchmark::resetResponseState(Connection &connection)
+{
+    connection.headerLength = -1;
+    connection.statusCode = 0;
+    connection.contentLength = -1;
+    connection.chunked = false;
+    connection.closeAfterResponse = !m_keepAlive;
+}
+
+void HttpBenchmark::onReadyRead()
+{
+    Connection *connection = connectionFor(sender());
+    if (!connection) {
+        return;
+    }
+
+    connection->buffer += connection->socket->readAll();
+    if (!connection->busy) {
+        connection->buffer.clear();
+        return;
+    }
+    processResponse(*connection);
+}
+
+bool HttpBenchmark::processResponse(Connection &connection)
+{
+    if (connection.headerLength < 0 && !parseHeaders(connection)) {
+        return !connection.busy;
+    }
+
+    if (connection.chunked) {
+        const qint64 end = chunkedMessageEnd(connection);
+        if (end == -2) {
+            failRequest(connection);
+            return true;
+        }
+        if (end >= 0) {
+            completeResponse(connection, end);
+            return true;
+        }
+    } else if (connection.contentLength >= 0) {
+        const qint64 end = connection.headerLength + connection.contentLength;
+        if (connection.buffer.size() >= end) {
+            completeResponse(connection, end);
+            return true;
+        }
+    }
+    // 既无 Content-Length 也非 chunked：响应体以连接关闭为结束，在 onDisconnected 中处理
+    return false;
+}
+
+bool HttpBenchmark::parseHeaders(Connection &connection)
+{
+    const int headerEnd = connection.buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        if (connection.buffer.size() > kMaxHeaderSize) {
+            failRequest(connection);
+        }
+        return false;
+    }
+
+    const QList<QByteArray> lines = connection.buffer.left(headerEnd).split('\n');
+    const QList<QByteArray> statusLine = lines.first().trimmed().split(' ');
+    if (statusLine.size() < 2 || !statusLine.first().startsWith("HTTP/1.")) {
+        failRequest(connection);
+        return false;
+    }
+
+    const bool http10 = statusLine.first() == "HTTP/1.0";
+    bool keepAliveHeader = false;
+    connection.statusCode = statusLine.at(1).toInt();
+    connection.headerLength = headerEnd + 4;
+
+    for (int i = 1; i < lines.size(); ++i) {
+        const int colon = lines.at(i).indexOf(':');
+        if (colon <= 0) {
+            continue;
+        }
+        const QByteArray name = lines.at(i).left(colon).trimmed().toLower();
+        const QByteArray value = lines.at(i).mid(colon + 1).trimmed().toLower();
+        if (name == "content-length") {
+            connection.contentLength = value.toLongLong();
+        } else if (name == "transfer-encoding") {
+            connection.chunked = value.contains("chunked");
+        } else if (name == "connection") {
+            if (value.contains("close")) {
+                connection.closeAfterResponse = true;
+            } else if (value.contains("keep-alive")) {
+                keepAliveHeader = true;
+            }
+        }
+    }
+
+    if (http10 && !keepAliveHeader) {
+        connection.closeAfterResponse = true;
+    }
+    // 1xx / 204 / 304 没有响应体
+    if (connection.statusCode < 200 || connection.statusCode == 204 || connection.statusCode == 304) {
+        connection.chunked = false;
+        connection.contentLength = 0;
+    }
+    return true;
+}
+
+qint64 HttpBenchmark::chunkedMessageEnd(const Connection &connection) const
+{
+    const QByteArray &buffer = connection.buffer;
+    qint64 pos = connection.headerLength;
+
+    while (true) {
+        const qint64 lineEnd = buffer.indexOf("\r\n", pos);
+        if (lineEnd < 0) {
+            return -1;
+        }
+        QByteArray sizeField = buffer.mid(pos, lineEnd - pos);
+        const int extension = sizeField.indexOf(';');
+        if (extension >= 0) {
+            sizeField.truncate(extension);
+        }
+        bool ok = false;
+        const qint64 chunkSize = sizeField.trimmed().toLongLong(&ok, 16);
+        if (!ok || chunkSize < 0) {
+            return -2;
+        }
+        pos = lineEnd + 2;
+
+        if (chunkSize == 0) {
+            // 跳过 trailer，直到空行
+            while (true) {
+                const qint64 trailerEnd = buffer.indexOf("\r\n", pos);
+                if (trailerEnd < 0) {
+                    return -1;
+                }
+                if (trailerEnd == pos) {
+                    return trailerEnd + 2;
+                }
+                pos = trailerEnd + 2;
+            }
+        }
+
+        pos += chunkSize + 2;
+        if (pos > buffer.size()) {
+            return -1;
+        }
+    }
+}
+
+void HttpBenchmark::completeResponse(Connection &connection, qint64 consumed)
+{
+    const qint64 latencyNs = m_clock.nsecsElapsed() - connection.intendedNs;
+    m_histogram.record(latencyNs / 1000);
+    ++m_completed;
+    m_bytes += consumed;
+    if (connection.statusCode < 200 || connection.statusCode >= 300) {
+        ++m_non2xx;
+    }
+
+    connection.buffer.remove(0, int(consumed));
+    connection.busy = false;
+    const bool reconnect = connection.closeAfterResponse;
+    resetResponseState(connection);
+
+    if (reconnect) {
+        ++m_reconnects;
+        if (m_running) {
+            openConnection(connection);
+        } else {
+            dropSocket(connection);
+        }
+        return;
+    }
+    trySend(connection);
+}
+
+void HttpBenchmark::failRequest(Connection &connection)
+{
+    if (connection.busy || connection.socket) {
+        ++m_errors;
+    }
+    dropSocket(connection);
+
+    if (!m_running) {
+        return;
+    }
+    // 稍后重连，避免服务端不可达时空转
+    const int index = connection.index;
+    QTimer::singleShot(kReconnectDelayMs, this, [this, index]() {
+        if (m_running && index < m_pool.size() && !m_pool[index].socket) {
+            ++m_reconnects;
+            openConnection(m_pool[index]);
+        }
+    });
+}
+
+void HttpBenchmark::onDisconnected()
+{
+    Connection *connection = connectionFor(sender());
+    if (!connection) {
+        return;
+    }
+
+    if (connection->busy) {
+        connection->buffer += connection->socket->readAll();
+        connection->closeAfterResponse = true;
+        if (processResponse(*connection)) {
+            return;
+        }
+        const bool closeDelimited = connection->headerLength >= 0
+            && !connection->chunked && connection->contentLength < 0;
+        if (closeDelimited) {
+            completeResponse(*connection, connection->buffer.size());
+        } else {
+            failRequest(*connection);
+        }
+        return;
+    }
+
+    // 服务端关闭了空闲连接
+    if (m_running) {
+        ++m_reconnects;
+        openConnection(*connection);
+    } else {
+        dropSocket(*connection);
+    }
+}
+
+void HttpBenchmark::onSocketError(QAbstractSocket::SocketError error)
+{
+    // 对端正常关闭由 onDisconnected 处理
+    if (error == QAbstractSocket::RemoteHostClosedError) {
+        return;
+    }
+
+    Connection *connection = connectionFor(sender());
+    if (!connection) {
+        return;
+    }
+    setStatusMessage(QString("连接错误: %1").arg(connection->socket->errorString()));
+    failRequest(*connection);
+}
+
+void HttpBenchmark::onScheduleTick()
+{
+    for (Connection &connection : m_pool) {
+        trySend(connection);
+    }
+}
+
+void HttpBenchmark::onProgressTick()
+{
+    emit progressChanged();
+}
+
+void HttpBenchmark::buildReport()
+{
+    const double seconds = m_elapsedNs / 1e9;
+    QString text;
+    text += QString("目标: %1\n").arg(m_target.toString());
+    text += QString("连接数: %1，模式: %2，时长: %3 s，Keep-Alive: %4\n")
+                .arg(m_connections)
+                .arg(m_rate > 0 ? QString("开环 %1 req/s").arg(m_rate) : QString("闭环"))
+                .arg(seconds, 0, 'f', 2)
+                .arg(m_keepAlive ? QString("是") : QString("否"));
+    text += QString("请求: %1，错误: %2，非 2xx: %3，重连: %4\n")
+                .arg(m_completed).arg(m_errors).arg(m_non2xx).arg(m_reconnects);
+    text += QString("吞吐: %1 req/s，%2/s\n")
+                .arg(requestsPerSecond(), 0, 'f', 1)
+                .arg(formatBytes(bytesPerSecond()));
+    text += QString("延迟 (ms): 最小 %1，平均 %2，p50 %3，p90 %4，p99 %5，p99.9 %6，最大 %7\n\n")
+                .arg(m_histogram.min() / 1000.0, 0, 'f', 3)
+                .arg(m_histogram.mean() / 1000.0, 0, 'f', 3)
+                .arg(m_histogram.valueAtPercentile(50.0) / 1000.0, 0, 'f', 3)
+                .arg(m_histogram.valueAtPercentile(90.0) / 1000.0, 0, 'f', 3)
+                .arg(m_histogram.valueAtPercentile(99.0) / 1000.0, 0, 'f', 3)
+                .arg(m_histogram.valueAtPercentile(99.9) / 1000.0, 0, 'f', 3)
+                .arg(m_histogram.max() / 1000.0, 0, 'f', 3);
+    text += m_histogram.percentileDistribution(1000.0);
+    m_report = text;
+}
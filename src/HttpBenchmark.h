@@ -0,0 +1,157 @@
+#ifndef HTTPBENCHMARK_H
+#define HTTPBENCHMARK_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+
+#include "LatencyHistogram.h"
+
+// HTTP/1.1 压测：N 个连接并发请求同一 URL，支持闭环（收到响应立即发下一个）
+// 与开环固定速率两种模式。开环模式下延迟从"计划发送时间"算起，避免协同遗漏。
+class HttpBenchmark : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString url READ url WRITE setUrl NOTIFY urlChanged)
+    Q_PROPERTY(int connections READ connections WRITE setConnections NOTIFY connectionsChanged)
+    Q_PROPERTY(int rate READ rate WRITE setRate NOTIFY rateChanged)
+    Q_PROPERTY(int duration READ duration WRITE setDuration NOTIFY durationChanged)
+    Q_PROPERTY(bool keepAlive READ keepAlive WRITE setKeepAlive NOTIFY keepAliveChanged)
+    Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+    Q_PROPERTY(qint64 completedRequests READ completedRequests NOTIFY progressChanged)
+    Q_PROPERTY(qint64 errorCount READ errorCount NOTIFY progressChanged)
+    Q_PROPERTY(qint64 non2xxCount READ non2xxCount NOTIFY progressChanged)
+    Q_PROPERTY(qint64 reconnectCount READ reconnectCount NOTIFY progressChanged)
+    Q_PROPERTY(double requestsPerSecond READ requestsPerSecond NOTIFY progressChanged)
+    Q_PROPERTY(double bytesPerSecond READ bytesPerSecond NOTIFY progressChanged)
+    Q_PROPERTY(double p50Latency READ p50Latency NOTIFY progressChanged)
+    Q_PROPERTY(double p99Latency READ p99Latency NOTIFY progressChanged)
+    Q_PROPERTY(double maxLatency READ maxLatency NOTIFY progressChanged)
+    Q_PROPERTY(QString report READ report NOTIFY reportChanged)
+    Q_PROPERTY(QString statusMessage READ statusMessage NOTIFY statusMessageChanged)
+
+public:
+    explicit HttpBenchmark(QObject *parent = nullptr);
+    ~HttpBenchmark();
+
+    QString url() const;
+    void setUrl(const QString &url);
+
+    int connections() const;
+    void setConnections(int connections);
+
+    // 目标总速率（请求/秒），0 表示闭环压测
+    int rate() const;
+    void setRate(int rate);
+
+    // 压测时长（秒）
+    int duration() const;
+    void setDuration(int seconds);
+
+    bool keepAlive() const;
+    void setKeepAlive(bool keepAlive);
+
+    bool running() const;
+    qint64 completedRequests() const;
+    qint64 errorCount() const;
+    qint64 non2xxCount() const;
+    qint64 reconnectCount() const;
+    double requestsPerSecond() const;
+    double bytesPerSecond() const;
+    // 以下延迟单位均为毫秒
+    double p50Latency() const;
+    double p99Latency() const;
+    double maxLatency() const;
+    QString report() const;
+    QString statusMessage() const;
+
+    const LatencyHistogram &histogram() const;
+
+    Q_INVOKABLE bool start();
+    Q_INVOKABLE void stop();
+
+signals:
+    void urlChanged();
+    void connectionsChanged();
+    void rateChanged();
+    void durationChanged();
+    void keepAliveChanged();
+    void runningChanged();
+    void progressChanged();
+    void reportChanged();
+    void statusMessageChanged();
+    void finished();
+
+private slots:
+    void onConnected();
+    void onReadyRead();
+    void onDisconnected();
+    void onSocketError(QAbstractSocket::SocketError error);
+    void onScheduleTick();
+    void onProgressTick();
+
+private:
+    struct Connection {
+        int index = 0;
+        QTcpSocket *socket = nullptr;
+        QByteArray buffer;
+        bool busy = false;
+        bool closeAfterResponse = false;
+        qint64 intendedNs = 0;
+        qint64 nextSendNs = 0;
+
+        // 当前响应的解析状态
+        int headerLength = -1;
+        int statusCode = 0;
+        qint64 contentLength = -1;
+        bool chunked = false;
+    };
+
+    Connection *connectionFor(QObject *socket);
+    void openConnection(Connection &connection);
+    void dropSocket(Connection &connection);
+    void sendRequest(Connection &connection, qint64 intendedNs);
+    void trySend(Connection &connection);
+    bool processResponse(Connection &connection);
+    bool parseHeaders(Connection &connection);
+    qint64 chunkedMessageEnd(const Connection &connection) const;
+    void completeResponse(Connection &connection, qint64 consumed);
+    void failRequest(Connection &connection);
+    void resetResponseState(Connection &connection);
+    void buildReport();
+    void setStatusMessage(const QString &message);
+
+    QString m_url;
+    int m_connections;
+    int m_rate;
+    int m_duration;
+    bool m_keepAlive;
+    bool m_running;
+    QString m_report;
+    QString m_statusMessage;
+
+    QUrl m_target;
+    QByteArray m_requestBytes;
+    QVector<Connection> m_pool;
+    QHash<QObject *, int> m_socketIndex;
+    QTimer *m_scheduleTimer;
+    QTimer *m_progressTimer;
+    QTimer *m_durationTimer;
+    QElapsedTimer m_clock;
+    qint64 m_intervalNs;
+    qint64 m_elapsedNs;
+
+    LatencyHistogram m_histogram;
+    qint64 m_completed;
+    qint64 m_errors;
+    qint64 m_non2xx;
+    qint64 m_reconnects;
+    qint64 m_bytes;
+};
+
+#endif // HTTPBENCHMARK_H
@@ -0,0 +1,317 @@
+#include "ImageCompressor.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QRegularExpression>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace {
+
+bool limited(int maxWidth, int maxHeight)
+{
+    return maxWidth > 0 && maxHeight > 0;
+}
+
+bool exceeds(const QSize &size, int maxWidth, int maxHeight)
+{
+    return size.width() > maxWidth || size.height() > maxHeight;
+}
+
+bool hasWildcard(const QString &text)
+{
+    return text.contains('*') || text.contains('?') || text.contains('[');
+}
+
+// * 与 ? 不匹配 '/'，**/ 匹配零或多层目录，[...] 为字符集合（[!...] 取反）
+QRegularExpression globExpression(const QString &pattern)
+{
+    QString expression;
+    for (qsizetype i = 0; i < pattern.size(); ++i) {
+        const QChar c = pattern.at(i);
+        if (c == '*') {
+            if (i + 1 < pattern.size() && pattern.at(i + 1) == '*') {
+                ++i;
+                if (i + 1 < pattern.size() && pattern.at(i + 1) == '/') {
+                    ++i;
+                    expression += QStringLiteral("(?:.*/)?");
+                } else {
+                    expression += QStringLiteral(".*");
+                }
+            } else {
+                expression += QStringLiteral("[^/]*");
+            }
+        } else if (c == '?') {
+            expression += QStringLiteral("[^/]");
+        } else if (c == '[') {
+            qsizetype end = i + 1;
+            if (end < pattern.size() && pattern.at(end) == '!') {
+                ++end;
+            }
+            if (end < pattern.size() && pattern.at(end) == ']') {
+                ++end;
+            }
+            end = pattern.indexOf(']', end);
+            if (end < 0) {
+                expression += QRegularExpression::escape(QString(c));
+                continue;
+            }
+            QString set = pattern.mid(i + 1, end - i - 1);
+            if (set.startsWith('!')) {
+                set[0] = '^';
+            }
+            expression += QStringLiteral("[") + set.replace(QStringLiteral("\\"), QStringLiteral("\\\\")) + ']';
+            i = end;
+        } else {
+            expression += QRegularExpression::escape(QString(c));
+        }
+    }
+    // 照片的扩展名大小写常常不统一
+    return QRegularExpression(QRegularExpression::anchoredPattern(expression), QRegularExpression::CaseInsensitiveOption);
+}
+
+// 换成输出格式的扩展名后的相对路径，重名时靠后的文件在文件名后加上原扩展名，仍然重名再加序号。
+// 比较时不区分大小写，避免在 Windows 与 macOS 上互相覆盖
+QStringList outputPaths(const QStringList &paths, const QString &suffix)
+{
+    QSet<QString> used;
+    QStringList result;
+    result.reserve(paths.size());
+    for (const QString &path : paths) {
+        const qsizetype slash = path.lastIndexOf('/');
+        const QString directory = path.left(slash + 1);
+        const QString name = path.mid(slash + 1);
+        const qsizetype dot = name.lastIndexOf('.');
+        const QString baseName = dot > 0 ? name.left(dot) : name;
+        const QString original = dot > 0 ? baseName + '_' + name.mid(dot + 1) : baseName;
+
+        QString candidate = directory + baseName + '.' + suffix;
+        for (int serial = 1; used.contains(candidate.toLower()); ++serial) {
+            candidate = directory + original + (serial > 1 ? QStringLiteral("_%1").arg(serial) : QString()) + '.' + suffix;
+        }
+        used.insert(candidate.toLower());
+        result.append(candidate);
+    }
+    return result;
+}
+
+// 逐个或在独立线程池中处理 indices；blockingMap 的调用线程也参与处理，池中只需再开 threadCount - 1 个线程
+template <typename Function>
+void forEachParallel(const QList<qsizetype> &indices, int threadCount, Function function)
+{
+    if (threadCount <= 1) {
+        for (qsizetype index : indices) {
+            function(index);
+        }
+        return;
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount - 1);
+    QtConcurrent::blockingMap(&pool, indices, [&function](const qsizetype &index) {
+        function(index);
+    });
+}
+
+}
+
+QSize ImageCompressor::scaledDecodeSize(const QSize &size, QImageIOHandler::Transformations transformation, int maxWidth, int maxHeight)
+{
+    if (!limited(maxWidth, maxHeight) || !size.isValid()) {
+        return QSize();
+    }
+    if (transformation.testFlag(QImageIOHandler::TransformationRotate90)) {
+        qSwap(maxWidth, maxHeight);
+    }
+    if (!exceeds(size, maxWidth, maxHeight)) {
+        return QSize();
+    }
+    // 极端长宽比时短边不能缩成 0
+    return size.scaled(maxWidth, maxHeight, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+}
+
+QImage ImageCompressor::read(QImageReader &reader, int maxWidth, int maxHeight, QSize *originalSize)
+{
+    reader.setAutoTransform(true);
+    const QSize storedSize = reader.size();
+    const QImageIOHandler::Transformations transformation = reader.transformation();
+    const QSize decodeSize = scaledDecodeSize(storedSize, transformation, maxWidth, maxHeight);
+    if (decodeSize.isValid()) {
+        reader.setScaledSize(decodeSize);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return image;
+    }
+
+    if (originalSize) {
+        if (!storedSize.isValid()) {
+            *originalSize = image.size();
+        } else if (transformation.testFlag(QImageIOHandler::TransformationRotate90)) {
+            *originalSize = storedSize.transposed();
+        } else {
+            *originalSize = storedSize;
+        }
+    }
+
+    // 无法预先读出尺寸的格式只能解码后再缩小
+    if (limited(maxWidth, maxHeight) && exceeds(image.size(), maxWidth, maxHeight)) {
+        image = image.scaled(maxWidth, maxHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    return image;
+}
+
+ImageCompressor::Result ImageCompressor::compress(const QString &inputPath, const QString &outputPath, const Options &options)
+{
+    Result result;
+    result.inputBytes = QFileInfo(inputPath).size();
+
+    QImageReader reader(inputPath);
+    const QImage image = read(reader, options.maxWidth, options.maxHeight, &result.originalSize);
+    if (image.isNull()) {
+        result.errorMessage = QStringLiteral("图片读取失败: %1").arg(reader.errorString());
+        return result;
+    }
+
+    QFileInfo outputInfo(outputPath);
+    if (!outputInfo.dir().exists() && !QDir().mkpath(outputInfo.absolutePath())) {
+        result.errorMessage = QStringLiteral("输出目录无法创建");
+        return result;
+    }
+
+    QImageWriter writer(outputPath, options.format);
+    if (writer.supportsOption(QImageIOHandler::Quality)) {
+        writer.setQuality(qBound(1, options.quality, 100));
+    }
+    if (!writer.write(image)) {
+        result.errorMessage = QStringLiteral("图片压缩失败: %1").arg(writer.errorString());
+        return result;
+    }
+
+    result.outputSize = image.size();
+    result.outputBytes = QFileInfo(outputPath).size();
+    result.success = true;
+    return result;
+}
+
+QString ImageCompressor::suffixForFormat(const QByteArray &format)
+{
+    const QString suffix = QString::fromLatin1(format).toLower();
+    return suffix == QStringLiteral("jpeg") ? QStringLiteral("jpg") : suffix;
+}
+
+bool ImageCompressor::parseInput(const QString &input, QString *root, QString *pattern)
+{
+    const QString path = QDir::fromNativeSeparators(input.trimmed());
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    QStringList parts = path.split('/');
+    qsizetype first = 0;
+    while (first < parts.size() && !hasWildcard(parts.at(first))) {
+        ++first;
+    }
+    if (first == parts.size()) {
+        *root = QDir::cleanPath(path);
+        pattern->clear();
+    } else {
+        const QString directory = parts.mid(0, first).join('/');
+        // "/*.jpg" 的目录是根目录，"*.jpg" 的目录是当前目录
+        *root = directory.isEmpty() ? (path.startsWith('/') ? QStringLiteral("/") : QStringLiteral(".")) : QDir::cleanPath(directory);
+        *pattern = parts.mid(first).join('/');
+    }
+    return QFileInfo(*root).isDir();
+}
+
+QStringList ImageCompressor::collectImages(const QString &root, const QString &pattern)
+{
+    QSet<QString> suffixes;
+    QRegularExpression expression;
+    if (pattern.isEmpty()) {
+        const auto formats = QImageReader::supportedImageFormats();
+        for (const QByteArray &format : formats) {
+            suffixes.insert(QString::fromLatin1(format).toLower());
+        }
+    } else {
+        expression = globExpression(pattern);
+    }
+
+    // 通配符不含 '/' 时只匹配 root 下一层，不必遍历子目录
+    const bool recursive = pattern.isEmpty() || pattern.contains('/') || pattern.contains(QStringLiteral("**"));
+    const QDir rootDir(root);
+    QStringList result;
+    QDirIterator it(root, QDir::Files | QDir::NoDotAndDotDot,
+                    recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        const QFileInfo info = it.fileInfo();
+        if (info.isSymLink()) {
+            continue;
+        }
+        const QString relative = rootDir.relativeFilePath(path);
+        const bool matched = pattern.isEmpty() ? suffixes.contains(info.suffix().toLower())
+                                               : expression.match(relative).hasMatch();
+        if (matched) {
+            result.append(relative);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QList<ImageCompressor::BatchItem> ImageCompressor::compressAll(const QString &inputRoot, const QStringList &paths,
+                                                               const QString &outputRoot, const Options &options,
+                                                               int threadCount, const ProgressFunction &progress,
+                                                               bool *canceled)
+{
+    const QDir inputDir(inputRoot);
+    const QDir outputDir(outputRoot);
+    const QStringList outputs = outputPaths(paths, suffixForFormat(options.format));
+    const int total = int(paths.size());
+
+    QList<BatchItem> items(paths.size());
+    QList<bool> processed(paths.size(), false);
+    std::atomic<bool> stop(false);
+    std::atomic<int> count(0);
+    QList<qsizetype> indices(paths.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    forEachParallel(indices, threadCount, [&](qsizetype index) {
+        if (stop.load(std::memory_order_relaxed)) {
+            return;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        BatchItem &item = items[index];
+        item.path = paths.at(index);
+        item.outputPath = outputs.at(index);
+        item.result = compress(inputDir.filePath(item.path), outputDir.filePath(item.outputPath), options);
+        item.milliseconds = double(timer.nsecsElapsed()) / 1e6;
+        processed[index] = true;
+        if (progress && !progress(item, ++count, total)) {
+            stop.store(true);
+        }
+    });
+
+    QList<BatchItem> result;
+    result.reserve(count.load());
+    for (qsizetype i = 0; i < items.size(); ++i) {
+        if (processed.at(i)) {
+            result.append(items.at(i));
+        }
+    }
+    if (canceled) {
+        *canceled = stop.load();
+    }
+    return result;
+}
@@ -0,0 +1,82 @@
+#ifndef IMAGECOMPRESSOR_H
+#define IMAGECOMPRESSOR_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QImageIOHandler>
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+class QImageReader;
+
+// 单张图片的缩小与重新编码，不依赖界面，可在任意线程中使用。
+// 需要缩小时先从文件头读出尺寸，再通过 QImageReader::setScaledSize 告诉解码器目标尺寸：
+// JPEG 由 libjpeg 在 DCT 域按 1/2、1/4、1/8 直接降采样解码，解码耗时和内存随输出尺寸而不是原图尺寸增长；
+// 不支持缩放解码的格式由 QImageReader 解码后再缩小。
+// 批量压缩时多个文件在独立的线程池中并行处理，每个工作线程各用自己的解码器与编码器。
+class ImageCompressor
+{
+public:
+    struct Options {
+        // QImageWriter 的格式名，例如 "jpeg"
+        QByteArray format = "jpeg";
+        // 1 ~ 100，只对支持质量参数的格式生效
+        int quality = 80;
+        // 任一为 0 表示保持原尺寸
+        int maxWidth = 0;
+        int maxHeight = 0;
+    };
+
+    struct Result {
+        bool success = false;
+        QString errorMessage;
+        // 原图（已按 EXIF 方向旋转）与输出图片的尺寸
+        QSize originalSize;
+        QSize outputSize;
+        qint64 inputBytes = 0;
+        qint64 outputBytes = 0;
+    };
+
+    // 批量压缩中的一个文件
+    struct BatchItem {
+        // 分别相对输入文件夹与输出文件夹，分隔符为 '/'
+        QString path;
+        QString outputPath;
+        Result result;
+        // 解码、缩小与编码的总耗时
+        double milliseconds = 0;
+    };
+
+    // 每处理完一个文件调用一次，可能来自不同的工作线程；返回 false 时取消
+    using ProgressFunction = std::function<bool(const BatchItem &item, int processed, int total)>;
+
+    // 文件中存储的尺寸为 size 的图片缩小到 maxWidth × maxHeight 以内时应解码出的尺寸，不需要缩小时返回无效尺寸。
+    // 缩放解码发生在自动旋转之前，transformation 含 90° 旋转时限制框要先转置
+    static QSize scaledDecodeSize(const QSize &size, QImageIOHandler::Transformations transformation, int maxWidth, int maxHeight);
+    // 开启自动旋转并按目标尺寸解码；originalSize 返回旋转后的原图尺寸。失败时返回空图片，原因见 reader.errorString()
+    static QImage read(QImageReader &reader, int maxWidth, int maxHeight, QSize *originalSize = nullptr);
+    // 输出目录不存在时自动创建
+    static Result compress(const QString &inputPath, const QString &outputPath, const Options &options);
+
+    // 输出文件的扩展名，jpeg 写为 jpg
+    static QString suffixForFormat(const QByteArray &format);
+
+    // 批量输入可以是文件夹，也可以是带通配符的路径：* 与 ? 不跨目录，** 匹配任意层目录，例如 D:/photos/**/*.jpg。
+    // root 为第一个含通配符的部分之前的目录，pattern 为相对 root 的通配符；输入是文件夹时 pattern 为空。root 不是文件夹时返回 false
+    static bool parseInput(const QString &input, QString *root, QString *pattern);
+    // 列出 root 下匹配 pattern 的文件，pattern 为空时递归列出扩展名属于可读图片格式的文件。
+    // 返回相对 root 的路径并排序；跳过隐藏文件，不进入目录符号链接
+    static QStringList collectImages(const QString &root, const QString &pattern);
+    // 压缩 inputRoot 下的 paths，输出到 outputRoot 下相同的相对位置，扩展名换成输出格式；
+    // 换扩展名后重名的文件（如 a.png 与 a.bmp）在文件名后加上原扩展名区分。threadCount 为同时处理的文件数。
+    // 返回已处理文件的结果，顺序与 paths 相同；被取消时置 canceled，尚未处理的文件不在结果中
+    static QList<BatchItem> compressAll(const QString &inputRoot, const QStringList &paths, const QString &outputRoot,
+                                        const Options &options, int threadCount,
+                                        const ProgressFunction &progress = ProgressFunction(), bool *canceled = nullptr);
+};
+
+#endif // IMAGECOMPRESSOR_H
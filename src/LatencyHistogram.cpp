@@ -0,0 +1,204 @@
+#include "LatencyHistogram.h"
+
+#include <QtAlgorithms>
+#include <QtMath>
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram(qint64 highestTrackableValue, int significantDigits)
+    : m_highestTrackableValue(qMax<qint64>(2, highestTrackableValue))
+    , m_totalCount(0)
+    , m_min(std::numeric_limits<qint64>::max())
+    , m_max(0)
+    , m_sum(0)
+{
+    significantDigits = qBound(1, significantDigits, 5);
+
+    // 子桶数量需覆盖 2 * 10^digits，取 2 的幂
+    const qint64 largestValueWithSingleUnitResolution = 2 * qint64(qPow(10, significantDigits));
+    const int subBucketCountMagnitude = int(qCeil(std::log2(double(largestValueWithSingleUnitResolution))));
+    m_subBucketHalfCountMagnitude = qMax(subBucketCountMagnitude, 1) - 1;
+    m_subBucketCount = 1 << (m_subBucketHalfCountMagnitude + 1);
+    m_subBucketHalfCount = m_subBucketCount / 2;
+    m_subBucketMask = qint64(m_subBucketCount - 1);
+
+    qint64 smallestUntrackableValue = qint64(m_subBucketCount);
+    int bucketsNeeded = 1;
+    while (smallestUntrackableValue <= m_highestTrackableValue) {
+        if (smallestUntrackableValue > std::numeric_limits<qint64>::max() / 2) {
+            ++bucketsNeeded;
+            break;
+        }
+        smallestUntrackableValue <<= 1;
+        ++bucketsNeeded;
+    }
+    m_counts.fill(0, (bucketsNeeded + 1) * m_subBucketHalfCount);
+}
+
+void LatencyHistogram::record(qint64 value)
+{
+    value = qBound<qint64>(0, value, m_highestTrackableValue);
+    const int index = countsIndexFor(value);
+    if (index < 0 || index >= m_counts.size()) {
+        return;
+    }
+
+    ++m_counts[index];
+    ++m_totalCount;
+    m_sum += double(value);
+    m_min = qMin(m_min, value);
+    m_max = qMax(m_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    if (other.m_counts.size() != m_counts.size() || other.m_subBucketCount != m_subBucketCount) {
+        return;
+    }
+
+    for (int i = 0; i < m_counts.size(); ++i) {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_totalCount += other.m_totalCount;
+    m_sum += other.m_sum;
+    if (other.m_totalCount > 0) {
+        m_min = qMin(m_min, other.m_min);
+        m_max = qMax(m_max, other.m_max);
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    m_counts.fill(0);
+    m_totalCount = 0;
+    m_min = std::numeric_limits<qint64>::max();
+    m_max = 0;
+    m_sum = 0;
+}
+
+qint64 LatencyHistogram::count() const
+{
+    return m_totalCount;
+}
+
+qint64 LatencyHistogram::min() const
+{
+    return m_totalCount > 0 ? m_min : 0;
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+double LatencyHistogram::mean() const
+{
+    return m_totalCount > 0 ? m_sum / double(m_totalCount) : 0.0;
+}
+
+qint64 LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    if (m_totalCount == 0) {
+        return 0;
+    }
+
+    percentile = qBound(0.0, percentile, 100.0);
+    const qint64 countAtPercentile = qMax<qint64>(1, qint64(percentile / 100.0 * double(m_totalCount) + 0.5));
+    qint64 total = 0;
+    for (int i = 0; i < m_counts.size(); ++i) {
+        total += m_counts[i];
+        if (total >= countAtPercentile) {
+            return qMin(highestEquivalentValue(valueFromIndex(i)), m_max);
+        }
+    }
+    return m_max;
+}
+
+QString LatencyHistogram::percentileDistribution(double unitScale, int ticksPerHalfDistance) const
+{
+    QString output = QString("%1 %2 %3 %4\n")
+        .arg(QString("Value"), 12)
+        .arg(QString("Percentile"), 14)
+        .arg(QString("TotalCount"), 12)
+        .arg(QString("1/(1-Percentile)"), 18);
+    if (m_totalCount == 0 || unitScale <= 0) {
+        return output;
+    }
+
+    // 与 HdrHistogram 相同：每接近 100% 一半距离，输出点数翻倍
+    double percentile = 0.0;
+    while (true) {
+        const qint64 value = valueAtPercentile(percentile);
+        qint64 countAtValue = 0;
+        for (int i = 0; i < m_counts.size(); ++i) {
+            if (valueFromIndex(i) > value) {
+                break;
+            }
+            countAtValue += m_counts[i];
+        }
+        const double ratio = percentile / 100.0;
+        output += QString("%1 %2 %3 %4\n")
+            .arg(double(value) / unitScale, 12, 'f', 3)
+            .arg(ratio, 14, 'f', 6)
+            .arg(countAtValue, 12)
+            .arg(ratio < 1.0 ? QString::number(1.0 / (1.0 - ratio), 'f', 2) : QString("inf"), 18);
+
+        if (percentile >= 100.0 || countAtValue >= m_totalCount) {
+            break;
+        }
+        const double halfDistance = std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - percentile))) + 1);
+        percentile += 100.0 / (halfDistance * ticksPerHalfDistance);
+        if (percentile > 99.9999) {
+            percentile = 100.0;
+        }
+    }
+
+    output += QString("#[Mean    = %1, Max = %2, Count = %3]\n")
+        .arg(mean() / unitScale, 0, 'f', 3)
+        .arg(double(m_max) / unitScale, 0, 'f', 3)
+        .arg(m_totalCount);
+    return output;
+}
+
+int LatencyHistogram::bucketIndex(qint64 value) const
+{
+    const int pow2Ceiling = 64 - qCountLeadingZeroBits(quint64(value | m_subBucketMask));
+    return pow2Ceiling - (m_subBucketHalfCountMagnitude + 1);
+}
+
+int LatencyHistogram::subBucketIndex(qint64 value, int bucketIndex) const
+{
+    return int(value >> bucketIndex);
+}
+
+int LatencyHistogram::countsIndex(int bucketIndex, int subBucketIndex) const
+{
+    const int bucketBaseIndex = (bucketIndex + 1) << m_subBucketHalfCountMagnitude;
+    return bucketBaseIndex + (subBucketIndex - m_subBucketHalfCount);
+}
+
+int LatencyHistogram::countsIndexFor(qint64 value) const
+{
+    const int bucket = bucketIndex(value);
+    return countsIndex(bucket, subBucketIndex(value, bucket));
+}
+
+qint64 LatencyHistogram::valueFromIndex(int index) const
+{
+    int bucket = (index >> m_subBucketHalfCountMagnitude) - 1;
+    int subBucket = (index & (m_subBucketHalfCount - 1)) + m_subBucketHalfCount;
+    if (bucket < 0) {
+        subBucket -= m_subBucketHalfCount;
+        bucket = 0;
+    }
+    return qint64(subBucket) << bucket;
+}
+
+qint64 LatencyHistogram::highestEquivalentValue(qint64 value) const
+{
+    const int bucket = bucketIndex(value);
+    const int subBucket = subBucketIndex(value, bucket);
+    const qint64 lowest = qint64(subBucket) << bucket;
+    const int adjustedBucket = subBucket >= m_subBucketCount ? bucket + 1 : bucket;
+    return lowest + (qint64(1) << adjustedBucket) - 1;
+}
@@ -0,0 +1,48 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// HDR（高动态范围）直方图：对数分桶 + 桶内线性子桶，
+// 在 1 到 highestTrackableValue 的整个范围内保持固定的有效数字精度。
+class LatencyHistogram
+{
+public:
+    explicit LatencyHistogram(qint64 highestTrackableValue = 60LL * 1000 * 1000, int significantDigits = 3);
+
+    void record(qint64 value);
+    void merge(const LatencyHistogram &other);
+    void reset();
+
+    qint64 count() const;
+    qint64 min() const;
+    qint64 max() const;
+    double mean() const;
+    qint64 valueAtPercentile(double percentile) const;
+
+    // HdrHistogram 风格的百分位分布文本，value 除以 unitScale 后输出
+    QString percentileDistribution(double unitScale, int ticksPerHalfDistance = 5) const;
+
+private:
+    int bucketIndex(qint64 value) const;
+    int subBucketIndex(qint64 value, int bucketIndex) const;
+    int countsIndex(int bucketIndex, int subBucketIndex) const;
+    int countsIndexFor(qint64 value) const;
+    qint64 valueFromIndex(int index) const;
+    qint64 highestEquivalentValue(qint64 value) const;
+
+    qint64 m_highestTrackableValue;
+    int m_subBucketHalfCountMagnitude;
+    int m_subBucketHalfCount;
+    int m_subBucketCount;
+    qint64 m_subBucketMask;
+    QVector<qint64> m_counts;
+    qint64 m_totalCount;
+    qint64 m_min;
+    qint64 m_max;
+    double m_sum;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,205 @@
+#include "MultiBufferHash.h"
+#include "CpuFeatures.h"
+#include "SM3.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+const quint32 MultiBufferHashHw::kSha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+namespace {
+
+const quint32 kSha256InitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+inline quint32 rotateRight(quint32 x, int n)
+{
+    return (x >> n) | (x << (32 - n));
+}
+
+void sm3Portable(quint32 *state, const quint8 *const *blocks)
+{
+    SM3::compress(state, blocks[0], 1);
+}
+
+void sha256Portable(quint32 *state, const quint8 *const *blocks)
+{
+    const quint32 *k = MultiBufferHashHw::kSha256RoundConstants;
+    quint32 w[64];
+    for (int t = 0; t < 16; ++t) {
+        w[t] = qFromBigEndian<quint32>(blocks[0] + t * 4);
+    }
+    for (int t = 16; t < 64; ++t) {
+        const quint32 s0 = rotateRight(w[t - 15], 7) ^ rotateRight(w[t - 15], 18) ^ (w[t - 15] >> 3);
+        const quint32 s1 = rotateRight(w[t - 2], 17) ^ rotateRight(w[t - 2], 19) ^ (w[t - 2] >> 10);
+        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    quint32 a = state[0], b = state[1], c = state[2], d = state[3];
+    quint32 e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 64; ++t) {
+        const quint32 t1 = h + (rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25))
+                           + ((e & f) ^ (~e & g)) + k[t] + w[t];
+        const quint32 t2 = (rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22))
+                           + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+// 一个通道上正在计算的消息：先直接读取消息中的完整分组，再读取带填充的尾部分组
+struct Lane {
+    qsizetype message = -1;
+    const quint8 *data = nullptr;
+    qsizetype fullBlocks = 0;
+    qsizetype totalBlocks = 0;
+    qsizetype next = 0;
+    quint8 tail[MultiBufferHash::kBlockLength * 2];
+
+    void start(qsizetype index, const QByteArray &bytes)
+    {
+        message = index;
+        data = reinterpret_cast<const quint8 *>(bytes.constData());
+        fullBlocks = bytes.size() / MultiBufferHash::kBlockLength;
+        next = 0;
+
+        // SM3 与 SHA-256 的填充规则相同：0x80，补 0，末尾 64 位大端比特长度
+        const qsizetype remainder = bytes.size() % MultiBufferHash::kBlockLength;
+        const int tailLength = remainder < 56 ? MultiBufferHash::kBlockLength : MultiBufferHash::kBlockLength * 2;
+        std::memset(tail, 0, sizeof(tail));
+        if (remainder > 0) {
+            std::memcpy(tail, data + fullBlocks * MultiBufferHash::kBlockLength, size_t(remainder));
+        }
+        tail[remainder] = 0x80;
+        qToBigEndian<quint64>(quint64(bytes.size()) * 8, tail + tailLength - 8);
+        totalBlocks = fullBlocks + tailLength / MultiBufferHash::kBlockLength;
+    }
+
+    const quint8 *block() const
+    {
+        return next < fullBlocks ? data + next * MultiBufferHash::kBlockLength
+                                 : tail + (next - fullBlocks) * MultiBufferHash::kBlockLength;
+    }
+};
+
+}
+
+const MultiBufferHash::Implementation &MultiBufferHash::portable()
+{
+    static const Implementation impl = {"Scalar", 1, sm3Portable, sha256Portable};
+    return impl;
+}
+
+QList<const MultiBufferHash::Implementation *> MultiBufferHash::available()
+{
+    QList<const Implementation *> result{&portable()};
+#if defined(Q_PROCESSOR_X86)
+    // 大端字节序转换用 PSHUFB
+    static const Implementation ssse3 = {"SSSE3 x4", 4, MultiBufferHashHw::sm3Ssse3, MultiBufferHashHw::sha256Ssse3};
+    static const Implementation avx2 = {"AVX2 x8", 8, MultiBufferHashHw::sm3Avx2, MultiBufferHashHw::sha256Avx2};
+    if (CpuFeatures::hasSsse3()) {
+        result << &ssse3;
+        if (CpuFeatures::hasAvx2()) {
+            result << &avx2;
+        }
+    }
+#endif
+    return result;
+}
+
+const MultiBufferHash::Implementation &MultiBufferHash::active()
+{
+    static const Implementation *impl = available().constLast();
+    return *impl;
+}
+
+void MultiBufferHash::hashMany(Algorithm algorithm, const QByteArray *messages, qsizetype count, quint8 *digests,
+                               const Implementation &implementation)
+{
+    const int lanes = implementation.lanes;
+    const CompressFunction compress = algorithm == Sm3 ? implementation.sm3 : implementation.sha256;
+    quint32 initial[8];
+    if (algorithm == Sm3) {
+        SM3::initialState(initial);
+    } else {
+        std::memcpy(initial, kSha256InitialState, sizeof(initial));
+    }
+
+    // 空闲通道压缩一个全 0 分组，结果丢弃
+    static const quint8 idleBlock[kBlockLength] = {};
+    quint32 state[8 * kMaxLanes];
+    Lane lane[kMaxLanes];
+    const quint8 *blocks[kMaxLanes];
+    qsizetype nextMessage = 0;
+    int busy = 0;
+
+    auto assign = [&](int i) {
+        if (nextMessage >= count) {
+            lane[i].message = -1;
+            return;
+        }
+        lane[i].start(nextMessage, messages[nextMessage]);
+        ++nextMessage;
+        ++busy;
+        for (int word = 0; word < 8; ++word) {
+            state[word * lanes + i] = initial[word];
+        }
+    };
+
+    for (int i = 0; i < lanes; ++i) {
+        assign(i);
+    }
+
+    // 每轮为所有通道各压缩一个分组；某条消息结束后立即输出摘要，并在该通道换上下一条消息
+    while (busy > 0) {
+        for (int i = 0; i < lanes; ++i) {
+            blocks[i] = lane[i].message >= 0 ? lane[i].block() : idleBlock;
+        }
+        compress(state, blocks);
+
+        for (int i = 0; i < lanes; ++i) {
+            if (lane[i].message < 0 || ++lane[i].next < lane[i].totalBlocks) {
+                continue;
+            }
+            quint8 *digest = digests + lane[i].message * kDigestLength;
+            for (int word = 0; word < 8; ++word) {
+                qToBigEndian(state[word * lanes + i], digest + word * 4);
+            }
+            --busy;
+            assign(i);
+        }
+    }
+}
+
+QList<QByteArray> MultiBufferHash::hashMany(Algorithm algorithm, const QList<QByteArray> &messages)
+{
+    QByteArray digests(messages.size() * kDigestLength, Qt::Uninitialized);
+    hashMany(algorithm, messages.constData(), messages.size(), reinterpret_cast<quint8 *>(digests.data()));
+
+    QList<QByteArray> result;
+    result.reserve(messages.size());
+    for (qsizetype i = 0; i < messages.size(); ++i) {
+        result.append(digests.mid(i * kDigestLength, kDigestLength));
+    }
+    return result;
+}
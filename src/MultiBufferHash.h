@@ -0,0 +1,56 @@
+#ifndef MULTIBUFFERHASH_H
+#define MULTIBUFFERHASH_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtGlobal>
+
+// 多缓冲区哈希：把多条互相独立的消息分别放进 SIMD 寄存器的各个通道同时压缩，
+// 适合一次校验成千上万个短令牌或逐文件摘要。SSSE3 每次 4 条，AVX2 每次 8 条，
+// 没有这些指令时逐条计算。结果与 SM3::hash / QCryptographicHash::hash 完全一致。
+class MultiBufferHash
+{
+public:
+    enum Algorithm { Sm3, Sha256 };
+
+    static constexpr int kDigestLength = 32;
+    static constexpr int kBlockLength = 64;
+    static constexpr int kMaxLanes = 8;
+
+    // 为每个通道各压缩一个 64 字节分组。state 按字交错存放：
+    // 第 i 个状态字在各通道的值依次位于 state[i * lanes]、state[i * lanes + 1] ...
+    using CompressFunction = void (*)(quint32 *state, const quint8 *const *blocks);
+
+    struct Implementation {
+        const char *name;
+        int lanes;
+        CompressFunction sm3;
+        CompressFunction sha256;
+    };
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active();
+    static const Implementation &portable();
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available();
+
+    // 计算 count 条消息的摘要，依次写入 digests（须有 count * kDigestLength 字节）
+    static void hashMany(Algorithm algorithm, const QByteArray *messages, qsizetype count, quint8 *digests,
+                         const Implementation &implementation = active());
+    static QList<QByteArray> hashMany(Algorithm algorithm, const QList<QByteArray> &messages);
+};
+
+// SHA-256 的 64 个轮常量，可移植实现与 SIMD 实现共用
+namespace MultiBufferHashHw {
+extern const quint32 kSha256RoundConstants[64];
+
+// SIMD 实现位于 MultiBufferHash_x86.cpp / MultiBufferHash_avx2.cpp，这两个文件使用单独的编译选项
+#if defined(Q_PROCESSOR_X86)
+void sm3Ssse3(quint32 *state, const quint8 *const *blocks);
+void sha256Ssse3(quint32 *state, const quint8 *const *blocks);
+void sm3Avx2(quint32 *state, const quint8 *const *blocks);
+void sha256Avx2(quint32 *state, const quint8 *const *blocks);
+#endif
+}
+
+#endif // MULTIBUFFERHASH_H
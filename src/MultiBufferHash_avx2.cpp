@@ -0,0 +1,163 @@
+#include "MultiBufferHash.h"
+
+// AVX2 实现。GCC/Clang 下本文件以 -mavx2 单独编译，只有 CpuFeatures 检测到 SSSE3 与 AVX2 时才会被调用。
+// 与 MultiBufferHash_x86.cpp 的算法相同，寄存器加宽到 256 位，每次同时压缩 8 条消息。
+#if defined(Q_PROCESSOR_X86)
+
+#include <immintrin.h>
+
+namespace {
+
+constexpr int kLanes = 8;
+
+inline __m256i add(__m256i a, __m256i b)
+{
+    return _mm256_add_epi32(a, b);
+}
+
+inline __m256i xor3(__m256i a, __m256i b, __m256i c)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+template <int N>
+inline __m256i rotateLeft(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+}
+
+template <int N>
+inline __m256i rotateRight(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N));
+}
+
+// 读入 8 个通道的 16 个消息字（大端），w[i] 的第 k 个元素来自第 k 个通道：
+// 通道 k 与 k + 4 的同一段放进同一个寄存器的低、高 128 位，再在两个 128 位通道内各做一次 4x4 转置
+inline void loadMessage(const quint8 *const *blocks, __m256i *w)
+{
+    const __m256i byteSwap = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+    for (int i = 0; i < 16; i += 4) {
+        __m256i r[4];
+        for (int k = 0; k < 4; ++k) {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[k] + i * 4));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[k + 4] + i * 4));
+            r[k] = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), byteSwap);
+        }
+        const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+        const __m256i t1 = _mm256_unpacklo_epi32(r[2], r[3]);
+        const __m256i t2 = _mm256_unpackhi_epi32(r[0], r[1]);
+        const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+        w[i] = _mm256_unpacklo_epi64(t0, t1);
+        w[i + 1] = _mm256_unpackhi_epi64(t0, t1);
+        w[i + 2] = _mm256_unpacklo_epi64(t2, t3);
+        w[i + 3] = _mm256_unpackhi_epi64(t2, t3);
+    }
+}
+
+inline void loadState(const quint32 *state, __m256i *v)
+{
+    for (int i = 0; i < 8; ++i) {
+        v[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state + i * kLanes));
+    }
+}
+
+inline quint32 rotateLeft32(quint32 x, int n)
+{
+    n &= 31;
+    return n == 0 ? x : (x << n) | (x >> (32 - n));
+}
+
+inline __m256i sm3P0(__m256i x)
+{
+    return xor3(x, rotateLeft<9>(x), rotateLeft<17>(x));
+}
+
+inline __m256i sm3P1(__m256i x)
+{
+    return xor3(x, rotateLeft<15>(x), rotateLeft<23>(x));
+}
+
+}
+
+void MultiBufferHashHw::sm3Avx2(quint32 *state, const quint8 *const *blocks)
+{
+    __m256i w[68];
+    loadMessage(blocks, w);
+    for (int j = 16; j < 68; ++j) {
+        w[j] = xor3(sm3P1(xor3(w[j - 16], w[j - 9], rotateLeft<15>(w[j - 3]))), rotateLeft<7>(w[j - 13]), w[j - 6]);
+    }
+
+    __m256i v[8];
+    loadState(state, v);
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int j = 0; j < 64; ++j) {
+        const __m256i t = _mm256_set1_epi32(int(rotateLeft32(j < 16 ? 0x79cc4519 : 0x7a879d8a, j)));
+        const __m256i a12 = rotateLeft<12>(a);
+        const __m256i ss1 = rotateLeft<7>(add(add(a12, e), t));
+        const __m256i ss2 = _mm256_xor_si256(ss1, a12);
+        __m256i ff;
+        __m256i gg;
+        if (j < 16) {
+            ff = xor3(a, b, c);
+            gg = xor3(e, f, g);
+        } else {
+            ff = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(_mm256_or_si256(a, b), c));
+            gg = _mm256_or_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        }
+        const __m256i tt1 = add(add(ff, d), add(ss2, _mm256_xor_si256(w[j], w[j + 4])));
+        const __m256i tt2 = add(add(gg, h), add(ss1, w[j]));
+        d = c;
+        c = rotateLeft<9>(b);
+        b = a;
+        a = tt1;
+        h = g;
+        g = rotateLeft<19>(f);
+        f = e;
+        e = sm3P0(tt2);
+    }
+
+    const __m256i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(state + i * kLanes), _mm256_xor_si256(v[i], out[i]));
+    }
+}
+
+void MultiBufferHashHw::sha256Avx2(quint32 *state, const quint8 *const *blocks)
+{
+    __m256i w[64];
+    loadMessage(blocks, w);
+    for (int t = 16; t < 64; ++t) {
+        const __m256i s0 = xor3(rotateRight<7>(w[t - 15]), rotateRight<18>(w[t - 15]), _mm256_srli_epi32(w[t - 15], 3));
+        const __m256i s1 = xor3(rotateRight<17>(w[t - 2]), rotateRight<19>(w[t - 2]), _mm256_srli_epi32(w[t - 2], 10));
+        w[t] = add(add(w[t - 16], s0), add(w[t - 7], s1));
+    }
+
+    __m256i v[8];
+    loadState(state, v);
+    __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int t = 0; t < 64; ++t) {
+        const __m256i k = _mm256_set1_epi32(int(kSha256RoundConstants[t]));
+        const __m256i sigma1 = xor3(rotateRight<6>(e), rotateRight<11>(e), rotateRight<25>(e));
+        const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const __m256i t1 = add(add(h, sigma1), add(ch, add(k, w[t])));
+        const __m256i sigma0 = xor3(rotateRight<2>(a), rotateRight<13>(a), rotateRight<22>(a));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(_mm256_or_si256(a, b), c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, add(sigma0, maj));
+    }
+
+    const __m256i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(state + i * kLanes), add(v[i], out[i]));
+    }
+}
+
+#endif
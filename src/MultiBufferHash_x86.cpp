@@ -0,0 +1,160 @@
+#include "MultiBufferHash.h"
+
+// SSSE3 实现。GCC/Clang 下本文件以 -mssse3 单独编译，只有 CpuFeatures 检测到 SSSE3 时才会被调用。
+// 4 条消息各取一个分组，转置后每个 128 位寄存器存放 4 条消息的同一个字，
+// 消息扩展与 64 轮压缩对 4 个通道同时进行；循环移位用移位加或，字节序转换用 PSHUFB。
+#if defined(Q_PROCESSOR_X86)
+
+#include <tmmintrin.h>
+
+namespace {
+
+constexpr int kLanes = 4;
+
+inline __m128i add(__m128i a, __m128i b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+inline __m128i xor3(__m128i a, __m128i b, __m128i c)
+{
+    return _mm_xor_si128(_mm_xor_si128(a, b), c);
+}
+
+template <int N>
+inline __m128i rotateLeft(__m128i x)
+{
+    return _mm_or_si128(_mm_slli_epi32(x, N), _mm_srli_epi32(x, 32 - N));
+}
+
+template <int N>
+inline __m128i rotateRight(__m128i x)
+{
+    return _mm_or_si128(_mm_srli_epi32(x, N), _mm_slli_epi32(x, 32 - N));
+}
+
+// 读入 4 个通道的 16 个消息字（大端），w[i] 的第 k 个元素来自第 k 个通道
+inline void loadMessage(const quint8 *const *blocks, __m128i *w)
+{
+    const __m128i byteSwap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (int i = 0; i < 16; i += 4) {
+        const __m128i r0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[0] + i * 4)), byteSwap);
+        const __m128i r1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[1] + i * 4)), byteSwap);
+        const __m128i r2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[2] + i * 4)), byteSwap);
+        const __m128i r3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks[3] + i * 4)), byteSwap);
+        const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+        const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+        const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+        const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+        w[i] = _mm_unpacklo_epi64(t0, t1);
+        w[i + 1] = _mm_unpackhi_epi64(t0, t1);
+        w[i + 2] = _mm_unpacklo_epi64(t2, t3);
+        w[i + 3] = _mm_unpackhi_epi64(t2, t3);
+    }
+}
+
+inline void loadState(const quint32 *state, __m128i *v)
+{
+    for (int i = 0; i < 8; ++i) {
+        v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + i * kLanes));
+    }
+}
+
+inline quint32 rotateLeft32(quint32 x, int n)
+{
+    n &= 31;
+    return n == 0 ? x : (x << n) | (x >> (32 - n));
+}
+
+inline __m128i sm3P0(__m128i x)
+{
+    return xor3(x, rotateLeft<9>(x), rotateLeft<17>(x));
+}
+
+inline __m128i sm3P1(__m128i x)
+{
+    return xor3(x, rotateLeft<15>(x), rotateLeft<23>(x));
+}
+
+}
+
+void MultiBufferHashHw::sm3Ssse3(quint32 *state, const quint8 *const *blocks)
+{
+    __m128i w[68];
+    loadMessage(blocks, w);
+    for (int j = 16; j < 68; ++j) {
+        w[j] = xor3(sm3P1(xor3(w[j - 16], w[j - 9], rotateLeft<15>(w[j - 3]))), rotateLeft<7>(w[j - 13]), w[j - 6]);
+    }
+
+    __m128i v[8];
+    loadState(state, v);
+    __m128i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int j = 0; j < 64; ++j) {
+        const __m128i t = _mm_set1_epi32(int(rotateLeft32(j < 16 ? 0x79cc4519 : 0x7a879d8a, j)));
+        const __m128i a12 = rotateLeft<12>(a);
+        const __m128i ss1 = rotateLeft<7>(add(add(a12, e), t));
+        const __m128i ss2 = _mm_xor_si128(ss1, a12);
+        __m128i ff;
+        __m128i gg;
+        if (j < 16) {
+            ff = xor3(a, b, c);
+            gg = xor3(e, f, g);
+        } else {
+            ff = _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(_mm_or_si128(a, b), c));
+            gg = _mm_or_si128(_mm_and_si128(e, f), _mm_andnot_si128(e, g));
+        }
+        const __m128i tt1 = add(add(ff, d), add(ss2, _mm_xor_si128(w[j], w[j + 4])));
+        const __m128i tt2 = add(add(gg, h), add(ss1, w[j]));
+        d = c;
+        c = rotateLeft<9>(b);
+        b = a;
+        a = tt1;
+        h = g;
+        g = rotateLeft<19>(f);
+        f = e;
+        e = sm3P0(tt2);
+    }
+
+    const __m128i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(state + i * kLanes), _mm_xor_si128(v[i], out[i]));
+    }
+}
+
+void MultiBufferHashHw::sha256Ssse3(quint32 *state, const quint8 *const *blocks)
+{
+    __m128i w[64];
+    loadMessage(blocks, w);
+    for (int t = 16; t < 64; ++t) {
+        const __m128i s0 = xor3(rotateRight<7>(w[t - 15]), rotateRight<18>(w[t - 15]), _mm_srli_epi32(w[t - 15], 3));
+        const __m128i s1 = xor3(rotateRight<17>(w[t - 2]), rotateRight<19>(w[t - 2]), _mm_srli_epi32(w[t - 2], 10));
+        w[t] = add(add(w[t - 16], s0), add(w[t - 7], s1));
+    }
+
+    __m128i v[8];
+    loadState(state, v);
+    __m128i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    for (int t = 0; t < 64; ++t) {
+        const __m128i k = _mm_set1_epi32(int(kSha256RoundConstants[t]));
+        const __m128i sigma1 = xor3(rotateRight<6>(e), rotateRight<11>(e), rotateRight<25>(e));
+        const __m128i ch = _mm_xor_si128(_mm_and_si128(e, f), _mm_andnot_si128(e, g));
+        const __m128i t1 = add(add(h, sigma1), add(ch, add(k, w[t])));
+        const __m128i sigma0 = xor3(rotateRight<2>(a), rotateRight<13>(a), rotateRight<22>(a));
+        const __m128i maj = _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(_mm_or_si128(a, b), c));
+        h = g;
+        g = f;
+        f = e;
+        e = add(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = add(t1, add(sigma0, maj));
+    }
+
+    const __m128i out[8] = {a, b, c, d, e, f, g, h};
+    for (int i = 0; i < 8; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(state + i * kLanes), add(v[i], out[i]));
+    }
+}
+
+#endif
@@ -0,0 +1,535 @@
+#include "OpenApiImporter.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QUrl>
+#include <yaml-cpp/yaml.h>
+
+namespace {
+
+const int kMaxSchemaDepth = 8;
+const int kMaxRefHops = 16;
+
+const char *const kHttpMethods[] = {
+    "get", "put", "post", "delete", "options", "head", "patch", "trace"
+};
+
+// yaml-cpp 节点转换为 QJsonValue；带引号的标量保持字符串类型
+QJsonValue yamlToJson(const YAML::Node &node)
+{
+    switch (node.Type()) {
+    case YAML::NodeType::Null:
+    case YAML::NodeType::Undefined:
+        return QJsonValue();
+    case YAML::NodeType::Scalar: {
+        const QString scalar = QString::fromStdString(node.Scalar());
+        if (node.Tag() == "!") {
+            return scalar;
+        }
+        if (scalar.isEmpty() || scalar == "~" || scalar == "null" || scalar == "Null" || scalar == "NULL") {
+            return QJsonValue();
+        }
+        const QString lower = scalar.toLower();
+        if (lower == "true") {
+            return true;
+        }
+        if (lower == "false") {
+            return false;
+        }
+        bool ok = false;
+        const qlonglong integer = scalar.toLongLong(&ok);
+        if (ok) {
+            return integer;
+        }
+        const double number = scalar.toDouble(&ok);
+        if (ok) {
+            return number;
+        }
+        return scalar;
+    }
+    case YAML::NodeType::Sequence: {
+        QJsonArray array;
+        for (const YAML::Node &child : node) {
+            array.append(yamlToJson(child));
+        }
+        return array;
+    }
+    case YAML::NodeType::Map: {
+        QJsonObject object;
+        for (auto it = node.begin(); it != node.end(); ++it) {
+            object.insert(QString::fromStdString(it->first.Scalar()), yamlToJson(it->second));
+        }
+        return object;
+    }
+    }
+    return QJsonValue();
+}
+
+QString responseTypeForMediaType(const QString &mediaType)
+{
+    const QString lower = mediaType.toLower();
+    if (lower.contains("json")) {
+        return "json";
+    }
+    if (lower.contains("xml")) {
+        return "xml";
+    }
+    if (lower.contains("html")) {
+        return "html";
+    }
+    return "text";
+}
+
+// 优先 application/json，其次任意 +json，最后取第一个
+QString preferredMediaType(const QJsonObject &content)
+{
+    if (content.contains("application/json")) {
+        return "application/json";
+    }
+    for (auto it = content.constBegin(); it != content.constEnd(); ++it) {
+        if (it.key().contains("json", Qt::CaseInsensitive)) {
+            return it.key();
+        }
+    }
+    return content.isEmpty() ? QString() : content.constBegin().key();
+}
+
+// 选择成功响应：最小的 2xx，其次 default，最后第一个状态码
+QString preferredStatusKey(const QJsonObject &responses)
+{
+    QString best;
+    int bestCode = 0;
+    for (auto it = responses.constBegin(); it != responses.constEnd(); ++it) {
+        const QString key = it.key().toUpper();
+        int code = 0;
+        if (key == "2XX") {
+            code = 200;
+        } else {
+            code = key.toInt();
+        }
+        if (code >= 200 && code < 300 && (bestCode == 0 || code < bestCode)) {
+            best = it.key();
+            bestCode = code;
+        }
+    }
+    if (!best.isEmpty()) {
+        return best;
+    }
+    if (responses.contains("default")) {
+        return "default";
+    }
+    return responses.isEmpty() ? QString() : responses.constBegin().key();
+}
+
+int statusCodeForKey(const QString &key)
+{
+    const QString upper = key.toUpper();
+    if (upper.size() == 3 && upper.endsWith("XX")) {
+        return upper.left(1).toInt() * 100;
+    }
+    const int code = key.toInt();
+    return code >= 100 && code < 600 ? code : 200;
+}
+
+QString bodyText(const QJsonValue &value)
+{
+    if (value.isUndefined() || value.isNull()) {
+        return QString();
+    }
+    if (value.isString()) {
+        return value.toString();
+    }
+    if (value.isObject()) {
+        return QString::fromUtf8(QJsonDocument(value.toObject()).toJson(QJsonDocument::Indented));
+    }
+    if (value.isArray()) {
+        return QString::fromUtf8(QJsonDocument(value.toArray()).toJson(QJsonDocument::Indented));
+    }
+    // 标量借助数组序列化后去掉外层括号
+    const QByteArray wrapped = QJsonDocument(QJsonArray{value}).toJson(QJsonDocument::Compact);
+    return QString::fromUtf8(wrapped.mid(1, wrapped.size() - 2));
+}
+
+} // namespace
+
+OpenApiImporter::OpenApiImporter(const QJsonObject &root)
+    : m_root(root)
+    , m_swagger2(root.contains("swagger"))
+{
+}
+
+OpenApiImporter::Result OpenApiImporter::importFile(const QString &filePath)
+{
+    QString localPath = filePath;
+    if (localPath.startsWith("file:///")) {
+        localPath = QUrl(localPath).toLocalFile();
+    }
+
+    QFile file(localPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Result result;
+        result.errorMessage = QString("无法打开文件: %1").arg(localPath);
+        return result;
+    }
+    return importData(file.readAll());
+}
+
+OpenApiImporter::Result OpenApiImporter::importData(const QByteArray &data)
+{
+    Result result;
+    QJsonObject root;
+    if (!parseDocument(data, &root, &result.errorMessage)) {
+        return result;
+    }
+    return importDocument(root);
+}
+
+OpenApiImporter::Result OpenApiImporter::importDocument(const QJsonObject &root)
+{
+    if (!isOpenApiRoot(root)) {
+        Result result;
+        result.errorMessage = "文档中未找到 openapi/swagger 版本字段";
+        return result;
+    }
+
+    OpenApiImporter importer(root);
+    return importer.run();
+}
+
+bool OpenApiImporter::parseDocument(const QByteArray &data, QJsonObject *root, QString *errorMessage)
+{
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+    if (error.error == QJsonParseError::NoError) {
+        if (!doc.isObject()) {
+            *errorMessage = "规范文档必须是对象";
+            return false;
+        }
+        *root = doc.object();
+        return true;
+    }
+
+    // JSON 解析失败时按 YAML 处理（YAML 是 JSON 的超集）
+    try {
+        const YAML::Node node = YAML::Load(data.toStdString());
+        const QJsonValue value = yamlToJson(node);
+        if (!value.isObject()) {
+            *errorMessage = "规范文档必须是对象";
+            return false;
+        }
+        *root = value.toObject();
+        return true;
+    } catch (const std::exception &e) {
+        *errorMessage = QString("规范解析失败: %1").arg(QString::fromStdString(e.what()));
+        return false;
+    }
+}
+
+bool OpenApiImporter::isOpenApiRoot(const QJsonObject &root)
+{
+    return (root.contains("openapi") || root.contains("swagger")) && root.value("paths").isObject();
+}
+
+OpenApiImporter::Result OpenApiImporter::run()
+{
+    Result result;
+    result.title = m_root.value("info").toObject().value("title").toString();
+    result.specVersion = m_root.value(m_swagger2 ? "swagger" : "openapi").toVariant().toString();
+
+    const QString prefix = basePath();
+    const QJsonObject paths = m_root.value("paths").toObject();
+    for (auto it = paths.constBegin(); it != paths.constEnd(); ++it) {
+        const QJsonObject pathItem = resolve(it.value());
+        for (const char *method : kHttpMethods) {
+            const QJsonValue operation = pathItem.value(QLatin1String(method));
+            if (!operation.isObject()) {
+                continue;
+            }
+            result.routes.append(buildRoute(prefix + it.key(), QString::fromLatin1(method).toUpper(),
+                                            operation.toObject()));
+        }
+    }
+
+    result.success = true;
+    return result;
+}
+
+// Swagger 2 使用 basePath，OpenAPI 3 取第一个 server 的路径部分
+QString OpenApiImporter::basePath() const
+{
+    QString path;
+    if (m_swagger2) {
+        path = m_root.value("basePath").toString();
+    } else {
+        const QJsonArray servers = m_root.value("servers").toArray();
+        if (!servers.isEmpty()) {
+            const QString url = servers.first().toObject().value("url").toString();
+            path = url.startsWith('/') ? url : QUrl(url).path();
+        }
+    }
+
+    // 含服务器变量的路径无法确定，直接忽略
+    if (path.contains('{')) {
+        return QString();
+    }
+    while (path.endsWith('/')) {
+        path.chop(1);
+    }
+    return path;
+}
+
+QVariantMap OpenApiImporter::buildRoute(const QString &path, const QString &method, const QJsonObject &operation)
+{
+    QVariantMap route;
+    route["path"] = path;
+    route["methods"] = QVariantList{method};
+    route["responseType"] = "json";
+    route["statusCode"] = 200;
+    route["responseBody"] = QString();
+    route["contentType"] = QString();
+    route["delay"] = 0;
+    route["enabled"] = true;
+    fillResponse(operation, &route);
+    return route;
+}
+
+void OpenApiImporter::fillResponse(const QJsonObject &operation, QVariantMap *route)
+{
+    const QJsonObject responses = operation.value("responses").toObject();
+    const QString statusKey = preferredStatusKey(responses);
+    if (statusKey.isEmpty()) {
+        return;
+    }
+
+    (*route)["statusCode"] = statusCodeForKey(statusKey);
+    const QJsonObject response = resolve(responses.value(statusKey));
+
+    if (m_swagger2) {
+        const QJsonObject examples = response.value("examples").toObject();
+        const QString mediaType = preferredMediaType(examples);
+        QJsonValue body;
+        if (!mediaType.isEmpty()) {
+            body = examples.value(mediaType);
+            (*route)["contentType"] = mediaType;
+            (*route)["responseType"] = responseTypeForMediaType(mediaType);
+        } else if (response.contains("schema")) {
+            body = sampleFromSchema(response.value("schema"), 0);
+        }
+        (*route)["responseBody"] = bodyText(body);
+        return;
+    }
+
+    const QJsonObject content = response.value("content").toObject();
+    const QString mediaType = preferredMediaType(content);
+    if (mediaType.isEmpty()) {
+        return;
+    }
+
+    (*route)["contentType"] = mediaType;
+    (*route)["responseType"] = responseTypeForMediaType(mediaType);
+    (*route)["responseBody"] = bodyText(mediaTypeExample(content.value(mediaType).toObject()));
+}
+
+QJsonValue OpenApiImporter::mediaTypeExample(const QJsonObject &mediaType)
+{
+    if (mediaType.contains("example")) {
+        return mediaType.value("example");
+    }
+
+    const QJsonObject examples = mediaType.value("examples").toObject();
+    for (auto it = examples.constBegin(); it != examples.constEnd(); ++it) {
+        const QJsonObject example = resolve(it.value());
+        if (example.contains("value")) {
+            return example.value("value");
+        }
+    }
+
+    return sampleFromSchema(mediaType.value("schema"), 0);
+}
+
+// 根据 schema 合成示例：example/default/enum 优先，其次按类型递归生成
+QJsonValue OpenApiImporter::sampleFromSchema(const QJsonValue &schemaValue, int depth)
+{
+    if (!schemaValue.isObject() || depth > kMaxSchemaDepth) {
+        return QJsonValue();
+    }
+
+    QString refName;
+    const QJsonObject schema = resolve(schemaValue, &refName);
+    if (!refName.isEmpty()) {
+        // 循环引用时截断，避免无限展开
+        if (m_refStack.contains(refName)) {
+            return QJsonValue();
+        }
+        m_refStack.append(refName);
+        const QJsonValue sample = sampleFromSchema(schema, depth + 1);
+        m_refStack.removeLast();
+        return sample;
+    }
+
+    if (schema.contains("example")) {
+        return schema.value("example");
+    }
+    const QJsonArray examples = schema.value("examples").toArray();
+    if (!examples.isEmpty()) {
+        return examples.first();
+    }
+    if (schema.contains("default")) {
+        return schema.value("default");
+    }
+    if (schema.contains("const")) {
+        return schema.value("const");
+    }
+    const QJsonArray enumValues = schema.value("enum").toArray();
+    if (!enumValues.isEmpty()) {
+        return enumValues.first();
+    }
+
+    const QJsonArray allOf = schema.value("allOf").toArray();
+    if (!allOf.isEmpty()) {
+        QJsonObject merged;
+        for (const QJsonValue &part : allOf) {
+            const QJsonValue sample = sampleFromSchema(part, depth + 1);
+            if (!sample.isObject()) {
+                if (allOf.size() == 1) {
+                    return sample;
+                }
+                continue;
+            }
+            const QJsonObject object = sample.toObject();
+            for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+                merged.insert(it.key(), it.value());
+            }
+        }
+        return merged;
+    }
+    for (const char *key : {"oneOf", "anyOf"}) {
+        const QJsonArray variants = schema.value(QLatin1String(key)).toArray();
+        if (!variants.isEmpty()) {
+            return sampleFromSchema(variants.first(), depth + 1);
+        }
+    }
+
+    // OpenAPI 3.1 允许 type 为数组，取第一个非 null 类型
+    QString type;
+    const QJsonValue typeValue = schema.value("type");
+    if (typeValue.isArray()) {
+        for (const QJsonValue &candidate : typeValue.toArray()) {
+            if (candidate.toString() != "null") {
+                type = candidate.toString();
+                break;
+            }
+        }
+    } else {
+        type = typeValue.toString();
+    }
+    if (type.isEmpty()) {
+        if (schema.contains("properties") || schema.contains("additionalProperties")) {
+            type = "object";
+        } else if (schema.contains("items")) {
+            type = "array";
+        }
+    }
+
+    if (type == "object") {
+        QJsonObject object;
+        const QJsonObject properties = schema.value("properties").toObject();
+        for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+            object.insert(it.key(), sampleFromSchema(it.value(), depth + 1));
+        }
+        const QJsonValue additional = schema.value("additionalProperties");
+        if (properties.isEmpty() && additional.isObject()) {
+            object.insert("key", sampleFromSchema(additional, depth + 1));
+        }
+        return object;
+    }
+    if (type == "array") {
+        const QJsonValue item = sampleFromSchema(schema.value("items"), depth + 1);
+        return item.isNull() ? QJsonArray() : QJsonArray{item};
+    }
+    if (type == "integer") {
+        return schema.contains("minimum") ? schema.value("minimum").toInteger() : 0;
+    }
+    if (type == "number") {
+        return schema.contains("minimum") ? schema.value("minimum").toDouble() : 0.0;
+    }
+    if (type == "boolean") {
+        return true;
+    }
+    if (type == "string") {
+        return sampleForString(schema);
+    }
+    return QJsonValue();
+}
+
+QJsonValue OpenApiImporter::sampleForString(const QJsonObject &schema) const
+{
+    const QString format = schema.value("format").toString();
+    if (format == "date-time") {
+        return "2024-01-01T00:00:00Z";
+    }
+    if (format == "date") {
+        return "2024-01-01";
+    }
+    if (format == "time") {
+        return "00:00:00";
+    }
+    if (format == "uuid") {
+        return "3fa85f64-5717-4562-b3fc-2c963f66afa6";
+    }
+    if (format == "email") {
+        return "user@example.com";
+    }
+    if (format == "uri" || format == "url") {
+        return "https://example.com";
+    }
+    if (format == "hostname") {
+        return "example.com";
+    }
+    if (format == "ipv4") {
+        return "192.168.0.1";
+    }
+    if (format == "ipv6") {
+        return "::1";
+    }
+    if (format == "byte") {
+        return "aGVsbG8=";
+    }
+    if (format == "password") {
+        return "********";
+    }
+    return "string";
+}
+
+// 解析本地 $ref（#/components/...、#/definitions/...），返回目标对象
+QJsonObject OpenApiImporter::resolve(const QJsonValue &value, QString *refName) const
+{
+    QJsonObject object = value.toObject();
+    for (int hop = 0; hop < kMaxRefHops && object.contains("$ref"); ++hop) {
+        const QString ref = object.value("$ref").toString();
+        if (!ref.startsWith("#/")) {
+            return QJsonObject();
+        }
+        if (refName) {
+            *refName = ref;
+        }
+
+        QJsonValue current = m_root;
+        const QStringList tokens = ref.mid(2).split('/');
+        for (QString token : tokens) {
+            token.replace("~1", "/");
+            token.replace("~0", "~");
+            token = QUrl::fromPercentEncoding(token.toUtf8());
+            if (current.isObject()) {
+                current = current.toObject().value(token);
+            } else if (current.isArray()) {
+                current = current.toArray().at(token.toInt());
+            } else {
+                return QJsonObject();
+            }
+        }
+        object = current.toObject();
+    }
+    return object;
+}
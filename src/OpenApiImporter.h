@@ -0,0 +1,50 @@
+#ifndef OPENAPIIMPORTER_H
+#define OPENAPIIMPORTER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+// OpenAPI 3 / Swagger 2 规范导入：把每个 operation 转换为 Fake API 路由。
+// 不依赖 QObject，可直接在工作线程中运行。
+class OpenApiImporter
+{
+public:
+    struct Result {
+        bool success = false;
+        QString errorMessage;
+        QString title;
+        QString specVersion;
+        QVariantList routes;
+    };
+
+    static Result importFile(const QString &filePath);
+    static Result importData(const QByteArray &data);
+    // 已解析好的文档，不是 OpenAPI/Swagger 规范时返回错误
+    static Result importDocument(const QJsonObject &root);
+
+private:
+    explicit OpenApiImporter(const QJsonObject &root);
+
+    static bool parseDocument(const QByteArray &data, QJsonObject *root, QString *errorMessage);
+    static bool isOpenApiRoot(const QJsonObject &root);
+
+    Result run();
+    QString basePath() const;
+    QVariantMap buildRoute(const QString &path, const QString &method, const QJsonObject &operation);
+    void fillResponse(const QJsonObject &operation, QVariantMap *route);
+    QJsonValue mediaTypeExample(const QJsonObject &mediaType);
+    QJsonValue sampleFromSchema(const QJsonValue &schema, int depth);
+    QJsonValue sampleForString(const QJsonObject &schema) const;
+    QJsonObject resolve(const QJsonValue &value, QString *refName = nullptr) const;
+
+    QJsonObject m_root;
+    bool m_swagger2;
+    QStringList m_refStack;
+};
+
+#endif // OPENAPIIMPORTER_H
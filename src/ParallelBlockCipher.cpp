@@ -0,0 +1,155 @@
+#include "ParallelBlockCipher.h"
+
+#include <QList>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+constexpr qsizetype kBlockSize = 16;
+// 每个线程期望分到的段数，段多一些可以平衡各核速度差异
+constexpr qsizetype kChunksPerThread = 4;
+// CTR 每次在栈上生成的密钥流分组数
+constexpr qsizetype kKeystreamBlocks = 64;
+
+struct Chunk {
+    qsizetype firstBlock;
+    qsizetype blockCount;
+};
+
+// 128 位大端计数器，按高/低 64 位保存
+struct CounterBlock {
+    quint64 high;
+    quint64 low;
+};
+
+constexpr quint64 kLow32Mask = 0xffffffffu;
+
+// 计数器 = iv + index（128 位大端加法，或只在低 32 位内回绕）
+CounterBlock counterAt(const quint8 *iv, quint64 index, ParallelBlockCipher::Counter mode)
+{
+    CounterBlock counter{qFromBigEndian<quint64>(iv), qFromBigEndian<quint64>(iv + 8)};
+    if (mode == ParallelBlockCipher::Counter::Low32) {
+        counter.low = (counter.low & ~kLow32Mask) | quint32(counter.low + index);
+    } else {
+        counter.low += index;
+        if (counter.low < index) {
+            ++counter.high;
+        }
+    }
+    return counter;
+}
+
+void incrementCounter(CounterBlock &counter, ParallelBlockCipher::Counter mode)
+{
+    if (mode == ParallelBlockCipher::Counter::Low32) {
+        counter.low = (counter.low & ~kLow32Mask) | quint32(counter.low + 1);
+    } else if (++counter.low == 0) {
+        ++counter.high;
+    }
+}
+
+}
+
+void ParallelBlockCipher::forEachChunk(qsizetype blocks, const ChunkFunction &function)
+{
+    if (blocks <= 0) {
+        return;
+    }
+
+    const qsizetype minChunkBlocks = kMinChunkBytes / kBlockSize;
+    const qsizetype threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    const qsizetype chunkBlocks = qMax(minChunkBlocks, (blocks + threads * kChunksPerThread - 1) / (threads * kChunksPerThread));
+
+    if (threads == 1 || blocks <= chunkBlocks) {
+        function(0, blocks);
+        return;
+    }
+
+    QList<Chunk> chunks;
+    chunks.reserve((blocks + chunkBlocks - 1) / chunkBlocks);
+    for (qsizetype first = 0; first < blocks; first += chunkBlocks) {
+        chunks.append({first, qMin(chunkBlocks, blocks - first)});
+    }
+
+    // blockingMap 会让调用线程也参与处理，在线程池内部调用也不会死锁
+    QtConcurrent::blockingMap(chunks, [&function](const Chunk &chunk) {
+        function(chunk.firstBlock, chunk.blockCount);
+    });
+}
+
+void ParallelBlockCipher::ecb(const BlockFunction &cipher, const quint8 *in, quint8 *out, qsizetype length)
+{
+    forEachChunk(length / kBlockSize, [&](qsizetype firstBlock, qsizetype blockCount) {
+        const qsizetype offset = firstBlock * kBlockSize;
+        cipher(in + offset, out + offset, size_t(blockCount));
+    });
+}
+
+void ParallelBlockCipher::cbcDecrypt(const BlockFunction &decrypt, const quint8 *iv,
+                                     const quint8 *in, quint8 *out, qsizetype length)
+{
+    forEachChunk(length / kBlockSize, [&](qsizetype firstBlock, qsizetype blockCount) {
+        const qsizetype offset = firstBlock * kBlockSize;
+        const qsizetype bytes = blockCount * kBlockSize;
+        decrypt(in + offset, out + offset, size_t(blockCount));
+
+        // 每段的第一个分组与上一段最后一个密文块（或 IV）异或，密文只读，各段互不影响
+        const quint8 *prev = offset == 0 ? iv : in + offset - kBlockSize;
+        for (qsizetype i = 0; i < bytes; i += kBlockSize) {
+            for (int j = 0; j < kBlockSize; ++j) {
+                out[offset + i + j] ^= prev[j];
+            }
+            prev = in + offset + i;
+        }
+    });
+}
+
+void ParallelBlockCipher::ctr(const BlockFunction &encrypt, const quint8 *iv,
+                              const quint8 *in, quint8 *out, qsizetype length,
+                              Counter counterMode)
+{
+    const qsizetype blocks = (length + kBlockSize - 1) / kBlockSize;
+
+    forEachChunk(blocks, [&](qsizetype firstBlock, qsizetype blockCount) {
+        alignas(16) quint8 keystream[kKeystreamBlocks * kBlockSize];
+        CounterBlock counter = counterAt(iv, quint64(firstBlock), counterMode);
+
+        for (qsizetype done = 0; done < blockCount;) {
+            const qsizetype batch = qMin(kKeystreamBlocks, blockCount - done);
+            for (qsizetype k = 0; k < batch; ++k) {
+                qToBigEndian(counter.high, keystream + k * kBlockSize);
+                qToBigEndian(counter.low, keystream + k * kBlockSize + 8);
+                incrementCounter(counter, counterMode);
+            }
+            encrypt(keystream, keystream, size_t(batch));
+
+            const qsizetype offset = (firstBlock + done) * kBlockSize;
+            const qsizetype bytes = qMin(batch * kBlockSize, length - offset);
+            qsizetype i = 0;
+            // 按 8 字节异或，尾部逐字节
+            for (; i + 8 <= bytes; i += 8) {
+                quint64 word;
+                quint64 key;
+                std::memcpy(&word, in + offset + i, 8);
+                std::memcpy(&key, keystream + i, 8);
+                word ^= key;
+                std::memcpy(out + offset + i, &word, 8);
+            }
+            for (; i < bytes; ++i) {
+                out[offset + i] = in[offset + i] ^ keystream[i];
+            }
+            done += batch;
+        }
+    });
+}
+
+void ParallelBlockCipher::advanceCounter(quint8 *counter, quint64 blocks, Counter mode)
+{
+    const CounterBlock next = counterAt(counter, blocks, mode);
+    qToBigEndian(next.high, counter);
+    qToBigEndian(next.low, counter + 8);
+}
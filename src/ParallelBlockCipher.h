@@ -0,0 +1,40 @@
+#ifndef PARALLELBLOCKCIPHER_H
+#define PARALLELBLOCKCIPHER_H
+
+#include <QtGlobal>
+
+#include <cstddef>
+#include <functional>
+
+// 分组相互独立的模式（ECB、CBC 解密、CTR）的多线程实现。
+// 大输入按块切分后交给全局线程池，小输入直接在当前线程处理；结果与串行处理逐字节一致。
+class ParallelBlockCipher
+{
+public:
+    // 对 blocks 个连续 16 字节分组做一次分组加密或解密，in 与 out 可以相同，须可被多个线程同时调用
+    using BlockFunction = std::function<void(const quint8 *in, quint8 *out, size_t blocks)>;
+    using ChunkFunction = std::function<void(qsizetype firstBlock, qsizetype blockCount)>;
+
+    // length 须为 16 的倍数，in 与 out 可以相同
+    static void ecb(const BlockFunction &cipher, const quint8 *in, quint8 *out, qsizetype length);
+    // length 须为 16 的倍数；需要读取前一密文块，out 不能与 in 相同
+    static void cbcDecrypt(const BlockFunction &decrypt, const quint8 *iv,
+                           const quint8 *in, quint8 *out, qsizetype length);
+
+    // 计数器递增方式：整个 128 位（通用 CTR），或只递增低 32 位（GCM 的 inc32）
+    enum class Counter { Full128, Low32 };
+
+    // iv 为大端计数器初值，每个分组加一；加密与解密相同，length 可以不是 16 的倍数
+    static void ctr(const BlockFunction &encrypt, const quint8 *iv,
+                    const quint8 *in, quint8 *out, qsizetype length,
+                    Counter counter = Counter::Full128);
+    // 把计数器前进 blocks 个分组，用于分段处理同一条 CTR 流
+    static void advanceCounter(quint8 *counter, quint64 blocks, Counter mode = Counter::Full128);
+
+    // 把 [0, blocks) 切成若干段并行执行，段的大小不小于 kMinChunkBytes
+    static void forEachChunk(qsizetype blocks, const ChunkFunction &function);
+
+    static constexpr qsizetype kMinChunkBytes = 256 * 1024;
+};
+
+#endif // PARALLELBLOCKCIPHER_H
@@ -0,0 +1,172 @@
+#include "SM3.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+inline quint32 rotateLeft(quint32 x, int n)
+{
+    n &= 31;
+    return n == 0 ? x : (x << n) | (x >> (32 - n));
+}
+
+inline quint32 p0(quint32 x)
+{
+    return x ^ rotateLeft(x, 9) ^ rotateLeft(x, 17);
+}
+
+inline quint32 p1(quint32 x)
+{
+    return x ^ rotateLeft(x, 15) ^ rotateLeft(x, 23);
+}
+
+// 第 j 轮的常量 Tj <<< j
+struct RoundConstants {
+    quint32 value[64];
+
+    RoundConstants()
+    {
+        for (int j = 0; j < 64; ++j) {
+            value[j] = rotateLeft(j < 16 ? 0x79cc4519 : 0x7a879d8a, j);
+        }
+    }
+};
+
+const RoundConstants kRoundConstants;
+
+template <bool Early>
+inline void round(quint32 &a, quint32 &b, quint32 &c, quint32 &d, quint32 &e, quint32 &f, quint32 &g, quint32 &h,
+                  quint32 t, quint32 w, quint32 w1)
+{
+    const quint32 a12 = rotateLeft(a, 12);
+    const quint32 ss1 = rotateLeft(a12 + e + t, 7);
+    const quint32 ss2 = ss1 ^ a12;
+    const quint32 ff = Early ? (a ^ b ^ c) : ((a & b) | (a & c) | (b & c));
+    const quint32 gg = Early ? (e ^ f ^ g) : ((e & f) | (~e & g));
+    const quint32 tt1 = ff + d + ss2 + w1;
+    const quint32 tt2 = gg + h + ss1 + w;
+    d = c;
+    c = rotateLeft(b, 9);
+    b = a;
+    a = tt1;
+    h = g;
+    g = rotateLeft(f, 19);
+    f = e;
+    e = p0(tt2);
+}
+
+}
+
+SM3::SM3()
+{
+    reset();
+}
+
+void SM3::initialState(quint32 *state)
+{
+    static const quint32 iv[8] = {
+        0x7380166f, 0x4914b2b9, 0x172442d7, 0xda8a0600,
+        0xa96f30bc, 0x163138aa, 0xe38dee4d, 0xb0fb0e4e
+    };
+    std::memcpy(state, iv, sizeof(iv));
+}
+
+void SM3::reset()
+{
+    initialState(m_state);
+    m_bufferLength = 0;
+    m_length = 0;
+}
+
+void SM3::compress(quint32 *state, const quint8 *data, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; ++n, data += kBlockLength) {
+        // 消息扩展
+        quint32 w[68];
+        for (int j = 0; j < 16; ++j) {
+            w[j] = qFromBigEndian<quint32>(data + j * 4);
+        }
+        for (int j = 16; j < 68; ++j) {
+            w[j] = p1(w[j - 16] ^ w[j - 9] ^ rotateLeft(w[j - 3], 15)) ^ rotateLeft(w[j - 13], 7) ^ w[j - 6];
+        }
+
+        quint32 a = state[0], b = state[1], c = state[2], d = state[3];
+        quint32 e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int j = 0; j < 16; ++j) {
+            round<true>(a, b, c, d, e, f, g, h, kRoundConstants.value[j], w[j], w[j] ^ w[j + 4]);
+        }
+        for (int j = 16; j < 64; ++j) {
+            round<false>(a, b, c, d, e, f, g, h, kRoundConstants.value[j], w[j], w[j] ^ w[j + 4]);
+        }
+
+        state[0] ^= a; state[1] ^= b; state[2] ^= c; state[3] ^= d;
+        state[4] ^= e; state[5] ^= f; state[6] ^= g; state[7] ^= h;
+    }
+}
+
+void SM3::addData(const char *data, qsizetype length)
+{
+    const quint8 *in = reinterpret_cast<const quint8 *>(data);
+    m_length += quint64(length);
+
+    // 先补齐上次留下的不完整分组
+    if (m_bufferLength > 0) {
+        const int take = int(qMin<qsizetype>(kBlockLength - m_bufferLength, length));
+        std::memcpy(m_buffer + m_bufferLength, in, size_t(take));
+        m_bufferLength += take;
+        in += take;
+        length -= take;
+        if (m_bufferLength < kBlockLength) {
+            return;
+        }
+        compress(m_state, m_buffer, 1);
+        m_bufferLength = 0;
+    }
+
+    const size_t blocks = size_t(length / kBlockLength);
+    compress(m_state, in, blocks);
+    in += blocks * kBlockLength;
+    length -= qsizetype(blocks * kBlockLength);
+
+    std::memcpy(m_buffer, in, size_t(length));
+    m_bufferLength = int(length);
+}
+
+void SM3::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+void SM3::result(quint8 *digest) const
+{
+    quint32 state[8];
+    std::memcpy(state, m_state, sizeof(state));
+
+    // 填充：0x80，补 0 到 56 字节（模 64），再追加 64 位大端消息比特长度
+    quint8 tail[kBlockLength * 2] = {};
+    std::memcpy(tail, m_buffer, size_t(m_bufferLength));
+    tail[m_bufferLength] = 0x80;
+    const int tailLength = m_bufferLength < 56 ? kBlockLength : kBlockLength * 2;
+    qToBigEndian<quint64>(m_length * 8, tail + tailLength - 8);
+    compress(state, tail, size_t(tailLength / kBlockLength));
+
+    for (int i = 0; i < 8; ++i) {
+        qToBigEndian(state[i], digest + i * 4);
+    }
+}
+
+QByteArray SM3::result() const
+{
+    QByteArray digest(kDigestLength, Qt::Uninitialized);
+    result(reinterpret_cast<quint8 *>(digest.data()));
+    return digest;
+}
+
+QByteArray SM3::hash(const QByteArray &data)
+{
+    SM3 sm3;
+    sm3.addData(data);
+    return sm3.result();
+}
@@ -0,0 +1,41 @@
+#ifndef SM3_H
+#define SM3_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+#include <cstddef>
+
+// SM3 密码杂凑算法（GB/T 32905-2016），接口与 QCryptographicHash 相同：
+// 可多次 addData 分段输入，完整的 64 字节分组直接在输入缓冲区上压缩，
+// 只缓存不足一个分组的尾部，内存占用与消息长度无关。
+class SM3
+{
+public:
+    static constexpr int kDigestLength = 32;
+    static constexpr int kBlockLength = 64;
+
+    SM3();
+
+    void reset();
+    void addData(const char *data, qsizetype length);
+    void addData(const QByteArray &data);
+
+    // 输出 32 字节摘要；不改变内部状态，可以继续 addData
+    void result(quint8 *digest) const;
+    QByteArray result() const;
+
+    static QByteArray hash(const QByteArray &data);
+
+    // 对 state（8 个字）依次压缩 blocks 个 64 字节分组
+    static void compress(quint32 *state, const quint8 *data, size_t blocks);
+    static void initialState(quint32 *state);
+
+private:
+    quint32 m_state[8];
+    quint8 m_buffer[kBlockLength];
+    int m_bufferLength;
+    quint64 m_length;
+};
+
+#endif // SM3_H
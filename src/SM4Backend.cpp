@@ -0,0 +1,158 @@
+#include "SM4Backend.h"
+#include "CpuFeatures.h"
+
+#include <QtEndian>
+
+namespace {
+
+// SM4 S盒
+const quint8 SM4_SBOX[256] = {
+    0xd6, 0x90, 0xe9, 0xfe, 0xcc, 0xe1, 0x3d, 0xb7, 0x16, 0xb6, 0x14, 0xc2, 0x28, 0xfb, 0x2c, 0x05,
+    0x2b, 0x67, 0x9a, 0x76, 0x2a, 0xbe, 0x04, 0xc3, 0xaa, 0x44, 0x13, 0x26, 0x49, 0x86, 0x06, 0x99,
+    0x9c, 0x42, 0x50, 0xf4, 0x91, 0xef, 0x98, 0x7a, 0x33, 0x54, 0x0b, 0x43, 0xed, 0xcf, 0xac, 0x62,
+    0xe4, 0xb3, 0x1c, 0xa9, 0xc9, 0x08, 0xe8, 0x95, 0x80, 0xdf, 0x94, 0xfa, 0x75, 0x8f, 0x3f, 0xa6,
+    0x47, 0x07, 0xa7, 0xfc, 0xf3, 0x73, 0x17, 0xba, 0x83, 0x59, 0x3c, 0x19, 0xe6, 0x85, 0x4f, 0xa8,
+    0x68, 0x6b, 0x81, 0xb2, 0x71, 0x64, 0xda, 0x8b, 0xf8, 0xeb, 0x0f, 0x4b, 0x70, 0x56, 0x9d, 0x35,
+    0x1e, 0x24, 0x0e, 0x5e, 0x63, 0x58, 0xd1, 0xa2, 0x25, 0x22, 0x7c, 0x3b, 0x01, 0x21, 0x78, 0x87,
+    0xd4, 0x00, 0x46, 0x57, 0x9f, 0xd3, 0x27, 0x52, 0x4c, 0x36, 0x02, 0xe7, 0xa0, 0xc4, 0xc8, 0x9e,
+    0xea, 0xbf, 0x8a, 0xd2, 0x40, 0xc7, 0x38, 0xb5, 0xa3, 0xf7, 0xf2, 0xce, 0xf9, 0x61, 0x15, 0xa1,
+    0xe0, 0xae, 0x5d, 0xa4, 0x9b, 0x34, 0x1a, 0x55, 0xad, 0x93, 0x32, 0x30, 0xf5, 0x8c, 0xb1, 0xe3,
+    0x1d, 0xf6, 0xe2, 0x2e, 0x82, 0x66, 0xca, 0x60, 0xc0, 0x29, 0x23, 0xab, 0x0d, 0x53, 0x4e, 0x6f,
+    0xd5, 0xdb, 0x37, 0x45, 0xde, 0xfd, 0x8e, 0x2f, 0x03, 0xff, 0x6a, 0x72, 0x6d, 0x6c, 0x5b, 0x51,
+    0x8d, 0x1b, 0xaf, 0x92, 0xbb, 0xdd, 0xbc, 0x7f, 0x11, 0xd9, 0x5c, 0x41, 0x1f, 0x10, 0x5a, 0xd8,
+    0x0a, 0xc1, 0x31, 0x88, 0xa5, 0xcd, 0x7b, 0xbd, 0x2d, 0x74, 0xd0, 0x12, 0xb8, 0xe5, 0xb4, 0xb0,
+    0x89, 0x69, 0x97, 0x4a, 0x0c, 0x96, 0x77, 0x7e, 0x65, 0xb9, 0xf1, 0x09, 0xc5, 0x6e, 0xc6, 0x84,
+    0x18, 0xf0, 0x7d, 0xec, 0x3a, 0xdc, 0x4d, 0x20, 0x79, 0xee, 0x5f, 0x3e, 0xd7, 0xcb, 0x39, 0x48
+};
+
+// SM4 系统参数FK
+const quint32 SM4_FK[4] = {
+    0xa3b1bac6, 0x56aa3350, 0x677d9197, 0xb27022dc
+};
+
+// SM4 固定参数CK
+const quint32 SM4_CK[32] = {
+    0x00070e15, 0x1c232a31, 0x383f464d, 0x545b6269,
+    0x70777e85, 0x8c939aa1, 0xa8afb6bd, 0xc4cbd2d9,
+    0xe0e7eef5, 0xfc030a11, 0x181f262d, 0x343b4249,
+    0x50575e65, 0x6c737a81, 0x888f969d, 0xa4abb2b9,
+    0xc0c7ced5, 0xdce3eaf1, 0xf8ff060d, 0x141b2229,
+    0x30373e45, 0x4c535a61, 0x686f767d, 0x848b9299,
+    0xa0a7aeb5, 0xbcc3cad1, 0xd8dfe6ed, 0xf4fb0209,
+    0x10171e25, 0x2c333a41, 0x484f565d, 0x646b7279
+};
+
+inline quint32 rotateLeft(quint32 x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+// 非线性变换 τ：逐字节查 S 盒
+inline quint32 tau(quint32 a)
+{
+    return (quint32(SM4_SBOX[a >> 24]) << 24) | (quint32(SM4_SBOX[(a >> 16) & 0xff]) << 16)
+         | (quint32(SM4_SBOX[(a >> 8) & 0xff]) << 8) | quint32(SM4_SBOX[a & 0xff]);
+}
+
+// 轮函数中的线性变换 L
+inline quint32 linear(quint32 b)
+{
+    return b ^ rotateLeft(b, 2) ^ rotateLeft(b, 10) ^ rotateLeft(b, 18) ^ rotateLeft(b, 24);
+}
+
+// 把 S 盒与 L 合并成 4 张 256 项的 32 位表：T(a) = Te0[a0] ^ Te1[a1] ^ Te2[a2] ^ Te3[a3]。
+// L 是线性变换且与循环移位可交换，因此各表只差一个循环移位
+struct Tables {
+    quint32 te[4][256];
+
+    Tables()
+    {
+        for (int x = 0; x < 256; ++x) {
+            const quint32 t = linear(quint32(SM4_SBOX[x]) << 24);
+            te[0][x] = t;
+            te[1][x] = rotateLeft(t, 24);
+            te[2][x] = rotateLeft(t, 16);
+            te[3][x] = rotateLeft(t, 8);
+        }
+    }
+};
+
+const Tables &tables()
+{
+    static const Tables instance;
+    return instance;
+}
+
+inline quint32 roundT(const Tables &t, quint32 a)
+{
+    return t.te[0][a >> 24] ^ t.te[1][(a >> 16) & 0xff] ^ t.te[2][(a >> 8) & 0xff] ^ t.te[3][a & 0xff];
+}
+
+// 32 轮迭代加反序变换；先读完输入再写输出，允许原地处理
+void cryptPortable(const quint32 *rk, const quint8 *in, quint8 *out, size_t blocks)
+{
+    const Tables &t = tables();
+    for (size_t n = 0; n < blocks; ++n, in += 16, out += 16) {
+        quint32 x0 = qFromBigEndian<quint32>(in);
+        quint32 x1 = qFromBigEndian<quint32>(in + 4);
+        quint32 x2 = qFromBigEndian<quint32>(in + 8);
+        quint32 x3 = qFromBigEndian<quint32>(in + 12);
+
+        for (int i = 0; i < SM4Backend::kRounds; i += 4) {
+            x0 ^= roundT(t, x1 ^ x2 ^ x3 ^ rk[i]);
+            x1 ^= roundT(t, x2 ^ x3 ^ x0 ^ rk[i + 1]);
+            x2 ^= roundT(t, x3 ^ x0 ^ x1 ^ rk[i + 2]);
+            x3 ^= roundT(t, x0 ^ x1 ^ x2 ^ rk[i + 3]);
+        }
+
+        qToBigEndian(x3, out);
+        qToBigEndian(x2, out + 4);
+        qToBigEndian(x1, out + 8);
+        qToBigEndian(x0, out + 12);
+    }
+}
+
+}
+
+void SM4Backend::expandKey(const quint8 *key, quint32 *roundKeys)
+{
+    // 密钥扩展中的 T' = L'(τ(.))
+    quint32 k[36];
+    for (int i = 0; i < 4; ++i) {
+        k[i] = qFromBigEndian<quint32>(key + i * 4) ^ SM4_FK[i];
+    }
+    for (int i = 0; i < kRounds; ++i) {
+        const quint32 b = tau(k[i + 1] ^ k[i + 2] ^ k[i + 3] ^ SM4_CK[i]);
+        k[i + 4] = k[i] ^ b ^ rotateLeft(b, 13) ^ rotateLeft(b, 23);
+        roundKeys[i] = k[i + 4];
+    }
+}
+
+const SM4Backend::Implementation &SM4Backend::portable()
+{
+    static const Implementation impl = {"T-table", cryptPortable};
+    return impl;
+}
+
+QList<const SM4Backend::Implementation *> SM4Backend::available()
+{
+    QList<const Implementation *> result{&portable()};
+#if defined(Q_PROCESSOR_X86)
+    // 借用 AESENCLAST 计算 S 盒，需要 AES-NI；字节置换用 PSHUFB
+    static const Implementation aesNi = {"AES-NI", SM4BackendHw::cryptAesNi};
+    static const Implementation avx2 = {"AVX2", SM4BackendHw::cryptAvx2};
+    if (CpuFeatures::hasAesNi() && CpuFeatures::hasSsse3()) {
+        result << &aesNi;
+        if (CpuFeatures::hasAvx2()) {
+            result << &avx2;
+        }
+    }
+#endif
+    return result;
+}
+
+const SM4Backend::Implementation &SM4Backend::active()
+{
+    static const Implementation *impl = available().constLast();
+    return *impl;
+}
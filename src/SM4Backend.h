@@ -0,0 +1,52 @@
+#ifndef SM4BACKEND_H
+#define SM4BACKEND_H
+
+#include <QList>
+#include <QtGlobal>
+
+#include <cstddef>
+
+// SM4 分组运算后端：可移植的 32 位查表实现，以及运行时按 CPU 特性选择的
+// x86 多分组实现（AES-NI + SSSE3 每次 8 个分组，AVX2 每次 16 个分组）。
+// SM4 的加解密结构相同，解密只需传入逆序的轮密钥。
+class SM4Backend
+{
+public:
+    static constexpr int kRounds = 32;
+
+    // 处理 blocks 个连续 16 字节分组，in 与 out 可以指向同一缓冲区
+    using BlockFunction = void (*)(const quint32 *roundKeys, const quint8 *in, quint8 *out, size_t blocks);
+
+    struct Implementation {
+        const char *name;
+        BlockFunction crypt;
+    };
+
+    // 由 16 字节密钥生成 32 个加密轮密钥
+    static void expandKey(const quint8 *key, quint32 *roundKeys);
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active();
+    static const Implementation &portable();
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available();
+
+    static void cryptBlocks(const quint32 *roundKeys, const quint8 *in, quint8 *out, size_t blocks)
+    {
+        active().crypt(roundKeys, in, out, blocks);
+    }
+};
+
+// 多分组实现位于 SM4Backend_x86.cpp / SM4Backend_avx2.cpp，这两个文件使用单独的编译选项
+namespace SM4BackendHw {
+#if defined(Q_PROCESSOR_X86)
+void cryptAesNi(const quint32 *roundKeys, const quint8 *in, quint8 *out, size_t blocks);
+void cryptAvx2(const quint32 *roundKeys, const quint8 *in, quint8 *out, size_t blocks);
+
+// 两个实现共用的 PSHUFB 查表：SM4 S 盒 = post(AES S 盒(pre(x)))，pre / post 是 GF(2) 上的仿射变换，
+// 按低、高半字节各查一次：preLow, preHigh, postLow, postHigh
+extern const quint8 kAffineTables[4][16];
+#endif
+}
+
+#endif // SM4BACKEND_H
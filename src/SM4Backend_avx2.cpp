@@ -0,0 +1,134 @@
+#include "SM4Backend.h"
+
+// AVX2 实现。GCC/Clang 下本文件以 -maes -mavx2 单独编译，
+// 只有 CpuFeatures 检测到 AES-NI、SSSE3 与 AVX2 时才会被调用。
+// 与 SM4Backend_x86.cpp 的算法相同，寄存器加宽到 256 位，每次交错处理 2 组共 16 个分组；
+// 没有 VAES 时 AESENCLAST 只能处理 128 位，S 盒步骤拆成高低两半分别执行。
+#if defined(Q_PROCESSOR_X86)
+
+#include <immintrin.h>
+
+namespace {
+
+constexpr int kGroups = 2;
+// 每组 8 个分组：每个 256 位寄存器的两个 128 位通道各存放 4 个分组的同一个字
+constexpr size_t kGroupBlocks = 8;
+
+struct Constants {
+    __m256i preLow, preHigh, postLow, postHigh;
+    __m256i lowNibble, invShiftRows, rotate8, rotate16, rotate24, byteSwap32;
+
+    Constants()
+        : preLow(table(0)), preHigh(table(1)), postLow(table(2)), postHigh(table(3))
+        , lowNibble(_mm256_set1_epi8(0x0f))
+        , invShiftRows(lanes(_mm_setr_epi8(0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3)))
+        , rotate8(lanes(_mm_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14)))
+        , rotate16(lanes(_mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13)))
+        , rotate24(lanes(_mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12)))
+        , byteSwap32(lanes(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)))
+    {
+    }
+
+    // VPSHUFB 在每个 128 位通道内独立查表，两个通道放同一份表
+    static __m256i lanes(__m128i v)
+    {
+        return _mm256_broadcastsi128_si256(v);
+    }
+
+    static __m256i table(int index)
+    {
+        return lanes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(SM4BackendHw::kAffineTables[index])));
+    }
+};
+
+inline __m256i affine(const Constants &c, __m256i x, __m256i low, __m256i high)
+{
+    const __m256i lo = _mm256_and_si256(x, c.lowNibble);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi32(x, 4), c.lowNibble);
+    return _mm256_xor_si256(_mm256_shuffle_epi8(low, lo), _mm256_shuffle_epi8(high, hi));
+}
+
+inline __m256i roundT(const Constants &c, __m256i x)
+{
+    x = _mm256_shuffle_epi8(affine(c, x, c.preLow, c.preHigh), c.invShiftRows);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_aesenclast_si128(_mm256_castsi256_si128(x), zero);
+    const __m128i hi = _mm_aesenclast_si128(_mm256_extracti128_si256(x, 1), zero);
+    x = affine(c, _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), c.postLow, c.postHigh);
+
+    const __m256i t = _mm256_xor_si256(_mm256_xor_si256(x, _mm256_shuffle_epi8(x, c.rotate8)),
+                                       _mm256_shuffle_epi8(x, c.rotate16));
+    const __m256i t2 = _mm256_or_si256(_mm256_slli_epi32(t, 2), _mm256_srli_epi32(t, 30));
+    return _mm256_xor_si256(_mm256_xor_si256(x, _mm256_shuffle_epi8(x, c.rotate24)), t2);
+}
+
+// 各 128 位通道内的 4x4 转置
+inline void transpose(__m256i &a, __m256i &b, __m256i &c, __m256i &d)
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(a, b);
+    const __m256i t1 = _mm256_unpacklo_epi32(c, d);
+    const __m256i t2 = _mm256_unpackhi_epi32(a, b);
+    const __m256i t3 = _mm256_unpackhi_epi32(c, d);
+    a = _mm256_unpacklo_epi64(t0, t1);
+    b = _mm256_unpackhi_epi64(t0, t1);
+    c = _mm256_unpacklo_epi64(t2, t3);
+    d = _mm256_unpackhi_epi64(t2, t3);
+}
+
+// 每次载入相邻的两个分组：低通道为偶数号分组，高通道为奇数号分组，输出时按原位置写回
+template <int Groups>
+void cryptGroups(const Constants &c, const quint32 *rk, const quint8 *in, quint8 *out)
+{
+    __m256i x[Groups][4];
+    for (int g = 0; g < Groups; ++g) {
+        for (int i = 0; i < 4; ++i) {
+            const __m256i pair = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + (g * 4 + i) * 32));
+            x[g][i] = _mm256_shuffle_epi8(pair, c.byteSwap32);
+        }
+        transpose(x[g][0], x[g][1], x[g][2], x[g][3]);
+    }
+
+    for (int r = 0; r < SM4Backend::kRounds; ++r) {
+        const __m256i key = _mm256_set1_epi32(int(rk[r]));
+        for (int g = 0; g < Groups; ++g) {
+            __m256i *s = x[g];
+            const __m256i t = _mm256_xor_si256(_mm256_xor_si256(s[(r + 1) & 3], s[(r + 2) & 3]),
+                                               _mm256_xor_si256(s[(r + 3) & 3], key));
+            s[r & 3] = _mm256_xor_si256(s[r & 3], roundT(c, t));
+        }
+    }
+
+    for (int g = 0; g < Groups; ++g) {
+        __m256i *s = x[g];
+        transpose(s[3], s[2], s[1], s[0]);
+        const __m256i pairs[4] = {s[3], s[2], s[1], s[0]};
+        for (int i = 0; i < 4; ++i) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + (g * 4 + i) * 32),
+                                _mm256_shuffle_epi8(pairs[i], c.byteSwap32));
+        }
+    }
+}
+
+}
+
+void SM4BackendHw::cryptAvx2(const quint32 *roundKeys, const quint8 *in, quint8 *out, size_t blocks)
+{
+    const Constants c;
+    const size_t step = kGroupBlocks * kGroups;
+    for (; blocks >= step; blocks -= step, in += step * 16, out += step * 16) {
+        cryptGroups<kGroups>(c, roundKeys, in, out);
+    }
+    if (blocks >= kGroupBlocks) {
+        cryptGroups<1>(c, roundKeys, in, out);
+        blocks -= kGroupBlocks;
+        in += kGroupBlocks * 16;
+        out += kGroupBlocks * 16;
+    }
+    // 余下不足 8 个分组交给 128 位实现
+    _mm256_zeroupper();
+    if (blocks > 0) {
+        cryptAesNi(roundKeys, in, out, blocks);
+    }
+}
+
+#endif
@@ -0,0 +1,134 @@
+#include "SM4Backend.h"
+
+// AES-NI + SSSE3 实现。GCC/Clang 下本文件以 -maes -mssse3 单独编译，
+// 只有 CpuFeatures 检测到 AES-NI 与 SSSE3 时才会被调用。
+// 4 个分组转置后每个 128 位寄存器存放 4 个分组的同一个字，32 轮运算对 4 个分组同时进行；
+// S 盒借用 AESENCLAST：SM4 与 AES 的有限域同构，S 盒只差前后各一个仿射变换（PSHUFB 查表完成），
+// 输入先做逆 ShiftRows 抵消 AESENCLAST 中的行移位，轮密钥取 0。
+#if defined(Q_PROCESSOR_X86)
+
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+
+alignas(16) const quint8 SM4BackendHw::kAffineTables[4][16] = {
+    {0x3e, 0xb2, 0x0e, 0x82, 0xbb, 0x37, 0x8b, 0x07, 0xa1, 0x2d, 0x91, 0x1d, 0x24, 0xa8, 0x14, 0x98},
+    {0x00, 0xdc, 0x2e, 0xf2, 0xc5, 0x19, 0xeb, 0x37, 0x08, 0xd4, 0x26, 0xfa, 0xcd, 0x11, 0xe3, 0x3f},
+    {0x6c, 0xd4, 0xa6, 0x1e, 0x52, 0xea, 0x98, 0x20, 0x0b, 0xb3, 0xc1, 0x79, 0x35, 0x8d, 0xff, 0x47},
+    {0x00, 0xe0, 0x50, 0xb0, 0x9d, 0x7d, 0xcd, 0x2d, 0xc0, 0x20, 0x90, 0x70, 0x5d, 0xbd, 0x0d, 0xed},
+};
+
+namespace {
+
+// 每次交错处理 2 组共 8 个分组，掩盖 AESENCLAST 的延迟
+constexpr int kGroups = 2;
+
+struct Constants {
+    __m128i preLow, preHigh, postLow, postHigh;
+    __m128i lowNibble, invShiftRows, rotate8, rotate16, rotate24, byteSwap32;
+
+    Constants()
+        : preLow(table(0)), preHigh(table(1)), postLow(table(2)), postHigh(table(3))
+        , lowNibble(_mm_set1_epi8(0x0f))
+        , invShiftRows(_mm_setr_epi8(0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3))
+        , rotate8(_mm_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14))
+        , rotate16(_mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13))
+        , rotate24(_mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12))
+        , byteSwap32(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12))
+    {
+    }
+
+    static __m128i table(int index)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(SM4BackendHw::kAffineTables[index]));
+    }
+};
+
+// 按低、高半字节分别查表，完成一个仿射变换
+inline __m128i affine(const Constants &c, __m128i x, __m128i low, __m128i high)
+{
+    const __m128i lo = _mm_and_si128(x, c.lowNibble);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi32(x, 4), c.lowNibble);
+    return _mm_xor_si128(_mm_shuffle_epi8(low, lo), _mm_shuffle_epi8(high, hi));
+}
+
+// T = L(τ(x))，对每个 32 位字
+inline __m128i roundT(const Constants &c, __m128i x)
+{
+    x = affine(c, x, c.preLow, c.preHigh);
+    x = _mm_aesenclast_si128(_mm_shuffle_epi8(x, c.invShiftRows), _mm_setzero_si128());
+    x = affine(c, x, c.postLow, c.postHigh);
+
+    // L(b) = b ^ (b <<< 24) ^ ((b ^ (b <<< 8) ^ (b <<< 16)) <<< 2)
+    const __m128i t = _mm_xor_si128(_mm_xor_si128(x, _mm_shuffle_epi8(x, c.rotate8)), _mm_shuffle_epi8(x, c.rotate16));
+    const __m128i t2 = _mm_or_si128(_mm_slli_epi32(t, 2), _mm_srli_epi32(t, 30));
+    return _mm_xor_si128(_mm_xor_si128(x, _mm_shuffle_epi8(x, c.rotate24)), t2);
+}
+
+// 4x4 个 32 位字的转置：分组为行 <-> 字为行
+inline void transpose(__m128i &a, __m128i &b, __m128i &c, __m128i &d)
+{
+    const __m128i t0 = _mm_unpacklo_epi32(a, b);
+    const __m128i t1 = _mm_unpacklo_epi32(c, d);
+    const __m128i t2 = _mm_unpackhi_epi32(a, b);
+    const __m128i t3 = _mm_unpackhi_epi32(c, d);
+    a = _mm_unpacklo_epi64(t0, t1);
+    b = _mm_unpackhi_epi64(t0, t1);
+    c = _mm_unpacklo_epi64(t2, t3);
+    d = _mm_unpackhi_epi64(t2, t3);
+}
+
+template <int Groups>
+void cryptGroups(const Constants &c, const quint32 *rk, const quint8 *in, quint8 *out)
+{
+    __m128i x[Groups][4];
+    for (int g = 0; g < Groups; ++g) {
+        for (int i = 0; i < 4; ++i) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + (g * 4 + i) * 16));
+            x[g][i] = _mm_shuffle_epi8(block, c.byteSwap32);
+        }
+        transpose(x[g][0], x[g][1], x[g][2], x[g][3]);
+    }
+
+    for (int r = 0; r < SM4Backend::kRounds; ++r) {
+        const __m128i key = _mm_set1_epi32(int(rk[r]));
+        for (int g = 0; g < Groups; ++g) {
+            __m128i *s = x[g];
+            const __m128i t = _mm_xor_si128(_mm_xor_si128(s[(r + 1) & 3], s[(r + 2) & 3]),
+                                            _mm_xor_si128(s[(r + 3) & 3], key));
+            s[r & 3] = _mm_xor_si128(s[r & 3], roundT(c, t));
+        }
+    }
+
+    // 反序变换：输出 (X35, X34, X33, X32)
+    for (int g = 0; g < Groups; ++g) {
+        __m128i *s = x[g];
+        transpose(s[3], s[2], s[1], s[0]);
+        const __m128i blocks[4] = {s[3], s[2], s[1], s[0]};
+        for (int i = 0; i < 4; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + (g * 4 + i) * 16),
+                             _mm_shuffle_epi8(blocks[i], c.byteSwap32));
+        }
+    }
+}
+
+}
+
+void SM4BackendHw::cryptAesNi(const quint32 *roundKeys, const quint8 *in, quint8 *out, size_t blocks)
+{
+    const Constants c;
+    for (; blocks >= 4 * kGroups; blocks -= 4 * kGroups, in += 64 * kGroups, out += 64 * kGroups) {
+        cryptGroups<kGroups>(c, roundKeys, in, out);
+    }
+    if (blocks >= 4) {
+        cryptGroups<1>(c, roundKeys, in, out);
+        blocks -= 4;
+        in += 64;
+        out += 64;
+    }
+    // 不足 4 个的分组（如 CBC 加密逐块调用）直接查表更快
+    if (blocks > 0) {
+        SM4Backend::portable().crypt(roundKeys, in, out, blocks);
+    }
+}
+
+#endif
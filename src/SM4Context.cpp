@@ -0,0 +1,33 @@
+#include "SM4Context.h"
+
+#include <cstring>
+
+bool SM4Context::setKey(const quint8 *key, int keyLength)
+{
+    if (keyLength != kKeyLength) {
+        return false;
+    }
+    if (m_hasKey && std::memcmp(key, m_key, kKeyLength) == 0) {
+        return true;
+    }
+
+    SM4Backend::expandKey(key, m_encRoundKeys);
+    // 解密与加密结构相同，轮密钥逆序使用
+    for (int i = 0; i < SM4Backend::kRounds; ++i) {
+        m_decRoundKeys[i] = m_encRoundKeys[SM4Backend::kRounds - 1 - i];
+    }
+
+    std::memcpy(m_key, key, kKeyLength);
+    m_hasKey = true;
+    return true;
+}
+
+void SM4Context::encryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const
+{
+    SM4Backend::cryptBlocks(m_encRoundKeys, in, out, blocks);
+}
+
+void SM4Context::decryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const
+{
+    SM4Backend::cryptBlocks(m_decRoundKeys, in, out, blocks);
+}
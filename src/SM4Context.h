@@ -0,0 +1,29 @@
+#ifndef SM4CONTEXT_H
+#define SM4CONTEXT_H
+
+#include "BlockCipherContext.h"
+#include "SM4Backend.h"
+
+// SM4 加解密上下文（GB/T 32907-2016）：保存加密轮密钥及其逆序（解密用），
+// 密钥不变时重复调用 setKey 不会再次扩展。可以按值复制。
+// 分组运算由 SM4Backend 按 CPU 特性选择实现。
+class SM4Context : public BlockCipherContext
+{
+public:
+    static constexpr int kKeyLength = 16;
+
+    // keyLength 必须为 16 字节
+    bool setKey(const quint8 *key, int keyLength);
+    bool hasKey() const { return m_hasKey; }
+
+    void encryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const override;
+    void decryptBlocks(const quint8 *in, quint8 *out, size_t blocks) const override;
+
+private:
+    quint32 m_encRoundKeys[SM4Backend::kRounds];
+    quint32 m_decRoundKeys[SM4Backend::kRounds];
+    quint8 m_key[kKeyLength] = {};
+    bool m_hasKey = false;
+};
+
+#endif // SM4CONTEXT_H
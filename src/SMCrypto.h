@@ -4,6 +4,10 @@
 #include <QObject>
 #include <QString>
 #include <QByteArray>
+#include <QFutureWatcher>
+
+#include "FileCipher.h"
+#include "SM4Context.h"
 
 class SMCrypto : public QObject
 {
@@ -15,9 +19,15 @@ class SMCrypto : public QObject
     Q_PROPERTY(QString algorithm READ algorithm WRITE setAlgorithm NOTIFY algorithmChanged)
     Q_PROPERTY(QString mode READ mode WRITE setMode NOTIFY modeChanged)
     Q_PROPERTY(bool uppercase READ uppercase WRITE setUppercase NOTIFY uppercaseChanged)
+    Q_PROPERTY(QString aad READ aad WRITE setAad NOTIFY aadChanged)
+    Q_PROPERTY(QString tag READ tag WRITE setTag NOTIFY tagChanged)
+    Q_PROPERTY(QString backendName READ backendName CONSTANT)
+    Q_PROPERTY(bool fileRunning READ fileRunning NOTIFY fileRunningChanged)
+    Q_PROPERTY(double fileProgress READ fileProgress NOTIFY fileProgressChanged)
 
 public:
     explicit SMCrypto(QObject *parent = nullptr);
+    ~SMCrypto();
 
     QString inputText() const;
     void setInputText(const QString &text);
@@ -39,6 +49,16 @@ public:
     bool uppercase() const;
     void setUppercase(bool upper);
 
+    // SM4-GCM 的附加认证数据与认证标签（十六进制）
+    QString aad() const;
+    void setAad(const QString &aad);
+
+    QString tag() const;
+    void setTag(const QString &tag);
+
+    // SM4 当前使用的分组运算实现："AVX2" / "AES-NI" / "T-table"
+    QString backendName() const;
+
     // SM3 哈希
     Q_INVOKABLE void sm3Hash();
     
@@ -46,6 +66,14 @@ public:
     Q_INVOKABLE void sm4Encrypt();
     Q_INVOKABLE void sm4Decrypt();
     
+    // SM4 文件加解密：后台线程分块处理，完成后发出 fileFinished
+    Q_INVOKABLE bool sm4EncryptFile(const QString &inputPath, const QString &outputPath);
+    Q_INVOKABLE bool sm4DecryptFile(const QString &inputPath, const QString &outputPath);
+    Q_INVOKABLE void cancelFile();
+    
+    bool fileRunning() const;
+    double fileProgress() const;
+    
     // 生成随机密钥
     Q_INVOKABLE QString generateKey(int length = 16);
     Q_INVOKABLE QString generateIV();
@@ -61,45 +89,34 @@ signals:
     void algorithmChanged();
     void modeChanged();
     void uppercaseChanged();
+    void aadChanged();
+    void tagChanged();
     void errorOccurred(const QString &error);
+    void fileRunningChanged();
+    void fileProgressChanged();
+    void fileFinished(bool success, const QString &message);
 
 private:
-    // SM3 内部函数
-    QByteArray sm3(const QByteArray &message);
-    quint32 sm3_ff(quint32 x, quint32 y, quint32 z, int j);
-    quint32 sm3_gg(quint32 x, quint32 y, quint32 z, int j);
-    quint32 sm3_p0(quint32 x);
-    quint32 sm3_p1(quint32 x);
-    quint32 rotateLeft(quint32 x, int n);
-    
-    // SM4 内部函数
-    QByteArray sm4_encrypt_ecb(const QByteArray &plaintext, const QByteArray &key);
-    QByteArray sm4_decrypt_ecb(const QByteArray &ciphertext, const QByteArray &key);
-    QByteArray sm4_encrypt_cbc(const QByteArray &plaintext, const QByteArray &key, const QByteArray &iv);
-    QByteArray sm4_decrypt_cbc(const QByteArray &ciphertext, const QByteArray &key, const QByteArray &iv);
-    void sm4_setkey(const QByteArray &key, quint32 *rk);
-    void sm4_one_round(quint32 *rk, const quint8 *input, quint8 *output);
-    quint32 sm4_lt(quint32 ka);
-    quint32 sm4_f(quint32 x0, quint32 x1, quint32 x2, quint32 x3, quint32 rk);
-    
-    // PKCS7 填充
-    QByteArray pkcs7Pad(const QByteArray &data, int blockSize);
-    QByteArray pkcs7Unpad(const QByteArray &data);
+    // SM4 内部函数：校验密钥并交给上下文扩展，解析当前模式所需的 IV
+    bool sm4_prepare_key();
+    bool sm4_parse_iv(QByteArray *ivBytes);
+    bool sm4_start_file(bool encrypt, const QString &inputPath, const QString &outputPath);
+    void onFileFinished();
 
     QString m_inputText;
     QString m_key;
     QString m_iv;
     QString m_result;
     QString m_algorithm;  // "SM3", "SM4"
-    QString m_mode;       // "ECB", "CBC"
+    QString m_mode;       // "ECB", "CBC", "CTR", "GCM"
     bool m_uppercase;
+    QString m_aad;
+    QString m_tag;
+    
+    QFutureWatcher<FileCipher::Result> *m_fileWatcher;
+    double m_fileProgress;
     
-    // SM4 S盒
-    static const quint8 SM4_SBOX[256];
-    // SM4 系统参数FK
-    static const quint32 SM4_FK[4];
-    // SM4 固定参数CK
-    static const quint32 SM4_CK[32];
+    SM4Context m_sm4;
 };
 
 #endif // SMCRYPTO_H
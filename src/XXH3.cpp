@@ -0,0 +1,460 @@
+#include "XXH3.h"
+#include "CpuFeatures.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+constexpr quint32 kPrime32_1 = 0x9e3779b1u;
+constexpr quint32 kPrime32_2 = 0x85ebca77u;
+constexpr quint32 kPrime32_3 = 0xc2b2ae3du;
+constexpr quint64 kPrime64_1 = 0x9e3779b185ebca87ull;
+constexpr quint64 kPrime64_2 = 0xc2b2ae3d27d4eb4full;
+constexpr quint64 kPrime64_3 = 0x165667b19e3779f9ull;
+constexpr quint64 kPrime64_4 = 0x85ebca77c2b2ae63ull;
+constexpr quint64 kPrime64_5 = 0x27d4eb2f165667c5ull;
+constexpr quint64 kPrimeMx1 = 0x165667919e3779f9ull;
+constexpr quint64 kPrimeMx2 = 0x9fb21c651e98df25ull;
+
+constexpr int kStripesPerBlock = (XXH3::kSecretLength - XXH3::kStripeLength) / 8;
+constexpr int kMidSizeMax = 240;
+constexpr int kMidSizeStartOffset = 3;
+constexpr int kMidSizeLastOffset = 17;
+constexpr int kSecretSizeMin = 136;
+constexpr int kLastStripeSecretOffset = XXH3::kSecretLength - XXH3::kStripeLength - 7;
+constexpr int kMergeSecretOffset = 11;
+
+const quint8 *const kSecret = XXH3Hw::kSecret;
+
+struct Hash128 {
+    quint64 low;
+    quint64 high;
+};
+
+inline quint32 read32(const quint8 *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+inline quint64 read64(const quint8 *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+inline quint32 rotateLeft32(quint32 x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+inline quint64 rotateLeft64(quint64 x, int n)
+{
+    return (x << n) | (x >> (64 - n));
+}
+
+inline quint32 swap32(quint32 x)
+{
+    return qbswap(x);
+}
+
+inline quint64 swap64(quint64 x)
+{
+    return qbswap(x);
+}
+
+inline Hash128 multiply128(quint64 a, quint64 b)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return {quint64(product), quint64(product >> 64)};
+#else
+    const quint64 loLo = (a & 0xffffffffu) * (b & 0xffffffffu);
+    const quint64 hiLo = (a >> 32) * (b & 0xffffffffu);
+    const quint64 loHi = (a & 0xffffffffu) * (b >> 32);
+    const quint64 hiHi = (a >> 32) * (b >> 32);
+    const quint64 cross = (loLo >> 32) + (hiLo & 0xffffffffu) + loHi;
+    return {(cross << 32) | (loLo & 0xffffffffu), (hiLo >> 32) + (cross >> 32) + hiHi};
+#endif
+}
+
+inline quint64 multiplyFold64(quint64 a, quint64 b)
+{
+    const Hash128 product = multiply128(a, b);
+    return product.low ^ product.high;
+}
+
+inline quint64 xxh64Avalanche(quint64 h)
+{
+    h ^= h >> 33;
+    h *= kPrime64_2;
+    h ^= h >> 29;
+    h *= kPrime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline quint64 avalanche(quint64 h)
+{
+    h ^= h >> 37;
+    h *= kPrimeMx1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline quint64 rrmxmx(quint64 h, quint64 length)
+{
+    h ^= rotateLeft64(h, 49) ^ rotateLeft64(h, 24);
+    h *= kPrimeMx2;
+    h ^= (h >> 35) + length;
+    h *= kPrimeMx2;
+    h ^= h >> 28;
+    return h;
+}
+
+inline quint64 mix16(const quint8 *input, const quint8 *secret)
+{
+    return multiplyFold64(read64(input) ^ read64(secret), read64(input + 8) ^ read64(secret + 8));
+}
+
+inline void mix32(Hash128 &acc, const quint8 *input1, const quint8 *input2, const quint8 *secret)
+{
+    acc.low += mix16(input1, secret);
+    acc.low ^= read64(input2) + read64(input2 + 8);
+    acc.high += mix16(input2, secret + 16);
+    acc.high ^= read64(input1) + read64(input1 + 8);
+}
+
+// ---- 64 位，长度不超过 240 字节 ----
+
+quint64 hash64Short(const quint8 *input, size_t length)
+{
+    if (length == 0) {
+        return xxh64Avalanche(read64(kSecret + 56) ^ read64(kSecret + 64));
+    }
+    if (length <= 3) {
+        const quint32 combined = (quint32(input[0]) << 16) | (quint32(input[length >> 1]) << 24)
+                                 | quint32(input[length - 1]) | (quint32(length) << 8);
+        return xxh64Avalanche(quint64(combined) ^ (read32(kSecret) ^ read32(kSecret + 4)));
+    }
+    if (length <= 8) {
+        const quint64 value = read32(input + length - 4) + (quint64(read32(input)) << 32);
+        return rrmxmx(value ^ (read64(kSecret + 8) ^ read64(kSecret + 16)), length);
+    }
+    if (length <= 16) {
+        const quint64 low = read64(input) ^ (read64(kSecret + 24) ^ read64(kSecret + 32));
+        const quint64 high = read64(input + length - 8) ^ (read64(kSecret + 40) ^ read64(kSecret + 48));
+        return avalanche(length + swap64(low) + high + multiplyFold64(low, high));
+    }
+
+    quint64 acc = length * kPrime64_1;
+    if (length <= 128) {
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    acc += mix16(input + 48, kSecret + 96);
+                    acc += mix16(input + length - 64, kSecret + 112);
+                }
+                acc += mix16(input + 32, kSecret + 64);
+                acc += mix16(input + length - 48, kSecret + 80);
+            }
+            acc += mix16(input + 16, kSecret + 32);
+            acc += mix16(input + length - 32, kSecret + 48);
+        }
+        acc += mix16(input, kSecret);
+        acc += mix16(input + length - 16, kSecret + 16);
+        return avalanche(acc);
+    }
+
+    const int rounds = int(length / 16);
+    for (int i = 0; i < 8; ++i) {
+        acc += mix16(input + 16 * i, kSecret + 16 * i);
+    }
+    acc = avalanche(acc);
+    for (int i = 8; i < rounds; ++i) {
+        acc += mix16(input + 16 * i, kSecret + 16 * (i - 8) + kMidSizeStartOffset);
+    }
+    acc += mix16(input + length - 16, kSecret + kSecretSizeMin - kMidSizeLastOffset);
+    return avalanche(acc);
+}
+
+// ---- 128 位，长度不超过 240 字节 ----
+
+Hash128 hash128Short(const quint8 *input, size_t length)
+{
+    if (length == 0) {
+        return {xxh64Avalanche(read64(kSecret + 64) ^ read64(kSecret + 72)),
+                xxh64Avalanche(read64(kSecret + 80) ^ read64(kSecret + 88))};
+    }
+    if (length <= 3) {
+        const quint32 combinedLow = (quint32(input[0]) << 16) | (quint32(input[length >> 1]) << 24)
+                                    | quint32(input[length - 1]) | (quint32(length) << 8);
+        const quint32 combinedHigh = rotateLeft32(swap32(combinedLow), 13);
+        return {xxh64Avalanche(quint64(combinedLow) ^ (read32(kSecret) ^ read32(kSecret + 4))),
+                xxh64Avalanche(quint64(combinedHigh) ^ (read32(kSecret + 8) ^ read32(kSecret + 12)))};
+    }
+    if (length <= 8) {
+        const quint64 value = read32(input) + (quint64(read32(input + length - 4)) << 32);
+        const quint64 keyed = value ^ (read64(kSecret + 16) ^ read64(kSecret + 24));
+        Hash128 m = multiply128(keyed, kPrime64_1 + (quint64(length) << 2));
+        m.high += m.low << 1;
+        m.low ^= m.high >> 3;
+        m.low ^= m.low >> 35;
+        m.low *= kPrimeMx2;
+        m.low ^= m.low >> 28;
+        m.high = avalanche(m.high);
+        return m;
+    }
+    if (length <= 16) {
+        const quint64 low = read64(input);
+        quint64 high = read64(input + length - 8);
+        Hash128 m = multiply128(low ^ high ^ (read64(kSecret + 32) ^ read64(kSecret + 40)), kPrime64_1);
+        m.low += quint64(length - 1) << 54;
+        high ^= read64(kSecret + 48) ^ read64(kSecret + 56);
+        m.high += high + quint64(quint32(high)) * (kPrime32_2 - 1);
+        m.low ^= swap64(m.high);
+        Hash128 h = multiply128(m.low, kPrime64_2);
+        h.high += m.high * kPrime64_2;
+        return {avalanche(h.low), avalanche(h.high)};
+    }
+
+    Hash128 acc = {length * kPrime64_1, 0};
+    if (length <= 128) {
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    mix32(acc, input + 48, input + length - 64, kSecret + 96);
+                }
+                mix32(acc, input + 32, input + length - 48, kSecret + 64);
+            }
+            mix32(acc, input + 16, input + length - 32, kSecret + 32);
+        }
+        mix32(acc, input, input + length - 16, kSecret);
+    } else {
+        const int rounds = int(length / 32);
+        for (int i = 0; i < 4; ++i) {
+            mix32(acc, input + 32 * i, input + 32 * i + 16, kSecret + 32 * i);
+        }
+        acc.low = avalanche(acc.low);
+        acc.high = avalanche(acc.high);
+        for (int i = 4; i < rounds; ++i) {
+            mix32(acc, input + 32 * i, input + 32 * i + 16, kSecret + kMidSizeStartOffset + 32 * (i - 4));
+        }
+        mix32(acc, input + length - 16, input + length - 32, kSecret + kSecretSizeMin - kMidSizeLastOffset - 16);
+    }
+    const quint64 low = acc.low + acc.high;
+    const quint64 high = acc.low * kPrime64_1 + acc.high * kPrime64_4 + length * kPrime64_2;
+    return {avalanche(low), 0 - avalanche(high)};
+}
+
+// ---- 长输入：累加器合并 ----
+
+quint64 mergeAccumulators(const quint64 *acc, const quint8 *secret, quint64 start)
+{
+    quint64 result = start;
+    for (int i = 0; i < 4; ++i) {
+        result += multiplyFold64(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+void accumulatePortable(quint64 *acc, const quint8 *input, const quint8 *secret, size_t stripes)
+{
+    for (size_t s = 0; s < stripes; ++s) {
+        const quint8 *stripe = input + s * XXH3::kStripeLength;
+        const quint8 *key = secret + s * 8;
+        for (int i = 0; i < 8; ++i) {
+            const quint64 value = read64(stripe + 8 * i);
+            const quint64 keyed = value ^ read64(key + 8 * i);
+            acc[i ^ 1] += value;
+            acc[i] += quint64(quint32(keyed)) * (keyed >> 32);
+        }
+    }
+}
+
+void scramblePortable(quint64 *acc, const quint8 *secret)
+{
+    for (int i = 0; i < 8; ++i) {
+        quint64 a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(secret + 8 * i);
+        a *= kPrime32_1;
+        acc[i] = a;
+    }
+}
+
+}
+
+const quint8 XXH3Hw::kSecret[XXH3::kSecretLength] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+const XXH3::Implementation &XXH3::portable()
+{
+    static const Implementation impl = {"Scalar", accumulatePortable, scramblePortable};
+    return impl;
+}
+
+QList<const XXH3::Implementation *> XXH3::available()
+{
+    QList<const Implementation *> result{&portable()};
+#if defined(Q_PROCESSOR_X86)
+    // x86-64 一定支持 SSE2，32 位 x86 仍需检测；CpuFeatures 只提供 SSSE3 及以上，以其为准
+    static const Implementation sse2 = {"SSE2", XXH3Hw::accumulateSse2, XXH3Hw::scrambleSse2};
+    static const Implementation avx2 = {"AVX2", XXH3Hw::accumulateAvx2, XXH3Hw::scrambleAvx2};
+#if defined(Q_PROCESSOR_X86_64)
+    result << &sse2;
+#else
+    if (CpuFeatures::hasSsse3()) {
+        result << &sse2;
+    }
+#endif
+    if (CpuFeatures::hasAvx2()) {
+        result << &avx2;
+    }
+#endif
+    return result;
+}
+
+const XXH3::Implementation &XXH3::active()
+{
+    static const Implementation *impl = available().constLast();
+    return *impl;
+}
+
+XXH3::XXH3(Width width, const Implementation &implementation)
+    : m_implementation(&implementation)
+    , m_width(width)
+{
+    reset();
+}
+
+void XXH3::reset()
+{
+    const quint64 init[8] = {kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+                             kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1};
+    std::memcpy(m_acc, init, sizeof(m_acc));
+    m_stripesSoFar = 0;
+    m_totalLength = 0;
+    m_bufferLength = 0;
+}
+
+void XXH3::consumeStripes(quint64 *acc, int *stripesSoFar, const quint8 *input, size_t stripes) const
+{
+    // 每凑满 16 个条带扰乱一次；调用方保证这些条带之后还有数据，所以凑满时可以立即扰乱
+    while (stripes > 0) {
+        const size_t count = qMin(stripes, size_t(kStripesPerBlock - *stripesSoFar));
+        m_implementation->accumulate(acc, input, kSecret + *stripesSoFar * 8, count);
+        *stripesSoFar += int(count);
+        if (*stripesSoFar == kStripesPerBlock) {
+            m_implementation->scramble(acc, kSecret + kSecretLength - kStripeLength);
+            *stripesSoFar = 0;
+        }
+        input += count * kStripeLength;
+        stripes -= count;
+    }
+}
+
+void XXH3::addData(const char *data, qsizetype length)
+{
+    if (length <= 0) {
+        return;
+    }
+    const quint8 *input = reinterpret_cast<const quint8 *>(data);
+    size_t remaining = size_t(length);
+    m_totalLength += remaining;
+
+    if (m_bufferLength + remaining <= size_t(kBufferLength)) {
+        std::memcpy(m_buffer + m_bufferLength, input, remaining);
+        m_bufferLength += int(remaining);
+        return;
+    }
+
+    // 总是留至少 1 字节在缓冲区里，result() 才能区分最后一个条带
+    if (m_bufferLength > 0) {
+        const size_t fill = size_t(kBufferLength - m_bufferLength);
+        std::memcpy(m_buffer + m_bufferLength, input, fill);
+        input += fill;
+        remaining -= fill;
+        consumeStripes(m_acc, &m_stripesSoFar, m_buffer, kBufferLength / kStripeLength);
+        std::memcpy(m_lastStripe, m_buffer + kBufferLength - kStripeLength, kStripeLength);
+        m_bufferLength = 0;
+    }
+    if (remaining > size_t(kBufferLength)) {
+        const size_t stripes = (remaining - 1) / kStripeLength;
+        consumeStripes(m_acc, &m_stripesSoFar, input, stripes);
+        input += stripes * kStripeLength;
+        remaining -= stripes * kStripeLength;
+        std::memcpy(m_lastStripe, input - kStripeLength, kStripeLength);
+    }
+    std::memcpy(m_buffer, input, remaining);
+    m_bufferLength = int(remaining);
+}
+
+void XXH3::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+QByteArray XXH3::result() const
+{
+    QByteArray digest(m_width == Bits128 ? 16 : 8, Qt::Uninitialized);
+    char *out = digest.data();
+
+    if (m_totalLength <= quint64(kMidSizeMax)) {
+        if (m_width == Bits128) {
+            const Hash128 h = hash128Short(m_buffer, size_t(m_totalLength));
+            qToBigEndian(h.high, out);
+            qToBigEndian(h.low, out + 8);
+        } else {
+            qToBigEndian(hash64Short(m_buffer, size_t(m_totalLength)), out);
+        }
+        return digest;
+    }
+
+    // 在副本上处理缓冲区中剩余的条带与最后一个条带，不影响继续输入
+    quint64 acc[8];
+    std::memcpy(acc, m_acc, sizeof(acc));
+    int stripesSoFar = m_stripesSoFar;
+    if (m_bufferLength >= kStripeLength) {
+        const size_t stripes = size_t(m_bufferLength - 1) / kStripeLength;
+        consumeStripes(acc, &stripesSoFar, m_buffer, stripes);
+        m_implementation->accumulate(acc, m_buffer + m_bufferLength - kStripeLength,
+                                     kSecret + kLastStripeSecretOffset, 1);
+    } else {
+        quint8 lastStripe[kStripeLength];
+        const int carried = kStripeLength - m_bufferLength;
+        std::memcpy(lastStripe, m_lastStripe + kStripeLength - carried, size_t(carried));
+        std::memcpy(lastStripe + carried, m_buffer, size_t(m_bufferLength));
+        m_implementation->accumulate(acc, lastStripe, kSecret + kLastStripeSecretOffset, 1);
+    }
+
+    const quint64 low = mergeAccumulators(acc, kSecret + kMergeSecretOffset, m_totalLength * kPrime64_1);
+    if (m_width == Bits128) {
+        const quint64 high = mergeAccumulators(acc, kSecret + kSecretLength - kStripeLength - kMergeSecretOffset,
+                                               ~(m_totalLength * kPrime64_2));
+        qToBigEndian(high, out);
+        qToBigEndian(low, out + 8);
+    } else {
+        qToBigEndian(low, out);
+    }
+    return digest;
+}
+
+QByteArray XXH3::hash(const QByteArray &data, Width width)
+{
+    XXH3 xxh3(width);
+    xxh3.addData(data);
+    return xxh3.result();
+}
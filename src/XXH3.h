@@ -0,0 +1,80 @@
+#ifndef XXH3_H
+#define XXH3_H
+
+#include <QByteArray>
+#include <QList>
+#include <QtGlobal>
+
+#include <cstddef>
+
+// 非加密哈希 XXH3（xxHash 0.8，默认密钥、种子为 0），输出 64 位或 128 位，与 xxhsum -H3 / -H2 的结果相同。
+// 长输入按 64 字节条带累加到 8 个 64 位累加器，累加与扰乱两步由运行时按 CPU 选择的 SSE2 / AVX2 实现完成。
+class XXH3
+{
+public:
+    static constexpr int kStripeLength = 64;
+    static constexpr int kSecretLength = 192;
+
+    enum Width {
+        Bits64,
+        Bits128,
+    };
+
+    // 依次累加 stripes 个连续条带，第 i 个条带使用从 secret + 8 * i 开始的 64 字节密钥
+    using AccumulateFunction = void (*)(quint64 *acc, const quint8 *input, const quint8 *secret, size_t stripes);
+    // 每 16 个条带（1 KiB）之后扰乱一次累加器
+    using ScrambleFunction = void (*)(quint64 *acc, const quint8 *secret);
+
+    struct Implementation {
+        const char *name;
+        AccumulateFunction accumulate;
+        ScrambleFunction scramble;
+    };
+
+    // 当前 CPU 上最快的实现（首次调用时选定）
+    static const Implementation &active();
+    static const Implementation &portable();
+    // 当前 CPU 可用的全部实现，可移植实现排在第一位
+    static QList<const Implementation *> available();
+
+    explicit XXH3(Width width = Bits64, const Implementation &implementation = active());
+
+    void reset();
+    void addData(const char *data, qsizetype length);
+    void addData(const QByteArray &data);
+
+    // 8 或 16 字节大端序，toHex() 后与 xxhsum 的输出一致；不改变内部状态，可以继续 addData
+    QByteArray result() const;
+
+    static QByteArray hash(const QByteArray &data, Width width = Bits64);
+
+private:
+    // 缓冲区能放下 4 个条带；总长不超过它时按短输入的算法一次算完
+    static constexpr int kBufferLength = 256;
+
+    void consumeStripes(quint64 *acc, int *stripesSoFar, const quint8 *input, size_t stripes) const;
+
+    const Implementation *m_implementation;
+    Width m_width;
+    quint64 m_acc[8];
+    int m_stripesSoFar;
+    quint64 m_totalLength;
+    quint8 m_buffer[kBufferLength];
+    int m_bufferLength;
+    // 最近一次累加的条带，剩余数据不足一个条带时最后一个条带要从这里补齐
+    quint8 m_lastStripe[kStripeLength];
+};
+
+namespace XXH3Hw {
+extern const quint8 kSecret[XXH3::kSecretLength];
+
+// SIMD 实现位于 XXH3_x86.cpp / XXH3_avx2.cpp，这两个文件使用单独的编译选项
+#if defined(Q_PROCESSOR_X86)
+void accumulateSse2(quint64 *acc, const quint8 *input, const quint8 *secret, size_t stripes);
+void scrambleSse2(quint64 *acc, const quint8 *secret);
+void accumulateAvx2(quint64 *acc, const quint8 *input, const quint8 *secret, size_t stripes);
+void scrambleAvx2(quint64 *acc, const quint8 *secret);
+#endif
+}
+
+#endif // XXH3_H
@@ -0,0 +1,53 @@
+#include "XXH3.h"
+
+// AVX2 实现。GCC/Clang 下本文件以 -mavx2 单独编译，只有 CpuFeatures 检测到 AVX2 时才会被调用。
+// 与 XXH3_x86.cpp 的算法相同，8 个累加器放在两个 256 位寄存器里。
+#if defined(Q_PROCESSOR_X86)
+
+#include <immintrin.h>
+
+namespace {
+
+inline __m256i load(const quint8 *p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+}
+
+void XXH3Hw::accumulateAvx2(quint64 *acc, const quint8 *input, const quint8 *secret, size_t stripes)
+{
+    __m256i a[2];
+    for (int i = 0; i < 2; ++i) {
+        a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + 4 * i));
+    }
+    for (size_t s = 0; s < stripes; ++s) {
+        const quint8 *stripe = input + s * XXH3::kStripeLength;
+        const quint8 *key = secret + s * 8;
+        for (int i = 0; i < 2; ++i) {
+            const __m256i data = load(stripe + 32 * i);
+            const __m256i keyed = _mm256_xor_si256(data, load(key + 32 * i));
+            const __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            a[i] = _mm256_add_epi64(a[i], _mm256_add_epi64(product, swapped));
+        }
+    }
+    for (int i = 0; i < 2; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + 4 * i), a[i]);
+    }
+}
+
+void XXH3Hw::scrambleAvx2(quint64 *acc, const quint8 *secret)
+{
+    const __m256i prime = _mm256_set1_epi32(int(0x9e3779b1u));
+    for (int i = 0; i < 2; ++i) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + 4 * i));
+        a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+        a = _mm256_xor_si256(a, load(secret + 32 * i));
+        const __m256i low = _mm256_mul_epu32(a, prime);
+        const __m256i high = _mm256_mul_epu32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + 4 * i), _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "XXH3.h"
+
+// SSE2 实现。GCC/Clang 下本文件以 -msse2 单独编译（x86-64 上本就是基线指令集）。
+// 每个 128 位寄存器放两个相邻的累加器，PMULUDQ 一次完成两个 32x32 位乘法。
+#if defined(Q_PROCESSOR_X86)
+
+#include <emmintrin.h>
+
+namespace {
+
+inline __m128i load(const quint8 *p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+}
+
+void XXH3Hw::accumulateSse2(quint64 *acc, const quint8 *input, const quint8 *secret, size_t stripes)
+{
+    __m128i a[4];
+    for (int i = 0; i < 4; ++i) {
+        a[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + 2 * i));
+    }
+    for (size_t s = 0; s < stripes; ++s) {
+        const quint8 *stripe = input + s * XXH3::kStripeLength;
+        const quint8 *key = secret + s * 8;
+        for (int i = 0; i < 4; ++i) {
+            const __m128i data = load(stripe + 16 * i);
+            const __m128i keyed = _mm_xor_si128(data, load(key + 16 * i));
+            // 低 32 位乘高 32 位；原始数据交换两个 64 位半部分后加到相邻的累加器
+            const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            a[i] = _mm_add_epi64(a[i], _mm_add_epi64(product, swapped));
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + 2 * i), a[i]);
+    }
+}
+
+void XXH3Hw::scrambleSse2(quint64 *acc, const quint8 *secret)
+{
+    const __m128i prime = _mm_set1_epi32(int(0x9e3779b1u));
+    for (int i = 0; i < 4; ++i) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + 2 * i));
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, load(secret + 16 * i));
+        // 64 位乘 32 位常数 = 低半部分乘积 + (高半部分乘积 << 32)
+        const __m128i low = _mm_mul_epu32(a, prime);
+        const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + 2 * i), _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+    }
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "../src/AESBackend.h"
+
+#include <QByteArray>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+struct KnownAnswer {
+    const char *key;
+    const char *plaintext;
+    const char *ciphertext;
+};
+
+// FIPS-197 附录 B 与附录 C.1 / C.2 / C.3
+const KnownAnswer kFips197[] = {
+    {"2b7e151628aed2a6abf7158809cf4f3c",
+     "3243f6a8885a308d313198a2e0370734", "3925841d02dc09fbdc118597196a0b32"},
+    {"000102030405060708090a0b0c0d0e0f",
+     "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a"},
+    {"000102030405060708090a0b0c0d0e0f1011121314151617",
+     "00112233445566778899aabbccddeeff", "dda97ca4864cdfe06eaf70a0ec0d7191"},
+    {"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+     "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089"},
+};
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+}
+
+int main()
+{
+    const QList<const AESBackend::Implementation *> backends = AESBackend::available();
+    require(!backends.isEmpty());
+    require(backends.contains(&AESBackend::active()));
+
+    for (const AESBackend::Implementation *backend : backends) {
+        for (const KnownAnswer &kat : kFips197) {
+            const QByteArray key = QByteArray::fromHex(kat.key);
+            const QByteArray plaintext = QByteArray::fromHex(kat.plaintext);
+            const QByteArray ciphertext = QByteArray::fromHex(kat.ciphertext);
+
+            AESBackend::KeySchedule schedule;
+            require(AESBackend::expandKey(bytes(key), key.size(), &schedule));
+
+            quint8 block[16];
+            backend->encrypt(schedule, bytes(plaintext), block, 1);
+            require(std::memcmp(block, ciphertext.constData(), 16) == 0);
+            backend->decrypt(schedule, block, block, 1);
+            require(std::memcmp(block, plaintext.constData(), 16) == 0);
+
+            // 多分组路径（4 块并行 + 尾块）必须与可移植实现逐字节一致
+            quint8 input[16 * 7];
+            for (int i = 0; i < int(sizeof(input)); ++i) {
+                input[i] = quint8(i * 37 + 11);
+            }
+            quint8 expected[sizeof(input)];
+            quint8 actual[sizeof(input)];
+            AESBackend::portable().encrypt(schedule, input, expected, 7);
+            backend->encrypt(schedule, input, actual, 7);
+            require(std::memcmp(expected, actual, sizeof(input)) == 0);
+            backend->decrypt(schedule, actual, actual, 7);
+            require(std::memcmp(input, actual, sizeof(input)) == 0);
+        }
+    }
+
+    AESBackend::KeySchedule schedule;
+    require(!AESBackend::expandKey(bytes(QByteArray(20, 'k')), 20, &schedule));
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "../src/AESCrypto.h"
+
+#include <QCoreApplication>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+struct Vector {
+    const char *keySize;
+    const char *mode;
+    const char *key;
+    const char *ciphertext;
+};
+
+// 由 openssl enc -aes-<bits>-<mode> 生成，ECB/CBC 为 PKCS7 填充，CTR 不填充
+const Vector kVectors[] = {
+    {"128", "ECB", "000102030405060708090a0b0c0d0e0f",
+     "9f1ee201a545de238d3b07af2945e8b52f1a4716de38fa58390f90b14596cf1b3561209253ab0ba5b484f9621d62dd2e954f64f2e4e86e9eee82d20216684899"},
+    {"128", "CBC", "000102030405060708090a0b0c0d0e0f",
+     "8dbc9158582887f0711e82ceadde2fa9a592da062ce17c36e1f09d80d38441135c3a82eb1a21cd1cd72bdefe9fd3e0f55d10caaee5eca8a8f34b4d261c5d21e9"},
+    {"192", "ECB", "000102030405060708090a0b0c0d0e0f1011121314151617",
+     "5f9895a41ebe3dedbcef95f8bbeb7f542f96c7ae8bbdd3cb908c845297c0ee3aa2f5023693d0e0ba4f78a8274a6571233fe7286abde5f03943d5777020259626"},
+    {"192", "CBC", "000102030405060708090a0b0c0d0e0f1011121314151617",
+     "cabd9e902b8cfa335a59065193510bb2e7b35fa0f41a23b04dd21bf360b47f72d8113a5a89ece0612c6cda3744dbee0b2119a237e264bf1df7bd41bfbacac609"},
+    {"256", "ECB", "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+     "a4bc6429b0a3b1547d7182443fc41e00e1c4440496d6b1e78ddd6b97fd3028469c7fb0400818a0b7bda9154cee8cf7d09f3b7504926f8bd36e3118e903a4cd4a"},
+    {"256", "CBC", "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+     "05de7d9ecb03e1f373b17a403961f6f55afafec24e8dbc4af903a812ed7a02c08c19e9c2a656a3e9093cc60f7e422bc15a80133dae48a3eca561e30ce9873438"},
+    {"128", "CTR", "000102030405060708090a0b0c0d0e0f",
+     "68c697f7cd2f3485663fa8f118cffb062286e5e0267e88d8ec57264eac8ea4ba3e681f125fe3598be3f0816a46bb4cac"},
+    {"192", "CTR", "000102030405060708090a0b0c0d0e0f1011121314151617",
+     "62c84f45b63bea9670b6fb5d2eead5f449512936cbd50b09ac65d7e7a6bc99a0328e0b054dbe09706e1f8e161b361539"},
+    {"256", "CTR", "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+     "3ade8d5d35102046118a90e7fe23e7cd8a5d006f92f42f6bb90ec9f7066b2f048b90b4388fec9427c5632257b9041c5e"},
+};
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QString plaintext = QString::fromUtf8("Honeycomb T-table AES 蜂巢工具箱 0123456789");
+    const QString iv = "0f0e0d0c0b0a09080706050403020100";
+
+    for (const Vector &vector : kVectors) {
+        AESCrypto aes;
+        aes.setKeySize(vector.keySize);
+        aes.setMode(vector.mode);
+        aes.setKey(vector.key);
+        aes.setIv(iv);
+
+        aes.setInputText(plaintext);
+        aes.encrypt();
+        require(aes.result() == vector.ciphertext);
+
+        aes.setInputText(vector.ciphertext);
+        aes.decrypt();
+        require(aes.result() == plaintext);
+    }
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "../src/Base64Codec.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+QByteArray randomBytes(qsizetype length, quint64 seed)
+{
+    QByteArray data(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        data[i] = char(seed >> 32);
+    }
+    return data;
+}
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(content) == content.size());
+}
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    require(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+// 每 76 个字符换一行（MIME 格式）
+QByteArray wrapLines(const QByteArray &text)
+{
+    QByteArray wrapped;
+    for (qsizetype i = 0; i < text.size(); i += 76) {
+        wrapped.append(text.mid(i, 76));
+        wrapped.append("\r\n", 2);
+    }
+    return wrapped;
+}
+}
+
+int main()
+{
+    // RFC 4648 第 10 节的测试向量
+    const char *const vectors[][2] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+
+    const QByteArray data = randomBytes(5000, 0x9e3779b97f4a7c15ULL);
+    for (const Base64Codec::Implementation *implementation : Base64Codec::available()) {
+        for (const auto &vector : vectors) {
+            require(Base64Codec::encode(vector[0], *implementation) == vector[1]);
+            bool ok = false;
+            require(Base64Codec::decode(vector[1], &ok, *implementation) == vector[0] && ok);
+        }
+
+        // 向量路径与逐字节部分的各种长度、任意对齐
+        for (qsizetype offset = 0; offset < 4; ++offset) {
+            for (qsizetype length = 0; length < 300; ++length) {
+                const QByteArray input = data.mid(offset, length);
+                const QByteArray encoded = Base64Codec::encode(input, *implementation);
+                require(encoded == input.toBase64());
+                bool ok = false;
+                require(Base64Codec::decode(encoded, &ok, *implementation) == input && ok);
+            }
+        }
+        const QByteArray text = data.toBase64();
+        require(Base64Codec::encode(data, *implementation) == text);
+
+        // 换行、空格与省略的填充符
+        bool ok = false;
+        require(Base64Codec::decode(wrapLines(text), &ok, *implementation) == data && ok);
+        require(Base64Codec::decode(" Zm9v\tYmE\n", &ok, *implementation) == "fooba" && ok);
+
+        // 字母表以外的字符出现在向量中的每个位置都能发现
+        for (qsizetype position = 0; position < 200; position += 7) {
+            for (const char bad : {'-', '_', '.', '@', char(0x80), char(0xff), '\0'}) {
+                QByteArray broken = text.left(256);
+                broken[position] = bad;
+                require(Base64Codec::decode(broken, &ok, *implementation).isEmpty() && !ok);
+            }
+        }
+        for (const char *invalid : {"Z", "Zg==Zg==", "Z===", "Zm9=v", "Zg=x"}) {
+            require(Base64Codec::decode(invalid, &ok, *implementation).isEmpty() && !ok);
+        }
+    }
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QDir root(dir.path());
+    const QByteArray large = randomBytes(1000003, 42);
+    writeFile(root.filePath("input.bin"), large);
+
+    // 分块长度不是 3 / 4 的倍数时，组仍然跨块正确拼接
+    Base64Codec::Options options;
+    options.inputPath = root.filePath("input.bin");
+    options.outputPath = root.filePath("input.b64");
+    options.chunkSize = 4097;
+    Base64Codec::Result result = Base64Codec::convertFile(options);
+    require(result.success && result.bytesRead == large.size());
+    const QByteArray text = readFile(options.outputPath);
+    require(text == large.toBase64() && result.bytesWritten == text.size());
+    require(result.preview == text.left(Base64Codec::kDefaultPreviewLength) && !result.previewComplete);
+
+    writeFile(root.filePath("wrapped.b64"), wrapLines(text));
+    options.encode = false;
+    options.inputPath = root.filePath("wrapped.b64");
+    options.outputPath = root.filePath("decoded.bin");
+    result = Base64Codec::convertFile(options);
+    require(result.success && readFile(options.outputPath) == large);
+
+    // 不指定输出文件时只转换预览所需的开头部分
+    options.encode = true;
+    options.inputPath = root.filePath("input.bin");
+    options.outputPath.clear();
+    options.previewLength = 100;
+    result = Base64Codec::convertFile(options);
+    require(result.success && result.preview == text.left(100) && !result.previewComplete);
+    require(result.bytesRead < large.size());
+    writeFile(root.filePath("small.txt"), "foobar");
+    options.inputPath = root.filePath("small.txt");
+    result = Base64Codec::convertFile(options);
+    require(result.success && result.preview == "Zm9vYmFy" && result.previewComplete);
+
+    // 取消或出错时不留下输出文件
+    options.inputPath = root.filePath("input.bin");
+    options.outputPath = root.filePath("canceled.b64");
+    result = Base64Codec::convertFile(options, [](qint64, qint64) { return false; });
+    require(!result.success && result.canceled && !QFileInfo::exists(options.outputPath));
+    writeFile(root.filePath("broken.b64"), text.left(5000) + "!" + text.mid(5000));
+    options.encode = false;
+    options.inputPath = root.filePath("broken.b64");
+    options.outputPath = root.filePath("broken.bin");
+    result = Base64Codec::convertFile(options);
+    require(!result.success && !result.errorMessage.isEmpty() && !QFileInfo::exists(options.outputPath));
+
+    return 0;
+}
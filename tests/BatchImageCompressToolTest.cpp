@@ -0,0 +1,135 @@
+#include "../src/BatchImageCompressTool.h"
+
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QImage>
+#include <QSet>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+// 处理事件直到 done() 成立，超时视为失败
+template<typename Predicate>
+void waitUntil(Predicate done)
+{
+    QDeadlineTimer deadline(60000);
+    while (!done()) {
+        require(!deadline.hasExpired());
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+    }
+}
+
+int countFiles(const QString &root)
+{
+    int count = 0;
+    QDirIterator it(root, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        ++count;
+    }
+    return count;
+}
+
+int succeeded(const BatchImageCompressTool &tool)
+{
+    int count = 0;
+    for (const QVariant &item : tool.items()) {
+        count += item.toMap().value("success").toBool() ? 1 : 0;
+    }
+    return count;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    // 图片格式插件与排队调用都需要 QCoreApplication
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QDir root(dir.path());
+    const QString album = root.filePath("album");
+    require(root.mkpath("album/sub"));
+    QImage image(800, 600, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        for (int x = 0; x < image.width(); ++x) {
+            image.setPixel(x, y, qRgb(x % 256, y % 256, (x + y) % 256));
+        }
+    }
+    const int fileCount = 24;
+    for (int i = 0; i < fileCount; ++i) {
+        const QString name = (i % 2 ? QStringLiteral("sub/") : QString()) + QString::number(i) + QStringLiteral(".png");
+        require(image.save(QDir(album).filePath(name), "png"));
+    }
+
+    BatchImageCompressTool tool;
+    int finishedCount = 0;
+    bool lastSuccess = false;
+    QObject::connect(&tool, &BatchImageCompressTool::finished, [&](bool success, const QString &) {
+        ++finishedCount;
+        lastSuccess = success;
+    });
+    tool.setInputPath(album);
+    tool.setFormat("jpeg");
+    tool.setMaxWidth(200);
+    tool.setMaxHeight(200);
+
+    // 输出文件夹是输入文件夹本身或其中的子文件夹时直接拒绝，不创建任何文件
+    for (const QString &output : {album, QDir(album).filePath("out"), QDir(album).filePath("sub/out")}) {
+        tool.setOutputFolder(output);
+        tool.start();
+        require(finishedCount == 1 && !lastSuccess && !tool.running() && tool.processedFiles() == 0);
+        finishedCount = 0;
+    }
+    require(!QFileInfo::exists(QDir(album).filePath("out")));
+
+    // 名称以输入文件夹开头的相邻文件夹不算在输入文件夹内
+    tool.setOutputFolder(QString());
+    require(QDir(tool.defaultOutputFolder()) == QDir(root.filePath("album_compressed")));
+    tool.start();
+    waitUntil([&] { return finishedCount == 1; });
+    require(lastSuccess && tool.processedFiles() == fileCount && countFiles(root.filePath("album_compressed")) == fileCount);
+
+    // 取消后仍在写的文件也计入结果：写到磁盘上的文件数与成功的条目数一致
+    tool.setThreadCount(4);
+    tool.setOutputFolder(root.filePath("canceled"));
+    finishedCount = 0;
+    tool.start();
+    waitUntil([&] { return tool.processedFiles() > 0 || finishedCount > 0; });
+    tool.cancel();
+    waitUntil([&] { return finishedCount == 1; });
+    require(succeeded(tool) == countFiles(root.filePath("canceled")));
+    require(tool.processedFiles() == int(tool.items().size()));
+
+    // 取消后马上开始新任务：上一次迟到的结果在新任务开始后才送到界面线程，应被丢弃，
+    // 新任务的条目不重复也不缺少
+    tool.setOutputFolder(root.filePath("first"));
+    finishedCount = 0;
+    tool.start();
+    waitUntil([&] { return tool.processedFiles() > 0 || finishedCount > 0; });
+    tool.cancel();
+    const int finishedBefore = finishedCount;
+    tool.setOutputFolder(root.filePath("second"));
+    tool.start();
+    waitUntil([&] { return finishedCount == finishedBefore + 1; });
+    require(lastSuccess && tool.processedFiles() == fileCount && tool.totalFiles() == fileCount);
+    QSet<QString> paths;
+    for (const QVariant &item : tool.items()) {
+        paths.insert(item.toMap().value("path").toString());
+    }
+    require(paths.size() == fileCount);
+    require(countFiles(root.filePath("second")) == fileCount);
+
+    return 0;
+}
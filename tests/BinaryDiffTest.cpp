@@ -0,0 +1,136 @@
+#include "../src/BinaryDiff.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(content) == content.size());
+}
+
+QByteArray randomBytes(qsizetype length, quint64 seed)
+{
+    QByteArray data(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        data[i] = char(seed >> 32);
+    }
+    return data;
+}
+
+void requireRange(const BinaryDiff::Range &range, BinaryDiff::Kind kind, qint64 oldOffset, qint64 oldLength,
+                  qint64 newOffset, qint64 newLength)
+{
+    require(range.kind == kind);
+    require(range.oldOffset == oldOffset && range.oldLength == oldLength);
+    require(range.newOffset == newOffset && range.newLength == newLength);
+}
+}
+
+int main()
+{
+    using Kind = BinaryDiff::Kind;
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QDir root(dir.path());
+
+    require(BinaryDiff::defaultBlockSize(0) == BinaryDiff::kMinBlockSize);
+    require(BinaryDiff::defaultBlockSize(qint64(64) << 30) == 64 * 1024);
+
+    // 24 MiB 的旧文件上依次做：改 10 字节、跨过 8 MiB 分段边界插入 3000 字节、删除 5000 字节、改最后一个字节。
+    // 插入与删除两端的字节特意与对面不同，期望的范围因此精确到字节
+    const qint64 size = 24 * 1024 * 1024;
+    const qint64 changed = 1000000;
+    const qint64 inserted = 8 * 1024 * 1024 - 100;
+    const qint64 deleted = 16000000;
+    QByteArray before = randomBytes(size, 0x9e3779b97f4a7c15ULL);
+    before[deleted] = char(before[deleted + 5000] ^ 1);
+    before[deleted + 4999] = char(before[deleted - 1] ^ 1);
+    QByteArray insertion = randomBytes(3000, 42);
+    insertion[0] = char(before[inserted] ^ 1);
+    insertion[2999] = char(before[inserted - 1] ^ 1);
+
+    QByteArray after = before;
+    for (qint64 i = changed; i < changed + 10; ++i) {
+        after[i] = char(after[i] ^ 0x5a);
+    }
+    after[size - 1] = char(after[size - 1] ^ 0x5a);
+    after.remove(deleted, 5000);
+    after.insert(inserted, insertion);
+    writeFile(root.filePath("old.bin"), before);
+    writeFile(root.filePath("new.bin"), after);
+
+    for (int threads : {1, 4}) {
+        for (int blockSize : {0, 1024}) {
+            const BinaryDiff::Result result =
+                BinaryDiff::compare(root.filePath("old.bin"), root.filePath("new.bin"), threads, blockSize);
+            require(result.success && !result.canceled && result.errorMessage.isEmpty());
+            require(result.blockSize == (blockSize == 0 ? BinaryDiff::kMinBlockSize : blockSize));
+            require(result.oldSize == size && result.newSize == size - 2000);
+            require(result.ranges.size() == 8);
+            requireRange(result.ranges.at(0), Kind::Match, 0, changed, 0, changed);
+            requireRange(result.ranges.at(1), Kind::Changed, changed, 10, changed, 10);
+            requireRange(result.ranges.at(2), Kind::Match, changed + 10, inserted - changed - 10,
+                         changed + 10, inserted - changed - 10);
+            requireRange(result.ranges.at(3), Kind::Inserted, inserted, 0, inserted, 3000);
+            requireRange(result.ranges.at(4), Kind::Match, inserted, deleted - inserted,
+                         inserted + 3000, deleted - inserted);
+            requireRange(result.ranges.at(5), Kind::Deleted, deleted, 5000, deleted + 3000, 0);
+            requireRange(result.ranges.at(6), Kind::Match, deleted + 5000, size - 1 - deleted - 5000,
+                         deleted + 3000, size - 1 - deleted - 5000);
+            requireRange(result.ranges.at(7), Kind::Changed, size - 1, 1, size - 2001, 1);
+            require(result.changedBytes == 11 && result.insertedBytes == 3000 && result.deletedBytes == 5000);
+            require(result.matchedBytes == size - 2000 - 3011);
+        }
+    }
+
+    // 相同文件只有一段匹配；旧文件为空时全部是插入；不足一块的小文件逐字节比较
+    require(BinaryDiff::compare(root.filePath("old.bin"), root.filePath("old.bin"), 4).ranges.size() == 1);
+    writeFile(root.filePath("empty"), QByteArray());
+    BinaryDiff::Result result = BinaryDiff::compare(root.filePath("empty"), root.filePath("new.bin"), 2);
+    require(result.success && result.ranges.size() == 1);
+    requireRange(result.ranges.at(0), Kind::Inserted, 0, 0, 0, size - 2000);
+    writeFile(root.filePath("a.txt"), "hello world");
+    writeFile(root.filePath("b.txt"), "hello there, world");
+    result = BinaryDiff::compare(root.filePath("a.txt"), root.filePath("b.txt"), 1);
+    require(result.success && result.ranges.size() == 3);
+    requireRange(result.ranges.at(0), Kind::Match, 0, 6, 0, 6);
+    requireRange(result.ranges.at(1), Kind::Inserted, 6, 0, 6, 7);
+    requireRange(result.ranges.at(2), Kind::Match, 6, 5, 13, 5);
+
+    // 数据块在旧文件中换了位置：两段都能匹配，只是旧文件偏移不连续
+    const QByteArray first = randomBytes(64 * 1024, 7);
+    const QByteArray second = randomBytes(64 * 1024, 8);
+    writeFile(root.filePath("ab.bin"), first + second);
+    writeFile(root.filePath("ba.bin"), second + first);
+    result = BinaryDiff::compare(root.filePath("ab.bin"), root.filePath("ba.bin"), 1);
+    require(result.success && result.ranges.size() == 2);
+    requireRange(result.ranges.at(0), Kind::Match, 64 * 1024, 64 * 1024, 0, 64 * 1024);
+    requireRange(result.ranges.at(1), Kind::Match, 0, 64 * 1024, 64 * 1024, 64 * 1024);
+
+    // 进度回调返回 false 时取消；文件不存在时报错
+    result = BinaryDiff::compare(root.filePath("old.bin"), root.filePath("new.bin"), 4, 0,
+                                 [](BinaryDiff::Stage, qint64, qint64) { return false; });
+    require(!result.success && result.canceled);
+    result = BinaryDiff::compare(root.filePath("missing"), root.filePath("new.bin"), 1);
+    require(!result.success && !result.canceled && !result.errorMessage.isEmpty());
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "../src/Blake3.h"
+
+#include <QByteArray>
+#include <QList>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+// BLAKE3 官方测试向量的输入：第 i 个字节为 i % 251
+QByteArray makeInput(qsizetype length)
+{
+    QByteArray input(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        input[i] = char(i % 251);
+    }
+    return input;
+}
+
+struct Vector {
+    qsizetype length;
+    const char *digest;
+};
+
+// 覆盖单分组、分块边界（1024）与多层合并（2049、3073、8193、31744 等）
+const Vector kVectors[] = {
+    {0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+    {1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+    {1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"},
+    {1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+    {1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+    {2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"},
+    {2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030"},
+    {3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2"},
+    {3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+    {4096, "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969"},
+    {4097, "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995"},
+    {8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+    {16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4"},
+    {31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+    {102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"},
+};
+
+void checkImplementation(const Blake3::Implementation &impl)
+{
+    for (const Vector &vector : kVectors) {
+        const QByteArray input = makeInput(vector.length);
+        const QByteArray expected = QByteArray::fromHex(vector.digest);
+
+        Blake3 whole(impl);
+        whole.addData(input);
+        require(whole.result() == expected);
+
+        // 分段输入的切分点与分块边界错开
+        for (qsizetype step : {1, 63, 64, 1000, 1024, 4097}) {
+            if (step > vector.length && vector.length > 0) {
+                continue;
+            }
+            Blake3 pieces(impl);
+            for (qsizetype offset = 0; offset < input.size(); offset += step) {
+                pieces.addData(input.constData() + offset, qMin(step, input.size() - offset));
+            }
+            require(pieces.result() == expected);
+        }
+    }
+}
+}
+
+int main()
+{
+    for (const Blake3::Implementation *impl : Blake3::available()) {
+        checkImplementation(*impl);
+    }
+
+    require(Blake3::hash("abc") == QByteArray::fromHex("6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85"));
+
+    // 多线程拆分子树与单线程结果一致，中途取结果不影响后续输入
+    const QByteArray large = makeInput(10 * 1024 * 1024 + 12345);
+    Blake3 serial;
+    serial.setParallel(false);
+    serial.addData(large);
+    Blake3 parallel;
+    require(parallel.isParallel());
+    parallel.addData(large.constData(), 3 * 1024 * 1024 + 7);
+    const QByteArray partial = parallel.result();
+    parallel.addData(large.constData() + 3 * 1024 * 1024 + 7, large.size() - 3 * 1024 * 1024 - 7);
+    require(parallel.result() == serial.result());
+    require(partial == Blake3::hash(large.left(3 * 1024 * 1024 + 7)));
+
+    Blake3 portable(Blake3::portable());
+    portable.setParallel(false);
+    portable.addData(large);
+    require(portable.result() == serial.result());
+
+    parallel.reset();
+    require(parallel.result() == QByteArray::fromHex(kVectors[0].digest));
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "../src/AESContext.h"
+#include "../src/SM4Context.h"
+
+#include <QByteArray>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+quint8 *bytes(QByteArray &data)
+{
+    return reinterpret_cast<quint8 *>(data.data());
+}
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+
+QByteArray hex(const char *text)
+{
+    return QByteArray::fromHex(text);
+}
+
+// 加密后解密回原文，覆盖原地与非原地两种调用
+void checkRoundTrip(const BlockCipherContext &context, const QByteArray &plaintext)
+{
+    const QByteArray iv = hex("000102030405060708090a0b0c0d0e0f");
+    const qsizetype padded = BlockCipherContext::paddedLength(plaintext.size());
+
+    QByteArray ecb = plaintext;
+    ecb.resize(padded);
+    require(context.encryptECB(bytes(ecb), plaintext.size(), bytes(ecb)) == padded);
+    QByteArray out(padded, Qt::Uninitialized);
+    require(context.encryptECB(bytes(plaintext), plaintext.size(), bytes(out)) == padded);
+    require(out == ecb);
+    require(context.decryptECB(bytes(ecb), padded, bytes(ecb)) == plaintext.size());
+    require(ecb.left(plaintext.size()) == plaintext);
+
+    QByteArray cbc = plaintext;
+    cbc.resize(padded);
+    require(context.encryptCBC(bytes(iv), bytes(cbc), plaintext.size(), bytes(cbc)) == padded);
+    require(context.decryptCBC(bytes(iv), bytes(cbc), padded, bytes(out)) == plaintext.size());
+    require(out.left(plaintext.size()) == plaintext);
+
+    QByteArray ctr = plaintext;
+    context.cryptCTR(bytes(iv), bytes(ctr), ctr.size(), bytes(ctr));
+    context.cryptCTR(bytes(iv), bytes(ctr), ctr.size(), bytes(ctr));
+    require(ctr == plaintext);
+}
+}
+
+int main()
+{
+    QByteArray out(160, Qt::Uninitialized);
+
+    // FIPS-197 附录 C.1，以及 SP 800-38A F.2.1 / F.5.1 的第一个分组
+    AESContext aes;
+    require(!aes.setKey(bytes(hex("000102")), 3));
+    require(aes.setKey(bytes(hex("000102030405060708090a0b0c0d0e0f")), 16));
+    aes.encryptBlocks(bytes(hex("00112233445566778899aabbccddeeff")), bytes(out), 1);
+    require(out.left(16) == hex("69c4e0d86a7b0430d8cdb78070b4c55a"));
+    aes.decryptBlocks(bytes(out), bytes(out), 1);
+    require(out.left(16) == hex("00112233445566778899aabbccddeeff"));
+
+    const QByteArray aesBlock = hex("6bc1bee22e409f96e93d7e117393172a");
+    require(aes.setKey(bytes(hex("2b7e151628aed2a6abf7158809cf4f3c")), 16));
+    require(aes.encryptCBC(bytes(hex("000102030405060708090a0b0c0d0e0f")), bytes(aesBlock), 16, bytes(out)) == 32);
+    require(out.left(16) == hex("7649abac8119b246cee98e9b12e9197d"));
+    aes.cryptCTR(bytes(hex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff")), bytes(aesBlock), 16, bytes(out));
+    require(out.left(16) == hex("874d6191b620e3261bef6864990db6ce"));
+
+    // 密钥不变时沿用缓存的轮密钥，换密钥后结果随之改变
+    const AESContext cached = aes;
+    require(aes.setKey(bytes(hex("2b7e151628aed2a6abf7158809cf4f3c")), 16));
+    aes.encryptBlocks(bytes(aesBlock), bytes(out), 1);
+    require(out.left(16) == hex("3ad77bb40d7a3660a89ecaf32466ef97"));
+    require(aes.setKey(bytes(hex("000102030405060708090a0b0c0d0e0f")), 16));
+    aes.encryptBlocks(bytes(aesBlock), bytes(out), 1);
+    require(out.left(16) != hex("3ad77bb40d7a3660a89ecaf32466ef97"));
+    cached.encryptBlocks(bytes(aesBlock), bytes(out), 1);
+    require(out.left(16) == hex("3ad77bb40d7a3660a89ecaf32466ef97"));
+
+    // GB/T 32907-2016 附录 A：单次加密，以及同一密钥连续加密 1000000 次
+    SM4Context sm4;
+    require(!sm4.setKey(bytes(hex("0123456789abcdef")), 8));
+    const QByteArray sm4Key = hex("0123456789abcdeffedcba9876543210");
+    require(sm4.setKey(bytes(sm4Key), 16));
+    sm4.encryptBlocks(bytes(sm4Key), bytes(out), 1);
+    require(out.left(16) == hex("681edf34d206965e86b3e94f536e4246"));
+    sm4.decryptBlocks(bytes(out), bytes(out), 1);
+    require(out.left(16) == sm4Key);
+
+    QByteArray iterated = sm4Key;
+    for (int i = 0; i < 1000000; ++i) {
+        sm4.encryptBlocks(bytes(iterated), bytes(iterated), 1);
+    }
+    require(iterated == hex("595298c7c6fd271f0402f804c33d3f66"));
+
+    // SM4-CBC / SM4-CTR（OpenSSL 生成），SM4-GCM（RFC 8998 附录 A.1）
+    const QByteArray sm4Plain = hex("aaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbccccccccccccccccdddddddddddddddd"
+                                    "eeeeeeeeeeeeeeeeffffffffffffffffeeeeeeeeeeeeeeeeaaaaaaaaaaaaaaaa");
+    const QByteArray sm4Iv = hex("000102030405060708090a0b0c0d0e0f");
+    require(sm4.encryptCBC(bytes(sm4Iv), bytes(sm4Plain), sm4Plain.size(), bytes(out)) == 80);
+    require(out.left(80) == hex("9554bcddf2d371452bffd93df8d461872360664050b1ae28e3e25ab2539ededb"
+                                 "ec17435cee4d9e7c413b774acf6ad121aa16d86ff8e97ed458e1746bfa7bb74c"
+                                 "bf45ec165f8b0fd62a2b84465bca03af"));
+    sm4.cryptCTR(bytes(sm4Iv), bytes(sm4Plain), sm4Plain.size(), bytes(out));
+    require(out.left(64) == hex("ac3236cb970cc20791364c395a1342d1a3cbc1878c6f30cd074cce385cdd70c7"
+                                 "f234bc0e24c11980fd1286310ce37b922a46b894bee4feb79a3822940c935405"));
+
+    const QByteArray gcmIv = hex("00001234567800000000abcd");
+    const QByteArray gcmAad = hex("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+    const QByteArray gcmCipher = hex("17f399f08c67d5ee19d0dc9969c4bb7d5fd46fd3756489069157b282bb200735"
+                                     "d82710ca5c22f0ccfa7cbf93d496ac15a56834cbcf98c397b4024a2691233b8d");
+    QByteArray tag(16, Qt::Uninitialized);
+    sm4.encryptGCM(bytes(gcmIv), gcmIv.size(), bytes(gcmAad), gcmAad.size(),
+                   bytes(sm4Plain), sm4Plain.size(), bytes(out), bytes(tag));
+    require(out.left(64) == gcmCipher);
+    require(tag == hex("83de3541e4c2b58177e065a9bf7b62ec"));
+
+    QByteArray opened = gcmCipher;
+    require(sm4.decryptGCM(bytes(gcmIv), gcmIv.size(), bytes(gcmAad), gcmAad.size(),
+                           bytes(opened), opened.size(), bytes(tag), tag.size(), bytes(opened)));
+    require(opened == sm4Plain);
+    tag[15] = char(tag[15] ^ 1);
+    opened = gcmCipher;
+    require(!sm4.decryptGCM(bytes(gcmIv), gcmIv.size(), bytes(gcmAad), gcmAad.size(),
+                            bytes(opened), opened.size(), bytes(tag), tag.size(), bytes(opened)));
+    require(opened == gcmCipher);
+
+    // 原地与非原地、填充边界
+    for (qsizetype length : {0, 1, 15, 16, 17, 31, 32, 100}) {
+        QByteArray plaintext(length, Qt::Uninitialized);
+        for (qsizetype i = 0; i < length; ++i) {
+            plaintext[i] = char(i * 31 + 7);
+        }
+        checkRoundTrip(aes, plaintext);
+        checkRoundTrip(sm4, plaintext);
+    }
+
+    // 长度不是分组整数倍或填充无效时返回 -1
+    QByteArray broken = hex("00112233445566778899aabbccddeeff");
+    require(sm4.decryptECB(bytes(broken), 15, bytes(out)) == -1);
+    require(sm4.decryptECB(bytes(broken), 0, bytes(out)) == -1);
+    broken.resize(16);
+    require(sm4.encryptECB(bytes(broken), 16, bytes(out)) == 32);
+    out[31] = char(out[31] ^ 0x5a);
+    require(sm4.decryptECB(bytes(out), 32, bytes(out)) == -1);
+    require(BlockCipherContext::pkcs7Unpad(bytes(hex("0102030405060708090a0b0c0d0e0f00")), 16) == -1);
+    require(BlockCipherContext::pkcs7Unpad(bytes(hex("0102030405060708090a0b0c0d0e0202")), 16) == 14);
+    require(BlockCipherContext::pkcs7Unpad(bytes(hex("0102030405060708090a0b0c0d0e0302")), 16) == -1);
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "../src/ChecksumManifest.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(content) == content.size());
+}
+}
+
+int main()
+{
+    // GNU 文本 / 二进制模式、转义文件名、BSD 格式、注释与格式错误的行
+    int malformed = -1;
+    QString bsdAlgorithm;
+    const QList<ChecksumManifest::Entry> parsed = ChecksumManifest::parse(
+        "# comment\n"
+        "d41d8cd98f00b204e9800998ecf8427e  empty.txt\r\n"
+        "900150983CD24FB0D6963F7D28E17F72 *bin/abc.dat\n"
+        "\\0cc175b9c0f1b6a831c399e269772661  back\\\\slash\\nname\n"
+        "\n"
+        "not a checksum line\n"
+        "MD5 (with space.txt) = 0cc175b9c0f1b6a831c399e269772661\n",
+        &malformed, &bsdAlgorithm);
+    require(malformed == 1);
+    require(bsdAlgorithm == "MD5");
+    require(parsed.size() == 4);
+    require(parsed[0].path == "empty.txt" && parsed[0].digest == "d41d8cd98f00b204e9800998ecf8427e");
+    require(parsed[1].path == "bin/abc.dat" && parsed[1].digest == "900150983cd24fb0d6963f7d28e17f72");
+    require(parsed[2].path == "back\\slash\nname");
+    require(parsed[3].path == "with space.txt");
+
+    // 写出的清单能原样读回，含反斜杠或换行的文件名按 coreutils 的规则转义
+    const QByteArray formatted = ChecksumManifest::format(parsed);
+    require(formatted.startsWith("d41d8cd98f00b204e9800998ecf8427e  empty.txt\n"));
+    require(formatted.contains("\\0cc175b9c0f1b6a831c399e269772661  back\\\\slash\\nname\n"));
+    const QList<ChecksumManifest::Entry> reparsed = ChecksumManifest::parse(formatted, &malformed);
+    require(malformed == 0 && reparsed.size() == parsed.size());
+    for (qsizetype i = 0; i < parsed.size(); ++i) {
+        require(reparsed[i].path == parsed[i].path && reparsed[i].digest == parsed[i].digest);
+    }
+
+    // 文件名含 " (" 与 ") = " 的 GNU 行不能被当成 BSD 格式，写出后能原样读回
+    const QList<ChecksumManifest::Entry> tricky = {{"photo (1) = x.jpg", "0cc175b9c0f1b6a831c399e269772661"}};
+    const QList<ChecksumManifest::Entry> trickyParsed = ChecksumManifest::parse(ChecksumManifest::format(tricky), &malformed);
+    require(malformed == 0 && trickyParsed.size() == 1);
+    require(trickyParsed[0].path == "photo (1) = x.jpg" && trickyParsed[0].digest == tricky[0].digest);
+
+    require(ChecksumManifest::algorithmForFile("a/SHA256SUMS.sha256") == "SHA256");
+    require(ChecksumManifest::algorithmForFile("files.md5sum") == "MD5");
+    require(ChecksumManifest::algorithmForFile("release.b3sum") == "BLAKE3");
+    require(ChecksumManifest::algorithmForFile("files.txt").isEmpty());
+    require(ChecksumManifest::algorithmForDigestLength(40) == "SHA1");
+    require(ChecksumManifest::algorithmForDigestLength(10).isEmpty());
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QDir root(dir.path());
+    require(root.mkpath("b/c"));
+    writeFile(root.filePath("z.txt"), "abc");
+    writeFile(root.filePath("a.txt"), "");
+    writeFile(root.filePath("b/c/deep.bin"), QByteArray(100000, 'x'));
+    writeFile(root.filePath("b/m.txt"), "a");
+    writeFile(root.filePath("list.md5"), "old");
+
+    // 同一目录的文件排在一起，子目录排在父目录的文件之后；清单自身不计入
+    const QStringList files = ChecksumManifest::collectFiles(dir.path(), root.filePath("list.md5"));
+    require(files == QStringList({"a.txt", "z.txt", "b/m.txt", "b/c/deep.bin"}));
+
+    QList<ChecksumManifest::Entry> entries;
+    for (const QString &file : files) {
+        entries.append({file, QByteArray()});
+    }
+    for (int threads : {1, 3}) {
+        std::atomic<int> calls(0);
+        const QList<ChecksumManifest::Check> checks = ChecksumManifest::hashFiles(
+            dir.path(), entries, "MD5", threads,
+            [&calls](const ChecksumManifest::Entry &, const ChecksumManifest::Check &) {
+                ++calls;
+                return true;
+            });
+        require(calls == 4 && checks.size() == 4);
+        require(checks[0].status == ChecksumManifest::Status::Ok);
+        require(checks[0].digest == "d41d8cd98f00b204e9800998ecf8427e");
+        require(checks[1].digest == "900150983cd24fb0d6963f7d28e17f72");
+        require(checks[2].digest == "0cc175b9c0f1b6a831c399e269772661");
+    }
+
+    // 校验：一致、不一致、缺失分别计数，结果与清单顺序一致
+    const QList<ChecksumManifest::Check> verified = ChecksumManifest::hashFiles(
+        dir.path(),
+        ChecksumManifest::parse("0cc175b9c0f1b6a831c399e269772661  b/m.txt\n"
+                                "00000000000000000000000000000000  z.txt\n"
+                                "0cc175b9c0f1b6a831c399e269772661  gone.txt\n"
+                                "d41d8cd98f00b204e9800998ecf8427e  a.txt\n"),
+        "MD5", 2);
+    require(verified.size() == 4);
+    require(verified[0].status == ChecksumManifest::Status::Ok);
+    require(verified[1].status == ChecksumManifest::Status::Mismatch);
+    require(verified[2].status == ChecksumManifest::Status::Missing);
+    require(verified[3].status == ChecksumManifest::Status::Ok);
+
+    // 回调返回 false 后不再派发剩余文件
+    const QList<ChecksumManifest::Check> stopped = ChecksumManifest::hashFiles(
+        dir.path(), entries, "MD5", 1,
+        [](const ChecksumManifest::Entry &, const ChecksumManifest::Check &) {
+            return false;
+        });
+    require(stopped[0].status == ChecksumManifest::Status::Ok);
+    require(stopped[3].status == ChecksumManifest::Status::Canceled);
+
+    // 调用者取消后正在读的文件也停下，不再调用回调
+    std::atomic<int> checkedAfterCancel(0);
+    const QList<ChecksumManifest::Check> canceled = ChecksumManifest::hashFiles(
+        dir.path(), entries, "MD5", 2,
+        [&checkedAfterCancel](const ChecksumManifest::Entry &, const ChecksumManifest::Check &) {
+            ++checkedAfterCancel;
+            return true;
+        },
+        []() { return true; });
+    require(checkedAfterCancel == 0);
+    for (const ChecksumManifest::Check &check : canceled) {
+        require(check.status == ChecksumManifest::Status::Canceled);
+    }
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include "../src/Crc32.h"
+#include "../src/XXH3.h"
+
+#include <QByteArray>
+#include <QList>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+// 第 i 个字节为 i % 251，与 BLAKE3 测试的输入相同
+QByteArray makeInput(qsizetype length)
+{
+    QByteArray input(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        input[i] = char(i % 251);
+    }
+    return input;
+}
+
+struct CrcVector {
+    qsizetype length;
+    quint32 ieee;
+    quint32 castagnoli;
+};
+
+// zlib.crc32 与逐位计算的 CRC-32C 生成
+const CrcVector kCrcVectors[] = {
+    {0, 0x00000000, 0x00000000},
+    {1, 0xd202ef8d, 0x527d5351},
+    {64, 0x100ece8c, 0xfb6d36eb},
+    {1000, 0x721746a6, 0x11f66220},
+    {4096, 0xd465f907, 0x719077fc},
+    {100000, 0xb353b8fa, 0x7247f66b},
+};
+
+struct XxhVector {
+    qsizetype length;
+    const char *hash64;
+    const char *hash128;
+};
+
+// python-xxhash 生成，覆盖每个长度区间的边界：1-3、4-8、9-16、17-128、129-240、长输入及其条带 / 1 KiB 块边界
+const XxhVector kXxhVectors[] = {
+    {0, "2d06800538d394c2", "99aa06d3014798d86001c324468d497f"},
+    {1, "c44bdff4074eecdb", "a6cd5e9392000f6ac44bdff4074eecdb"},
+    {3, "5f4299fc161c9cbb", "e3b55f57945a17cf5f4299fc161c9cbb"},
+    {4, "60dab036a58211f2", "eb70bf5fc779e9e6a6111d53e80a3db5"},
+    {8, "3a1c2d7c85af88f8", "e1e4432a62217fe4cfd50c61c8bb98c1"},
+    {9, "e9612598145bb9dc", "16c769d83e4aebce907931979dca3746"},
+    {16, "8355e3a6f61770db", "72950631827607e2842812cc870dcae2"},
+    {17, "9ef341a99de37328", "685bc458b37d057fc06e233df7729217"},
+    {128, "85c6174c7ff4c46b", "14792fc3af88dc6c05321a0b64d67b41"},
+    {129, "ec7642b431ba3e5a", "dd5e74ac6b45f54ebc30b63382b09a3b"},
+    {240, "375a384d957fe865", "65b5be86da5540e7c92b68e16f83bbb6"},
+    {241, "02e8cd95421c6d02", "1da1cb61bcb8a2a102e8cd95421c6d02"},
+    {256, "44f5d90dacde463a", "96c36c85d00e5bc544f5d90dacde463a"},
+    {257, "88fc3f7934a6c9be", "8c650dc0594ae28188fc3f7934a6c9be"},
+    {320, "8a1836a6cc02f09e", "5b6936509fe4670f8a1836a6cc02f09e"},
+    {1023, "d3d91d80ac495685", "4325711b0ed4d742d3d91d80ac495685"},
+    {1024, "e5d78bafa45b2aa5", "d0ac1f7b93bf57b9e5d78bafa45b2aa5"},
+    {1025, "e95c42288f28186e", "2882ebca04ec915ce95c42288f28186e"},
+    {1089, "a51e35ec282cb1d8", "bd054149e0f6660ea51e35ec282cb1d8"},
+    {16385, "fea38d9173737a4b", "7f1012a369696b6dfea38d9173737a4b"},
+    {1000003, "3bd135bb217f309d", "ff7880a76b3ad0273bd135bb217f309d"},
+};
+
+void checkCrc(Crc32::Variant variant)
+{
+    const QByteArray check("123456789");
+    const quint32 checkValue = variant == Crc32::Castagnoli ? 0xe3069283 : 0xcbf43926;
+    const QByteArray large = makeInput(100000);
+
+    for (const Crc32::Implementation *impl : Crc32::available(variant)) {
+        Crc32 crc(*impl);
+        crc.addData(check);
+        require(crc.value() == checkValue);
+        require(crc.result() == QByteArray::fromHex(variant == Crc32::Castagnoli ? "e3069283" : "cbf43926"));
+
+        for (const CrcVector &vector : kCrcVectors) {
+            const quint32 expected = variant == Crc32::Castagnoli ? vector.castagnoli : vector.ieee;
+            crc.reset();
+            crc.addData(large.constData(), vector.length);
+            require(crc.value() == expected);
+        }
+
+        // 任意起始对齐与长度都与查表法一致，分段输入与一次输入一致
+        for (qsizetype offset = 0; offset < 16; ++offset) {
+            for (qsizetype length : {0, 15, 16, 63, 64, 65, 127, 128, 200, 4099}) {
+                Crc32 hardware(*impl);
+                hardware.addData(large.constData() + offset, length);
+                Crc32 reference(Crc32::portable(variant));
+                reference.addData(large.constData() + offset, length);
+                require(hardware.value() == reference.value());
+            }
+        }
+        Crc32 pieces(*impl);
+        for (qsizetype offset = 0; offset < large.size(); offset += 777) {
+            pieces.addData(large.constData() + offset, qMin<qsizetype>(777, large.size() - offset));
+        }
+        require(pieces.value() == Crc32::checksum(variant, large));
+    }
+}
+
+void checkXxh3(const XXH3::Implementation &impl)
+{
+    const QByteArray input = makeInput(1000003);
+    for (const XxhVector &vector : kXxhVectors) {
+        const QByteArray data = input.left(vector.length);
+        XXH3 hash64(XXH3::Bits64, impl);
+        XXH3 hash128(XXH3::Bits128, impl);
+        hash64.addData(data);
+        hash128.addData(data);
+        require(hash64.result().toHex() == vector.hash64);
+        require(hash128.result().toHex() == vector.hash128);
+
+        // 切分点与条带、缓冲区、1 KiB 块边界错开；中途取结果不影响后续输入
+        for (qsizetype step : {1, 63, 64, 100, 255, 256, 257, 4000}) {
+            if (vector.length > 20000 && step < 64) {
+                continue;
+            }
+            XXH3 pieces(XXH3::Bits128, impl);
+            for (qsizetype offset = 0; offset < data.size(); offset += step) {
+                pieces.addData(data.constData() + offset, qMin(step, data.size() - offset));
+                if (offset == step) {
+                    pieces.result();
+                }
+            }
+            require(pieces.result().toHex() == vector.hash128);
+        }
+    }
+}
+}
+
+int main()
+{
+    checkCrc(Crc32::Ieee);
+    checkCrc(Crc32::Castagnoli);
+    for (const XXH3::Implementation *impl : XXH3::available()) {
+        checkXxh3(*impl);
+    }
+    require(XXH3::hash("").toHex() == "2d06800538d394c2");
+    require(XXH3::hash("", XXH3::Bits128).size() == 16);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "../src/DuplicateFinder.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(content) == content.size());
+}
+
+QByteArray pattern(qsizetype length, int seed)
+{
+    QByteArray data(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        data[i] = char(i * 131 + (i >> 9) + seed);
+    }
+    return data;
+}
+}
+
+int main()
+{
+    QTemporaryDir dir;
+    require(dir.isValid());
+    QDir root(dir.path());
+    require(root.mkpath("sub"));
+
+    // a 与 sub/b 完全相同；c 只有中间不同（首尾相同，要到第 3 步才排除）；d 开头不同；
+    // 小文件 s1 / s2 相同（第 2 步直接确认）；空文件被 minimumSize 排除
+    const QByteArray large = pattern(300 * 1024, 1);
+    QByteArray middle = large;
+    middle[150 * 1024] = char(middle[150 * 1024] ^ 1);
+    QByteArray head = large;
+    head[0] = char(head[0] ^ 1);
+    writeFile(root.filePath("a.bin"), large);
+    writeFile(root.filePath("sub/b.bin"), large);
+    writeFile(root.filePath("c.bin"), middle);
+    writeFile(root.filePath("d.bin"), head);
+    writeFile(root.filePath("s1.txt"), "same small content");
+    writeFile(root.filePath("sub/s2.txt"), "same small content");
+    writeFile(root.filePath("unique.txt"), "different length");
+    writeFile(root.filePath("empty1"), QByteArray());
+    writeFile(root.filePath("empty2"), QByteArray());
+#if defined(Q_OS_UNIX)
+    // 同一文件的硬链接不是可以删除的重复
+    require(::link(QFile::encodeName(root.filePath("a.bin")).constData(),
+                   QFile::encodeName(root.filePath("sub/a-link.bin")).constData()) == 0);
+#endif
+
+    const QList<DuplicateFinder::File> files = DuplicateFinder::collectFiles(dir.path());
+    require(files.constFirst().path == "a.bin");
+    for (const DuplicateFinder::File &file : files) {
+        require(file.size > 0);
+    }
+
+    for (int threads : {1, 4}) {
+        QStringList errors;
+        bool canceled = true;
+        int fullProcessed = 0;
+        const QList<DuplicateFinder::Group> groups = DuplicateFinder::find(
+            dir.path(), files, "SHA256", threads,
+            [&](DuplicateFinder::Stage stage, int, int total) {
+                if (stage == DuplicateFinder::Stage::Full) {
+                    fullProcessed = total;
+                }
+                return true;
+            },
+            &errors, &canceled);
+        require(!canceled && errors.isEmpty());
+        require(groups.size() == 2);
+        require(groups[0].paths == QStringList({"a.bin", "sub/b.bin"}));
+        require(groups[0].reclaimableBytes() == large.size());
+        require(groups[0].digest.size() == 64);
+        require(groups[1].paths == QStringList({"s1.txt", "sub/s2.txt"}));
+        // 只有首尾相同的 a、b、c 需要完整读取
+        require(fullProcessed == 3);
+    }
+
+    // 进度回调返回 false 时取消
+    bool canceled = false;
+    const QList<DuplicateFinder::Group> none = DuplicateFinder::find(
+        dir.path(), files, "SHA256", 2, [](DuplicateFinder::Stage, int, int) { return false; }, nullptr, &canceled);
+    require(canceled && none.isEmpty());
+
+    return 0;
+}
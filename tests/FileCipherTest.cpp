@@ -0,0 +1,186 @@
+#include "../src/AESBackend.h"
+#include "../src/FileCipher.h"
+#include "../src/GcmMode.h"
+#include "../src/ParallelBlockCipher.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+// 小分块，便于覆盖跨块的链接与计数器延续
+constexpr qsizetype kChunk = 4096;
+
+AESBackend::KeySchedule schedule;
+
+void encryptBlocks(const quint8 *in, quint8 *out, size_t blocks)
+{
+    AESBackend::encryptBlocks(schedule, in, out, blocks);
+}
+
+void decryptBlocks(const quint8 *in, quint8 *out, size_t blocks)
+{
+    AESBackend::decryptBlocks(schedule, in, out, blocks);
+}
+
+quint8 *bytes(QByteArray &data)
+{
+    return reinterpret_cast<quint8 *>(data.data());
+}
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+
+QByteArray pattern(qsizetype length)
+{
+    QByteArray data(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        data[i] = char(i * 167 + (i >> 8));
+    }
+    return data;
+}
+
+void writeFile(const QString &path, const QByteArray &data)
+{
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(data) == data.size());
+}
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    require(file.open(QIODevice::ReadOnly));
+    return file.readAll();
+}
+
+// 一次性处理整段数据的参照结果
+QByteArray referenceEncrypt(FileCipher::Mode mode, const QByteArray &iv, const QByteArray &plaintext, QByteArray *tag)
+{
+    if (mode == FileCipher::Mode::GCM) {
+        return GcmMode::encrypt(encryptBlocks, iv, QByteArray("header"), plaintext, tag);
+    }
+    QByteArray data = plaintext;
+    if (mode == FileCipher::Mode::CTR) {
+        ParallelBlockCipher::ctr(encryptBlocks, bytes(iv), bytes(data), bytes(data), data.size());
+        return data;
+    }
+
+    const int padLength = 16 - int(data.size() % 16);
+    data.append(QByteArray(padLength, char(padLength)));
+    if (mode == FileCipher::Mode::ECB) {
+        encryptBlocks(bytes(data), bytes(data), size_t(data.size() / 16));
+        return data;
+    }
+    QByteArray prev = iv;
+    for (qsizetype i = 0; i < data.size(); i += 16) {
+        for (int j = 0; j < 16; ++j) {
+            data[i + j] = char(data[i + j] ^ prev[j]);
+        }
+        encryptBlocks(bytes(data) + i, bytes(data) + i, 1);
+        prev = data.mid(i, 16);
+    }
+    return data;
+}
+
+FileCipher::Options makeOptions(FileCipher::Mode mode, bool encrypt, const QString &input, const QString &output)
+{
+    FileCipher::Options options;
+    options.mode = mode;
+    options.encrypt = encrypt;
+    options.encryptBlocks = encryptBlocks;
+    options.decryptBlocks = decryptBlocks;
+    options.iv = QByteArray::fromHex(mode == FileCipher::Mode::GCM ? "cafebabefacedbaddecaf888"
+                                                                   : "0001020304050607fffffffffffffffe");
+    options.aad = "header";
+    options.inputPath = input;
+    options.outputPath = output;
+    options.chunkSize = kChunk;
+    return options;
+}
+}
+
+int main()
+{
+    const QByteArray key = QByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+    require(AESBackend::expandKey(bytes(key), key.size(), &schedule));
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QString plainPath = dir.filePath("plain.bin");
+    const QString cipherPath = dir.filePath("cipher.bin");
+    const QString decryptedPath = dir.filePath("decrypted.bin");
+
+    const FileCipher::Mode modes[] = {
+        FileCipher::Mode::ECB, FileCipher::Mode::CBC, FileCipher::Mode::CTR, FileCipher::Mode::GCM,
+    };
+    const qsizetype lengths[] = {0, 1, 15, 16, 17, kChunk - 1, kChunk, kChunk + 1, kChunk * 3 + 5};
+
+    for (FileCipher::Mode mode : modes) {
+        for (qsizetype length : lengths) {
+            const QByteArray plaintext = pattern(length);
+            writeFile(plainPath, plaintext);
+
+            const FileCipher::Options encryptOptions = makeOptions(mode, true, plainPath, cipherPath);
+            qint64 lastProcessed = -1;
+            const FileCipher::Result encrypted = FileCipher::run(encryptOptions, [&](qint64 processed, qint64 total) {
+                require(processed > lastProcessed && processed <= total);
+                lastProcessed = processed;
+                return true;
+            });
+            require(encrypted.success);
+            require(lastProcessed == length);
+
+            QByteArray expectedTag;
+            const QByteArray expected = referenceEncrypt(mode, encryptOptions.iv, plaintext, &expectedTag);
+            require(readFile(cipherPath) == expected);
+            require(encrypted.bytesWritten == expected.size());
+            require(encrypted.tag == expectedTag);
+
+            FileCipher::Options decryptOptions = makeOptions(mode, false, cipherPath, decryptedPath);
+            decryptOptions.tag = encrypted.tag;
+            require(FileCipher::run(decryptOptions).success);
+            require(readFile(decryptedPath) == plaintext);
+        }
+    }
+
+    // 取消、认证失败、填充错误都不能留下输出文件
+    writeFile(plainPath, pattern(kChunk * 4));
+    QFile::remove(cipherPath);
+    const FileCipher::Result canceled = FileCipher::run(
+        makeOptions(FileCipher::Mode::CBC, true, plainPath, cipherPath),
+        [](qint64 processed, qint64) { return processed < kChunk * 2; });
+    require(canceled.canceled && !canceled.success);
+    require(!QFile::exists(cipherPath));
+
+    FileCipher::Options gcm = makeOptions(FileCipher::Mode::GCM, true, plainPath, cipherPath);
+    const FileCipher::Result sealed = FileCipher::run(gcm);
+    require(sealed.success);
+    gcm = makeOptions(FileCipher::Mode::GCM, false, cipherPath, decryptedPath);
+    gcm.tag = sealed.tag;
+    gcm.tag[0] = char(gcm.tag[0] ^ 1);
+    QFile::remove(decryptedPath);
+    const FileCipher::Result forged = FileCipher::run(gcm);
+    require(!forged.success && !forged.canceled && !forged.errorMessage.isEmpty());
+    require(!QFile::exists(decryptedPath));
+
+    // 把明文当作 CBC 密文解密：这组固定数据解出的末尾填充无效
+    const FileCipher::Result badPadding = FileCipher::run(
+        makeOptions(FileCipher::Mode::CBC, false, plainPath, decryptedPath));
+    require(!badPadding.success && !QFile::exists(decryptedPath));
+
+    require(!FileCipher::run(makeOptions(FileCipher::Mode::CTR, true, plainPath, plainPath)).success);
+    require(FileCipher::localPath("file:///tmp/a.bin") == "/tmp/a.bin");
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "../src/FileDigest.h"
+#include "../src/SM3.h"
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+#include <vector>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+QByteArray hex(const char *text)
+{
+    return QByteArray::fromHex(text);
+}
+}
+
+int main()
+{
+    // 跨越多个读缓冲区的输入
+    QByteArray large(3000000, 'a');
+    QBuffer buffer(&large);
+    require(buffer.open(QIODevice::ReadOnly));
+    std::unique_ptr<FileDigest> digest = FileDigest::create("sm3");
+    require(digest && digest->addDevice(&buffer));
+    require(digest->result() == hex("e40f06f533f5207a993b8cd44de7122f565a65781a014f3702e60cf94ab054bf"));
+
+    digest = FileDigest::create("SHA256");
+    require(digest != nullptr);
+    digest->addData("abc", 3);
+    require(digest->result() == hex("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    require(!FileDigest::create("CRC64"));
+
+    // 跨越多个预读块且不是块大小的整数倍
+    QByteArray mixed(FileDigest::kReadAheadBufferSize * 2 + 12345, Qt::Uninitialized);
+    for (qsizetype i = 0; i < mixed.size(); ++i) {
+        mixed[i] = char(i * 7 + (i >> 11));
+    }
+
+    // 只读一遍同时计算多个摘要，结果与逐个计算一致
+    const QList<QString> algorithms = {"MD5", "SHA256", "SM3", "BLAKE3", "CRC32C", "XXH128"};
+    std::vector<std::unique_ptr<FileDigest>> owners;
+    QList<FileDigest *> digests;
+    for (const QString &algorithm : algorithms) {
+        owners.push_back(FileDigest::create(algorithm));
+        digests.append(owners.back().get());
+    }
+    QBuffer mixedBuffer(&mixed);
+    require(mixedBuffer.open(QIODevice::ReadOnly));
+    require(FileDigest::addDevice(&mixedBuffer, digests));
+    for (qsizetype i = 0; i < algorithms.size(); ++i) {
+        std::unique_ptr<FileDigest> single = FileDigest::create(algorithms[i]);
+        single->addData(mixed.constData(), mixed.size());
+        require(digests[i]->result() == single->result());
+    }
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QString path = dir.filePath("mixed.bin");
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(mixed) == mixed.size());
+    file.close();
+
+    // hashFile：进度单调递增并以文件大小结束；进度回调返回 false 时取消且不给出摘要；文件不存在时报错
+    qint64 lastProcessed = 0;
+    FileDigest::FileResult result = FileDigest::hashFile(path, {"SM3"}, [&](qint64 processed, qint64 total) {
+        require(processed > lastProcessed && total == mixed.size());
+        lastProcessed = processed;
+        return true;
+    });
+    require(result.success && !result.canceled && lastProcessed == mixed.size());
+    require(result.digests.value(0) == SM3::hash(mixed));
+    result = FileDigest::hashFile(path, {"SM3"}, [](qint64, qint64) { return false; });
+    require(!result.success && result.canceled && result.digests.isEmpty());
+    result = FileDigest::hashFile(dir.filePath("missing.bin"), {"SM3"});
+    require(!result.success && !result.canceled && !result.errorMessage.isEmpty());
+
+    // 普通读取与内存映射两种方式结果相同，进度单调递增并以文件大小结束，进度回调返回 false 时取消
+    const QByteArray sha256 = QCryptographicHash::hash(mixed, QCryptographicHash::Sha256);
+    for (FileDigest::IoBackend backend : {FileDigest::IoBackend::Read, FileDigest::IoBackend::Map}) {
+        lastProcessed = 0;
+        result = FileDigest::hashFile(path, {"SM3", "MD5"}, [&](qint64 processed, qint64 total) {
+            require(processed > lastProcessed && total == mixed.size());
+            lastProcessed = processed;
+            return true;
+        }, backend);
+        require(result.success && lastProcessed == mixed.size() && result.bytesRead == mixed.size());
+        require(result.digests.size() == 2 && result.digests[0] == SM3::hash(mixed));
+        require(FileDigest::hashFile(path, {"SHA256"}, FileDigest::ProgressFunction(), backend).digests.value(0) == sha256);
+
+        result = FileDigest::hashFile(path, {"SM3"}, [](qint64, qint64) { return false; }, backend);
+        require(!result.success && result.canceled && result.digests.isEmpty());
+    }
+
+    return 0;
+}
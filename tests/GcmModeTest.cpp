@@ -0,0 +1,183 @@
+#include "../src/AESBackend.h"
+#include "../src/AESCrypto.h"
+#include "../src/GHash.h"
+#include "../src/GcmMode.h"
+#include "../src/SMCrypto.h"
+
+#include <QCoreApplication>
+#include <QRandomGenerator>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+struct Vector {
+    const char *key;
+    const char *iv;
+    const char *aad;
+    const char *plaintext;
+    const char *ciphertext;
+    const char *tag;
+};
+
+// McGrew & Viega《The Galois/Counter Mode of Operation》测试用例 2、3、4、6
+const Vector kAesVectors[] = {
+    {"00000000000000000000000000000000", "000000000000000000000000", "",
+     "00000000000000000000000000000000",
+     "0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf"},
+    {"feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "",
+     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+     "4d5c2af327cd64a62cf35abd2ba6fab4"},
+    {"feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+     "5bc94fbc3221a5db94fae95ae7121a47"},
+    {"feffe9928665731c6d6a8f9467308308",
+     "9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+     "feedfacedeadbeeffeedfacedeadbeefabaddad2",
+     "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+     "8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca701e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+     "619cc5aefffe0bfa462af43c1699d050"},
+};
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+
+void checkAesVectors()
+{
+    for (const Vector &vector : kAesVectors) {
+        const QByteArray key = QByteArray::fromHex(vector.key);
+        AESBackend::KeySchedule schedule;
+        require(AESBackend::expandKey(bytes(key), key.size(), &schedule));
+        const auto encrypt = [&schedule](const quint8 *in, quint8 *out, size_t blocks) {
+            AESBackend::encryptBlocks(schedule, in, out, blocks);
+        };
+
+        const QByteArray iv = QByteArray::fromHex(vector.iv);
+        const QByteArray aad = QByteArray::fromHex(vector.aad);
+        const QByteArray plaintext = QByteArray::fromHex(vector.plaintext);
+        const QByteArray ciphertext = QByteArray::fromHex(vector.ciphertext);
+        const QByteArray expectedTag = QByteArray::fromHex(vector.tag);
+
+        QByteArray tag;
+        require(GcmMode::encrypt(encrypt, iv, aad, plaintext, &tag) == ciphertext);
+        require(tag == expectedTag);
+
+        QByteArray decrypted;
+        require(GcmMode::decrypt(encrypt, iv, aad, ciphertext, tag, &decrypted));
+        require(decrypted == plaintext);
+        // 截断到 96 位的标签同样可以校验
+        require(GcmMode::decrypt(encrypt, iv, aad, ciphertext, tag.left(12), &decrypted));
+
+        // 篡改密文、AAD 或标签都必须拒绝，且不输出明文
+        QByteArray untouched("unchanged");
+        QByteArray tampered = ciphertext;
+        tampered[0] = char(tampered[0] ^ 1);
+        require(!GcmMode::decrypt(encrypt, iv, aad, tampered, tag, &untouched));
+        require(!GcmMode::decrypt(encrypt, iv, aad + "x", ciphertext, tag, &untouched));
+        QByteArray badTag = tag;
+        badTag[15] = char(badTag[15] ^ 0x80);
+        require(!GcmMode::decrypt(encrypt, iv, aad, ciphertext, badTag, &untouched));
+        require(!GcmMode::decrypt(encrypt, iv, aad, ciphertext, tag.left(8), &untouched));
+        require(untouched == "unchanged");
+    }
+}
+
+// 硬件实现与查表实现对任意长度输入的结果必须一致
+void checkGHashImplementations()
+{
+    QRandomGenerator random(2024);
+    for (int round = 0; round < 64; ++round) {
+        QByteArray hashKey(16, Qt::Uninitialized);
+        QByteArray data(random.bounded(600), Qt::Uninitialized);
+        random.fillRange(reinterpret_cast<quint32 *>(hashKey.data()), 4);
+        for (char &c : data) {
+            c = char(random.bounded(256));
+        }
+
+        GHash hardware(bytes(hashKey));
+        GHash table(bytes(hashKey), false);
+        hardware.update(bytes(data), data.size());
+        table.update(bytes(data), data.size());
+
+        quint8 a[16];
+        quint8 b[16];
+        hardware.finish(7, quint64(data.size()), a);
+        table.finish(7, quint64(data.size()), b);
+        require(std::memcmp(a, b, 16) == 0);
+    }
+}
+
+// 经由界面对象的 AES-GCM：向量由 OpenSSL EVP_aes_128_gcm 生成
+void checkAesCrypto()
+{
+    const QString plaintext = QString::fromUtf8("Honeycomb AES-GCM 蜂巢工具箱 0123456789");
+    const QString ciphertext = "db03c9ab1f78983929f220cf658e374bfe06f27ad1084a54039654c891f345c23484ebc6c6b383d676c331de";
+
+    AESCrypto aes;
+    aes.setKeySize("128");
+    aes.setMode("GCM");
+    aes.setKey("000102030405060708090a0b0c0d0e0f");
+    aes.setIv("000102030405060708090a0b");
+    aes.setAad("feedfacedeadbeef");
+
+    aes.setInputText(plaintext);
+    aes.encrypt();
+    require(aes.result() == ciphertext);
+    require(aes.tag() == "a2a19ef3859307dbebfe4976b1e7980b");
+
+    aes.setInputText(ciphertext);
+    aes.decrypt();
+    require(aes.result() == plaintext);
+
+    bool rejected = false;
+    QObject::connect(&aes, &AESCrypto::errorOccurred, [&rejected](const QString &) { rejected = true; });
+    aes.setAad("feedfacedeadbeee");
+    aes.decrypt();
+    require(rejected);
+}
+
+// 经由界面对象的 SM4-GCM：检验 AAD 与标签的输出和校验流程
+void checkSm4Crypto()
+{
+    const QString plaintext = QString::fromUtf8("Honeycomb SM4-GCM 蜂巢工具箱 0123456789");
+
+    SMCrypto sm4;
+    sm4.setAlgorithm("SM4");
+    sm4.setMode("GCM");
+    sm4.setKey("000102030405060708090a0b0c0d0e0f");
+    sm4.setIv("000102030405060708090a0b");
+    sm4.setAad("feedfacedeadbeef");
+
+    sm4.setInputText(plaintext);
+    sm4.sm4Encrypt();
+    require(sm4.result() == "df29b09eb009ea6d9dbc2700e596be256cb7e957b3eca255125f67a98769697f3ac26e8c5d5f19bc1caea317");
+    require(sm4.tag() == "9dd401a44b6a6e68e2fe71d1ccc7506c");
+
+    sm4.setInputText(sm4.result());
+    sm4.sm4Decrypt();
+    require(sm4.result() == plaintext);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    checkAesVectors();
+    checkGHashImplementations();
+    checkAesCrypto();
+    checkSm4Crypto();
+
+    return 0;
+}
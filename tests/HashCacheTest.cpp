@@ -0,0 +1,77 @@
+#include "../src/FileDigest.h"
+#include "../src/HashCache.h"
+#include "../src/SM3.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+void writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    require(file.open(QIODevice::WriteOnly));
+    require(file.write(content) == content.size());
+}
+}
+
+int main()
+{
+    QTemporaryDir dir;
+    require(dir.isValid());
+    QByteArray data(FileDigest::kReadAheadBufferSize + 12345, Qt::Uninitialized);
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 7 + (i >> 11));
+    }
+    const QString path = dir.filePath("data.bin");
+    writeFile(path, data);
+
+    // 第二次计算直接命中；算法顺序不同也能命中，缺少任一算法或强制重算时重新读取
+    const QString cachePath = dir.filePath("cache/hash-cache.bin");
+    FileDigest::FileResult result;
+    {
+        HashCache cache(cachePath);
+        result = FileDigest::hashFile(path, {"SM3", "MD5"}, &cache, false);
+        require(result.success && !result.cached && result.digests[0] == SM3::hash(data));
+        // 写入只改内存，flush() 时才保存到文件，析构时保存剩下的修改
+        require(!QFile::exists(cachePath) && cache.flush() && QFile::exists(cachePath));
+        result = FileDigest::hashFile(path, {"MD5", "SM3"}, &cache, false);
+        require(result.success && result.cached && result.digests[1] == SM3::hash(data));
+        result = FileDigest::hashFile(path, {"SM3", "SHA1"}, &cache, false);
+        require(result.success && !result.cached);
+        result = FileDigest::hashFile(path, {"SHA1"}, &cache, true);
+        require(result.success && !result.cached);
+    }
+
+    // 重新打开缓存文件后仍然有效，包括析构时才保存的算法
+    HashCache reopened(cachePath);
+    require(reopened.size() == 1);
+    result = FileDigest::hashFile(path, {"SHA1", "MD5", "SM3"}, &reopened, false);
+    require(result.success && result.cached && result.digests[2] == SM3::hash(data));
+
+    // 文件改动后失效
+    writeFile(path, "abc");
+    result = FileDigest::hashFile(path, {"SM3"}, &reopened, false);
+    require(result.success && !result.cached && result.digests[0] == SM3::hash("abc"));
+
+    // 超过上限时淘汰最久未用的条目
+    reopened.setMaxEntries(2);
+    for (const char *name : {"a.txt", "b.txt", "c.txt"}) {
+        writeFile(dir.filePath(name), name);
+        require(FileDigest::hashFile(dir.filePath(name), {"MD5"}, &reopened, false).success);
+    }
+    require(reopened.size() <= 2);
+    require(FileDigest::hashFile(dir.filePath("c.txt"), {"MD5"}, &reopened, false).cached);
+    require(!FileDigest::hashFile(dir.filePath("a.txt"), {"MD5"}, &reopened, false).cached);
+
+    return 0;
+}
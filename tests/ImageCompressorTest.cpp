@@ -0,0 +1,152 @@
+#include "../src/ImageCompressor.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QTemporaryDir>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+// 渐变图案，避免纯色图片被编码得过小
+QImage testImage(int width, int height)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixel(x, y, qRgb(x % 256, y % 256, (x + y) % 256));
+        }
+    }
+    return image;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    // 图片格式插件通过 QCoreApplication 加载
+    QCoreApplication app(argc, argv);
+
+    const QImageIOHandler::Transformations none = QImageIOHandler::TransformationNone;
+    const QImageIOHandler::Transformations rotate = QImageIOHandler::TransformationRotate90;
+    require(ImageCompressor::scaledDecodeSize(QSize(4000, 3000), none, 1920, 1080) == QSize(1440, 1080));
+    require(!ImageCompressor::scaledDecodeSize(QSize(1000, 800), none, 1920, 1080).isValid());
+    require(!ImageCompressor::scaledDecodeSize(QSize(4000, 3000), none, 0, 1080).isValid());
+    require(!ImageCompressor::scaledDecodeSize(QSize(), none, 1920, 1080).isValid());
+    // 竖拍照片存储为横向，旋转后是 3000 × 4000，应缩到 810 × 1080，即解码为 1080 × 810
+    require(ImageCompressor::scaledDecodeSize(QSize(4000, 3000), rotate, 1920, 1080) == QSize(1080, 810));
+    require(!ImageCompressor::scaledDecodeSize(QSize(1000, 1900), rotate, 1920, 1080).isValid());
+    require(ImageCompressor::scaledDecodeSize(QSize(100000, 10), none, 100, 100) == QSize(100, 1));
+
+    QTemporaryDir dir;
+    require(dir.isValid());
+    const QDir root(dir.path());
+    const QImage source = testImage(1600, 1200);
+
+    // JPEG 解码时直接缩放，输出目录自动创建
+    require(source.save(root.filePath("photo.jpg"), "jpeg", 95));
+    ImageCompressor::Options options;
+    options.format = "jpeg";
+    options.quality = 70;
+    options.maxWidth = 400;
+    options.maxHeight = 400;
+    ImageCompressor::Result result = ImageCompressor::compress(root.filePath("photo.jpg"), root.filePath("out/photo.jpg"), options);
+    require(result.success && result.originalSize == QSize(1600, 1200) && result.outputSize == QSize(400, 300));
+    require(result.inputBytes == QFileInfo(root.filePath("photo.jpg")).size());
+    require(result.outputBytes > 0 && result.outputBytes == QFileInfo(root.filePath("out/photo.jpg")).size());
+    require(QImage(root.filePath("out/photo.jpg")).size() == QSize(400, 300));
+
+    QImageReader reader(root.filePath("photo.jpg"));
+    QSize originalSize;
+    require(ImageCompressor::read(reader, 100, 100, &originalSize).size() == QSize(100, 75));
+    require(originalSize == QSize(1600, 1200));
+
+    // PNG 不支持缩放解码，由 QImageReader 解码后缩小；不限制尺寸时保持原样
+    require(source.save(root.filePath("photo.png"), "png"));
+    options.format = "png";
+    result = ImageCompressor::compress(root.filePath("photo.png"), root.filePath("photo_small.png"), options);
+    require(result.success && result.outputSize == QSize(400, 300));
+    options.maxWidth = 0;
+    result = ImageCompressor::compress(root.filePath("photo.png"), root.filePath("photo_full.png"), options);
+    require(result.success && result.outputSize == QSize(1600, 1200));
+
+    // 不是图片的文件
+    QFile text(root.filePath("notes.jpg"));
+    require(text.open(QIODevice::WriteOnly) && text.write("not an image") > 0);
+    text.close();
+    result = ImageCompressor::compress(root.filePath("notes.jpg"), root.filePath("notes_out.jpg"), options);
+    require(!result.success && !result.errorMessage.isEmpty() && !QFileInfo::exists(root.filePath("notes_out.jpg")));
+
+    // 批量输入：文件夹或通配符
+    QString inputRoot;
+    QString pattern;
+    require(ImageCompressor::parseInput(root.path(), &inputRoot, &pattern) && pattern.isEmpty());
+    require(ImageCompressor::parseInput(root.filePath("**/*.JPG"), &inputRoot, &pattern));
+    require(QDir(inputRoot) == root && pattern == "**/*.JPG");
+    require(!ImageCompressor::parseInput(root.filePath("missing/*.jpg"), &inputRoot, &pattern));
+
+    // 子目录、大小写不同的扩展名、换扩展名后重名的文件与不是图片的文件
+    require(root.mkpath("album/2024"));
+    const QImage small = testImage(640, 480);
+    require(small.save(root.filePath("album/a.jpg"), "jpeg"));
+    require(small.save(root.filePath("album/a.png"), "png"));
+    require(small.save(root.filePath("album/2024/b.JPG"), "jpeg"));
+    require(small.save(root.filePath("album/2024/c.png"), "png"));
+    QFile broken(root.filePath("album/2024/broken.jpg"));
+    require(broken.open(QIODevice::WriteOnly) && broken.write("not an image") > 0);
+    broken.close();
+    QFile readme(root.filePath("album/readme.txt"));
+    require(readme.open(QIODevice::WriteOnly) && readme.write("text") > 0);
+    readme.close();
+
+    const QString album = root.filePath("album");
+    const QStringList all = ImageCompressor::collectImages(album, QString());
+    require(all == QStringList({"2024/b.JPG", "2024/broken.jpg", "2024/c.png", "a.jpg", "a.png"}));
+    require(ImageCompressor::collectImages(album, "*.jpg") == QStringList({"a.jpg"}));
+    require(ImageCompressor::collectImages(album, "**/*.jpg") == QStringList({"2024/b.JPG", "2024/broken.jpg", "a.jpg"}));
+    require(ImageCompressor::collectImages(album, "2024/[!b]*") == QStringList({"2024/c.png"}));
+
+    options.format = "jpeg";
+    options.maxWidth = 320;
+    options.maxHeight = 320;
+    const QString outputRoot = root.filePath("album_compressed");
+    bool canceled = true;
+    int reported = 0;
+    const QList<ImageCompressor::BatchItem> items = ImageCompressor::compressAll(
+        album, all, outputRoot, options, 3,
+        [&reported](const ImageCompressor::BatchItem &, int processed, int total) {
+            require(processed >= 1 && processed <= total && total == 5);
+            ++reported;
+            return true;
+        },
+        &canceled);
+    require(!canceled && reported == 5 && items.size() == 5);
+    const QStringList outputs = {"2024/b.jpg", "2024/broken.jpg", "2024/c.jpg", "a.jpg", "a_png.jpg"};
+    for (qsizetype i = 0; i < items.size(); ++i) {
+        const ImageCompressor::BatchItem &item = items.at(i);
+        require(item.path == all.at(i) && item.outputPath == outputs.at(i));
+        if (item.path.endsWith("broken.jpg")) {
+            require(!item.result.success && !QFileInfo::exists(QDir(outputRoot).filePath(item.outputPath)));
+            continue;
+        }
+        require(item.result.success && item.result.outputSize == QSize(320, 240));
+        require(QImage(QDir(outputRoot).filePath(item.outputPath)).size() == QSize(320, 240));
+    }
+
+    // 取消后不再处理剩下的文件
+    const QList<ImageCompressor::BatchItem> partial = ImageCompressor::compressAll(
+        album, all, root.filePath("canceled"), options, 1,
+        [](const ImageCompressor::BatchItem &, int, int) { return false; }, &canceled);
+    require(canceled && partial.size() == 1 && partial.constFirst().path == all.constFirst());
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "../src/MultiBufferHash.h"
+#include "../src/SM3.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QList>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+// 长度各不相同，保证各通道在不同时刻结束、换上新消息；覆盖 55/56/64 字节的填充边界
+QList<QByteArray> makeMessages()
+{
+    QList<QByteArray> messages;
+    for (int length = 0; length <= 200; ++length) {
+        QByteArray message(length, Qt::Uninitialized);
+        for (int i = 0; i < length; ++i) {
+            message[i] = char(i * 37 + length);
+        }
+        messages.append(message);
+    }
+    messages.append(QByteArray(1000, 'x'));
+    messages.append(QByteArray(4096, 'y'));
+    messages.append("abc");
+    return messages;
+}
+
+void checkImplementation(const MultiBufferHash::Implementation &impl, const QList<QByteArray> &messages)
+{
+    QByteArray digests(messages.size() * MultiBufferHash::kDigestLength, Qt::Uninitialized);
+    quint8 *out = reinterpret_cast<quint8 *>(digests.data());
+
+    MultiBufferHash::hashMany(MultiBufferHash::Sm3, messages.constData(), messages.size(), out, impl);
+    for (qsizetype i = 0; i < messages.size(); ++i) {
+        require(digests.mid(i * 32, 32) == SM3::hash(messages[i]));
+    }
+
+    MultiBufferHash::hashMany(MultiBufferHash::Sha256, messages.constData(), messages.size(), out, impl);
+    for (qsizetype i = 0; i < messages.size(); ++i) {
+        require(digests.mid(i * 32, 32) == QCryptographicHash::hash(messages[i], QCryptographicHash::Sha256));
+    }
+
+    // 消息数少于通道数时其余通道空转
+    MultiBufferHash::hashMany(MultiBufferHash::Sha256, messages.constData() + 3, 1, out, impl);
+    require(digests.left(32) == QCryptographicHash::hash(messages[3], QCryptographicHash::Sha256));
+}
+}
+
+int main()
+{
+    const QList<QByteArray> messages = makeMessages();
+    for (const MultiBufferHash::Implementation *impl : MultiBufferHash::available()) {
+        checkImplementation(*impl, messages);
+    }
+
+    // GB/T 32905 与 FIPS 180-2 的 "abc" 示例
+    const QList<QByteArray> abc = {"abc", "abc"};
+    const QList<QByteArray> sm3 = MultiBufferHash::hashMany(MultiBufferHash::Sm3, abc);
+    require(sm3.size() == 2 && sm3[1] == QByteArray::fromHex("66c7f0f462eeedd9d1f2d46bdc10e4e24167c4875cf2f7a2297da02b8f4ba8e0"));
+    const QList<QByteArray> sha256 = MultiBufferHash::hashMany(MultiBufferHash::Sha256, abc);
+    require(sha256[0] == QByteArray::fromHex("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    require(MultiBufferHash::hashMany(MultiBufferHash::Sm3, QList<QByteArray>()).isEmpty());
+
+    return 0;
+}
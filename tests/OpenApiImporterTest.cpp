@@ -0,0 +1,99 @@
+#include "../src/OpenApiImporter.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QByteArray yaml = R"(
+openapi: 3.0.3
+info:
+  title: Pets
+  version: "1"
+servers:
+  - url: https://api.example.test/v1
+paths:
+  /pets/{petId}:
+    get:
+      responses:
+        '404':
+          description: missing
+        '200':
+          description: ok
+          content:
+            application/json:
+              schema:
+                $ref: '#/components/schemas/Pet'
+    delete:
+      responses:
+        '204':
+          description: deleted
+components:
+  schemas:
+    Pet:
+      type: object
+      properties:
+        id:
+          type: integer
+          minimum: 1
+        name:
+          type: string
+          example: Rex
+        owner:
+          $ref: '#/components/schemas/Owner'
+    Owner:
+      type: object
+      properties:
+        pets:
+          type: array
+          items:
+            $ref: '#/components/schemas/Pet'
+)";
+
+    const OpenApiImporter::Result result = OpenApiImporter::importData(yaml);
+    require(result.success);
+    require(result.title == "Pets");
+    require(result.routes.size() == 2);
+
+    const QVariantMap get = result.routes.at(0).toMap();
+    require(get["path"].toString() == "/v1/pets/{petId}");
+    require(get["methods"].toList() == QVariantList{"GET"});
+    require(get["statusCode"].toInt() == 200);
+    require(get["contentType"].toString() == "application/json");
+
+    const QJsonObject body = QJsonDocument::fromJson(get["responseBody"].toString().toUtf8()).object();
+    require(body["id"].toInt() == 1);
+    require(body["name"].toString() == "Rex");
+    require(body["owner"].toObject()["pets"].isArray());
+
+    const QVariantMap remove = result.routes.at(1).toMap();
+    require(remove["methods"].toList() == QVariantList{"DELETE"});
+    require(remove["statusCode"].toInt() == 204);
+    require(remove["responseBody"].toString().isEmpty());
+
+    require(!OpenApiImporter::importData("[1, 2, 3]").success);
+    // 已解析的 JSON 文档直接转换；普通配置对象不是规范
+    const QJsonObject swagger = QJsonDocument::fromJson(
+        R"({"swagger": "2.0", "basePath": "/api", "paths": {"/ping": {"get": {"responses": {"200": {}}}}}})").object();
+    const OpenApiImporter::Result document = OpenApiImporter::importDocument(swagger);
+    require(document.success && document.routes.size() == 1);
+    require(document.routes.at(0).toMap()["path"].toString() == "/api/ping");
+    require(!OpenApiImporter::importDocument(QJsonObject{{"port", 8080}, {"routes", QJsonArray()}}).success);
+
+    return 0;
+}
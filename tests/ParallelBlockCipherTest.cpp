@@ -0,0 +1,134 @@
+#include "../src/AESBackend.h"
+#include "../src/ParallelBlockCipher.h"
+
+#include <QByteArray>
+#include <QThreadPool>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+AESBackend::KeySchedule schedule;
+
+void encryptBlocks(const quint8 *in, quint8 *out, size_t blocks)
+{
+    AESBackend::encryptBlocks(schedule, in, out, blocks);
+}
+
+void decryptBlocks(const quint8 *in, quint8 *out, size_t blocks)
+{
+    AESBackend::decryptBlocks(schedule, in, out, blocks);
+}
+
+quint8 *bytes(QByteArray &data)
+{
+    return reinterpret_cast<quint8 *>(data.data());
+}
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+
+QByteArray pattern(qsizetype length)
+{
+    QByteArray data(length, Qt::Uninitialized);
+    for (qsizetype i = 0; i < length; ++i) {
+        data[i] = char(i * 131 + (i >> 9));
+    }
+    return data;
+}
+
+// 逐块串行实现，作为并行结果的参照
+QByteArray serialCbcDecrypt(const quint8 *iv, const QByteArray &ciphertext)
+{
+    QByteArray plaintext(ciphertext.size(), Qt::Uninitialized);
+    const quint8 *prev = iv;
+    for (qsizetype i = 0; i < ciphertext.size(); i += 16) {
+        decryptBlocks(bytes(ciphertext) + i, bytes(plaintext) + i, 1);
+        for (int j = 0; j < 16; ++j) {
+            plaintext[i + j] = char(plaintext[i + j] ^ prev[j]);
+        }
+        prev = bytes(ciphertext) + i;
+    }
+    return plaintext;
+}
+
+QByteArray serialCtr(const quint8 *iv, const QByteArray &input, int counterBytes = 16)
+{
+    QByteArray output = input;
+    quint8 counter[16];
+    std::memcpy(counter, iv, 16);
+    for (qsizetype i = 0; i < input.size(); i += 16) {
+        quint8 keystream[16];
+        encryptBlocks(counter, keystream, 1);
+        for (qsizetype j = 0; j < 16 && i + j < input.size(); ++j) {
+            output[i + j] = char(output[i + j] ^ keystream[j]);
+        }
+        for (int k = 15; k >= 16 - counterBytes && ++counter[k] == 0; --k) {
+        }
+    }
+    return output;
+}
+}
+
+int main()
+{
+    // 单核机器上也强制切分成多段，覆盖段边界处理
+    QThreadPool::globalInstance()->setMaxThreadCount(4);
+
+    const QByteArray key = QByteArray::fromHex("000102030405060708090a0b0c0d0e0f");
+    require(AESBackend::expandKey(bytes(key), key.size(), &schedule));
+
+    // 低 64 位 / 低 32 位即将溢出，检验进位与回绕
+    const QByteArray ivs[] = {
+        QByteArray::fromHex("0f0e0d0c0b0a09080706050403020100"),
+        QByteArray::fromHex("0001020304050607fffffffffffffff0"),
+        QByteArray::fromHex("000102030405060708090a0bfffffff0"),
+    };
+
+    const qsizetype chunk = ParallelBlockCipher::kMinChunkBytes;
+    const qsizetype lengths[] = {0, 16, 4096, chunk, chunk * 3 + 48, chunk * 9};
+
+    for (qsizetype length : lengths) {
+        const QByteArray plaintext = pattern(length);
+
+        QByteArray ecb = plaintext;
+        ParallelBlockCipher::ecb(encryptBlocks, bytes(ecb), bytes(ecb), ecb.size());
+        QByteArray expected = plaintext;
+        encryptBlocks(bytes(expected), bytes(expected), size_t(length / 16));
+        require(ecb == expected);
+        ParallelBlockCipher::ecb(decryptBlocks, bytes(ecb), bytes(ecb), ecb.size());
+        require(ecb == plaintext);
+
+        for (const QByteArray &iv : ivs) {
+            QByteArray cbcPlain(length, Qt::Uninitialized);
+            ParallelBlockCipher::cbcDecrypt(decryptBlocks, bytes(iv), bytes(plaintext), bytes(cbcPlain), length);
+            require(cbcPlain == serialCbcDecrypt(bytes(iv), plaintext));
+
+            // CTR 同时覆盖不足一个分组的尾部
+            for (qsizetype ctrLength : {length, length + 7}) {
+                const QByteArray input = pattern(ctrLength);
+                QByteArray ctr(ctrLength, Qt::Uninitialized);
+                ParallelBlockCipher::ctr(encryptBlocks, bytes(iv), bytes(input), bytes(ctr), ctrLength);
+                require(ctr == serialCtr(bytes(iv), input));
+                ParallelBlockCipher::ctr(encryptBlocks, bytes(iv), bytes(ctr), bytes(ctr), ctrLength);
+                require(ctr == input);
+
+                // GCM 的 inc32：只在低 32 位内回绕
+                ParallelBlockCipher::ctr(encryptBlocks, bytes(iv), bytes(input), bytes(ctr), ctrLength,
+                                         ParallelBlockCipher::Counter::Low32);
+                require(ctr == serialCtr(bytes(iv), input, 4));
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "../src/SM3.h"
+
+#include <QByteArray>
+
+#include <cstdlib>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+QByteArray hex(const char *text)
+{
+    return QByteArray::fromHex(text);
+}
+}
+
+int main()
+{
+    // GB/T 32905-2016 附录 A 的两个示例，以及空消息
+    require(SM3::hash("abc") == hex("66c7f0f462eeedd9d1f2d46bdc10e4e24167c4875cf2f7a2297da02b8f4ba8e0"));
+    require(SM3::hash(QByteArray("abcd").repeated(16))
+            == hex("debe9ff92275b8a138604889c18e5a4d6fdb70e5387e5765293dcba39c0c5732"));
+    require(SM3::hash(QByteArray()) == hex("1ab21d8355cfa17f8e61194831e81a8f22bec8c728fefb747ed035eb5082aa2b"));
+
+    // 任意切分的分段输入与一次性输入一致，覆盖 55/56/64 字节等填充边界
+    QByteArray message(300, Qt::Uninitialized);
+    for (qsizetype i = 0; i < message.size(); ++i) {
+        message[i] = char(i * 131 + 17);
+    }
+    for (qsizetype length : {0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 300}) {
+        const QByteArray expected = SM3::hash(message.left(length));
+        for (qsizetype split = 0; split <= length; ++split) {
+            SM3 sm3;
+            sm3.addData(message.constData(), split);
+            sm3.addData(message.constData() + split, length - split);
+            require(sm3.result() == expected);
+        }
+        for (qsizetype step : {1, 7, 64, 65}) {
+            SM3 sm3;
+            for (qsizetype offset = 0; offset < length; offset += step) {
+                sm3.addData(message.constData() + offset, qMin(step, length - offset));
+            }
+            require(sm3.result() == expected);
+        }
+    }
+
+    // result() 不改变状态，之后可以继续输入；reset() 回到初始状态
+    SM3 sm3;
+    sm3.addData("ab", 2);
+    require(sm3.result() == SM3::hash("ab"));
+    sm3.addData("c", 1);
+    require(sm3.result() == SM3::hash("abc"));
+    sm3.reset();
+    require(sm3.result() == SM3::hash(QByteArray()));
+
+    return 0;
+}
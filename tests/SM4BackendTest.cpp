@@ -0,0 +1,92 @@
+#include "../src/SM4Backend.h"
+
+#include <QByteArray>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void require(bool condition)
+{
+    if (!condition) {
+        std::abort();
+    }
+}
+
+const quint8 *bytes(const QByteArray &data)
+{
+    return reinterpret_cast<const quint8 *>(data.constData());
+}
+
+// 把同一个分组复制 copies 份，使多分组实现走完整的并行路径
+void fill(quint8 *buffer, const QByteArray &block, int copies)
+{
+    for (int i = 0; i < copies; ++i) {
+        std::memcpy(buffer + i * 16, block.constData(), 16);
+    }
+}
+
+bool allEqual(const quint8 *buffer, const QByteArray &block, int copies)
+{
+    for (int i = 0; i < copies; ++i) {
+        if (std::memcmp(buffer + i * 16, block.constData(), 16) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+int main()
+{
+    const QList<const SM4Backend::Implementation *> backends = SM4Backend::available();
+    require(!backends.isEmpty());
+    require(backends.contains(&SM4Backend::active()));
+
+    // GB/T 32907-2016 附录 A 示例 1 与示例 2
+    const QByteArray key = QByteArray::fromHex("0123456789abcdeffedcba9876543210");
+    const QByteArray once = QByteArray::fromHex("681edf34d206965e86b3e94f536e4246");
+    const QByteArray million = QByteArray::fromHex("595298c7c6fd271f0402f804c33d3f66");
+
+    quint32 encKeys[SM4Backend::kRounds];
+    quint32 decKeys[SM4Backend::kRounds];
+    SM4Backend::expandKey(bytes(key), encKeys);
+    for (int i = 0; i < SM4Backend::kRounds; ++i) {
+        decKeys[i] = encKeys[SM4Backend::kRounds - 1 - i];
+    }
+
+    for (const SM4Backend::Implementation *backend : backends) {
+        constexpr int kCopies = 16;
+        quint8 buffer[16 * kCopies];
+        fill(buffer, key, kCopies);
+        backend->crypt(encKeys, buffer, buffer, kCopies);
+        require(allEqual(buffer, once, kCopies));
+        backend->crypt(decKeys, buffer, buffer, kCopies);
+        require(allEqual(buffer, key, kCopies));
+
+        // 可移植实现只算一份，多分组实现一次 8 份
+        const int copies = backend == &SM4Backend::portable() ? 1 : 8;
+        fill(buffer, key, copies);
+        for (int i = 0; i < 1000000; ++i) {
+            backend->crypt(encKeys, buffer, buffer, size_t(copies));
+        }
+        require(allEqual(buffer, million, copies));
+
+        // 各种分组数（并行组 + 不足一组的尾块）必须与可移植实现逐字节一致
+        quint8 input[16 * 41];
+        for (int i = 0; i < int(sizeof(input)); ++i) {
+            input[i] = quint8(i * 37 + 11);
+        }
+        for (size_t blocks = 1; blocks <= 41; ++blocks) {
+            quint8 expected[sizeof(input)];
+            quint8 actual[sizeof(input)];
+            SM4Backend::portable().crypt(encKeys, input, expected, blocks);
+            backend->crypt(encKeys, input, actual, blocks);
+            require(std::memcmp(expected, actual, blocks * 16) == 0);
+            backend->crypt(decKeys, actual, actual, blocks);
+            require(std::memcmp(input, actual, blocks * 16) == 0);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+// honeycomb_hashbench：哈希吞吐对比
+//
+//   honeycomb_hashbench [-n 消息数] [-s 消息长度] [-b 大块 MiB]
+//
+// 对同一批短消息分别用逐条计算（SHA-256 用 QCryptographicHash，SM3 用 SM3::hash）
+// 与 MultiBufferHash::hashMany 的每个可用实现计算摘要，输出每秒消息数与加速比；
+// 再对一整块数据测 BLAKE3、CRC32、CRC32C、XXH3 各实现的 MB/s，以可移植实现的结果为准。
+// 任一实现的结果与基准不一致时返回 1。
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QList>
+#include <QTextStream>
+
+#include "../../src/Blake3.h"
+#include "../../src/Crc32.h"
+#include "../../src/MultiBufferHash.h"
+#include "../../src/SM3.h"
+#include "../../src/XXH3.h"
+
+#include <functional>
+
+namespace {
+
+QList<QByteArray> makeMessages(int count, int size)
+{
+    QList<QByteArray> messages;
+    messages.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QByteArray message(size, Qt::Uninitialized);
+        for (int j = 0; j < size; ++j) {
+            message[j] = char(i * 131 + j * 7);
+        }
+        messages.append(message);
+    }
+    return messages;
+}
+
+double messagesPerSecond(qsizetype count, qint64 elapsedNs)
+{
+    return elapsedNs > 0 ? double(count) * 1e9 / double(elapsedNs) : 0.0;
+}
+
+// 计时 hash(data)，返回 MB/s；结果写入 digest
+double megabytesPerSecond(const QByteArray &data, const std::function<QByteArray(const QByteArray &)> &hash,
+                          QByteArray *digest)
+{
+    QElapsedTimer timer;
+    timer.start();
+    *digest = hash(data);
+    const qint64 elapsedNs = timer.nsecsElapsed();
+    return elapsedNs > 0 ? double(data.size()) / (1024.0 * 1024.0) * 1e9 / double(elapsedNs) : 0.0;
+}
+
+struct BulkCandidate {
+    QString name;
+    std::function<QByteArray(const QByteArray &)> hash;
+};
+
+// 第一个候选为基准，其余候选的结果必须与它相同
+bool runBulk(QTextStream &out, const QString &title, const QByteArray &data, const QList<BulkCandidate> &candidates)
+{
+    out << Qt::endl << title << Qt::endl;
+    bool allMatch = true;
+    QByteArray expected;
+    double baseline = 0.0;
+    for (qsizetype i = 0; i < candidates.size(); ++i) {
+        QByteArray digest;
+        const double rate = megabytesPerSecond(data, candidates[i].hash, &digest);
+        if (i == 0) {
+            expected = digest;
+            baseline = rate;
+        }
+        const bool matches = digest == expected;
+        allMatch = allMatch && matches;
+        out << QString("  %1 %2 MB/s  x%3%4")
+                   .arg(candidates[i].name, -20)
+                   .arg(rate, 10, 'f', 0)
+                   .arg(baseline > 0 ? rate / baseline : 0.0, 0, 'f', 2)
+                   .arg(matches ? "" : "  [结果不一致]")
+            << Qt::endl;
+    }
+    return allMatch;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("honeycomb_hashbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Honeycomb 多缓冲区哈希压测工具");
+    parser.addHelpOption();
+    QCommandLineOption countOption({"n", "count"}, "消息条数", "n", "200000");
+    QCommandLineOption sizeOption({"s", "size"}, "每条消息的字节数", "bytes", "32");
+    QCommandLineOption bulkOption({"b", "bulk"}, "大块吞吐测试的数据量，0 表示跳过", "MiB", "256");
+    parser.addOptions({countOption, sizeOption, bulkOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const int count = qMax(1, parser.value(countOption).toInt());
+    const int size = qMax(0, parser.value(sizeOption).toInt());
+    const QList<QByteArray> messages = makeMessages(count, size);
+    out << QString("%1 条消息，每条 %2 字节").arg(count).arg(size) << Qt::endl;
+
+    int exitCode = 0;
+    const MultiBufferHash::Algorithm algorithms[] = {MultiBufferHash::Sha256, MultiBufferHash::Sm3};
+    for (MultiBufferHash::Algorithm algorithm : algorithms) {
+        const bool sm3 = algorithm == MultiBufferHash::Sm3;
+
+        // 基准：逐条计算
+        QByteArray expected;
+        expected.reserve(qsizetype(count) * MultiBufferHash::kDigestLength);
+        QElapsedTimer timer;
+        timer.start();
+        for (const QByteArray &message : messages) {
+            expected.append(sm3 ? SM3::hash(message) : QCryptographicHash::hash(message, QCryptographicHash::Sha256));
+        }
+        const double baseline = messagesPerSecond(count, timer.nsecsElapsed());
+        out << Qt::endl << (sm3 ? "SM3" : "SHA-256") << Qt::endl;
+        out << QString("  %1 %2 msg/s").arg(sm3 ? "SM3::hash" : "QCryptographicHash", -20)
+                                         .arg(baseline, 14, 'f', 0) << Qt::endl;
+
+        QByteArray digests(qsizetype(count) * MultiBufferHash::kDigestLength, Qt::Uninitialized);
+        for (const MultiBufferHash::Implementation *impl : MultiBufferHash::available()) {
+            timer.restart();
+            MultiBufferHash::hashMany(algorithm, messages.constData(), messages.size(),
+                                      reinterpret_cast<quint8 *>(digests.data()), *impl);
+            const double rate = messagesPerSecond(count, timer.nsecsElapsed());
+            const bool matches = digests == expected;
+            out << QString("  %1 %2 msg/s  x%3%4")
+                       .arg(QString("hashMany %1").arg(impl->name), -20)
+                       .arg(rate, 14, 'f', 0)
+                       .arg(baseline > 0 ? rate / baseline : 0.0, 0, 'f', 2)
+                       .arg(matches ? "" : "  [结果不一致]")
+                << Qt::endl;
+            if (!matches) {
+                exitCode = 1;
+            }
+        }
+    }
+
+    const qsizetype bulkSize = qsizetype(qMax(0, parser.value(bulkOption).toInt())) * 1024 * 1024;
+    if (bulkSize > 0) {
+        QByteArray data(bulkSize, Qt::Uninitialized);
+        for (qsizetype i = 0; i < data.size(); ++i) {
+            data[i] = char(i * 131 + (i >> 13));
+        }
+        out << Qt::endl << QString("大块吞吐：%1 MiB").arg(bulkSize / (1024 * 1024)) << Qt::endl;
+
+        QList<BulkCandidate> sha256 = {
+            {"QCryptographicHash", [](const QByteArray &d) { return QCryptographicHash::hash(d, QCryptographicHash::Sha256); }},
+        };
+        bool bulkMatches = runBulk(out, "SHA-256（对照）", data, sha256);
+
+        QList<BulkCandidate> blake3;
+        for (const Blake3::Implementation *impl : Blake3::available()) {
+            blake3.append({QString::fromLatin1(impl->name), [impl](const QByteArray &d) {
+                               Blake3 hash(*impl);
+                               hash.setParallel(false);
+                               hash.addData(d);
+                               return hash.result();
+                           }});
+        }
+        blake3.append({QString("%1 多线程").arg(Blake3::active().name), [](const QByteArray &d) {
+                           return Blake3::hash(d);
+                       }});
+        bulkMatches = runBulk(out, "BLAKE3", data, blake3) && bulkMatches;
+
+        const Crc32::Variant variants[] = {Crc32::Ieee, Crc32::Castagnoli};
+        for (Crc32::Variant variant : variants) {
+            QList<BulkCandidate> crc;
+            for (const Crc32::Implementation *impl : Crc32::available(variant)) {
+                crc.append({QString::fromLatin1(impl->name), [impl](const QByteArray &d) {
+                                Crc32 hash(*impl);
+                                hash.addData(d);
+                                return hash.result();
+                            }});
+            }
+            bulkMatches = runBulk(out, variant == Crc32::Ieee ? "CRC32" : "CRC32C", data, crc) && bulkMatches;
+        }
+
+        QList<BulkCandidate> xxh3;
+        for (const XXH3::Implementation *impl : XXH3::available()) {
+            xxh3.append({QString::fromLatin1(impl->name), [impl](const QByteArray &d) {
+                             XXH3 hash(XXH3::Bits128, *impl);
+                             hash.addData(d);
+                             return hash.result();
+                         }});
+        }
+        bulkMatches = runBulk(out, "XXH3-128", data, xxh3) && bulkMatches;
+
+        if (!bulkMatches) {
+            exitCode = 1;
+        }
+    }
+
+    if (exitCode != 0) {
+        err << "[失败] 加速实现与基准实现的结果不一致" << Qt::endl;
+    }
+    return exitCode;
+}
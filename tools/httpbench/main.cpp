@@ -0,0 +1,192 @@
+// honeycomb_httpbench：命令行 HTTP 压测工具
+//
+//   honeycomb_httpbench [-c 连接数] [-r 速率] [-d 秒] [--no-keepalive] <url>
+//   honeycomb_httpbench --builtin folder|fakeapi [--min-rps N] [--max-p99 ms]
+//
+// --builtin 在独立线程中启动内置的文件夹映射 / Fake API 服务并对其压测，供 CTest 使用；
+// 未达到 --min-rps / --max-p99 阈值或出现请求错误时返回非 0。
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+
+#include <memory>
+
+#include "../../src/FakeApiServer.h"
+#include "../../src/FolderHttpServer.h"
+#include "../../src/HttpBenchmark.h"
+
+namespace {
+
+// 让系统分配一个空闲端口
+int findFreePort()
+{
+    QTcpServer probe;
+    if (!probe.listen(QHostAddress::LocalHost, 0)) {
+        return -1;
+    }
+    const int port = probe.serverPort();
+    probe.close();
+    return port;
+}
+
+// 在独立线程中运行被测服务，避免与压测客户端争用同一事件循环
+class BuiltinServer
+{
+public:
+    ~BuiltinServer()
+    {
+        if (m_server) {
+            QObject *server = m_server;
+            QMetaObject::invokeMethod(server, [server]() {
+                QMetaObject::invokeMethod(server, "stopServer");
+                delete server;
+            }, Qt::BlockingQueuedConnection);
+        }
+        m_thread.quit();
+        m_thread.wait();
+    }
+
+    bool start(const QString &kind, QString *url, QString *errorMessage)
+    {
+        const int port = findFreePort();
+        if (port < 0) {
+            *errorMessage = "无法分配空闲端口";
+            return false;
+        }
+
+        if (kind == "folder") {
+            if (!m_folder.isValid()) {
+                *errorMessage = "无法创建临时目录";
+                return false;
+            }
+            QFile page(m_folder.filePath("index.html"));
+            if (!page.open(QIODevice::WriteOnly)) {
+                *errorMessage = "无法写入测试页面";
+                return false;
+            }
+            page.write("<!DOCTYPE html><html><body>" + QByteArray(4096, 'x') + "</body></html>");
+            page.close();
+
+            FolderHttpServer *server = new FolderHttpServer();
+            server->setFolderPath(m_folder.path());
+            server->setPort(port);
+            m_server = server;
+            *url = QString("http://127.0.0.1:%1/index.html").arg(port);
+        } else if (kind == "fakeapi") {
+            FakeApiServer *server = new FakeApiServer();
+            server->addRoute("/api/bench");
+            server->setPort(port);
+            m_server = server;
+            *url = QString("http://127.0.0.1:%1/api/bench").arg(port);
+        } else {
+            *errorMessage = QString("未知的内置服务: %1（可选 folder / fakeapi）").arg(kind);
+            return false;
+        }
+
+        m_server->moveToThread(&m_thread);
+        m_thread.start();
+
+        bool started = false;
+        QMetaObject::invokeMethod(m_server, "startServer", Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(bool, started));
+        if (!started) {
+            *errorMessage = QString("内置服务启动失败（端口 %1）").arg(port);
+        }
+        return started;
+    }
+
+private:
+    QThread m_thread;
+    QTemporaryDir m_folder;
+    QObject *m_server = nullptr;
+};
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("honeycomb_httpbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Honeycomb HTTP 压测工具");
+    parser.addHelpOption();
+    parser.addPositionalArgument("url", "压测地址，例如 http://127.0.0.1:8080/");
+
+    QCommandLineOption connectionsOption({"c", "connections"}, "并发连接数", "n", "10");
+    QCommandLineOption rateOption({"r", "rate"}, "目标总速率（请求/秒），0 为闭环", "n", "0");
+    QCommandLineOption durationOption({"d", "duration"}, "压测时长（秒）", "seconds", "10");
+    QCommandLineOption noKeepAliveOption("no-keepalive", "每个请求后关闭连接");
+    QCommandLineOption builtinOption("builtin", "压测内置服务: folder 或 fakeapi", "kind");
+    QCommandLineOption minRpsOption("min-rps", "吞吐低于该值时返回失败", "n", "0");
+    QCommandLineOption maxP99Option("max-p99", "p99 延迟高于该值（毫秒）时返回失败", "ms", "0");
+    parser.addOptions({connectionsOption, rateOption, durationOption, noKeepAliveOption,
+                       builtinOption, minRpsOption, maxP99Option});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    std::unique_ptr<BuiltinServer> builtin;
+    QString url = parser.positionalArguments().value(0);
+    if (parser.isSet(builtinOption)) {
+        builtin = std::make_unique<BuiltinServer>();
+        QString errorMessage;
+        if (!builtin->start(parser.value(builtinOption), &url, &errorMessage)) {
+            err << errorMessage << Qt::endl;
+            return 2;
+        }
+    }
+    if (url.isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    HttpBenchmark bench;
+    bench.setUrl(url);
+    bench.setConnections(parser.value(connectionsOption).toInt());
+    bench.setRate(parser.value(rateOption).toInt());
+    bench.setDuration(parser.value(durationOption).toInt());
+    bench.setKeepAlive(!parser.isSet(noKeepAliveOption));
+
+    const double minRps = parser.value(minRpsOption).toDouble();
+    const double maxP99 = parser.value(maxP99Option).toDouble();
+
+    int exitCode = 0;
+    QObject::connect(&bench, &HttpBenchmark::finished, &app, [&]() {
+        out << bench.report() << Qt::endl;
+
+        QStringList failures;
+        if (bench.completedRequests() == 0) {
+            failures << "没有完成任何请求";
+        }
+        if (bench.errorCount() > 0) {
+            failures << QString("%1 个请求出错").arg(bench.errorCount());
+        }
+        if (minRps > 0 && bench.requestsPerSecond() < minRps) {
+            failures << QString("吞吐 %1 req/s 低于阈值 %2")
+                            .arg(bench.requestsPerSecond(), 0, 'f', 1).arg(minRps);
+        }
+        if (maxP99 > 0 && bench.p99Latency() > maxP99) {
+            failures << QString("p99 延迟 %1 ms 高于阈值 %2 ms")
+                            .arg(bench.p99Latency(), 0, 'f', 3).arg(maxP99);
+        }
+        for (const QString &failure : failures) {
+            err << "[失败] " << failure << Qt::endl;
+        }
+        exitCode = failures.isEmpty() ? 0 : 1;
+        app.quit();
+    });
+
+    if (!bench.start()) {
+        err << bench.statusMessage() << Qt::endl;
+        return 2;
+    }
+    app.exec();
+    return exitCode;
+}
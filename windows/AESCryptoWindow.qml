@@ -1,13 +1,14 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
+import QtQuick.Dialogs
 import Honeycomb
 import "../i18n/i18n.js" as I18n
 
 Window {
     id: aesCryptoWindow
     width: 700
-    height: 750
+    height: 900
     title: I18n.t("toolAESCrypto") || "AES加解密"
     flags: Qt.Window
     modality: Qt.NonModal
@@ -19,6 +20,41 @@ Window {
             errorDialog.text = error
             errorDialog.open()
         }
+
+        onFileFinished: function(success, message) {
+            fileStatusText.text = message
+            fileStatusText.color = success ? "#43a047" : "#999"
+        }
+    }
+
+    property string fileUrl: ""
+
+    FileDialog {
+        id: openFileDialog
+        title: I18n.t("fileCryptoSelect") || "选择文件"
+        fileMode: FileDialog.OpenFile
+
+        onAccepted: {
+            fileUrl = selectedFile.toString()
+            fileStatusText.text = ""
+        }
+    }
+
+    // 选择输出位置后开始处理
+    FileDialog {
+        id: saveFileDialog
+        property bool encryptMode: true
+        title: I18n.t("fileCryptoSaveTitle") || "保存为"
+        fileMode: FileDialog.SaveFile
+
+        onAccepted: {
+            fileStatusText.text = ""
+            if (encryptMode) {
+                crypto.encryptFile(fileUrl, selectedFile)
+            } else {
+                crypto.decryptFile(fileUrl, selectedFile)
+            }
+        }
     }
 
     Dialog {
@@ -55,12 +91,19 @@ Window {
             }
 
             Text {
-                text: I18n.t("aesCryptoDesc") || "支持AES-128/192/256加密，ECB/CBC模式"
+                text: I18n.t("aesCryptoDesc") || "支持AES-128/192/256加密，ECB/CBC/CTR/GCM模式"
                 font.pixelSize: 14
                 color: "#666"
                 Layout.alignment: Qt.AlignHCenter
             }
 
+            Text {
+                text: (I18n.t("aesBackend") || "加速实现") + ": " + crypto.backendName
+                font.pixelSize: 12
+                color: "#999"
+                Layout.alignment: Qt.AlignHCenter
+            }
+
             Rectangle {
                 Layout.fillWidth: true
                 height: 1
@@ -136,6 +179,22 @@ Window {
                     }
                 }
 
+                RadioButton {
+                    id: ctrRadio
+                    text: "CTR"
+                    onCheckedChanged: {
+                        if (checked) crypto.mode = "CTR"
+                    }
+                }
+
+                RadioButton {
+                    id: gcmRadio
+                    text: "GCM"
+                    onCheckedChanged: {
+                        if (checked) crypto.mode = "GCM"
+                    }
+                }
+
                 Item { Layout.fillWidth: true }
 
                 CheckBox {
@@ -212,17 +271,17 @@ Window {
                 }
             }
 
-            // IV 输入 (CBC模式)
+            // IV 输入 (CBC/CTR/GCM模式)
             ColumnLayout {
                 Layout.fillWidth: true
                 spacing: 8
-                visible: cbcRadio.checked
+                visible: cbcRadio.checked || ctrRadio.checked || gcmRadio.checked
 
                 RowLayout {
                     Layout.fillWidth: true
 
                     Text {
-                        text: "IV (32 Hex):"
+                        text: gcmRadio.checked ? "IV (24/32 Hex):" : "IV (32 Hex):"
                         font.pixelSize: 14
                         font.bold: true
                         color: "#333"
@@ -275,6 +334,66 @@ Window {
                 }
             }
 
+            // 附加数据与认证标签 (GCM模式)
+            GridLayout {
+                Layout.fillWidth: true
+                visible: gcmRadio.checked
+                columns: 2
+                columnSpacing: 10
+                rowSpacing: 8
+
+                Text {
+                    text: (I18n.t("gcmAad") || "附加数据") + " (Hex):"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                TextField {
+                    id: aadInput
+                    Layout.fillWidth: true
+                    placeholderText: I18n.t("gcmAadPlaceholder") || "可选，参与认证但不加密的数据..."
+                    font.family: "Consolas"
+                    font.pixelSize: 14
+
+                    background: Rectangle {
+                        color: "white"
+                        border.color: aadInput.focus ? "#1976d2" : "#e0e0e0"
+                        border.width: aadInput.focus ? 2 : 1
+                        radius: 6
+                    }
+
+                    onTextChanged: crypto.aad = text
+                }
+
+                Text {
+                    text: (I18n.t("gcmTag") || "认证标签") + " (Hex):"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                // 加密后自动填入标签，解密前需填写
+                TextField {
+                    id: tagInput
+                    Layout.fillWidth: true
+                    placeholderText: I18n.t("gcmTagPlaceholder") || "加密后自动生成，解密时需填写..."
+                    text: crypto.tag
+                    font.family: "Consolas"
+                    font.pixelSize: 14
+                    maximumLength: 32
+
+                    background: Rectangle {
+                        color: "white"
+                        border.color: tagInput.focus ? "#1976d2" : "#e0e0e0"
+                        border.width: tagInput.focus ? 2 : 1
+                        radius: 6
+                    }
+
+                    onTextChanged: crypto.tag = text
+                }
+            }
+
             // 输入区域
             ColumnLayout {
                 Layout.fillWidth: true
@@ -390,6 +509,7 @@ Window {
                         inputText.text = ""
                         keyInput.text = ""
                         ivInput.text = ""
+                        aadInput.text = ""
                         crypto.clear()
                     }
                 }
@@ -480,6 +600,171 @@ Window {
                 }
             }
 
+            // 文件加解密：后台线程分块处理，内存占用与文件大小无关
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.preferredHeight: fileColumn.implicitHeight + 24
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 8
+
+                ColumnLayout {
+                    id: fileColumn
+                    anchors.fill: parent
+                    anchors.margins: 12
+                    spacing: 8
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 10
+
+                        Text {
+                            text: (I18n.t("fileCryptoTitle") || "文件加解密") + ":"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333"
+                        }
+
+                        TextField {
+                            id: fileInputField
+                            Layout.fillWidth: true
+                            readOnly: true
+                            placeholderText: I18n.t("fileCryptoPlaceholder") || "选择要加密或解密的文件..."
+                            text: decodeURIComponent(fileUrl.replace(/^file:\/\/(\/(?=[A-Za-z]:))?/, ""))
+                            font.pixelSize: 13
+
+                            background: Rectangle {
+                                color: "#fafafa"
+                                border.color: "#e0e0e0"
+                                border.width: 1
+                                radius: 6
+                            }
+                        }
+
+                        Button {
+                            text: I18n.t("fileCryptoSelect") || "选择文件"
+                            enabled: !crypto.fileRunning
+
+                            contentItem: Text {
+                                text: parent.text
+                                font.pixelSize: 12
+                                color: "#1976d2"
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+
+                            background: Rectangle {
+                                color: parent.pressed ? "#e3f2fd" : (parent.hovered ? "#f5f5f5" : "transparent")
+                                border.color: "#1976d2"
+                                border.width: 1
+                                radius: 4
+                                implicitHeight: 28
+                                implicitWidth: 80
+                            }
+
+                            onClicked: openFileDialog.open()
+                        }
+                    }
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 10
+
+                        ProgressBar {
+                            Layout.fillWidth: true
+                            from: 0
+                            to: 1
+                            value: crypto.fileProgress
+                        }
+
+                        Text {
+                            id: fileStatusText
+                            font.pixelSize: 12
+                            color: "#666"
+                        }
+
+                        Button {
+                            text: I18n.t("fileCryptoEncrypt") || "加密文件"
+                            enabled: !crypto.fileRunning && fileInputField.text.length > 0
+
+                            contentItem: Text {
+                                text: parent.text
+                                font.pixelSize: 12
+                                color: parent.enabled ? "#43a047" : "#bbb"
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+
+                            background: Rectangle {
+                                color: parent.pressed ? "#e8f5e9" : (parent.hovered ? "#f5f5f5" : "transparent")
+                                border.color: parent.enabled ? "#43a047" : "#e0e0e0"
+                                border.width: 1
+                                radius: 4
+                                implicitHeight: 28
+                                implicitWidth: 80
+                            }
+
+                            onClicked: {
+                                saveFileDialog.encryptMode = true
+                                saveFileDialog.open()
+                            }
+                        }
+
+                        Button {
+                            text: I18n.t("fileCryptoDecrypt") || "解密文件"
+                            enabled: !crypto.fileRunning && fileInputField.text.length > 0
+
+                            contentItem: Text {
+                                text: parent.text
+                                font.pixelSize: 12
+                                color: parent.enabled ? "#1976d2" : "#bbb"
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+
+                            background: Rectangle {
+                                color: parent.pressed ? "#e3f2fd" : (parent.hovered ? "#f5f5f5" : "transparent")
+                                border.color: parent.enabled ? "#1976d2" : "#e0e0e0"
+                                border.width: 1
+                                radius: 4
+                                implicitHeight: 28
+                                implicitWidth: 80
+                            }
+
+                            onClicked: {
+                                saveFileDialog.encryptMode = false
+                                saveFileDialog.open()
+                            }
+                        }
+
+                        Button {
+                            text: I18n.t("fileCryptoCancel") || "取消"
+                            visible: crypto.fileRunning
+
+                            contentItem: Text {
+                                text: parent.text
+                                font.pixelSize: 12
+                                color: "#e53935"
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+
+                            background: Rectangle {
+                                color: parent.pressed ? "#ffebee" : (parent.hovered ? "#f5f5f5" : "transparent")
+                                border.color: "#e53935"
+                                border.width: 1
+                                radius: 4
+                                implicitHeight: 28
+                                implicitWidth: 60
+                            }
+
+                            onClicked: crypto.cancelFile()
+                        }
+                    }
+                }
+            }
+
             // 算法说明
             Rectangle {
                 Layout.fillWidth: true
@@ -490,7 +775,7 @@ Window {
                 Text {
                     anchors.fill: parent
                     anchors.margins: 10
-                    text: "AES: " + (I18n.t("aesDesc") || "高级加密标准，支持128/192/256位密钥，ECB/CBC模式，使用PKCS7填充")
+                    text: "AES: " + (I18n.t("aesDesc") || "高级加密标准，支持128/192/256位密钥，ECB/CBC/CTR/GCM模式，ECB/CBC使用PKCS7填充")
                     font.pixelSize: 12
                     color: "#666"
                     wrapMode: Text.Wrap
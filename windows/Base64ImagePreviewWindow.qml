@@ -1,6 +1,7 @@
 import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
+import Honeycomb
 import "../i18n/i18n.js" as I18n
 
 Window {
@@ -13,19 +14,30 @@ Window {
     flags: Qt.Window
     modality: Qt.NonModal
 
-    property string imageSource: ""
-    property string statusText: ""
+    Base64ImageDecoder {
+        id: decoder
+        maxDimension: dimensionBox.model[dimensionBox.currentIndex].value
+    }
+
+    FileUtilityTool {
+        id: sizeFormatter
+    }
 
     function preview() {
-        var value = input.text.trim()
-        if (value.length === 0) {
-            imageSource = ""
-            statusText = "请输入 Base64 或 Data URL"
-            return
+        decoder.decode(input.text)
+    }
+
+    function imageInfo() {
+        if (!decoder.hasImage) {
+            return ""
+        }
+        var text = decoder.format.toUpperCase() + "  " + decoder.imageWidth + " × " + decoder.imageHeight
+        if (decoder.decodedWidth !== decoder.imageWidth || decoder.decodedHeight !== decoder.imageHeight) {
+            text += "（预览 " + decoder.decodedWidth + " × " + decoder.decodedHeight + "）"
         }
-        value = value.replace(/\s/g, "")
-        imageSource = value.indexOf("data:image/") === 0 ? value : "data:image/" + formatBox.currentText + ";base64," + value
-        statusText = "已生成预览，字符数：" + value.length
+        text += "  ·  " + sizeFormatter.formatFileSize(decoder.byteCount)
+        text += "  ·  Base64 " + decoder.base64Milliseconds.toFixed(1) + " ms，图片 " + decoder.imageMilliseconds.toFixed(1) + " ms"
+        return text
     }
 
     Rectangle {
@@ -75,18 +87,25 @@ Window {
                     ColumnLayout {
                         Layout.preferredWidth: 170
                         spacing: 6
-                        Text { text: "图片格式"; font.pixelSize: 13; color: "#666" }
+                        Text { text: "预览最长边"; font.pixelSize: 13; color: "#666" }
                         ComboBox {
-                            id: formatBox
+                            id: dimensionBox
                             Layout.fillWidth: true
                             Layout.preferredHeight: 36
-                            model: ["png", "jpeg", "webp", "gif", "bmp", "svg+xml"]
+                            textRole: "text"
+                            model: [
+                                {text: "1024 px", value: 1024},
+                                {text: "2048 px", value: 2048},
+                                {text: "4096 px", value: 4096},
+                                {text: "原始尺寸", value: 0}
+                            ]
+                            currentIndex: 1
                         }
                     }
 
                     Text {
                         Layout.fillWidth: true
-                        text: statusText.length > 0 ? statusText : "支持纯 Base64，也支持 data:image/png;base64,..."
+                        text: decoder.statusMessage.length > 0 ? decoder.statusMessage : "支持纯 Base64，也支持 data:image/png;base64,...，格式自动识别"
                         font.pixelSize: 12
                         color: "#888"
                         wrapMode: Text.WordWrap
@@ -96,6 +115,7 @@ Window {
                         text: I18n.t("generateBtn") || "生成"
                         Layout.preferredWidth: 90
                         Layout.preferredHeight: 36
+                        enabled: !decoder.running
                         onClicked: preview()
                         background: Rectangle { color: parent.hovered ? "#006cbd" : "#0078d4"; radius: 4 }
                         contentItem: Text { text: parent.text; color: "white"; font.pixelSize: 13; horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter }
@@ -105,7 +125,7 @@ Window {
                         text: I18n.t("clearBtn") || "清空"
                         Layout.preferredWidth: 80
                         Layout.preferredHeight: 36
-                        onClicked: { input.text = ""; imageSource = ""; statusText = "" }
+                        onClicked: { input.text = ""; decoder.clear() }
                         background: Rectangle { color: parent.hovered ? "#f5f5f5" : "white"; border.color: "#d0d0d0"; border.width: 1; radius: 4 }
                         contentItem: Text { text: parent.text; color: "#333"; font.pixelSize: 13; horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter }
                     }
@@ -188,9 +208,16 @@ Window {
                             Image {
                                 anchors.fill: parent
                                 anchors.margins: 12
-                                source: imageSource
+                                source: decoder.imageSource
                                 fillMode: Image.PreserveAspectFit
                                 asynchronous: true
+                                cache: false
+                            }
+
+                            BusyIndicator {
+                                anchors.centerIn: parent
+                                running: decoder.running
+                                visible: running
                             }
 
                             Text {
@@ -198,9 +225,18 @@ Window {
                                 text: "生成后在这里预览"
                                 color: "#aaa"
                                 font.pixelSize: 14
-                                visible: imageSource.length === 0
+                                visible: !decoder.hasImage && !decoder.running
                             }
                         }
+
+                        Text {
+                            Layout.fillWidth: true
+                            visible: decoder.hasImage
+                            text: imageInfo()
+                            font.pixelSize: 12
+                            color: "#666"
+                            elide: Text.ElideRight
+                        }
                     }
                 }
             }
@@ -0,0 +1,464 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import Honeycomb
+import "../i18n/i18n.js" as I18n
+
+Window {
+    id: binaryDiffWindow
+    width: 820
+    height: 720
+    minimumWidth: 720
+    minimumHeight: 600
+    title: I18n.t("binaryDiff") || "二进制文件比较"
+    flags: Qt.Window
+    modality: Qt.NonModal
+
+    BinaryDiffTool {
+        id: diffTool
+    }
+
+    FileUtilityTool {
+        id: sizeFormatter
+    }
+
+    function stageName(stage) {
+        if (stage === 1) {
+            return I18n.t("binaryDiffStageScan") || "扫描新文件"
+        }
+        return I18n.t("binaryDiffStageSignature") || "计算块签名"
+    }
+
+    function kindName(kind) {
+        if (kind === "changed") {
+            return I18n.t("binaryDiffChanged") || "修改"
+        }
+        if (kind === "inserted") {
+            return I18n.t("binaryDiffInserted") || "插入"
+        }
+        return I18n.t("binaryDiffDeleted") || "删除"
+    }
+
+    function kindColor(kind) {
+        if (kind === "changed") {
+            return "#ef6c00"
+        }
+        if (kind === "inserted") {
+            return "#2e7d32"
+        }
+        return "#c62828"
+    }
+
+    function hexOffset(offset) {
+        var text = Number(offset).toString(16)
+        while (text.length < 8) {
+            text = "0" + text
+        }
+        return "0x" + text
+    }
+
+    function copyToClipboard(text) {
+        clipboardArea.text = text
+        clipboardArea.selectAll()
+        clipboardArea.copy()
+        clipboardArea.text = ""
+        copyFeedback.show()
+    }
+
+    TextArea {
+        id: clipboardArea
+        visible: false
+    }
+
+    function pathFromDrop(drop) {
+        var value = ""
+        if (drop.urls && drop.urls.length > 0) {
+            value = drop.urls[0].toString()
+        } else if (drop.text && drop.text.length > 0) {
+            value = drop.text.trim()
+        }
+
+        value = value.replace(/\r?\n/g, "")
+        try {
+            value = decodeURIComponent(value)
+        } catch (error) {
+            // 文件名可以包含裸 %，解码失败时保留原路径。
+        }
+
+        // file:///C:/、file:/C:/ 和 file:///C:\ 均归一为 Windows 本地路径。
+        // 仅移除 file:，这样 file://server/share 仍会保留 UNC 的 //server/share。
+        value = value.replace(/^file:\/\/localhost(?=\/)/i, "")
+        value = value.replace(/^file:/i, "")
+        if (/^\/+[A-Za-z]:[\\/]/.test(value)) {
+            value = value.replace(/^\/+/, "")
+        }
+        return value
+    }
+
+    component ActionButton: Button {
+        property bool primary: true
+        Layout.preferredWidth: 100
+        Layout.preferredHeight: 38
+
+        background: Rectangle {
+            color: !parent.enabled ? "#bdbdbd"
+                   : parent.primary ? (parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2"))
+                   : (parent.pressed ? "#f0f0f0" : (parent.hovered ? "#f5f5f5" : "white"))
+            border.color: parent.primary ? "transparent" : "#e0e0e0"
+            border.width: parent.primary ? 0 : 1
+            radius: 4
+        }
+        contentItem: Text {
+            text: parent.text
+            color: parent.primary ? "white" : "#666666"
+            font.pixelSize: 14
+            font.bold: parent.primary
+            horizontalAlignment: Text.AlignHCenter
+            verticalAlignment: Text.AlignVCenter
+        }
+    }
+
+    component PathField: Rectangle {
+        id: field
+        property alias text: input.text
+        property alias placeholderText: input.placeholderText
+        signal edited(string value)
+        signal dropReceived(var drop)
+
+        Layout.fillWidth: true
+        Layout.preferredHeight: 42
+        color: "white"
+        border.color: (dropArea.containsDrag || input.activeFocus) ? "#1976d2" : "#e0e0e0"
+        border.width: (dropArea.containsDrag || input.activeFocus) ? 2 : 1
+        radius: 4
+
+        TextField {
+            id: input
+            anchors.fill: parent
+            anchors.margins: 1
+            font.pixelSize: 14
+            selectByMouse: true
+            onTextEdited: field.edited(text)
+            background: null
+        }
+
+        DropArea {
+            id: dropArea
+            anchors.fill: parent
+            onDropped: function(drop) {
+                field.dropReceived(drop)
+                drop.accept()
+            }
+        }
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        color: "#f9f9f9"
+
+        ColumnLayout {
+            anchors.fill: parent
+            anchors.margins: 25
+            spacing: 16
+
+            Column {
+                Layout.fillWidth: true
+                spacing: 5
+
+                Text {
+                    text: I18n.t("binaryDiff") || "二进制文件比较"
+                    font.pixelSize: 22
+                    font.bold: true
+                    color: "#333"
+                }
+
+                Text {
+                    text: I18n.t("binaryDiffDesc") || "按块比较两个大文件（固件、磁盘镜像等），列出修改、插入与删除的字节范围"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                height: 1
+                color: "#e0e0e0"
+            }
+
+            GridLayout {
+                Layout.fillWidth: true
+                columns: 2
+                columnSpacing: 12
+                rowSpacing: 10
+
+                Text {
+                    text: I18n.t("binaryDiffOld") || "旧文件"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                PathField {
+                    id: oldField
+                    placeholderText: I18n.t("binaryDiffOldPlaceholder") || "请输入旧文件路径，或拖入文件..."
+                    onEdited: function(value) { diffTool.oldPath = value }
+                    onDropReceived: function(drop) {
+                        var path = pathFromDrop(drop)
+                        if (path.length === 0) {
+                            return
+                        }
+                        oldField.text = path
+                        diffTool.oldPath = path
+                    }
+                }
+
+                Text {
+                    text: I18n.t("binaryDiffNew") || "新文件"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                PathField {
+                    id: newField
+                    placeholderText: I18n.t("binaryDiffNewPlaceholder") || "请输入新文件路径，或拖入文件..."
+                    onEdited: function(value) { diffTool.newPath = value }
+                    onDropReceived: function(drop) {
+                        var path = pathFromDrop(drop)
+                        if (path.length === 0) {
+                            return
+                        }
+                        newField.text = path
+                        diffTool.newPath = path
+                        if (diffTool.oldPath.length > 0) {
+                            diffTool.compare()
+                        }
+                    }
+                }
+            }
+
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 10
+
+                Text {
+                    text: I18n.t("binaryDiffBlockSize") || "块长"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+
+                ComboBox {
+                    Layout.preferredWidth: 110
+                    textRole: "text"
+                    valueRole: "value"
+                    model: [
+                        {text: I18n.t("binaryDiffAuto") || "自动", value: 0},
+                        {text: "1 KB", value: 1024},
+                        {text: "4 KB", value: 4096},
+                        {text: "64 KB", value: 65536},
+                        {text: "1 MB", value: 1048576}
+                    ]
+                    onActivated: diffTool.blockSize = currentValue
+                }
+
+                Text {
+                    text: I18n.t("binaryDiffThreads") || "并行段数"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+
+                SpinBox {
+                    from: 1
+                    to: 8
+                    value: diffTool.threadCount
+                    onValueModified: diffTool.threadCount = value
+                }
+
+                Item { Layout.fillWidth: true }
+
+                ActionButton {
+                    text: I18n.t("binaryDiffCompare") || "比较"
+                    enabled: !diffTool.running
+                    onClicked: diffTool.compare()
+                }
+
+                ActionButton {
+                    text: I18n.t("fileHashCancel") || "取消"
+                    primary: false
+                    visible: diffTool.running
+                    onClicked: diffTool.cancel()
+                }
+            }
+
+            ColumnLayout {
+                Layout.fillWidth: true
+                spacing: 8
+
+                ProgressBar {
+                    Layout.fillWidth: true
+                    from: 0
+                    to: 1000
+                    value: diffTool.progress
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 18
+
+                    Text {
+                        visible: diffTool.running
+                        text: stageName(diffTool.stage) + "  " + (diffTool.progress / 10).toFixed(1) + "%"
+                        font.pixelSize: 13
+                        color: "#333"
+                    }
+
+                    Text {
+                        text: (I18n.t("binaryDiffMatched") || "相同") + " " + sizeFormatter.formatFileSize(diffTool.matchedBytes)
+                        font.pixelSize: 13
+                        color: "#333"
+                    }
+
+                    Text {
+                        text: kindName("changed") + " " + sizeFormatter.formatFileSize(diffTool.changedBytes)
+                        font.pixelSize: 13
+                        color: diffTool.changedBytes > 0 ? kindColor("changed") : "#666"
+                    }
+
+                    Text {
+                        text: kindName("inserted") + " " + sizeFormatter.formatFileSize(diffTool.insertedBytes)
+                        font.pixelSize: 13
+                        color: diffTool.insertedBytes > 0 ? kindColor("inserted") : "#666"
+                    }
+
+                    Text {
+                        text: kindName("deleted") + " " + sizeFormatter.formatFileSize(diffTool.deletedBytes)
+                        font.pixelSize: 13
+                        color: diffTool.deletedBytes > 0 ? kindColor("deleted") : "#666"
+                    }
+
+                    Item { Layout.fillWidth: true }
+                }
+
+                Text {
+                    Layout.fillWidth: true
+                    text: diffTool.statusMessage
+                    font.pixelSize: 13
+                    color: "#495057"
+                    elide: Text.ElideMiddle
+                }
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 8
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: 15
+                    spacing: 10
+
+                    RowLayout {
+                        Layout.fillWidth: true
+
+                        Text {
+                            text: (I18n.t("binaryDiffRanges") || "不同的范围") + " (" + diffTool.differenceCount + ")"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333"
+                        }
+
+                        Item { Layout.fillWidth: true }
+
+                        ActionButton {
+                            text: I18n.t("copyAll") || "复制全部"
+                            primary: false
+                            enabled: diffTool.differenceCount > 0
+                            onClicked: copyToClipboard(diffTool.report())
+                        }
+                    }
+
+                    ListView {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        model: diffTool.ranges
+                        ScrollBar.vertical: ScrollBar {}
+
+                        delegate: RowLayout {
+                            width: ListView.view.width
+                            spacing: 12
+
+                            Text {
+                                Layout.preferredWidth: 48
+                                text: kindName(modelData.kind)
+                                font.pixelSize: 13
+                                font.bold: true
+                                color: kindColor(modelData.kind)
+                                padding: 3
+                            }
+
+                            Text {
+                                Layout.fillWidth: true
+                                text: (I18n.t("binaryDiffOld") || "旧文件") + " " + hexOffset(modelData.oldOffset) + " +" + modelData.oldLength
+                                      + "    " + (I18n.t("binaryDiffNew") || "新文件") + " " + hexOffset(modelData.newOffset) + " +" + modelData.newLength
+                                font.pixelSize: 13
+                                font.family: "Consolas, Monaco, monospace"
+                                color: "#495057"
+                                elide: Text.ElideRight
+                            }
+                        }
+
+                        Text {
+                            anchors.centerIn: parent
+                            visible: parent.count === 0
+                            text: I18n.t("binaryDiffNone") || "没有不同的范围"
+                            font.pixelSize: 13
+                            color: "#999"
+                        }
+                    }
+
+                    Text {
+                        Layout.fillWidth: true
+                        visible: diffTool.differenceCount > diffTool.ranges.length
+                        text: (I18n.t("binaryDiffTruncated") || "只列出前 %1 项，复制全部可取得完整列表").replace("%1", diffTool.ranges.length)
+                        font.pixelSize: 12
+                        color: "#999"
+                    }
+                }
+            }
+        }
+    }
+
+    Rectangle {
+        id: copyFeedback
+        anchors.centerIn: parent
+        width: 140
+        height: 48
+        color: "#333333"
+        radius: 6
+        opacity: 0
+        visible: opacity > 0
+
+        Text {
+            anchors.centerIn: parent
+            text: I18n.t("copySuccess") || "已复制到剪贴板"
+            font.pixelSize: 13
+            color: "white"
+        }
+
+        function show() {
+            opacity = 1
+            feedbackTimer.start()
+        }
+
+        Timer {
+            id: feedbackTimer
+            interval: 1500
+            onTriggered: copyFeedback.opacity = 0
+        }
+    }
+}
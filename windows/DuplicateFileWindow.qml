@@ -0,0 +1,442 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import Honeycomb
+import "../i18n/i18n.js" as I18n
+
+Window {
+    id: duplicateFileWindow
+    width: 820
+    height: 720
+    minimumWidth: 720
+    minimumHeight: 600
+    title: I18n.t("duplicateFile") || "重复文件查找"
+    flags: Qt.Window
+    modality: Qt.NonModal
+
+    DuplicateFileTool {
+        id: duplicateTool
+    }
+
+    FileUtilityTool {
+        id: sizeFormatter
+    }
+
+    function stageName(stage) {
+        if (stage === 1) {
+            return I18n.t("duplicateFileStageEdge") || "比较首尾"
+        }
+        if (stage === 2) {
+            return I18n.t("duplicateFileStageFull") || "完整比较"
+        }
+        return I18n.t("duplicateFileStageSize") || "按大小分组"
+    }
+
+    function copyToClipboard(text) {
+        clipboardArea.text = text
+        clipboardArea.selectAll()
+        clipboardArea.copy()
+        clipboardArea.text = ""
+        copyFeedback.show()
+    }
+
+    TextArea {
+        id: clipboardArea
+        visible: false
+    }
+
+    function pathFromDrop(drop) {
+        var value = ""
+        if (drop.urls && drop.urls.length > 0) {
+            value = drop.urls[0].toString()
+        } else if (drop.text && drop.text.length > 0) {
+            value = drop.text.trim()
+        }
+
+        value = value.replace(/\r?\n/g, "")
+        try {
+            value = decodeURIComponent(value)
+        } catch (error) {
+            // 文件名可以包含裸 %，解码失败时保留原路径。
+        }
+
+        // file:///C:/、file:/C:/ 和 file:///C:\ 均归一为 Windows 本地路径。
+        // 仅移除 file:，这样 file://server/share 仍会保留 UNC 的 //server/share。
+        value = value.replace(/^file:\/\/localhost(?=\/)/i, "")
+        value = value.replace(/^file:/i, "")
+        if (/^\/+[A-Za-z]:[\\/]/.test(value)) {
+            value = value.replace(/^\/+/, "")
+        }
+        return value
+    }
+
+    component ActionButton: Button {
+        property bool primary: true
+        Layout.preferredWidth: 100
+        Layout.preferredHeight: 38
+
+        background: Rectangle {
+            color: !parent.enabled ? "#bdbdbd"
+                   : parent.primary ? (parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2"))
+                   : (parent.pressed ? "#f0f0f0" : (parent.hovered ? "#f5f5f5" : "white"))
+            border.color: parent.primary ? "transparent" : "#e0e0e0"
+            border.width: parent.primary ? 0 : 1
+            radius: 4
+        }
+        contentItem: Text {
+            text: parent.text
+            color: parent.primary ? "white" : "#666666"
+            font.pixelSize: 14
+            font.bold: parent.primary
+            horizontalAlignment: Text.AlignHCenter
+            verticalAlignment: Text.AlignVCenter
+        }
+    }
+
+    component PathField: Rectangle {
+        id: field
+        property alias text: input.text
+        property alias placeholderText: input.placeholderText
+        signal edited(string value)
+        signal dropReceived(var drop)
+
+        Layout.fillWidth: true
+        Layout.preferredHeight: 42
+        color: "white"
+        border.color: (dropArea.containsDrag || input.activeFocus) ? "#1976d2" : "#e0e0e0"
+        border.width: (dropArea.containsDrag || input.activeFocus) ? 2 : 1
+        radius: 4
+
+        TextField {
+            id: input
+            anchors.fill: parent
+            anchors.margins: 1
+            font.pixelSize: 14
+            selectByMouse: true
+            onTextEdited: field.edited(text)
+            background: null
+        }
+
+        DropArea {
+            id: dropArea
+            anchors.fill: parent
+            onDropped: function(drop) {
+                field.dropReceived(drop)
+                drop.accept()
+            }
+        }
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        color: "#f9f9f9"
+
+        ColumnLayout {
+            anchors.fill: parent
+            anchors.margins: 25
+            spacing: 16
+
+            Column {
+                Layout.fillWidth: true
+                spacing: 5
+
+                Text {
+                    text: I18n.t("duplicateFile") || "重复文件查找"
+                    font.pixelSize: 22
+                    font.bold: true
+                    color: "#333"
+                }
+
+                Text {
+                    text: I18n.t("duplicateFileDesc") || "先按大小分组，再比较首尾 64 KB，只有仍然相同的文件才完整计算哈希"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                height: 1
+                color: "#e0e0e0"
+            }
+
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 12
+
+                Text {
+                    text: I18n.t("folderHashFolder") || "文件夹"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                PathField {
+                    id: folderField
+                    placeholderText: I18n.t("folderHashFolderPlaceholder") || "请输入文件夹路径，或拖入文件夹..."
+                    onEdited: function(value) { duplicateTool.folderPath = value }
+                    onDropReceived: function(drop) {
+                        var path = pathFromDrop(drop)
+                        if (path.length === 0) {
+                            return
+                        }
+                        folderField.text = path
+                        duplicateTool.folderPath = path
+                        duplicateTool.scan()
+                    }
+                }
+            }
+
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 10
+
+                ComboBox {
+                    id: algorithmCombo
+                    Layout.preferredWidth: 120
+                    model: ["BLAKE3", "SHA256", "XXH128", "MD5", "SHA1", "SM3"]
+                    onActivated: duplicateTool.algorithm = currentText
+                    Component.onCompleted: duplicateTool.algorithm = currentText
+                }
+
+                Text {
+                    text: I18n.t("duplicateFileMinimumSize") || "最小文件"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+
+                ComboBox {
+                    id: minimumSizeCombo
+                    Layout.preferredWidth: 100
+                    textRole: "text"
+                    valueRole: "value"
+                    model: [
+                        {text: "1 B", value: 1},
+                        {text: "4 KB", value: 4096},
+                        {text: "1 MB", value: 1048576},
+                        {text: "10 MB", value: 10485760},
+                        {text: "100 MB", value: 104857600}
+                    ]
+                    onActivated: duplicateTool.minimumSize = currentValue
+                    Component.onCompleted: duplicateTool.minimumSize = currentValue
+                }
+
+                Text {
+                    text: I18n.t("folderHashThreads") || "并行文件数"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+
+                SpinBox {
+                    from: 1
+                    to: 8
+                    value: duplicateTool.threadCount
+                    onValueModified: duplicateTool.threadCount = value
+                }
+
+                Item { Layout.fillWidth: true }
+
+                ActionButton {
+                    text: I18n.t("duplicateFileScan") || "查找"
+                    enabled: !duplicateTool.running
+                    onClicked: duplicateTool.scan()
+                }
+
+                ActionButton {
+                    text: I18n.t("fileHashCancel") || "取消"
+                    primary: false
+                    visible: duplicateTool.running
+                    onClicked: duplicateTool.cancel()
+                }
+            }
+
+            ColumnLayout {
+                Layout.fillWidth: true
+                spacing: 8
+
+                ProgressBar {
+                    Layout.fillWidth: true
+                    from: 0
+                    to: Math.max(1, duplicateTool.totalFiles)
+                    value: duplicateTool.processedFiles
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 18
+
+                    Text {
+                        visible: duplicateTool.running
+                        text: stageName(duplicateTool.stage) + "  " + duplicateTool.processedFiles + " / " + duplicateTool.totalFiles
+                        font.pixelSize: 13
+                        color: "#333"
+                    }
+
+                    Text {
+                        text: (I18n.t("duplicateFileGroups") || "重复组") + " " + duplicateTool.groupCount
+                        font.pixelSize: 13
+                        color: "#333"
+                    }
+
+                    Text {
+                        text: (I18n.t("duplicateFileDuplicates") || "重复文件") + " " + duplicateTool.duplicateCount
+                        font.pixelSize: 13
+                        color: duplicateTool.duplicateCount > 0 ? "#ef6c00" : "#666"
+                    }
+
+                    Text {
+                        text: (I18n.t("duplicateFileReclaimable") || "可释放") + " " + sizeFormatter.formatFileSize(duplicateTool.reclaimableBytes)
+                        font.pixelSize: 13
+                        font.bold: duplicateTool.reclaimableBytes > 0
+                        color: duplicateTool.reclaimableBytes > 0 ? "#2e7d32" : "#666"
+                    }
+
+                    Text {
+                        text: (I18n.t("folderHashFailed") || "读取失败") + " " + duplicateTool.problems.length
+                        font.pixelSize: 13
+                        color: duplicateTool.problems.length > 0 ? "#c62828" : "#666"
+                    }
+
+                    Item { Layout.fillWidth: true }
+                }
+
+                Text {
+                    Layout.fillWidth: true
+                    text: duplicateTool.statusMessage
+                    font.pixelSize: 13
+                    color: "#495057"
+                    elide: Text.ElideMiddle
+                }
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 8
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: 15
+                    spacing: 10
+
+                    RowLayout {
+                        Layout.fillWidth: true
+
+                        Text {
+                            text: (I18n.t("duplicateFileGroups") || "重复组") + " (" + duplicateTool.groupCount + ")"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333"
+                        }
+
+                        Item { Layout.fillWidth: true }
+
+                        ActionButton {
+                            text: I18n.t("copyAll") || "复制全部"
+                            primary: false
+                            enabled: duplicateTool.groupCount > 0 || duplicateTool.problems.length > 0
+                            onClicked: {
+                                var text = duplicateTool.report()
+                                if (duplicateTool.problems.length > 0) {
+                                    text += duplicateTool.problems.join("\n") + "\n"
+                                }
+                                copyToClipboard(text)
+                            }
+                        }
+                    }
+
+                    ListView {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        spacing: 8
+                        model: duplicateTool.groups
+                        ScrollBar.vertical: ScrollBar {}
+
+                        delegate: Column {
+                            width: ListView.view.width
+                            spacing: 2
+
+                            Text {
+                                width: parent.width
+                                text: sizeFormatter.formatFileSize(modelData.size) + " × " + modelData.paths.length
+                                      + "    " + (I18n.t("duplicateFileReclaimable") || "可释放") + " "
+                                      + sizeFormatter.formatFileSize(modelData.reclaimable)
+                                font.pixelSize: 13
+                                font.bold: true
+                                color: "#333"
+                                padding: 3
+                            }
+
+                            Repeater {
+                                model: modelData.paths
+
+                                Text {
+                                    width: parent.width
+                                    text: modelData
+                                    font.pixelSize: 13
+                                    font.family: "Consolas, Monaco, monospace"
+                                    color: "#495057"
+                                    elide: Text.ElideMiddle
+                                    leftPadding: 16
+                                }
+                            }
+                        }
+
+                        Text {
+                            anchors.centerIn: parent
+                            visible: parent.count === 0
+                            text: I18n.t("duplicateFileNone") || "没有重复文件"
+                            font.pixelSize: 13
+                            color: "#999"
+                        }
+                    }
+
+                    // 无法读取的文件只显示前几行，完整列表随“复制全部”一起复制
+                    Text {
+                        Layout.fillWidth: true
+                        visible: duplicateTool.problems.length > 0
+                        text: duplicateTool.problems.join("\n")
+                        font.pixelSize: 13
+                        font.family: "Consolas, Monaco, monospace"
+                        color: "#c62828"
+                        maximumLineCount: 4
+                        elide: Text.ElideRight
+                    }
+                }
+            }
+        }
+    }
+
+    Rectangle {
+        id: copyFeedback
+        anchors.centerIn: parent
+        width: 140
+        height: 48
+        color: "#333333"
+        radius: 6
+        opacity: 0
+        visible: opacity > 0
+
+        Text {
+            anchors.centerIn: parent
+            text: I18n.t("copySuccess") || "已复制到剪贴板"
+            font.pixelSize: 13
+            color: "white"
+        }
+
+        function show() {
+            opacity = 1
+            feedbackTimer.start()
+        }
+
+        Timer {
+            id: feedbackTimer
+            interval: 1500
+            onTriggered: copyFeedback.opacity = 0
+        }
+    }
+}
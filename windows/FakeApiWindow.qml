@@ -35,6 +35,14 @@ Window {
         onSelectedIndexChanged: {
             loadRouteToEditor()
         }
+        
+        // 配置按 OpenAPI 规范在后台导入时，解析成功后才提示
+        onImportFinished: function(ok) {
+            if (ok && fakeApiWindow.importToastPending) {
+                importToast.show()
+            }
+            fakeApiWindow.importToastPending = false
+        }
     }
     
     // 日志模型
@@ -42,6 +50,9 @@ Window {
         id: logModel
     }
     
+    // 配置导入转到后台进行时，等 importFinished 再显示导入成功
+    property bool importToastPending: false
+    
     // HTTP方法选项
     property var httpMethods: ["GET", "POST", "PUT", "DELETE", "PATCH", "HEAD", "OPTIONS"]
     
@@ -335,13 +346,51 @@ Window {
                                         var filePath = fakeServer.selectImportFile()
                                         if (filePath) {
                                             if (fakeServer.importFromFile(filePath)) {
-                                                importToast.show()
+                                                if (fakeServer.isImporting) {
+                                                    fakeApiWindow.importToastPending = true
+                                                } else {
+                                                    importToast.show()
+                                                }
                                             }
                                         }
                                     }
                                 }
                             }
                             
+                            // OpenAPI 导入按钮
+                            Rectangle {
+                                width: 24
+                                height: 24
+                                radius: 4
+                                color: openApiMouseArea.containsMouse ? "#f3e5f5" : "transparent"
+                                opacity: fakeServer.isImporting ? 0.4 : 1.0
+                                
+                                Text {
+                                    anchors.centerIn: parent
+                                    text: "📑"
+                                    font.pixelSize: 14
+                                }
+                                
+                                MouseArea {
+                                    id: openApiMouseArea
+                                    anchors.fill: parent
+                                    hoverEnabled: true
+                                    enabled: !fakeServer.isImporting
+                                    cursorShape: Qt.PointingHandCursor
+                                    
+                                    ToolTip.visible: containsMouse
+                                    ToolTip.text: I18n.t("importOpenApi") || "导入 OpenAPI 规范"
+                                    ToolTip.delay: 500
+                                    
+                                    onClicked: {
+                                        var filePath = fakeServer.selectOpenApiFile()
+                                        if (filePath) {
+                                            fakeServer.importOpenApiFile(filePath)
+                                        }
+                                    }
+                                }
+                            }
+                            
                             // 导出按钮
                             Rectangle {
                                 width: 24
@@ -366,7 +415,7 @@ Window {
                                     ToolTip.delay: 500
                                     
                                     onClicked: {
-                                        if (fakeServer.routes.length === 0) {
+                                        if (fakeServer.routeCount === 0) {
                                             return
                                         }
                                         var filePath = fakeServer.selectExportFile()
@@ -380,7 +429,9 @@ Window {
                             }
                             
                             Text {
-                                text: fakeServer.routes.length + " 个"
+                                text: fakeServer.isImporting
+                                      ? (I18n.t("importingOpenApi") || "导入中...")
+                                      : fakeServer.routeCount + " 个"
                                 font.pixelSize: 11
                                 color: "#888"
                                 Layout.leftMargin: 4
@@ -419,7 +470,7 @@ Window {
                             Layout.fillWidth: true
                             Layout.fillHeight: true
                             clip: true
-                            model: fakeServer.routes
+                            model: fakeServer.routeModel
                             spacing: 4
                             
                             ScrollBar.vertical: ScrollBar {
@@ -428,8 +479,11 @@ Window {
                             }
                             
                             delegate: Rectangle {
+                                id: routeDelegate
                                 width: routeListView.width
                                 height: 56
+                                property string routePath: model.path || ""
+                                property var routeMethods: model.methods
                                 color: fakeServer.selectedIndex === index ? "#e3f2fd" : (routeMouseArea.containsMouse ? "#f5f5f5" : "transparent")
                                 radius: 4
                                 border.color: fakeServer.selectedIndex === index ? "#1976d2" : "transparent"
@@ -458,7 +512,7 @@ Window {
                                         spacing: 4
                                         
                                         Text {
-                                            text: modelData.path || "/api/new"
+                                            text: routeDelegate.routePath || "/api/new"
                                             font.pixelSize: 13
                                             font.bold: true
                                             color: "#333"
@@ -470,7 +524,7 @@ Window {
                                             spacing: 4
                                             
                                             Repeater {
-                                                model: modelData.methods || ["GET"]
+                                                model: routeDelegate.routeMethods || ["GET"]
                                                 
                                                 Rectangle {
                                                     width: methodLabel.width + 8
@@ -538,7 +592,7 @@ Window {
                             
                             // 空状态
                             Text {
-                                visible: fakeServer.routes.length === 0
+                                visible: fakeServer.routeCount === 0 && !fakeServer.isImporting
                                 anchors.centerIn: parent
                                 text: I18n.t("noRoutes") || "暂无路由\n点击上方按钮添加"
                                 font.pixelSize: 13
@@ -7,24 +7,15 @@ import "../i18n/i18n.js" as I18n
 Window {
     id: base64Window
     width: 820
-    height: 640
+    height: 720
     minimumWidth: 700
-    minimumHeight: 520
+    minimumHeight: 600
     title: I18n.t("toolFileBase64") || "文件转Base64"
     flags: Qt.Window
     modality: Qt.NonModal
 
-    property var sizeOptions: [
-        { label: "1 MB", bytes: 1024 * 1024 },
-        { label: "3 MB", bytes: 3 * 1024 * 1024 },
-        { label: "5 MB", bytes: 5 * 1024 * 1024 },
-        { label: "10 MB", bytes: 10 * 1024 * 1024 },
-        { label: "20 MB", bytes: 20 * 1024 * 1024 }
-    ]
-
-    FileUtilityTool {
-        id: fileTool
-        maxBase64SizeBytes: sizeOptions[sizeLimitBox.currentIndex].bytes
+    Base64FileTool {
+        id: base64Tool
     }
 
     function pathFromDrop(drop) {
@@ -52,8 +43,8 @@ Window {
             return
         }
         filePathInput.text = path
-        fileTool.filePath = path
-        fileTool.encodeFileToBase64()
+        base64Tool.inputPath = path
+        base64Tool.loadPreview()
     }
 
     function copyToClipboard(text) {
@@ -69,6 +60,29 @@ Window {
         visible: false
     }
 
+    component ActionButton: Button {
+        property bool primary: true
+        Layout.preferredWidth: 100
+        Layout.preferredHeight: 38
+
+        background: Rectangle {
+            color: !parent.enabled ? "#bdbdbd"
+                   : parent.primary ? (parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2"))
+                   : (parent.pressed ? "#f0f0f0" : (parent.hovered ? "#f5f5f5" : "white"))
+            border.color: parent.primary ? "transparent" : "#e0e0e0"
+            border.width: parent.primary ? 0 : 1
+            radius: 4
+        }
+        contentItem: Text {
+            text: parent.text
+            color: parent.primary ? "white" : "#666666"
+            font.pixelSize: 14
+            font.bold: parent.primary
+            horizontalAlignment: Text.AlignHCenter
+            verticalAlignment: Text.AlignVCenter
+        }
+    }
+
     Rectangle {
         anchors.fill: parent
         color: "#f9f9f9"
@@ -90,7 +104,7 @@ Window {
                 }
 
                 Text {
-                    text: I18n.t("toolFileBase64Desc") || "将小文件转换为Base64文本"
+                    text: I18n.t("toolFileBase64Desc") || "文件与Base64互转，大文件流式转换"
                     font.pixelSize: 13
                     color: "#666"
                 }
@@ -106,8 +120,69 @@ Window {
                 Layout.fillWidth: true
                 spacing: 10
 
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 10
+
+                    Text {
+                        text: I18n.t("filePath") || "文件路径"
+                        font.pixelSize: 14
+                        font.bold: true
+                        color: "#333"
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    ComboBox {
+                        Layout.preferredWidth: 150
+                        model: [
+                            I18n.t("fileBase64Encode") || "文件转Base64",
+                            I18n.t("fileBase64Decode") || "Base64转文件"
+                        ]
+                        currentIndex: base64Tool.decoding ? 1 : 0
+                        onActivated: function(index) {
+                            base64Tool.decoding = index === 1
+                            if (base64Tool.inputPath.length > 0) {
+                                base64Tool.loadPreview()
+                            }
+                        }
+                    }
+                }
+
+                Rectangle {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 42
+                    color: "white"
+                    border.color: base64DropArea.containsDrag ? "#1976d2" : (filePathInput.activeFocus ? "#1976d2" : "#e0e0e0")
+                    border.width: (base64DropArea.containsDrag || filePathInput.activeFocus) ? 2 : 1
+                    radius: 4
+
+                    TextField {
+                        id: filePathInput
+                        anchors.fill: parent
+                        anchors.margins: 1
+                        placeholderText: base64DropArea.containsDrag
+                                         ? (I18n.t("fileBase64DropTip") || "松开后转换Base64")
+                                         : (I18n.t("filePathPlaceholder") || "请输入文件完整路径，或拖入文件...")
+                        font.pixelSize: 14
+                        selectByMouse: true
+                        onTextChanged: base64Tool.inputPath = text
+                        onAccepted: base64Tool.loadPreview()
+                        background: null
+                    }
+
+                    DropArea {
+                        id: base64DropArea
+                        anchors.fill: parent
+                        onDropped: function(drop) {
+                            acceptFilePath(pathFromDrop(drop))
+                            drop.accept()
+                        }
+                    }
+                }
+
                 Text {
-                    text: I18n.t("filePath") || "文件路径"
+                    text: I18n.t("fileBase64Output") || "输出文件"
                     font.pixelSize: 14
                     font.bold: true
                     color: "#333"
@@ -121,104 +196,73 @@ Window {
                         Layout.fillWidth: true
                         Layout.preferredHeight: 42
                         color: "white"
-                        border.color: base64DropArea.containsDrag ? "#1976d2" : (filePathInput.activeFocus ? "#1976d2" : "#e0e0e0")
-                        border.width: (base64DropArea.containsDrag || filePathInput.activeFocus) ? 2 : 1
+                        border.color: outputPathInput.activeFocus ? "#1976d2" : "#e0e0e0"
+                        border.width: outputPathInput.activeFocus ? 2 : 1
                         radius: 4
 
                         TextField {
-                            id: filePathInput
+                            id: outputPathInput
                             anchors.fill: parent
                             anchors.margins: 1
-                            placeholderText: base64DropArea.containsDrag
-                                             ? (I18n.t("fileBase64DropTip") || "松开后转换Base64")
-                                             : (I18n.t("filePathPlaceholder") || "请输入文件完整路径，或拖入文件...")
+                            placeholderText: base64Tool.inputPath.length > 0
+                                             ? base64Tool.defaultOutputPath()
+                                             : (I18n.t("fileBase64OutputPlaceholder") || "留空时保存在输入文件旁")
                             font.pixelSize: 14
                             selectByMouse: true
-                            onTextChanged: fileTool.filePath = text
-                            onAccepted: fileTool.encodeFileToBase64()
+                            onTextChanged: base64Tool.outputPath = text
                             background: null
                         }
-
-                        DropArea {
-                            id: base64DropArea
-                            anchors.fill: parent
-                            onDropped: function(drop) {
-                                acceptFilePath(pathFromDrop(drop))
-                                drop.accept()
-                            }
-                        }
                     }
 
-                    ComboBox {
-                        id: sizeLimitBox
-                        Layout.preferredWidth: 105
-                        Layout.preferredHeight: 38
-                        model: sizeOptions.map(function(item) { return item.label })
-                        currentIndex: 3
-                    }
-
-                    Button {
-                        text: I18n.t("convertBtn") || "转换"
-                        Layout.preferredWidth: 85
-                        Layout.preferredHeight: 38
-                        onClicked: fileTool.encodeFileToBase64()
-
-                        background: Rectangle {
-                            color: parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2")
-                            radius: 4
-                        }
-                        contentItem: Text {
-                            text: parent.text
-                            color: "white"
-                            font.pixelSize: 14
-                            font.bold: true
-                            horizontalAlignment: Text.AlignHCenter
-                            verticalAlignment: Text.AlignVCenter
-                        }
+                    ActionButton {
+                        text: I18n.t("fileBase64Save") || "保存为文件"
+                        Layout.preferredWidth: 110
+                        enabled: !base64Tool.running && base64Tool.inputPath.length > 0
+                        onClicked: base64Tool.convert()
                     }
 
-                    Button {
-                        text: I18n.t("clearBtn") || "清空"
+                    ActionButton {
+                        text: base64Tool.running ? (I18n.t("fileHashCancel") || "取消") : (I18n.t("clearBtn") || "清空")
+                        primary: false
                         Layout.preferredWidth: 75
-                        Layout.preferredHeight: 38
                         onClicked: {
+                            if (base64Tool.running) {
+                                base64Tool.cancel()
+                                return
+                            }
                             filePathInput.text = ""
-                            fileTool.filePath = ""
-                            fileTool.clearBase64()
-                        }
-
-                        background: Rectangle {
-                            color: parent.pressed ? "#f0f0f0" : (parent.hovered ? "#f5f5f5" : "white")
-                            border.color: "#e0e0e0"
-                            border.width: 1
-                            radius: 4
-                        }
-                        contentItem: Text {
-                            text: parent.text
-                            color: "#666"
-                            font.pixelSize: 14
-                            horizontalAlignment: Text.AlignHCenter
-                            verticalAlignment: Text.AlignVCenter
+                            outputPathInput.text = ""
+                            base64Tool.clear()
                         }
                     }
                 }
 
-                Text {
+                ProgressBar {
                     Layout.fillWidth: true
-                    text: (I18n.t("fileBase64LimitTip") || "为避免卡顿，单文件大小限制：") + sizeOptions[sizeLimitBox.currentIndex].label
-                    font.pixelSize: 12
-                    color: "#888"
-                    wrapMode: Text.WordWrap
+                    visible: base64Tool.running || base64Tool.progress > 0
+                    from: 0
+                    to: 1000
+                    value: base64Tool.progress
                 }
-            }
 
-            Text {
-                Layout.fillWidth: true
-                text: fileTool.errorMessage
-                visible: fileTool.errorMessage.length > 0
-                font.pixelSize: 13
-                color: "#c62828"
-                wrapMode: Text.WordWrap
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 18
+
+                    Text {
+                        Layout.fillWidth: true
+                        text: base64Tool.statusMessage
+                        font.pixelSize: 12
+                        color: "#888"
+                        elide: Text.ElideMiddle
+                    }
+
+                    Text {
+                        text: (I18n.t("fileBase64Simd") || "SIMD 实现：") + base64Tool.implementationName
+                        font.pixelSize: 12
+                        color: "#888"
+                    }
+                }
             }
 
             Rectangle {
@@ -238,7 +282,9 @@ Window {
                         Layout.fillWidth: true
 
                         Text {
-                            text: I18n.t("fileBase64Result") || "Base64结果"
+                            text: base64Tool.decoding
+                                  ? (I18n.t("fileBase64DecodedPreview") || "解码结果（十六进制）")
+                                  : (I18n.t("fileBase64Result") || "Base64结果")
                             font.pixelSize: 14
                             font.bold: true
                             color: "#333"
@@ -248,8 +294,9 @@ Window {
 
                         Button {
                             text: I18n.t("copyBtn") || "复制"
-                            enabled: fileTool.base64Result.length > 0
-                            onClicked: copyToClipboard(fileTool.base64Result)
+                            // 只有完整的 Base64 文本才值得复制，截断的预览或解码出的十六进制请保存为文件
+                            enabled: !base64Tool.decoding && base64Tool.previewComplete && base64Tool.preview.length > 0
+                            onClicked: copyToClipboard(base64Tool.preview)
 
                             background: Rectangle {
                                 color: parent.enabled ? (parent.hovered ? "#006cbd" : "#0078d4") : "#ccc"
@@ -275,18 +322,21 @@ Window {
                         border.width: 1
                         radius: 4
 
-                        TextArea {
+                        ScrollView {
                             anchors.fill: parent
                             anchors.margins: 12
-                            text: fileTool.base64Result
-                            readOnly: true
-                            font.pixelSize: 13
-                            font.family: "Consolas, Monaco, monospace"
-                            color: "#495057"
-                            selectByMouse: true
-                            wrapMode: TextArea.Wrap
-                            placeholderText: I18n.t("fileBase64ResultPlaceholder") || "转换后显示Base64文本"
-                            background: null
+
+                            TextArea {
+                                text: base64Tool.preview
+                                readOnly: true
+                                font.pixelSize: 13
+                                font.family: "Consolas, Monaco, monospace"
+                                color: "#495057"
+                                selectByMouse: true
+                                wrapMode: TextArea.WrapAnywhere
+                                placeholderText: I18n.t("fileBase64ResultPlaceholder") || "转换后显示Base64文本"
+                                background: null
+                            }
                         }
                     }
                 }
@@ -60,7 +60,13 @@ Window {
                  + "SHA1: " + fileTool.sha1 + "\n"
                  + "SHA256: " + fileTool.sha256 + "\n"
                  + "SHA384: " + fileTool.sha384 + "\n"
-                 + "SHA512: " + fileTool.sha512
+                 + "SHA512: " + fileTool.sha512 + "\n"
+                 + "SM3: " + fileTool.sm3 + "\n"
+                 + "BLAKE3: " + fileTool.blake3 + "\n"
+                 + "CRC32: " + fileTool.crc32 + "\n"
+                 + "CRC32C: " + fileTool.crc32c + "\n"
+                 + "XXH3: " + fileTool.xxh3 + "\n"
+                 + "XXH128: " + fileTool.xxh128
         copyToClipboard(text)
     }
 
@@ -150,7 +156,8 @@ Window {
                     }
 
                     Button {
-                        text: I18n.t("calculateBtn") || "计算"
+                        text: fileTool.hashing ? (I18n.t("fileChecksumRunning") || "计算中...")
+                                               : (I18n.t("calculateBtn") || "计算")
                         Layout.preferredWidth: 90
                         Layout.preferredHeight: 38
                         onClicked: fileTool.calculateAllHashes()
@@ -196,6 +203,25 @@ Window {
                 }
             }
 
+            RowLayout {
+                Layout.fillWidth: true
+
+                CheckBox {
+                    text: I18n.t("forceRehash") || "忽略缓存重新计算"
+                    checked: false
+                    onCheckedChanged: fileTool.forceRehash = checked
+                }
+
+                Text {
+                    text: I18n.t("hashFromCache") || "（来自缓存）"
+                    visible: fileTool.hashesFromCache
+                    font.pixelSize: 13
+                    color: "#2e7d32"
+                }
+
+                Item { Layout.fillWidth: true }
+            }
+
             Text {
                 Layout.fillWidth: true
                 text: fileTool.errorMessage
@@ -265,6 +291,12 @@ Window {
                             HashRow { label: "SHA256"; hashValue: fileTool.sha256 }
                             HashRow { label: "SHA384"; hashValue: fileTool.sha384 }
                             HashRow { label: "SHA512"; hashValue: fileTool.sha512 }
+                            HashRow { label: "SM3"; hashValue: fileTool.sm3 }
+                            HashRow { label: "BLAKE3"; hashValue: fileTool.blake3 }
+                            HashRow { label: "CRC32"; hashValue: fileTool.crc32 }
+                            HashRow { label: "CRC32C"; hashValue: fileTool.crc32c }
+                            HashRow { label: "XXH3"; hashValue: fileTool.xxh3 }
+                            HashRow { label: "XXH128"; hashValue: fileTool.xxh128 }
                         }
                     }
                 }
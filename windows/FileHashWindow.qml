@@ -7,9 +7,9 @@ import "../i18n/i18n.js" as I18n
 Window {
     id: fileHashWindow
     width: 760
-    height: 560
+    height: 600
     minimumWidth: 680
-    minimumHeight: 480
+    minimumHeight: 520
     title: algorithm + " " + (I18n.t("fileHash") || "文件哈希")
     flags: Qt.Window
     modality: Qt.NonModal
@@ -19,12 +19,25 @@ Window {
     FileHashCalculator {
         id: calculator
         algorithm: fileHashWindow.algorithm
+    }
 
-        onUppercaseChanged: {
-            if (result.length > 0) {
-                calculate()
-            }
+    function formatSpeed(bytesPerSecond) {
+        if (bytesPerSecond >= 1024 * 1024 * 1024) {
+            return (bytesPerSecond / (1024 * 1024 * 1024)).toFixed(2) + " GB/s"
+        }
+        if (bytesPerSecond >= 1024 * 1024) {
+            return (bytesPerSecond / (1024 * 1024)).toFixed(1) + " MB/s"
+        }
+        return (bytesPerSecond / 1024).toFixed(1) + " KB/s"
+    }
+
+    function formatEta(seconds) {
+        if (seconds < 0) {
+            return "--:--"
         }
+        var minutes = Math.floor(seconds / 60)
+        var rest = seconds % 60
+        return minutes + ":" + (rest < 10 ? "0" : "") + rest
     }
 
     function pathFromDrop(drop) {
@@ -200,6 +213,49 @@ Window {
                 }
             }
 
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 10
+                visible: calculator.running || (calculator.progress > 0 && !calculator.fromCache)
+
+                ProgressBar {
+                    Layout.fillWidth: true
+                    from: 0
+                    to: 1
+                    value: calculator.progress
+                }
+
+                Text {
+                    text: (I18n.t("fileHashSpeed") || "速度") + " " + formatSpeed(calculator.bytesPerSecond)
+                          + (calculator.running ? "  " + (I18n.t("fileHashEta") || "剩余") + " " + formatEta(calculator.etaSeconds) : "")
+                    font.pixelSize: 12
+                    color: "#666"
+                }
+
+                Button {
+                    text: I18n.t("fileHashCancel") || "取消"
+                    visible: calculator.running
+                    onClicked: calculator.cancel()
+
+                    contentItem: Text {
+                        text: parent.text
+                        font.pixelSize: 12
+                        color: "#e53935"
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                    }
+
+                    background: Rectangle {
+                        color: parent.pressed ? "#ffebee" : (parent.hovered ? "#f5f5f5" : "transparent")
+                        border.color: "#e53935"
+                        border.width: 1
+                        radius: 4
+                        implicitWidth: 70
+                        implicitHeight: 28
+                    }
+                }
+            }
+
             RowLayout {
                 Layout.fillWidth: true
 
@@ -209,6 +265,12 @@ Window {
                     onCheckedChanged: calculator.uppercase = checked
                 }
 
+                CheckBox {
+                    text: I18n.t("forceRehash") || "忽略缓存重新计算"
+                    checked: false
+                    onCheckedChanged: calculator.forceRehash = checked
+                }
+
                 Item { Layout.fillWidth: true }
             }
 
@@ -230,6 +292,7 @@ Window {
 
                         Text {
                             text: algorithm + " " + (I18n.t("resultLabel") || "结果") + ":"
+                                  + (calculator.fromCache ? " " + (I18n.t("hashFromCache") || "（来自缓存）") : "")
                             font.pixelSize: 14
                             font.bold: true
                             color: "#333"
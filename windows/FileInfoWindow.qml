@@ -14,7 +14,18 @@ Window {
     flags: Qt.Window
     modality: Qt.NonModal
 
-    FileUtilityTool { id: fileTool }
+    FileUtilityTool {
+        id: fileTool
+        // 缓存中没有摘要时 fileInfo() 在后台计算，算完后补上
+        onHashesChanged: {
+            if (info.name === undefined || fileTool.md5.length === 0) return
+            var updated = Object.assign({}, info)
+            updated.md5 = fileTool.md5
+            updated.sha1 = fileTool.sha1
+            updated.sha256 = fileTool.sha256
+            info = updated
+        }
+    }
     property var info: ({})
 
     function pathFromDrop(drop) {
@@ -34,6 +45,9 @@ Window {
     function copyToClipboard(text) {
         clipboardArea.text = text; clipboardArea.selectAll(); clipboardArea.copy(); clipboardArea.text = ""; copyFeedback.show()
     }
+    function hashText(value) {
+        return value ? value : (fileTool.hashing ? (I18n.t("fileChecksumRunning") || "计算中...") : "")
+    }
     function infoText() {
         return Object.keys(info).map(function(k) { return k + ": " + info[k] }).join("\n")
     }
@@ -95,7 +109,7 @@ Window {
                             ["文件名", info.name], ["路径", info.absolutePath], ["目录", info.directory], ["扩展名", info.suffix],
                             ["大小", info.sizeText], ["MIME", info.mime], ["创建时间", info.created], ["修改时间", info.lastModified],
                             ["可读", info.readable], ["可写", info.writable], ["可执行", info.executable],
-                            ["MD5", info.md5], ["SHA1", info.sha1], ["SHA256", info.sha256]
+                            ["MD5", hashText(info.md5)], ["SHA1", hashText(info.sha1)], ["SHA256", hashText(info.sha256)]
                         ]
                         RowLayout {
                             Layout.fillWidth: true
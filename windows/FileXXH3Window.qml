@@ -0,0 +1,5 @@
+import QtQuick
+
+FileHashWindow {
+    algorithm: "XXH3"
+}
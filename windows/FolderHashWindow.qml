@@ -0,0 +1,344 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import Honeycomb
+import "../i18n/i18n.js" as I18n
+
+Window {
+    id: folderHashWindow
+    width: 820
+    height: 680
+    minimumWidth: 720
+    minimumHeight: 560
+    title: I18n.t("folderHash") || "文件夹校验"
+    flags: Qt.Window
+    modality: Qt.NonModal
+
+    FolderHashTool {
+        id: folderTool
+    }
+
+    function pathFromDrop(drop) {
+        var value = ""
+        if (drop.urls && drop.urls.length > 0) {
+            value = drop.urls[0].toString()
+        } else if (drop.text && drop.text.length > 0) {
+            value = drop.text.trim()
+        }
+
+        value = value.replace(/\r?\n/g, "")
+        try {
+            value = decodeURIComponent(value)
+        } catch (error) {
+            // 文件名可以包含裸 %，解码失败时保留原路径。
+        }
+
+        // file:///C:/、file:/C:/ 和 file:///C:\ 均归一为 Windows 本地路径。
+        // 仅移除 file:，这样 file://server/share 仍会保留 UNC 的 //server/share。
+        value = value.replace(/^file:\/\/localhost(?=\/)/i, "")
+        value = value.replace(/^file:/i, "")
+        if (/^\/+[A-Za-z]:[\\/]/.test(value)) {
+            value = value.replace(/^\/+/, "")
+        }
+        return value
+    }
+
+    component ActionButton: Button {
+        property bool primary: true
+        Layout.preferredWidth: 100
+        Layout.preferredHeight: 38
+
+        background: Rectangle {
+            color: !parent.enabled ? "#bdbdbd"
+                   : parent.primary ? (parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2"))
+                   : (parent.pressed ? "#f0f0f0" : (parent.hovered ? "#f5f5f5" : "white"))
+            border.color: parent.primary ? "transparent" : "#e0e0e0"
+            border.width: parent.primary ? 0 : 1
+            radius: 4
+        }
+        contentItem: Text {
+            text: parent.text
+            color: parent.primary ? "white" : "#666666"
+            font.pixelSize: 14
+            font.bold: parent.primary
+            horizontalAlignment: Text.AlignHCenter
+            verticalAlignment: Text.AlignVCenter
+        }
+    }
+
+    component PathField: Rectangle {
+        id: field
+        property alias text: input.text
+        property alias placeholderText: input.placeholderText
+        signal edited(string value)
+        signal dropReceived(var drop)
+
+        Layout.fillWidth: true
+        Layout.preferredHeight: 42
+        color: "white"
+        border.color: (dropArea.containsDrag || input.activeFocus) ? "#1976d2" : "#e0e0e0"
+        border.width: (dropArea.containsDrag || input.activeFocus) ? 2 : 1
+        radius: 4
+
+        TextField {
+            id: input
+            anchors.fill: parent
+            anchors.margins: 1
+            font.pixelSize: 14
+            selectByMouse: true
+            onTextEdited: field.edited(text)
+            background: null
+        }
+
+        DropArea {
+            id: dropArea
+            anchors.fill: parent
+            onDropped: function(drop) {
+                field.dropReceived(drop)
+                drop.accept()
+            }
+        }
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        color: "#f9f9f9"
+
+        ColumnLayout {
+            anchors.fill: parent
+            anchors.margins: 25
+            spacing: 16
+
+            Column {
+                Layout.fillWidth: true
+                spacing: 5
+
+                Text {
+                    text: I18n.t("folderHash") || "文件夹校验"
+                    font.pixelSize: 22
+                    font.bold: true
+                    color: "#333"
+                }
+
+                Text {
+                    text: I18n.t("folderHashDesc") || "批量生成 sha256sum / md5sum 兼容的校验清单，或按清单逐个校验文件"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                height: 1
+                color: "#e0e0e0"
+            }
+
+            GridLayout {
+                Layout.fillWidth: true
+                columns: 2
+                columnSpacing: 12
+                rowSpacing: 10
+
+                Text {
+                    text: I18n.t("folderHashFolder") || "文件夹"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                PathField {
+                    id: folderField
+                    placeholderText: I18n.t("folderHashFolderPlaceholder") || "请输入文件夹路径，或拖入文件夹..."
+                    onEdited: function(value) { folderTool.folderPath = value }
+                    onDropReceived: function(drop) {
+                        var path = pathFromDrop(drop)
+                        if (path.length === 0) {
+                            return
+                        }
+                        folderField.text = path
+                        folderTool.folderPath = path
+                        folderTool.manifestPath = ""
+                        manifestField.text = ""
+                    }
+                }
+
+                Text {
+                    text: I18n.t("folderHashManifest") || "校验清单"
+                    font.pixelSize: 14
+                    font.bold: true
+                    color: "#333"
+                }
+
+                PathField {
+                    id: manifestField
+                    placeholderText: I18n.t("folderHashManifestPlaceholder") || "生成时留空则写入文件夹内；校验时拖入 .sha256 / .md5 文件"
+                    onEdited: function(value) { folderTool.manifestPath = value }
+                    onDropReceived: function(drop) {
+                        var path = pathFromDrop(drop)
+                        if (path.length === 0) {
+                            return
+                        }
+                        manifestField.text = path
+                        folderTool.manifestPath = path
+                        folderTool.verify()
+                    }
+                }
+            }
+
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 10
+
+                ComboBox {
+                    id: algorithmCombo
+                    Layout.preferredWidth: 120
+                    model: ["SHA256", "MD5", "SHA1", "SHA512", "SM3", "BLAKE3"]
+                    onActivated: folderTool.algorithm = currentText
+                    Component.onCompleted: folderTool.algorithm = currentText
+                }
+
+                Text {
+                    text: I18n.t("folderHashThreads") || "并行文件数"
+                    font.pixelSize: 13
+                    color: "#666"
+                }
+
+                SpinBox {
+                    from: 1
+                    to: 8
+                    value: folderTool.threadCount
+                    onValueModified: folderTool.threadCount = value
+                }
+
+                Item { Layout.fillWidth: true }
+
+                ActionButton {
+                    text: I18n.t("folderHashGenerate") || "生成清单"
+                    enabled: !folderTool.running
+                    onClicked: {
+                        folderTool.generate()
+                        manifestField.text = folderTool.manifestPath
+                    }
+                }
+
+                ActionButton {
+                    text: I18n.t("folderHashVerify") || "校验"
+                    enabled: !folderTool.running
+                    onClicked: folderTool.verify()
+                }
+
+                ActionButton {
+                    text: I18n.t("fileHashCancel") || "取消"
+                    primary: false
+                    visible: folderTool.running
+                    onClicked: folderTool.cancel()
+                }
+            }
+
+            ColumnLayout {
+                Layout.fillWidth: true
+                spacing: 8
+
+                ProgressBar {
+                    Layout.fillWidth: true
+                    from: 0
+                    to: Math.max(1, folderTool.totalFiles)
+                    value: folderTool.processedFiles
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 18
+
+                    Text {
+                        text: folderTool.processedFiles + " / " + folderTool.totalFiles
+                        font.pixelSize: 13
+                        color: "#333"
+                    }
+
+                    Text {
+                        text: (I18n.t("folderHashOk") || "一致") + " " + folderTool.okCount
+                        font.pixelSize: 13
+                        color: "#2e7d32"
+                    }
+
+                    Text {
+                        text: (I18n.t("folderHashMismatch") || "不一致") + " " + folderTool.mismatchCount
+                        font.pixelSize: 13
+                        color: folderTool.mismatchCount > 0 ? "#c62828" : "#666"
+                    }
+
+                    Text {
+                        text: (I18n.t("folderHashMissing") || "缺失") + " " + folderTool.missingCount
+                        font.pixelSize: 13
+                        color: folderTool.missingCount > 0 ? "#ef6c00" : "#666"
+                    }
+
+                    Text {
+                        text: (I18n.t("folderHashFailed") || "读取失败") + " " + folderTool.failedCount
+                        font.pixelSize: 13
+                        color: folderTool.failedCount > 0 ? "#c62828" : "#666"
+                    }
+
+                    Item { Layout.fillWidth: true }
+                }
+
+                Text {
+                    Layout.fillWidth: true
+                    text: folderTool.statusMessage
+                    font.pixelSize: 13
+                    color: "#495057"
+                    elide: Text.ElideMiddle
+                }
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 8
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: 15
+                    spacing: 10
+
+                    Text {
+                        text: (I18n.t("folderHashProblems") || "问题文件") + " (" + folderTool.problems.length + ")"
+                        font.pixelSize: 14
+                        font.bold: true
+                        color: "#333"
+                    }
+
+                    ListView {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        model: folderTool.problems
+                        ScrollBar.vertical: ScrollBar {}
+
+                        delegate: Text {
+                            width: ListView.view.width
+                            text: modelData
+                            font.pixelSize: 13
+                            font.family: "Consolas, Monaco, monospace"
+                            color: "#c62828"
+                            elide: Text.ElideMiddle
+                            padding: 3
+                        }
+
+                        Text {
+                            anchors.centerIn: parent
+                            visible: parent.count === 0
+                            text: I18n.t("folderHashNoProblems") || "没有问题文件"
+                            font.pixelSize: 13
+                            color: "#999"
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,327 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import Honeycomb
+import "../i18n/i18n.js" as I18n
+
+Window {
+    id: httpBenchWindow
+    width: 760
+    height: 680
+    title: I18n.t("toolHttpBench") || "HTTP压测"
+    flags: Qt.Window
+    modality: Qt.NonModal
+
+    // 窗口关闭时停止压测
+    onClosing: {
+        if (bench.running) {
+            bench.stop()
+        }
+    }
+
+    // C++ 后端实例
+    HttpBenchmark {
+        id: bench
+    }
+
+    function formatBytes(bytes) {
+        var units = ["B", "KB", "MB", "GB"]
+        var unit = 0
+        while (bytes >= 1024 && unit < units.length - 1) {
+            bytes /= 1024
+            unit++
+        }
+        return bytes.toFixed(unit === 0 ? 0 : 2) + " " + units[unit]
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        color: "#f9f9f9"
+
+        ColumnLayout {
+            anchors.fill: parent
+            anchors.margins: 20
+            spacing: 15
+
+            // 标题
+            Text {
+                text: I18n.t("toolHttpBench") || "HTTP压测"
+                font.pixelSize: 22
+                font.bold: true
+                color: "#333333"
+                Layout.alignment: Qt.AlignHCenter
+            }
+
+            Text {
+                text: I18n.t("toolHttpBenchDesc") || "HTTP接口吞吐与延迟压测"
+                font.pixelSize: 14
+                color: "#666666"
+                Layout.alignment: Qt.AlignHCenter
+            }
+
+            // 分隔线
+            Rectangle {
+                Layout.fillWidth: true
+                height: 1
+                color: "#e0e0e0"
+            }
+
+            // 配置区域
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.preferredHeight: configColumn.implicitHeight + 30
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 6
+
+                ColumnLayout {
+                    id: configColumn
+                    anchors.fill: parent
+                    anchors.margins: 15
+                    spacing: 12
+
+                    // 目标地址
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 10
+
+                        Text {
+                            text: I18n.t("benchUrl") || "目标地址:"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333333"
+                            Layout.preferredWidth: 100
+                        }
+
+                        TextField {
+                            id: urlInput
+                            Layout.fillWidth: true
+                            text: bench.url
+                            placeholderText: "http://127.0.0.1:8080/"
+                            font.pixelSize: 13
+                            readOnly: bench.running
+
+                            background: Rectangle {
+                                color: bench.running ? "#f5f5f5" : "white"
+                                border.color: urlInput.focus ? "#1976d2" : "#e0e0e0"
+                                border.width: urlInput.focus ? 2 : 1
+                                radius: 4
+                            }
+
+                            onTextChanged: {
+                                if (!bench.running) {
+                                    bench.url = text
+                                }
+                            }
+                        }
+                    }
+
+                    // 连接数 / 速率 / 时长
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 10
+
+                        Text {
+                            text: I18n.t("benchConnections") || "连接数:"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333333"
+                            Layout.preferredWidth: 100
+                        }
+
+                        SpinBox {
+                            id: connectionsInput
+                            from: 1
+                            to: 1000
+                            value: bench.connections
+                            editable: true
+                            enabled: !bench.running
+                            Layout.preferredWidth: 110
+                            onValueChanged: bench.connections = value
+                        }
+
+                        Text {
+                            text: I18n.t("benchRate") || "速率(req/s):"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333333"
+                        }
+
+                        SpinBox {
+                            id: rateInput
+                            from: 0
+                            to: 1000000
+                            stepSize: 100
+                            value: bench.rate
+                            editable: true
+                            enabled: !bench.running
+                            Layout.preferredWidth: 130
+                            onValueChanged: bench.rate = value
+
+                            ToolTip.visible: hovered
+                            ToolTip.text: I18n.t("benchRateTip") || "0 为闭环模式，大于 0 为开环固定速率"
+                        }
+
+                        Text {
+                            text: I18n.t("benchDuration") || "时长(秒):"
+                            font.pixelSize: 14
+                            font.bold: true
+                            color: "#333333"
+                        }
+
+                        SpinBox {
+                            id: durationInput
+                            from: 1
+                            to: 3600
+                            value: bench.duration
+                            editable: true
+                            enabled: !bench.running
+                            Layout.preferredWidth: 100
+                            onValueChanged: bench.duration = value
+                        }
+
+                        Item { Layout.fillWidth: true }
+                    }
+
+                    // 操作按钮
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 15
+
+                        CheckBox {
+                            text: I18n.t("benchKeepAlive") || "保持连接 (Keep-Alive)"
+                            checked: bench.keepAlive
+                            enabled: !bench.running
+                            onToggled: bench.keepAlive = checked
+                        }
+
+                        Item { Layout.fillWidth: true }
+
+                        Button {
+                            text: bench.running ? (I18n.t("benchStop") || "停止") : (I18n.t("benchStart") || "开始压测")
+                            Layout.preferredWidth: 120
+                            Layout.preferredHeight: 36
+
+                            background: Rectangle {
+                                color: {
+                                    if (bench.running) {
+                                        return parent.hovered ? "#d32f2f" : "#f44336"
+                                    } else {
+                                        return parent.hovered ? "#1565c0" : "#1976d2"
+                                    }
+                                }
+                                radius: 4
+                            }
+
+                            contentItem: Text {
+                                text: parent.text
+                                font.pixelSize: 14
+                                font.bold: true
+                                color: "white"
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+
+                            onClicked: {
+                                if (bench.running) {
+                                    bench.stop()
+                                } else {
+                                    bench.start()
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // 实时指标
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 10
+
+                Repeater {
+                    model: [
+                        {label: I18n.t("benchRequests") || "请求数", value: bench.completedRequests},
+                        {label: I18n.t("benchErrors") || "错误数", value: bench.errorCount + " / " + bench.non2xxCount},
+                        {label: I18n.t("benchThroughput") || "吞吐", value: bench.requestsPerSecond.toFixed(1) + " req/s"},
+                        {label: "", value: httpBenchWindow.formatBytes(bench.bytesPerSecond) + "/s"},
+                        {label: "p50 / p99", value: bench.p50Latency.toFixed(2) + " / " + bench.p99Latency.toFixed(2) + " ms"}
+                    ]
+
+                    delegate: Rectangle {
+                        Layout.fillWidth: true
+                        Layout.preferredHeight: 60
+                        color: "white"
+                        border.color: "#e0e0e0"
+                        border.width: 1
+                        radius: 6
+
+                        Column {
+                            anchors.centerIn: parent
+                            spacing: 4
+
+                            Text {
+                                text: modelData.label || " "
+                                font.pixelSize: 12
+                                color: "#666"
+                                anchors.horizontalCenter: parent.horizontalCenter
+                            }
+
+                            Text {
+                                text: modelData.value
+                                font.pixelSize: 15
+                                font.bold: true
+                                color: "#1976d2"
+                                anchors.horizontalCenter: parent.horizontalCenter
+                            }
+                        }
+                    }
+                }
+            }
+
+            Text {
+                text: bench.statusMessage
+                visible: text.length > 0
+                font.pixelSize: 12
+                color: bench.running ? "#2e7d32" : "#666"
+                elide: Text.ElideRight
+                Layout.fillWidth: true
+            }
+
+            // 压测报告
+            Text {
+                text: I18n.t("benchReport") || "压测报告"
+                font.pixelSize: 14
+                font.bold: true
+                color: "#333333"
+            }
+
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 6
+
+                ScrollView {
+                    anchors.fill: parent
+                    anchors.margins: 1
+
+                    TextArea {
+                        text: bench.report
+                        readOnly: true
+                        selectByMouse: true
+                        wrapMode: TextEdit.NoWrap
+                        font.family: "Consolas, Monaco, monospace"
+                        font.pixelSize: 12
+                        color: "#333333"
+                        placeholderText: I18n.t("benchNoReport") || "压测结束后将在此显示延迟分布"
+                        background: null
+                    }
+                }
+            }
+        }
+    }
+}
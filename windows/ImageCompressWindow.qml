@@ -7,9 +7,9 @@ import "../i18n/i18n.js" as I18n
 Window {
     id: imageCompressWindow
     width: 860
-    height: 680
+    height: 720
     minimumWidth: 760
-    minimumHeight: 560
+    minimumHeight: 600
     title: I18n.t("toolImageCompress") || "图片压缩"
     flags: Qt.Window
     modality: Qt.NonModal
@@ -35,10 +35,16 @@ Window {
         { label: "800px", width: 800, height: 800 }
     ]
 
+    property bool batchMode: modeBar.currentIndex === 1
+
     FileUtilityTool {
         id: fileTool
     }
 
+    BatchImageCompressTool {
+        id: batchTool
+    }
+
     Component.onCompleted: {
         var supported = fileTool.supportedWriteImageFormats()
         var preferred = ["jpeg", "jpg", "png", "webp", "bmp", "tiff"]
@@ -108,6 +114,29 @@ Window {
         fileTool.compressImage(outputPathInput.text, selectedFormat(), selectedQuality(), selectedMaxWidth(), selectedMaxHeight())
     }
 
+    function acceptBatchPath(path) {
+        if (path.length === 0) {
+            return
+        }
+        batchInput.text = path
+        batchTool.inputPath = path
+        batchOutputInput.text = batchTool.defaultOutputFolder()
+    }
+
+    function startBatch() {
+        batchTool.inputPath = batchInput.text
+        batchTool.outputFolder = batchOutputInput.text
+        batchTool.format = selectedFormat()
+        batchTool.quality = selectedQuality()
+        batchTool.maxWidth = selectedMaxWidth()
+        batchTool.maxHeight = selectedMaxHeight()
+        batchTool.start()
+    }
+
+    function savedPercent(inputBytes, outputBytes) {
+        return inputBytes > 0 ? Math.round((1 - outputBytes / inputBytes) * 1000) / 10 : 0
+    }
+
     function copyToClipboard(text) {
         clipboardArea.text = text
         clipboardArea.selectAll()
@@ -142,7 +171,7 @@ Window {
                 }
 
                 Text {
-                    text: I18n.t("toolImageCompressDesc") || "支持多格式图片压缩与尺寸限制"
+                    text: I18n.t("toolImageCompressDesc") || "多格式图片压缩与尺寸限制，可并行批量压缩整个文件夹"
                     font.pixelSize: 13
                     color: "#666"
                 }
@@ -154,9 +183,18 @@ Window {
                 color: "#e0e0e0"
             }
 
+            TabBar {
+                id: modeBar
+                Layout.preferredWidth: 260
+
+                TabButton { text: I18n.t("imageModeSingle") || "单张图片" }
+                TabButton { text: I18n.t("imageModeBatch") || "批量压缩" }
+            }
+
             RowLayout {
                 Layout.fillWidth: true
                 spacing: 14
+                visible: !batchMode
 
                 Rectangle {
                     Layout.fillWidth: true
@@ -210,6 +248,39 @@ Window {
                 }
             }
 
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.preferredHeight: 42
+                visible: batchMode
+                color: "white"
+                border.color: (batchDropArea.containsDrag || batchInput.activeFocus) ? "#1976d2" : "#e0e0e0"
+                border.width: (batchDropArea.containsDrag || batchInput.activeFocus) ? 2 : 1
+                radius: 4
+
+                TextField {
+                    id: batchInput
+                    anchors.fill: parent
+                    anchors.margins: 1
+                    placeholderText: batchDropArea.containsDrag
+                                     ? (I18n.t("imageBatchDropTip") || "松开后填入文件夹路径")
+                                     : (I18n.t("imageBatchInputPlaceholder") || "文件夹路径或通配符，如 D:/photos/**/*.jpg，也可拖入文件夹...")
+                    font.pixelSize: 14
+                    selectByMouse: true
+                    onTextEdited: batchTool.inputPath = text
+                    onAccepted: acceptBatchPath(text)
+                    background: null
+                }
+
+                DropArea {
+                    id: batchDropArea
+                    anchors.fill: parent
+                    onDropped: function(drop) {
+                        acceptBatchPath(pathFromDrop(drop))
+                        drop.accept()
+                    }
+                }
+            }
+
             Rectangle {
                 Layout.fillWidth: true
                 color: "white"
@@ -264,17 +335,52 @@ Window {
                             }
                         }
 
+                        ColumnLayout {
+                            visible: batchMode
+                            spacing: 6
+                            Text { text: I18n.t("folderHashThreads") || "并行文件数"; font.pixelSize: 13; color: "#666" }
+                            SpinBox {
+                                from: 1
+                                to: 16
+                                value: batchTool.threadCount
+                                onValueModified: batchTool.threadCount = value
+                            }
+                        }
+
                         Item { Layout.fillWidth: true }
 
+                        Button {
+                            text: I18n.t("fileHashCancel") || "取消"
+                            visible: batchMode && batchTool.running
+                            Layout.preferredWidth: 80
+                            Layout.preferredHeight: 38
+                            Layout.alignment: Qt.AlignBottom
+                            onClicked: batchTool.cancel()
+
+                            background: Rectangle {
+                                color: parent.pressed ? "#f0f0f0" : (parent.hovered ? "#f5f5f5" : "white")
+                                border.color: "#e0e0e0"
+                                radius: 4
+                            }
+                            contentItem: Text {
+                                text: parent.text
+                                color: "#666666"
+                                font.pixelSize: 14
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+                        }
+
                         Button {
                             text: I18n.t("compressBtn") || "压缩"
+                            enabled: !(batchMode && batchTool.running)
                             Layout.preferredWidth: 100
                             Layout.preferredHeight: 38
                             Layout.alignment: Qt.AlignBottom
-                            onClicked: compress()
+                            onClicked: batchMode ? startBatch() : compress()
 
                             background: Rectangle {
-                                color: parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2")
+                                color: !parent.enabled ? "#bdbdbd" : (parent.pressed ? "#1565c0" : (parent.hovered ? "#1e88e5" : "#1976d2"))
                                 radius: 4
                             }
                             contentItem: Text {
@@ -293,7 +399,8 @@ Window {
                         spacing: 6
 
                         Text {
-                            text: I18n.t("imageOutputPath") || "输出路径"
+                            text: batchMode ? (I18n.t("imageBatchOutputFolder") || "输出文件夹")
+                                            : (I18n.t("imageOutputPath") || "输出路径")
                             font.pixelSize: 13
                             color: "#666"
                         }
@@ -302,19 +409,32 @@ Window {
                             Layout.fillWidth: true
                             Layout.preferredHeight: 38
                             color: "#f8f9fa"
-                            border.color: outputPathInput.activeFocus ? "#1976d2" : "#e9ecef"
-                            border.width: outputPathInput.activeFocus ? 2 : 1
+                            border.color: (outputPathInput.activeFocus || batchOutputInput.activeFocus) ? "#1976d2" : "#e9ecef"
+                            border.width: (outputPathInput.activeFocus || batchOutputInput.activeFocus) ? 2 : 1
                             radius: 4
 
                             TextField {
                                 id: outputPathInput
                                 anchors.fill: parent
                                 anchors.margins: 1
+                                visible: !batchMode
                                 placeholderText: I18n.t("imageOutputPathPlaceholder") || "留空时自动生成"
                                 font.pixelSize: 13
                                 selectByMouse: true
                                 background: null
                             }
+
+                            // 批量压缩保留输入文件夹的目录结构
+                            TextField {
+                                id: batchOutputInput
+                                anchors.fill: parent
+                                anchors.margins: 1
+                                visible: batchMode
+                                placeholderText: I18n.t("imageBatchOutputPlaceholder") || "留空时输出到输入文件夹旁的“文件夹名_compressed”"
+                                font.pixelSize: 13
+                                selectByMouse: true
+                                background: null
+                            }
                         }
                     }
                 }
@@ -323,7 +443,7 @@ Window {
             Text {
                 Layout.fillWidth: true
                 text: fileTool.errorMessage
-                visible: fileTool.errorMessage.length > 0
+                visible: !batchMode && fileTool.errorMessage.length > 0
                 font.pixelSize: 13
                 color: "#c62828"
                 wrapMode: Text.WordWrap
@@ -332,6 +452,7 @@ Window {
             Rectangle {
                 Layout.fillWidth: true
                 Layout.fillHeight: true
+                visible: !batchMode
                 color: "white"
                 border.color: "#e0e0e0"
                 border.width: 1
@@ -429,6 +550,142 @@ Window {
                     }
                 }
             }
+
+            // 批量压缩的进度、汇总与逐个文件的结果
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                visible: batchMode
+                color: "white"
+                border.color: "#e0e0e0"
+                border.width: 1
+                radius: 8
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: 15
+                    spacing: 10
+
+                    ProgressBar {
+                        Layout.fillWidth: true
+                        from: 0
+                        to: Math.max(1, batchTool.totalFiles)
+                        value: batchTool.processedFiles
+                    }
+
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 18
+
+                        Text {
+                            text: (I18n.t("imageBatchProcessed") || "已处理") + " " + batchTool.processedFiles + " / " + batchTool.totalFiles
+                            font.pixelSize: 13
+                            color: "#333"
+                        }
+
+                        Text {
+                            text: fileTool.formatFileSize(batchTool.inputBytes) + " → " + fileTool.formatFileSize(batchTool.outputBytes)
+                            font.pixelSize: 13
+                            color: "#333"
+                        }
+
+                        Text {
+                            text: (I18n.t("imageSaved") || "节省") + " " + savedPercent(batchTool.inputBytes, batchTool.outputBytes) + "%"
+                            font.pixelSize: 13
+                            font.bold: batchTool.outputBytes < batchTool.inputBytes
+                            color: batchTool.outputBytes < batchTool.inputBytes ? "#2e7d32" : "#666"
+                        }
+
+                        Text {
+                            text: (I18n.t("fileHashSpeed") || "速度") + " " + batchTool.filesPerSecond.toFixed(1) + " "
+                                  + (I18n.t("imageBatchFilesPerSecond") || "张/秒") + "  "
+                                  + fileTool.formatFileSize(batchTool.bytesPerSecond) + "/s"
+                            font.pixelSize: 13
+                            color: "#666"
+                        }
+
+                        Text {
+                            text: (I18n.t("imageBatchFailed") || "失败") + " " + batchTool.failedFiles
+                            font.pixelSize: 13
+                            color: batchTool.failedFiles > 0 ? "#c62828" : "#666"
+                        }
+
+                        Item { Layout.fillWidth: true }
+
+                        Button {
+                            text: I18n.t("copyAll") || "复制全部"
+                            enabled: batchTool.processedFiles > 0
+                            onClicked: copyToClipboard(batchTool.report())
+
+                            background: Rectangle {
+                                color: parent.enabled ? (parent.hovered ? "#006cbd" : "#0078d4") : "#ccc"
+                                radius: 4
+                                implicitWidth: 90
+                                implicitHeight: 32
+                            }
+                            contentItem: Text {
+                                text: parent.text
+                                color: "white"
+                                font.pixelSize: 12
+                                horizontalAlignment: Text.AlignHCenter
+                                verticalAlignment: Text.AlignVCenter
+                            }
+                        }
+                    }
+
+                    Text {
+                        Layout.fillWidth: true
+                        visible: text.length > 0
+                        text: batchTool.statusMessage
+                        font.pixelSize: 13
+                        color: "#495057"
+                        elide: Text.ElideMiddle
+                    }
+
+                    ListView {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        model: batchTool.items
+                        ScrollBar.vertical: ScrollBar {}
+
+                        delegate: RowLayout {
+                            width: ListView.view.width
+                            spacing: 12
+
+                            Text {
+                                Layout.fillWidth: true
+                                text: modelData.path
+                                font.pixelSize: 13
+                                font.family: "Consolas, Monaco, monospace"
+                                color: modelData.success ? "#495057" : "#c62828"
+                                elide: Text.ElideMiddle
+                                padding: 3
+                            }
+
+                            Text {
+                                text: modelData.success
+                                      ? modelData.width + "×" + modelData.height + " → " + modelData.outputWidth + "×" + modelData.outputHeight
+                                        + "    " + fileTool.formatFileSize(modelData.inputBytes) + " → " + fileTool.formatFileSize(modelData.outputBytes)
+                                        + "    " + savedPercent(modelData.inputBytes, modelData.outputBytes) + "%"
+                                      : modelData.error
+                                Layout.maximumWidth: 420
+                                font.pixelSize: 13
+                                color: modelData.success ? "#666" : "#c62828"
+                                elide: Text.ElideRight
+                            }
+                        }
+
+                        Text {
+                            anchors.centerIn: parent
+                            visible: parent.count === 0
+                            text: I18n.t("imageBatchNone") || "压缩后在此逐个列出文件的结果"
+                            font.pixelSize: 13
+                            color: "#999"
+                        }
+                    }
+                }
+            }
         }
     }
 